@@ -0,0 +1,834 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "iterator/_pointer_iterator.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+
+namespace ft
+{
+    // BEGIN Iterator
+    // What a flat map iterator dereferences to: the key and mapped value seen through references.
+    template <typename TKey, typename TMapped>
+    struct _flat_map_reference
+    {
+        const TKey& first;
+        TMapped& second;
+
+        _flat_map_reference(const TKey& first, TMapped& second) throw()
+            : first(first), second(second) {}
+
+        _flat_map_reference(const _flat_map_reference& that) throw()
+            : first(that.first), second(that.second) {}
+
+        template <typename UKey, typename UMapped>
+        operator ft::pair<UKey, UMapped>() const { return ft::pair<UKey, UMapped>(this->first, this->second); }
+
+        friend bool operator==(const _flat_map_reference& lhs, const _flat_map_reference& rhs)
+        {
+            return lhs.first == rhs.first && lhs.second == rhs.second;
+        }
+
+        friend bool operator<(const _flat_map_reference& lhs, const _flat_map_reference& rhs)
+        {
+            return lhs.first < rhs.first || (!(rhs.first < lhs.first) && lhs.second < rhs.second);
+        }
+
+    private:
+        _flat_map_reference& operator=(const _flat_map_reference&);
+    };
+
+    template <typename TRef>
+    struct _flat_map_arrow
+    {
+    private:
+        TRef ref;
+
+    public:
+        explicit _flat_map_arrow(const TRef& ref)
+            : ref(ref) {}
+
+        const TRef* operator->() const throw() { return &this->ref; }
+    };
+
+    // Walks the key and mapped arrays of a flat map in lockstep.
+    // Dereferencing yields a pair of references instead of a reference to a stored pair.
+    template <typename TKey, typename TMapped>
+    struct _flat_map_iterator
+    {
+        typedef std::ptrdiff_t difference_type;
+        typedef ft::pair<const TKey, typename ft::remove_const<TMapped>::type> value_type;
+        typedef _flat_map_reference<TKey, TMapped> reference;
+        typedef _flat_map_arrow<reference> pointer;
+        typedef ft::random_access_iterator_tag iterator_category;
+
+        const TKey* key;
+        TMapped* mapped;
+
+        _flat_map_iterator() throw()
+            : key(), mapped() {}
+
+        _flat_map_iterator(const TKey* key, TMapped* mapped) throw()
+            : key(key), mapped(mapped) {}
+
+        template <typename UMapped>
+        _flat_map_iterator(const _flat_map_iterator<TKey, UMapped>& that, typename ft::enable_if<ft::is_same<const UMapped, TMapped>::value, void*>::type = NULL) throw()
+            : key(that.key), mapped(that.mapped) {}
+
+        reference operator*() const throw() { return reference(*this->key, *this->mapped); }
+        pointer operator->() const throw() { return pointer(**this); }
+        reference operator[](difference_type n) const throw() { return reference(this->key[n], this->mapped[n]); }
+
+        _flat_map_iterator& operator++() throw()
+        {
+            ++this->key;
+            ++this->mapped;
+            return *this;
+        }
+
+        _flat_map_iterator operator++(int) throw()
+        {
+            _flat_map_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        _flat_map_iterator& operator--() throw()
+        {
+            --this->key;
+            --this->mapped;
+            return *this;
+        }
+
+        _flat_map_iterator operator--(int) throw()
+        {
+            _flat_map_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        _flat_map_iterator& operator+=(difference_type n) throw()
+        {
+            this->key += n;
+            this->mapped += n;
+            return *this;
+        }
+
+        _flat_map_iterator& operator-=(difference_type n) throw()
+        {
+            this->key -= n;
+            this->mapped -= n;
+            return *this;
+        }
+
+        _flat_map_iterator operator+(difference_type n) const throw() { return _flat_map_iterator(this->key + n, this->mapped + n); }
+        _flat_map_iterator operator-(difference_type n) const throw() { return _flat_map_iterator(this->key - n, this->mapped - n); }
+
+        friend _flat_map_iterator operator+(difference_type n, const _flat_map_iterator& it) throw() { return it + n; }
+        friend difference_type operator-(const _flat_map_iterator& lhs, const _flat_map_iterator& rhs) throw() { return lhs.key - rhs.key; }
+
+        friend bool operator==(const _flat_map_iterator& lhs, const _flat_map_iterator& rhs) throw() { return lhs.key == rhs.key; }
+        friend bool operator!=(const _flat_map_iterator& lhs, const _flat_map_iterator& rhs) throw() { return lhs.key != rhs.key; }
+        friend bool operator<(const _flat_map_iterator& lhs, const _flat_map_iterator& rhs) throw() { return lhs.key < rhs.key; }
+        friend bool operator<=(const _flat_map_iterator& lhs, const _flat_map_iterator& rhs) throw() { return lhs.key <= rhs.key; }
+        friend bool operator>(const _flat_map_iterator& lhs, const _flat_map_iterator& rhs) throw() { return lhs.key > rhs.key; }
+        friend bool operator>=(const _flat_map_iterator& lhs, const _flat_map_iterator& rhs) throw() { return lhs.key >= rhs.key; }
+    };
+    // END Iterator
+
+    // BEGIN Storage
+    // vector<bool> packs its bits and has no bool& to hand out, so bools are kept in cells;
+    // a cell is standard layout and its address is that of the bool it holds.
+    struct _flat_bool_cell
+    {
+        bool value;
+
+        _flat_bool_cell(bool value = false)
+            : value(value) {}
+    };
+
+    template <typename T>
+    struct _flat_slot
+    {
+        typedef T type;
+    };
+
+    template <>
+    struct _flat_slot<bool>
+    {
+        typedef _flat_bool_cell type;
+    };
+
+    // Keys and mapped values live in two parallel vectors, so lookups only touch the keys.
+    template <typename TKey, typename TMapped, typename TAlloc>
+    class _flat_pair_storage
+    {
+    public:
+        typedef TKey key_type;
+        typedef ft::pair<const TKey, TMapped> value_type;
+        typedef TAlloc allocator_type;
+        typedef std::size_t size_type;
+        typedef _flat_map_iterator<TKey, TMapped> iterator;
+        typedef _flat_map_iterator<TKey, const TMapped> const_iterator;
+
+    private:
+        typedef typename _flat_slot<TKey>::type key_slot;
+        typedef typename _flat_slot<TMapped>::type mapped_slot;
+        typedef typename allocator_type::template rebind<key_slot>::other key_allocator_type;
+        typedef typename allocator_type::template rebind<mapped_slot>::other mapped_allocator_type;
+
+        ft::vector<key_slot, key_allocator_type> keys;
+        ft::vector<mapped_slot, mapped_allocator_type> values;
+
+        const TKey* key_data() const { return reinterpret_cast<const TKey*>(this->keys.data()); }
+        TMapped* mapped_data() { return reinterpret_cast<TMapped*>(this->values.data()); }
+        const TMapped* mapped_data() const { return reinterpret_cast<const TMapped*>(this->values.data()); }
+
+    public:
+        explicit _flat_pair_storage(const allocator_type& alloc)
+            : keys(key_allocator_type(alloc)), values(mapped_allocator_type(alloc)) {}
+
+    public:
+        allocator_type get_allocator() const { return allocator_type(this->keys.get_allocator()); }
+
+        static const key_type& key_of(const value_type& value) { return value.first; }
+        const key_type& key(size_type i) const { return this->key_data()[i]; }
+
+        iterator begin() { return iterator(this->key_data(), this->mapped_data()); }
+        const_iterator begin() const { return const_iterator(this->key_data(), this->mapped_data()); }
+        iterator end() { return this->begin() + this->size(); }
+        const_iterator end() const { return this->begin() + this->size(); }
+
+        size_type index_of(const_iterator it) const { return it.key - this->key_data(); }
+
+        bool empty() const { return this->keys.empty(); }
+        size_type size() const { return this->keys.size(); }
+
+        size_type max_size() const
+        {
+            size_type n = this->keys.max_size();
+            size_type m = this->values.max_size();
+            return n < m ? n : m;
+        }
+
+        size_type capacity() const { return this->keys.capacity(); }
+
+        void reserve(size_type n)
+        {
+            this->keys.reserve(n);
+            this->values.reserve(n);
+        }
+
+        void clear()
+        {
+            this->keys.clear();
+            this->values.clear();
+        }
+
+        void insert(size_type i, const value_type& value)
+        {
+            this->keys.insert(this->keys.begin() + i, value.first);
+            try
+            {
+                this->values.insert(this->values.begin() + i, value.second);
+            }
+            catch (...)
+            {
+                this->keys.erase(this->keys.begin() + i);
+                throw;
+            }
+        }
+
+#if __cplusplus >= 201103L
+        // the key and the mapped value go to their own arrays, the mapped value is built from args
+        template <typename UKey, typename... Args>
+        void emplace(size_type i, UKey&& key, Args&&... args)
+        {
+            this->keys.emplace(this->keys.begin() + i, ft::forward<UKey>(key));
+            try
+            {
+                this->values.emplace(this->values.begin() + i, ft::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                this->keys.erase(this->keys.begin() + i);
+                throw;
+            }
+        }
+#endif
+
+        void push_back(const value_type& value)
+        {
+            this->keys.push_back(value.first);
+            try
+            {
+                this->values.push_back(value.second);
+            }
+            catch (...)
+            {
+                this->keys.pop_back();
+                throw;
+            }
+        }
+
+#if __cplusplus >= 201103L
+        // a pair converted on the way in is a temporary, its mapped value is not copied twice
+        void push_back(value_type&& value)
+        {
+            this->keys.push_back(value.first);
+            try
+            {
+                this->values.push_back(ft::move(value.second));
+            }
+            catch (...)
+            {
+                this->keys.pop_back();
+                throw;
+            }
+        }
+#endif
+
+        void push_back(const _flat_pair_storage& that, size_type i)
+        {
+            this->keys.push_back(that.keys[i]);
+            try
+            {
+                this->values.push_back(that.values[i]);
+            }
+            catch (...)
+            {
+                this->keys.pop_back();
+                throw;
+            }
+        }
+
+        // Appends element i of that into reserved room, moving it only when neither half can throw:
+        // either the element moves whole or that keeps it.
+        void move_back(_flat_pair_storage& that, size_type i)
+        {
+#if __cplusplus >= 201103L
+            if (_internal::_move_if_noexcept<key_slot>::value && _internal::_move_if_noexcept<mapped_slot>::value)
+            {
+                this->keys.push_back(ft::move(that.keys[i]));
+                this->values.push_back(ft::move(that.values[i]));
+                return;
+            }
+#endif
+            this->push_back(that, i);
+        }
+
+        void erase(size_type first, size_type last)
+        {
+            this->keys.erase(this->keys.begin() + first, this->keys.begin() + last);
+            this->values.erase(this->values.begin() + first, this->values.begin() + last);
+        }
+
+        void swap(_flat_pair_storage& that)
+        {
+            this->keys.swap(that.keys);
+            this->values.swap(that.values);
+        }
+    };
+
+    // Sets store the keys only, elements are immutable so both iterators are const.
+    template <typename TKey, typename TAlloc>
+    class _flat_key_storage
+    {
+    public:
+        typedef TKey key_type;
+        typedef TKey value_type;
+        typedef TAlloc allocator_type;
+        typedef std::size_t size_type;
+        typedef const TKey* pointer;
+        typedef const TKey* const_pointer;
+
+    private:
+        typedef typename _flat_slot<TKey>::type key_slot;
+        typedef typename allocator_type::template rebind<key_slot>::other key_allocator_type;
+        typedef ft::vector<key_slot, key_allocator_type> vector_type;
+
+    public:
+        typedef ft::_internal::_pointer_iterator<const_pointer, _flat_key_storage> iterator;
+        typedef ft::_internal::_pointer_iterator<const_pointer, _flat_key_storage> const_iterator;
+
+    private:
+        vector_type keys;
+
+        const TKey* key_data() const { return reinterpret_cast<const TKey*>(this->keys.data()); }
+
+    public:
+        explicit _flat_key_storage(const allocator_type& alloc)
+            : keys(key_allocator_type(alloc)) {}
+
+    public:
+        allocator_type get_allocator() const { return allocator_type(this->keys.get_allocator()); }
+
+        static const key_type& key_of(const value_type& value) { return value; }
+        const key_type& key(size_type i) const { return this->key_data()[i]; }
+
+        const_iterator begin() const { return const_iterator(this->key_data()); }
+        const_iterator end() const { return const_iterator(this->key_data() + this->size()); }
+
+        size_type index_of(const_iterator it) const { return it - this->begin(); }
+
+        bool empty() const { return this->keys.empty(); }
+        size_type size() const { return this->keys.size(); }
+        size_type max_size() const { return this->keys.max_size(); }
+        size_type capacity() const { return this->keys.capacity(); }
+
+        void reserve(size_type n) { this->keys.reserve(n); }
+        void clear() { this->keys.clear(); }
+
+        void insert(size_type i, const value_type& value) { this->keys.insert(this->keys.begin() + i, value); }
+
+#if __cplusplus >= 201103L
+        template <typename UKey>
+        void emplace(size_type i, UKey&& key) { this->keys.emplace(this->keys.begin() + i, ft::forward<UKey>(key)); }
+#endif
+
+        void push_back(const value_type& value) { this->keys.push_back(value); }
+        void push_back(const _flat_key_storage& that, size_type i) { this->keys.push_back(that.keys[i]); }
+
+        // appends element i of that into reserved room, moving it only when that cannot throw
+        void move_back(_flat_key_storage& that, size_type i)
+        {
+#if __cplusplus >= 201103L
+            this->keys.push_back(ft::move_if_noexcept(that.keys[i]));
+#else
+            this->keys.push_back(that.keys[i]);
+#endif
+        }
+
+        void erase(size_type first, size_type last)
+        {
+            this->keys.erase(this->keys.begin() + first, this->keys.begin() + last);
+        }
+
+        void swap(_flat_key_storage& that) { this->keys.swap(that.keys); }
+    };
+    // END Storage
+
+    // Orders batch positions by key, equal keys keep their input order.
+    template <typename TStorage, typename TComp>
+    struct _flat_index_compare
+    {
+        const TStorage& storage;
+        TComp comp;
+
+        _flat_index_compare(const TStorage& storage, const TComp& comp)
+            : storage(storage), comp(comp) {}
+
+        bool operator()(std::size_t lhs, std::size_t rhs) const
+        {
+            if (this->comp(this->storage.key(lhs), this->storage.key(rhs)))
+            {
+                return true;
+            }
+            if (this->comp(this->storage.key(rhs), this->storage.key(lhs)))
+            {
+                return false;
+            }
+            return lhs < rhs;
+        }
+    };
+
+    // Sorted vector engine shared by the flat associative containers.
+    // Lookups are binary searches over contiguous keys; single inserts shift the tail,
+    // range inserts sort the batch once and merge it with the existing elements in one pass.
+    template <typename TStorage, typename TComp>
+    class _flat_tree
+    {
+    public:
+        typedef TStorage storage_type;
+        typedef typename storage_type::key_type key_type;
+        typedef typename storage_type::value_type value_type;
+        typedef TComp key_compare;
+        typedef typename storage_type::allocator_type allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename storage_type::iterator iterator;
+        typedef typename storage_type::const_iterator const_iterator;
+        typedef ft::reverse_iterator<iterator> reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        storage_type storage;
+        key_compare comp;
+
+    public:
+        _flat_tree(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            : storage(alloc), comp(comp) {}
+
+        _flat_tree(const _flat_tree& that)
+            : storage(that.storage), comp(that.comp) {}
+
+#if __cplusplus >= 201103L
+        _flat_tree(_flat_tree&& that) noexcept(_internal::_is_nothrow_copy_constructible<key_compare>::value)
+            : storage(ft::move(that.storage)), comp(that.comp) {}
+#endif
+
+        ~_flat_tree() {}
+
+        _flat_tree& operator=(const _flat_tree& that)
+        {
+            if (this != &that)
+            {
+                _flat_tree tmp(that);
+                this->swap(tmp);
+            }
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        _flat_tree& operator=(_flat_tree&& that)
+        {
+            if (this != &that)
+            {
+                _flat_tree tmp(ft::move(that));
+                this->swap(tmp);
+            }
+            return *this;
+        }
+#endif
+
+    public:
+        allocator_type get_allocator() const { return this->storage.get_allocator(); }
+        key_compare key_comp() const { return this->comp; }
+
+        iterator begin() { return this->storage.begin(); }
+        const_iterator begin() const { return this->storage.begin(); }
+        iterator end() { return this->storage.end(); }
+        const_iterator end() const { return this->storage.end(); }
+        reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+        reverse_iterator rend() { return reverse_iterator(this->begin()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+        bool empty() const { return this->storage.empty(); }
+        size_type size() const { return this->storage.size(); }
+        size_type max_size() const { return this->storage.max_size(); }
+        size_type capacity() const { return this->storage.capacity(); }
+
+        void reserve(size_type n) { this->storage.reserve(n); }
+        void clear() { this->storage.clear(); }
+
+        void swap(_flat_tree& that)
+        {
+            this->storage.swap(that.storage);
+            ft::swap(this->comp, that.comp);
+        }
+
+    private:
+        iterator at_index(size_type i) { return this->begin() + i; }
+        const_iterator at_index(size_type i) const { return this->begin() + i; }
+
+        size_type lower_bound_index(const key_type& key) const
+        {
+            size_type first = 0;
+            size_type n = this->size();
+            while (n > 0)
+            {
+                size_type step = n / 2;
+                if (this->comp(this->storage.key(first + step), key))
+                {
+                    first += step + 1;
+                    n -= step + 1;
+                }
+                else
+                {
+                    n = step;
+                }
+            }
+            return first;
+        }
+
+        size_type upper_bound_index(const key_type& key) const
+        {
+            size_type first = 0;
+            size_type n = this->size();
+            while (n > 0)
+            {
+                size_type step = n / 2;
+                if (!this->comp(key, this->storage.key(first + step)))
+                {
+                    first += step + 1;
+                    n -= step + 1;
+                }
+                else
+                {
+                    n = step;
+                }
+            }
+            return first;
+        }
+
+        size_type find_index(const key_type& key) const
+        {
+            size_type i = this->lower_bound_index(key);
+            if (i == this->size() || this->comp(key, this->storage.key(i)))
+            {
+                return this->size();
+            }
+            return i;
+        }
+
+        // hint is taken when key belongs right before it, end() makes in order appends O(1);
+        // false with i at the equal element when the key is already present
+        bool unique_index(const_iterator hint, const key_type& key, size_type& i) const
+        {
+            size_type n = this->size();
+            i = this->storage.index_of(hint);
+            if (!((i == 0 || this->comp(this->storage.key(i - 1), key)) && (i == n || this->comp(key, this->storage.key(i)))))
+            {
+                i = this->lower_bound_index(key);
+                if (i != n && !this->comp(key, this->storage.key(i)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        size_type equal_index(const_iterator hint, const key_type& key) const
+        {
+            size_type n = this->size();
+            size_type i = this->storage.index_of(hint);
+            if (!((i == 0 || !this->comp(key, this->storage.key(i - 1))) && (i == n || !this->comp(this->storage.key(i), key))))
+            {
+                i = this->upper_bound_index(key);
+            }
+            return i;
+        }
+
+    public:
+        iterator find(const key_type& key) { return this->at_index(this->find_index(key)); }
+        const_iterator find(const key_type& key) const { return this->at_index(this->find_index(key)); }
+
+        size_type count(const key_type& key) const { return this->upper_bound_index(key) - this->lower_bound_index(key); }
+
+        iterator lower_bound(const key_type& key) { return this->at_index(this->lower_bound_index(key)); }
+        const_iterator lower_bound(const key_type& key) const { return this->at_index(this->lower_bound_index(key)); }
+
+        iterator upper_bound(const key_type& key) { return this->at_index(this->upper_bound_index(key)); }
+        const_iterator upper_bound(const key_type& key) const { return this->at_index(this->upper_bound_index(key)); }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key)
+        {
+            return ft::make_pair(this->lower_bound(key), this->upper_bound(key));
+        }
+
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+        {
+            return ft::make_pair(this->lower_bound(key), this->upper_bound(key));
+        }
+
+    public:
+        ft::pair<iterator, bool> insert_unique(const_iterator hint, const value_type& value)
+        {
+            size_type i;
+            if (!this->unique_index(hint, storage_type::key_of(value), i))
+            {
+                return ft::make_pair(this->at_index(i), false);
+            }
+            this->storage.insert(i, value);
+            return ft::make_pair(this->at_index(i), true);
+        }
+
+        iterator insert_equal(const_iterator hint, const value_type& value)
+        {
+            size_type i = this->equal_index(hint, storage_type::key_of(value));
+            this->storage.insert(i, value);
+            return this->at_index(i);
+        }
+
+#if __cplusplus >= 201103L
+        // The key is compared before anything is built, args make the mapped value of a map
+        // and are left alone when the key is already present.
+        template <typename UKey, typename... Args>
+        ft::pair<iterator, bool> emplace_unique(const_iterator hint, UKey&& key, Args&&... args)
+        {
+            size_type i;
+            if (!this->unique_index(hint, key, i))
+            {
+                return ft::make_pair(this->at_index(i), false);
+            }
+            this->storage.emplace(i, ft::forward<UKey>(key), ft::forward<Args>(args)...);
+            return ft::make_pair(this->at_index(i), true);
+        }
+
+        template <typename UKey, typename... Args>
+        iterator emplace_equal(const_iterator hint, UKey&& key, Args&&... args)
+        {
+            size_type i = this->equal_index(hint, key);
+            this->storage.emplace(i, ft::forward<UKey>(key), ft::forward<Args>(args)...);
+            return this->at_index(i);
+        }
+#endif
+
+        template <typename UIter>
+        void insert_range_unique(UIter first, UIter last)
+        {
+            this->insert_range(first, last, true, false);
+        }
+
+        template <typename UIter>
+        void insert_range_unique(ft::sorted_unique_t, UIter first, UIter last)
+        {
+            this->insert_range(first, last, true, true);
+        }
+
+        template <typename UIter>
+        void insert_range_equal(UIter first, UIter last)
+        {
+            this->insert_range(first, last, false, false);
+        }
+
+        template <typename UIter>
+        void insert_range_equal(ft::sorted_equivalent_t, UIter first, UIter last)
+        {
+            this->insert_range(first, last, false, true);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            size_type i = this->storage.index_of(first);
+            this->storage.erase(i, this->storage.index_of(last));
+            return this->at_index(i);
+        }
+
+    private:
+        template <typename UIter>
+        void insert_range(UIter first, UIter last, bool unique, bool sorted)
+        {
+            storage_type batch(this->get_allocator());
+            for (; first != last; ++first)
+            {
+                batch.push_back(*first);
+            }
+            size_type m = batch.size();
+            if (m == 0)
+            {
+                return;
+            }
+
+            ft::vector<size_type> order;
+            order.reserve(m);
+            for (size_type j = 0; j < m; ++j)
+            {
+                if (!sorted && j != 0 && this->comp(batch.key(j), batch.key(j - 1)))
+                {
+                    sorted = true;
+                    order.clear();
+                    for (size_type k = 0; k < m; ++k)
+                    {
+                        order.push_back(k);
+                    }
+                    ft::sort(order.begin(), order.end(), _flat_index_compare<storage_type, key_compare>(batch, this->comp));
+                    break;
+                }
+                order.push_back(j);
+            }
+
+            size_type n = this->size();
+            const key_type& lowest = batch.key(order[0]);
+            if (n == 0 || (unique ? this->comp(this->storage.key(n - 1), lowest) : !this->comp(lowest, this->storage.key(n - 1))))
+            {
+                // the whole batch goes after the current maximum
+                this->storage.reserve(n + m);
+                for (size_type j = 0; j < m; ++j)
+                {
+                    this->push_back_from(this->storage, batch, order[j], unique);
+                }
+                return;
+            }
+
+            // Every comparison happens before the first element moves, so a throwing comparator
+            // leaves the container as it was: the k-th kept batch element goes after before[k]
+            // existing ones, order keeps only the batch elements that are kept.
+            ft::vector<size_type> before;
+            before.reserve(m);
+            size_type kept = 0;
+            size_type i = 0;
+            const key_type* previous = NULL;
+            for (size_type j = 0; j < m; ++j)
+            {
+                const key_type& key = batch.key(order[j]);
+                // existing elements win ties, so equal keys from the batch land after them
+                while (i < n && !this->comp(key, this->storage.key(i)))
+                {
+                    previous = &this->storage.key(i++);
+                }
+                if (!unique || previous == NULL || this->comp(*previous, key))
+                {
+                    order[kept++] = order[j];
+                    before.push_back(i);
+                    previous = &key;
+                }
+            }
+
+            storage_type merged(this->get_allocator());
+            merged.reserve(n + kept);
+            i = 0;
+            for (size_type k = 0; k < kept; ++k)
+            {
+                for (; i < before[k]; ++i)
+                {
+                    merged.move_back(this->storage, i);
+                }
+                merged.move_back(batch, order[k]);
+            }
+            for (; i < n; ++i)
+            {
+                merged.move_back(this->storage, i);
+            }
+            this->storage.swap(merged);
+        }
+
+        void push_back_from(storage_type& dest, storage_type& src, size_type i, bool unique)
+        {
+            size_type n = dest.size();
+            if (!unique || n == 0 || this->comp(dest.key(n - 1), src.key(i)))
+            {
+                dest.move_back(src, i);
+            }
+        }
+
+    public:
+        friend bool operator==(const _flat_tree& lhs, const _flat_tree& rhs)
+        {
+            return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        friend bool operator!=(const _flat_tree& lhs, const _flat_tree& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const _flat_tree& lhs, const _flat_tree& rhs)
+        {
+            return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator<=(const _flat_tree& lhs, const _flat_tree& rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>(const _flat_tree& lhs, const _flat_tree& rhs)
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator>=(const _flat_tree& lhs, const _flat_tree& rhs)
+        {
+            return !(lhs < rhs);
+        }
+    };
+}
@@ -0,0 +1,1285 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "algorithm.hpp"
+#include "functional.hpp"
+#include "iterator.hpp"
+#include "stdexcept.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "utility/_in_place.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace ft
+{
+    namespace _internal
+    {
+        typedef signed char _hash_ctrl;
+
+        // Control bytes: a full slot stores the low 7 bits of its hash, the others have the high bit set.
+        enum
+        {
+            _hash_empty = -128,
+            _hash_deleted = -2,
+            _hash_sentinel = -1
+        };
+
+        // A group of control bytes probed at once, one byte per lane of a machine word.
+        // Lanes are little endian whatever the platform, so the lowest set bit is the first slot.
+        struct _hash_group
+        {
+            typedef std::size_t word_type;
+
+            enum
+            {
+                width = sizeof(word_type)
+            };
+
+            word_type ctrl;
+
+            explicit _hash_group(const _hash_ctrl* p) throw()
+                : ctrl()
+            {
+                for (std::size_t i = 0; i < width; i++)
+                {
+                    this->ctrl |= static_cast<word_type>(static_cast<unsigned char>(p[i])) << (i * 8);
+                }
+            }
+
+            static word_type lsbs() throw() { return ~word_type() / 0xFF; }
+            static word_type msbs() throw() { return lsbs() << 7; }
+
+            // may report a false positive after a true match, callers compare the keys anyway
+            word_type match(_hash_ctrl h2) const throw()
+            {
+                word_type x = this->ctrl ^ (lsbs() * static_cast<unsigned char>(h2));
+                return (x - lsbs()) & ~x & msbs();
+            }
+
+            word_type mask_empty() const throw() { return this->ctrl & (~this->ctrl << 6) & msbs(); }
+            word_type mask_empty_or_deleted() const throw() { return this->ctrl & (~this->ctrl << 7) & msbs(); }
+
+            // lanes before the first bit of a non zero mask
+            static std::size_t trailing(word_type mask) throw()
+            {
+#if defined(__GNUC__) || defined(__clang__)
+                return static_cast<std::size_t>(sizeof(word_type) > sizeof(unsigned long) ? __builtin_ctzll(mask) : __builtin_ctzl(static_cast<unsigned long>(mask))) >> 3;
+#else
+                std::size_t n = 0;
+                for (; (mask & 0x80) == 0; mask >>= 8)
+                {
+                    n++;
+                }
+                return n;
+#endif
+            }
+
+            // lanes after the last bit of a non zero mask
+            static std::size_t leading(word_type mask) throw()
+            {
+                std::size_t n = 0;
+                for (word_type top = msbs() & ~(msbs() >> 8); (mask & top) == 0; top >>= 8)
+                {
+                    n++;
+                }
+                return n;
+            }
+        };
+
+        // Shared by every empty table, so default construction does not allocate.
+        template <typename T>
+        struct _hash_empty_group
+        {
+            static const _hash_ctrl ctrl[16];
+        };
+
+        template <typename T>
+        const _hash_ctrl _hash_empty_group<T>::ctrl[16] = {
+            _hash_sentinel, _hash_empty, _hash_empty, _hash_empty,
+            _hash_empty, _hash_empty, _hash_empty, _hash_empty,
+            _hash_empty, _hash_empty, _hash_empty, _hash_empty,
+            _hash_empty, _hash_empty, _hash_empty, _hash_empty};
+
+        // ft::hash is the identity for integers, spread every input bit before splitting the hash
+        inline std::size_t hash_mix(std::size_t h) throw()
+        {
+            const std::size_t k = sizeof(std::size_t) > 4 ? (std::size_t(0x9E3779B9) << 16 << 16) | 0x7F4A7C15 : 0x9E3779B9;
+            h *= k;
+            return h ^ (h >> (sizeof(std::size_t) * 4));
+        }
+    }
+
+    template <typename T>
+    struct _hash_table_iterator
+    {
+        typedef T value_type;
+        typedef value_type& reference;
+        typedef value_type* pointer;
+
+        typedef ft::forward_iterator_tag iterator_category;
+        typedef std::ptrdiff_t difference_type;
+
+        const _internal::_hash_ctrl* ctrl;
+        value_type* slot;
+
+        _hash_table_iterator() throw()
+            : ctrl(), slot() {}
+
+        _hash_table_iterator(const _internal::_hash_ctrl* ctrl, value_type* slot) throw()
+            : ctrl(ctrl), slot(slot) {}
+
+        template <typename U>
+        _hash_table_iterator(const _hash_table_iterator<U>& that, typename ft::enable_if<ft::is_same<const U, T>::value, void*>::type = NULL) throw()
+            : ctrl(that.ctrl), slot(that.slot) {}
+
+        bool at_end() const throw() { return *this->ctrl == _internal::_hash_sentinel; }
+
+        // move forward to the next full slot or the sentinel
+        void skip_free() throw()
+        {
+            while (*this->ctrl < _internal::_hash_sentinel)
+            {
+                ++this->ctrl;
+                ++this->slot;
+            }
+        }
+
+        reference operator*() const throw() { return *this->slot; }
+        pointer operator->() const throw() { return this->slot; }
+
+        _hash_table_iterator& operator++() throw()
+        {
+            ++this->ctrl;
+            ++this->slot;
+            this->skip_free();
+            return *this;
+        }
+
+        _hash_table_iterator operator++(int) throw()
+        {
+            _hash_table_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const _hash_table_iterator& lhs, const _hash_table_iterator& rhs) throw()
+        {
+            return lhs.ctrl == rhs.ctrl;
+        }
+
+        friend bool operator!=(const _hash_table_iterator& lhs, const _hash_table_iterator& rhs) throw()
+        {
+            return lhs.ctrl != rhs.ctrl;
+        }
+    };
+
+    // 참조: Swiss table (open addressing with a separate control byte array)
+    // Slots hold the values themselves. The table has 2^k - 1 slots followed in ctrl by a sentinel
+    // and a copy of the first group, so a group can be loaded at any slot without wrapping.
+    // Lookups probe whole groups: the 7 bit tag of the hash filters candidates before any key compare,
+    // and an empty lane in the group ends the search.
+    //
+    // TKeySelector: const TKey& (*keySelector)(const T&)
+    // THash: std::size_t (*hash)(const TKey&)
+    // TEqual: bool (*equal)(const TKey&, const TKey&)
+    template <typename TKey, typename T, typename TKeySelector, typename THash = ft::hash<TKey>, typename TEqual = ft::equal_to<TKey>, typename TAlloc = std::allocator<T> >
+    class _hash_table
+    {
+    public:
+        typedef TKey key_type;
+        typedef T value_type;
+        typedef TKeySelector key_selector;
+        typedef THash hasher;
+        typedef TEqual key_equal;
+        typedef typename TAlloc::template rebind<T>::other allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        typedef _hash_table_iterator<value_type> iterator;
+        typedef _hash_table_iterator<const value_type> const_iterator;
+
+    private:
+        typedef _internal::_hash_ctrl ctrl_type;
+        typedef _internal::_hash_group group_type;
+        typedef typename TAlloc::template rebind<ctrl_type>::other ctrl_allocator_type;
+        typedef typename allocator_type::pointer pointer;
+
+        enum
+        {
+            cloned = group_type::width - 1
+        };
+
+        ctrl_type* ctrl;
+        pointer slots;
+        size_type mask;
+        size_type number;
+        size_type growth_left;
+        float max_load;
+
+        hasher hash;
+        key_equal equal;
+        allocator_type alloc;
+
+    public:
+        _hash_table(size_type n = 0, const THash& hash = THash(), const TEqual& equal = TEqual(), const TAlloc& alloc = TAlloc())
+            : ctrl(empty_group()), slots(), mask(), number(), growth_left(), max_load(0.875f),
+              hash(hash), equal(equal), alloc(alloc)
+        {
+            this->rehash(n);
+        }
+
+        _hash_table(const _hash_table& that)
+            : ctrl(empty_group()), slots(), mask(), number(), growth_left(), max_load(that.max_load),
+              hash(that.hash), equal(that.equal), alloc(that.alloc)
+        {
+            this->reserve(that.number);
+            try
+            {
+                for (const_iterator it = that.begin(); it != that.end(); ++it)
+                {
+                    this->insert_new(this->hash_of(key_selector()(*it)), *it);
+                }
+            }
+            catch (...)
+            {
+                this->destruct();
+                throw;
+            }
+        }
+
+#if __cplusplus >= 201103L
+        _hash_table(_hash_table&& that) noexcept(_internal::_is_nothrow_copy_constructible<hasher>::value && _internal::_is_nothrow_copy_constructible<key_equal>::value && _internal::_is_nothrow_copy_constructible<allocator_type>::value)
+            : ctrl(empty_group()), slots(), mask(), number(), growth_left(), max_load(that.max_load),
+              hash(that.hash), equal(that.equal), alloc(that.alloc)
+        {
+            this->swap(that);
+        }
+#endif
+
+        ~_hash_table()
+        {
+            this->destruct();
+        }
+
+        _hash_table& operator=(const _hash_table& that)
+        {
+            if (this != &that)
+            {
+                _hash_table temp = that;
+                this->swap(temp);
+            }
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        _hash_table& operator=(_hash_table&& that)
+        {
+            if (this != &that)
+            {
+                _hash_table temp(ft::move(that));
+                this->swap(temp);
+            }
+            return *this;
+        }
+#endif
+
+    public:
+        allocator_type get_allocator() const { return this->alloc; }
+        hasher hash_function() const { return this->hash; }
+        key_equal key_eq() const { return this->equal; }
+
+    private:
+        static ctrl_type* empty_group() throw()
+        {
+            // never written, a table without slots always grows before inserting
+            return const_cast<ctrl_type*>(_internal::_hash_empty_group<void>::ctrl);
+        }
+
+        static size_type h1(size_type h) throw() { return h >> 7; }
+        static ctrl_type h2(size_type h) throw() { return static_cast<ctrl_type>(h & 0x7F); }
+
+        size_type hash_of(const key_type& key) const { return _internal::hash_mix(this->hash(key)); }
+
+        // elements a table of cap slots takes before it has to grow, one slot always stays empty
+        size_type growth(size_type cap) const
+        {
+            if (cap == 0)
+            {
+                return 0;
+            }
+            size_type n = static_cast<size_type>(static_cast<double>(cap) * this->max_load);
+            return n < cap ? n : cap - 1;
+        }
+
+        size_type capacity_for(size_type n) const
+        {
+            if (n == 0)
+            {
+                return 0;
+            }
+            size_type cap = group_type::width - 1;
+            while (this->growth(cap) < n)
+            {
+                if (cap > this->max_size() / 2)
+                {
+                    throw ft::length_error("unordered container: capacity_for");
+                }
+                cap = cap * 2 + 1;
+            }
+            return cap;
+        }
+
+        static void set_ctrl(ctrl_type* ctrl, size_type mask, size_type i, ctrl_type value) throw()
+        {
+            ctrl[i] = value;
+            // mirror the first group after the sentinel
+            ctrl[((i - cloned) & mask) + (cloned & mask)] = value;
+        }
+
+        // triangular probing over groups visits every group once when the slot count is a power of two minus one
+        static size_type find_first_non_full(const ctrl_type* ctrl, size_type mask, size_type h) throw()
+        {
+            size_type pos = h1(h) & mask;
+            for (size_type stride = group_type::width;; stride += group_type::width)
+            {
+                group_type::word_type free = group_type(ctrl + pos).mask_empty_or_deleted();
+                if (free != 0)
+                {
+                    return (pos + group_type::trailing(free)) & mask;
+                }
+                pos = (pos + stride) & mask;
+            }
+        }
+
+        size_type find_index(const key_type& key, size_type h) const
+        {
+            size_type pos = h1(h) & this->mask;
+            for (size_type stride = group_type::width;; stride += group_type::width)
+            {
+                group_type group(this->ctrl + pos);
+                for (group_type::word_type m = group.match(h2(h)); m != 0; m &= m - 1)
+                {
+                    size_type i = (pos + group_type::trailing(m)) & this->mask;
+                    if (this->equal(key_selector()(this->slots[i]), key))
+                    {
+                        return i;
+                    }
+                }
+                if (group.mask_empty() != 0)
+                {
+                    return this->mask;
+                }
+                pos = (pos + stride) & this->mask;
+            }
+        }
+
+        bool must_grow(size_type i) const { return this->growth_left == 0 && this->ctrl[i] != _internal::_hash_deleted; }
+
+        // also drops the tombstones when most of the used slots were erased
+        void grow() { this->resize(this->capacity_for(this->number * 2 + 1)); }
+
+        // marks slot i, just constructed, as holding an element of hash h
+        void occupy(size_type i, size_type h) throw()
+        {
+            if (this->ctrl[i] == _internal::_hash_empty)
+            {
+                this->growth_left--;
+            }
+            set_ctrl(this->ctrl, this->mask, i, h2(h));
+            this->number++;
+        }
+
+#if __cplusplus >= 201103L
+        // caller guarantees no element with an equal key exists
+        template <typename... Args>
+        size_type insert_new(size_type h, Args&&... args)
+        {
+            size_type i = find_first_non_full(this->ctrl, this->mask, h);
+            if (this->must_grow(i))
+            {
+                // the arguments may refer to an element the rehash moves, so the value is built first
+                value_type value(ft::forward<Args>(args)...);
+                this->grow();
+                i = find_first_non_full(this->ctrl, this->mask, h);
+                this->alloc.construct(this->slots + i, ft::move(value));
+            }
+            else
+            {
+                this->alloc.construct(this->slots + i, ft::forward<Args>(args)...);
+            }
+            this->occupy(i, h);
+            return i;
+        }
+#else
+        // caller guarantees no element with an equal key exists
+        size_type insert_new(size_type h, const value_type& value)
+        {
+            size_type i = find_first_non_full(this->ctrl, this->mask, h);
+            if (this->must_grow(i))
+            {
+                this->grow();
+                i = find_first_non_full(this->ctrl, this->mask, h);
+            }
+            this->alloc.construct(this->slots + i, value);
+            this->occupy(i, h);
+            return i;
+        }
+#endif
+
+        void erase_index(size_type i)
+        {
+            this->alloc.destroy(this->slots + i);
+            this->number--;
+
+            // a probe can only have walked past i if some window around it was full,
+            // otherwise the slot goes back to empty instead of leaving a tombstone
+            group_type::word_type empty_before = group_type(this->ctrl + ((i - group_type::width) & this->mask)).mask_empty();
+            group_type::word_type empty_after = group_type(this->ctrl + i).mask_empty();
+            if (empty_before != 0 && empty_after != 0 &&
+                group_type::trailing(empty_after) + group_type::leading(empty_before) < static_cast<size_type>(group_type::width))
+            {
+                set_ctrl(this->ctrl, this->mask, i, _internal::_hash_empty);
+                this->growth_left++;
+            }
+            else
+            {
+                set_ctrl(this->ctrl, this->mask, i, _internal::_hash_deleted);
+            }
+        }
+
+        void resize(size_type cap)
+        {
+            ctrl_type* new_ctrl = empty_group();
+            pointer new_slots = pointer();
+            if (cap != 0)
+            {
+                ctrl_allocator_type ctrl_alloc(this->alloc);
+                new_ctrl = ctrl_alloc.allocate(cap + group_type::width);
+                try
+                {
+                    new_slots = this->alloc.allocate(cap);
+                }
+                catch (...)
+                {
+                    ctrl_alloc.deallocate(new_ctrl, cap + group_type::width);
+                    throw;
+                }
+                std::memset(new_ctrl, _internal::_hash_empty, cap + group_type::width);
+                new_ctrl[cap] = _internal::_hash_sentinel;
+            }
+
+            try
+            {
+                for (size_type i = 0; i < this->mask; i++)
+                {
+                    if (this->ctrl[i] >= 0)
+                    {
+                        size_type h = this->hash_of(key_selector()(this->slots[i]));
+                        size_type j = find_first_non_full(new_ctrl, cap, h);
+#if __cplusplus >= 201103L
+                        // a throwing move would leave the old slots half moved, those are copied instead
+                        this->alloc.construct(new_slots + j, ft::move_if_noexcept(this->slots[i]));
+#else
+                        this->alloc.construct(new_slots + j, this->slots[i]);
+#endif
+                        set_ctrl(new_ctrl, cap, j, h2(h));
+                    }
+                }
+            }
+            catch (...)
+            {
+                release(this->alloc, new_ctrl, new_slots, cap);
+                throw;
+            }
+
+            release(this->alloc, this->ctrl, this->slots, this->mask);
+            this->ctrl = new_ctrl;
+            this->slots = new_slots;
+            this->mask = cap;
+            this->growth_left = this->growth(cap) - this->number;
+        }
+
+        static void release(allocator_type& alloc, ctrl_type* ctrl, pointer slots, size_type mask)
+        {
+            if (mask == 0)
+            {
+                return;
+            }
+            for (size_type i = 0; i < mask; i++)
+            {
+                if (ctrl[i] >= 0)
+                {
+                    alloc.destroy(slots + i);
+                }
+            }
+            alloc.deallocate(slots, mask);
+            ctrl_allocator_type(alloc).deallocate(ctrl, mask + group_type::width);
+        }
+
+        void destruct()
+        {
+            release(this->alloc, this->ctrl, this->slots, this->mask);
+            this->ctrl = empty_group();
+            this->slots = pointer();
+            this->mask = 0;
+            this->number = 0;
+            this->growth_left = 0;
+        }
+
+        iterator iterator_at(size_type i) { return iterator(this->ctrl + i, this->slots + i); }
+        const_iterator iterator_at(size_type i) const { return const_iterator(this->ctrl + i, this->slots + i); }
+
+    public:
+        iterator begin()
+        {
+            iterator it = this->iterator_at(0);
+            it.skip_free();
+            return it;
+        }
+
+        const_iterator begin() const
+        {
+            const_iterator it = this->iterator_at(0);
+            it.skip_free();
+            return it;
+        }
+
+        iterator end() { return this->iterator_at(this->mask); }
+        const_iterator end() const { return this->iterator_at(this->mask); }
+
+        bool empty() const { return this->number == 0; }
+        size_type size() const { return this->number; }
+        size_type max_size() const { return this->alloc.max_size(); }
+
+    public:
+        size_type bucket_count() const { return this->mask; }
+        float load_factor() const { return this->mask == 0 ? 0.0f : static_cast<float>(this->number) / this->mask; }
+        float max_load_factor() const { return this->max_load; }
+
+        // capacity_for needs a positive factor to grow at all, and a table never fills past one
+        void max_load_factor(float ml)
+        {
+            if (!(ml > 0.0f))
+            {
+                throw ft::invalid_argument("unordered container: max_load_factor");
+            }
+            this->max_load = ml < 1.0f ? ml : 1.0f;
+            if (this->mask != 0)
+            {
+                this->resize(this->capacity_for(this->number));
+            }
+        }
+
+        // at least n slots, never fewer than the current elements need
+        void rehash(size_type n)
+        {
+            size_type cap = this->capacity_for(this->number);
+            if (n > cap)
+            {
+                cap = group_type::width - 1;
+                while (cap < n)
+                {
+                    cap = cap * 2 + 1;
+                }
+            }
+            if (cap != this->mask || this->number + this->growth_left != this->growth(this->mask))
+            {
+                this->resize(cap);
+            }
+        }
+
+        void reserve(size_type n)
+        {
+            if (n > this->number + this->growth_left)
+            {
+                size_type cap = this->capacity_for(n);
+                this->resize(cap < this->mask ? this->mask : cap);
+            }
+        }
+
+    public:
+        void clear()
+        {
+            if (this->mask == 0)
+            {
+                return;
+            }
+            for (size_type i = 0; i < this->mask && this->number != 0; i++)
+            {
+                if (this->ctrl[i] >= 0)
+                {
+                    this->alloc.destroy(this->slots + i);
+                    this->number--;
+                }
+            }
+            std::memset(this->ctrl, _internal::_hash_empty, this->mask + group_type::width);
+            this->ctrl[this->mask] = _internal::_hash_sentinel;
+            this->growth_left = this->growth(this->mask);
+        }
+
+        ft::pair<iterator, bool> insert_unique(const value_type& value)
+        {
+            size_type h = this->hash_of(key_selector()(value));
+            size_type i = this->find_index(key_selector()(value), h);
+            if (i != this->mask)
+            {
+                return ft::make_pair(this->iterator_at(i), false);
+            }
+            return ft::make_pair(this->iterator_at(this->insert_new(h, value)), true);
+        }
+
+#if __cplusplus >= 201103L
+        ft::pair<iterator, bool> insert_unique(value_type&& value)
+        {
+            size_type h = this->hash_of(key_selector()(value));
+            size_type i = this->find_index(key_selector()(value), h);
+            if (i != this->mask)
+            {
+                return ft::make_pair(this->iterator_at(i), false);
+            }
+            return ft::make_pair(this->iterator_at(this->insert_new(h, ft::move(value))), true);
+        }
+
+        // The key is only known once the value is built, which then moves into its slot.
+        template <typename... Args>
+        ft::pair<iterator, bool> emplace_unique(Args&&... args)
+        {
+            value_type value(ft::forward<Args>(args)...);
+            return this->insert_unique(ft::move(value));
+        }
+
+        // try_emplace of a map: nothing is built (and the key is not moved from) when the key is present,
+        // otherwise the mapped value is constructed in its slot from the arguments.
+        template <typename UKey, typename... Args>
+        ft::pair<iterator, bool> try_emplace_unique(UKey&& key, Args&&... args)
+        {
+            size_type h = this->hash_of(key);
+            size_type i = this->find_index(key, h);
+            if (i != this->mask)
+            {
+                return ft::make_pair(this->iterator_at(i), false);
+            }
+            return ft::make_pair(this->iterator_at(this->insert_new(h, _internal::_piecewise_second_t(), ft::forward<UKey>(key), ft::forward<Args>(args)...)), true);
+        }
+
+        // operator[] of a map: the lookup and the insertion share one hash, the value is built only when missing
+        iterator find_or_insert(const key_type& key)
+        {
+            return this->try_emplace_unique(key).first;
+        }
+#else
+        // operator[] of a map: the lookup and the insertion share one hash, the value is built only when missing
+        iterator find_or_insert(const key_type& key)
+        {
+            size_type h = this->hash_of(key);
+            size_type i = this->find_index(key, h);
+            if (i == this->mask)
+            {
+                i = this->insert_new(h, value_type(key, typename value_type::second_type()));
+            }
+            return this->iterator_at(i);
+        }
+#endif
+
+        template <typename UIter>
+        void insert_range_unique(UIter first, UIter last)
+        {
+            for (; first != last; ++first)
+            {
+                this->insert_unique(*first);
+            }
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            size_type i = pos.ctrl - this->ctrl;
+            this->erase_index(i);
+            iterator it = this->iterator_at(i);
+            it.skip_free();
+            return it;
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            while (first != last)
+            {
+                first = this->erase(first);
+            }
+            return this->iterator_at(last.ctrl - this->ctrl);
+        }
+
+        size_type erase_unique(const key_type& key)
+        {
+            size_type i = this->find_index(key, this->hash_of(key));
+            if (i == this->mask)
+            {
+                return 0;
+            }
+            this->erase_index(i);
+            return 1;
+        }
+
+        // the element behind a const_iterator, for containers that keep mutable state in the slot
+        value_type& value_at(const_iterator pos) { return this->slots[pos.ctrl - this->ctrl]; }
+
+        void swap(_hash_table& that)
+        {
+            ft::swap(this->ctrl, that.ctrl);
+            ft::swap(this->slots, that.slots);
+            ft::swap(this->mask, that.mask);
+            ft::swap(this->number, that.number);
+            ft::swap(this->growth_left, that.growth_left);
+            ft::swap(this->max_load, that.max_load);
+            ft::swap(this->hash, that.hash);
+            ft::swap(this->equal, that.equal);
+            ft::swap(this->alloc, that.alloc);
+        }
+
+    public:
+        iterator find(const key_type& key) { return this->iterator_at(this->find_index(key, this->hash_of(key))); }
+        const_iterator find(const key_type& key) const { return this->iterator_at(this->find_index(key, this->hash_of(key))); }
+
+        size_type count(const key_type& key) const { return this->find_index(key, this->hash_of(key)) != this->mask; }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key)
+        {
+            iterator first = this->find(key);
+            iterator last = first;
+            return ft::make_pair(first, first == this->end() ? last : ++last);
+        }
+
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+        {
+            const_iterator first = this->find(key);
+            const_iterator last = first;
+            return ft::make_pair(first, first == this->end() ? last : ++last);
+        }
+
+    public:
+        friend bool operator==(const _hash_table& lhs, const _hash_table& rhs)
+        {
+            if (lhs.size() != rhs.size())
+            {
+                return false;
+            }
+            for (const_iterator it = lhs.begin(); it != lhs.end(); ++it)
+            {
+                const_iterator found = rhs.find(key_selector()(*it));
+                if (found == rhs.end() || !(*found == *it))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        friend bool operator!=(const _hash_table& lhs, const _hash_table& rhs)
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    template <typename T>
+    struct _hash_chain_node
+    {
+        T data;
+        _hash_chain_node* next;
+
+        explicit _hash_chain_node(const T& data)
+            : data(data), next() {}
+
+#if __cplusplus >= 201103L
+        template <typename... Args>
+        explicit _hash_chain_node(_internal::_in_place_t, Args&&... args)
+            : data(ft::forward<Args>(args)...), next() {}
+#endif
+
+        _hash_chain_node(const _hash_chain_node& that)
+            : data(that.data), next(that.next) {}
+
+        ~_hash_chain_node() {}
+
+    private:
+        _hash_chain_node& operator=(const _hash_chain_node&);
+    };
+
+    template <typename TKey, typename TNode, typename TKeySelector>
+    struct _hash_chain_select
+    {
+        const TKey& operator()(const TNode* node) const
+        {
+            return TKeySelector()(node->data);
+        }
+    };
+
+    template <typename T, typename TNode>
+    struct _hash_chain_iterator
+    {
+        typedef T value_type;
+        typedef value_type& reference;
+        typedef value_type* pointer;
+
+        typedef ft::forward_iterator_tag iterator_category;
+        typedef std::ptrdiff_t difference_type;
+
+        _hash_table_iterator<TNode* const> slot;
+        TNode* node;
+
+        _hash_chain_iterator() throw()
+            : slot(), node() {}
+
+        // node is the head of the chain in slot, or NULL at the end
+        explicit _hash_chain_iterator(const _hash_table_iterator<TNode* const>& slot) throw()
+            : slot(slot), node(slot.at_end() ? NULL : *slot) {}
+
+        _hash_chain_iterator(const _hash_table_iterator<TNode* const>& slot, TNode* node) throw()
+            : slot(slot), node(node) {}
+
+        template <typename U>
+        _hash_chain_iterator(const _hash_chain_iterator<U, TNode>& that, typename ft::enable_if<ft::is_same<const U, T>::value, void*>::type = NULL) throw()
+            : slot(that.slot), node(that.node) {}
+
+        reference operator*() const throw() { return this->node->data; }
+        pointer operator->() const throw() { return &this->node->data; }
+
+        _hash_chain_iterator& operator++() throw()
+        {
+            this->node = this->node->next;
+            if (this->node == NULL)
+            {
+                ++this->slot;
+                if (!this->slot.at_end())
+                {
+                    this->node = *this->slot;
+                }
+            }
+            return *this;
+        }
+
+        _hash_chain_iterator operator++(int) throw()
+        {
+            _hash_chain_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const _hash_chain_iterator& lhs, const _hash_chain_iterator& rhs) throw()
+        {
+            return lhs.node == rhs.node;
+        }
+
+        friend bool operator!=(const _hash_chain_iterator& lhs, const _hash_chain_iterator& rhs) throw()
+        {
+            return lhs.node != rhs.node;
+        }
+    };
+
+    // Multi variant: a slot holds the chain of all the elements sharing one key,
+    // so equal elements stay adjacent in iteration order and probing only sees distinct keys.
+    template <typename TKey, typename T, typename TKeySelector, typename THash = ft::hash<TKey>, typename TEqual = ft::equal_to<TKey>, typename TAlloc = std::allocator<T> >
+    class _hash_multi_table
+    {
+    public:
+        typedef TKey key_type;
+        typedef T value_type;
+        typedef TKeySelector key_selector;
+        typedef THash hasher;
+        typedef TEqual key_equal;
+        typedef _hash_chain_node<T> node_type;
+        typedef typename TAlloc::template rebind<node_type>::other allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        typedef _hash_chain_iterator<value_type, node_type> iterator;
+        typedef _hash_chain_iterator<const value_type, node_type> const_iterator;
+
+    private:
+        typedef _hash_chain_select<key_type, node_type, key_selector> chain_selector;
+        typedef _hash_table<key_type, node_type*, chain_selector, hasher, key_equal, TAlloc> table_type;
+
+        table_type table;
+        allocator_type alloc;
+        size_type number;
+
+    public:
+        _hash_multi_table(size_type n = 0, const THash& hash = THash(), const TEqual& equal = TEqual(), const TAlloc& alloc = TAlloc())
+            : table(n, hash, equal, alloc), alloc(alloc), number() {}
+
+        _hash_multi_table(const _hash_multi_table& that)
+            : table(0, that.table.hash_function(), that.table.key_eq(), that.table.get_allocator()), alloc(that.alloc), number()
+        {
+            this->table.max_load_factor(that.table.max_load_factor());
+            this->table.reserve(that.table.size());
+            try
+            {
+                for (typename table_type::const_iterator it = that.table.begin(); it != that.table.end(); ++it)
+                {
+                    this->insert_chain(*it);
+                }
+            }
+            catch (...)
+            {
+                this->destruct();
+                throw;
+            }
+        }
+
+#if __cplusplus >= 201103L
+        _hash_multi_table(_hash_multi_table&& that) noexcept(noexcept(table_type(ft::declval<table_type>())) && _internal::_is_nothrow_copy_constructible<allocator_type>::value)
+            : table(ft::move(that.table)), alloc(that.alloc), number(that.number)
+        {
+            that.number = 0;
+        }
+#endif
+
+        ~_hash_multi_table()
+        {
+            this->destruct();
+        }
+
+        _hash_multi_table& operator=(const _hash_multi_table& that)
+        {
+            if (this != &that)
+            {
+                _hash_multi_table temp = that;
+                this->swap(temp);
+            }
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        _hash_multi_table& operator=(_hash_multi_table&& that)
+        {
+            if (this != &that)
+            {
+                _hash_multi_table temp(ft::move(that));
+                this->swap(temp);
+            }
+            return *this;
+        }
+#endif
+
+    public:
+        allocator_type get_allocator() const { return this->alloc; }
+        hasher hash_function() const { return this->table.hash_function(); }
+        key_equal key_eq() const { return this->table.key_eq(); }
+
+    private:
+#if __cplusplus >= 201103L
+        template <typename... Args>
+        node_type* create_node(Args&&... args)
+        {
+            node_type* node = this->alloc.allocate(1);
+            try
+            {
+                _internal::_construct_node(this->alloc, node, _internal::_in_place_t(), ft::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                this->alloc.deallocate(node, 1);
+                throw;
+            }
+            return node;
+        }
+#else
+        node_type* create_node(const value_type& data)
+        {
+            node_type* node = this->alloc.allocate(1);
+            try
+            {
+                _internal::_construct_node(this->alloc, node, data);
+            }
+            catch (...)
+            {
+                this->alloc.deallocate(node, 1);
+                throw;
+            }
+            return node;
+        }
+#endif
+
+        void destroy_node(node_type* node)
+        {
+            _internal::_destroy_node(this->alloc, node);
+            this->alloc.deallocate(node, 1);
+        }
+
+        size_type destroy_chain(node_type* node)
+        {
+            size_type n = 0;
+            while (node != NULL)
+            {
+                node_type* next = node->next;
+                this->destroy_node(node);
+                node = next;
+                n++;
+            }
+            return n;
+        }
+
+        // copy of a chain from another table, in the same order
+        void insert_chain(const node_type* src)
+        {
+            node_type* head = this->create_node(src->data);
+            node_type* tail = head;
+            try
+            {
+                for (src = src->next; src != NULL; src = src->next)
+                {
+                    tail->next = this->create_node(src->data);
+                    tail = tail->next;
+                }
+                this->table.insert_unique(head);
+            }
+            catch (...)
+            {
+                this->destroy_chain(head);
+                throw;
+            }
+            for (tail = head; tail != NULL; tail = tail->next)
+            {
+                this->number++;
+            }
+        }
+
+        void destruct()
+        {
+            for (typename table_type::iterator it = this->table.begin(); it != this->table.end(); ++it)
+            {
+                this->destroy_chain(*it);
+            }
+            this->table.clear();
+            this->number = 0;
+        }
+
+        // takes ownership of node, which is destroyed if it cannot be linked
+        iterator link_node(node_type* node)
+        {
+            typename table_type::const_iterator slot;
+            try
+            {
+                slot = this->table.find(key_selector()(node->data));
+                if (slot == this->table.end())
+                {
+                    slot = this->table.insert_unique(node).first;
+                    this->number++;
+                    return iterator(slot, node);
+                }
+            }
+            catch (...)
+            {
+                this->destroy_node(node);
+                throw;
+            }
+            // the new element becomes the head of its chain
+            node->next = *slot;
+            this->table.value_at(slot) = node;
+            this->number++;
+            return iterator(slot, node);
+        }
+
+        static size_type chain_length(const node_type* node)
+        {
+            size_type n = 0;
+            for (; node != NULL; node = node->next)
+            {
+                n++;
+            }
+            return n;
+        }
+
+        static size_type chain_count(const node_type* node, const value_type& value)
+        {
+            size_type n = 0;
+            for (; node != NULL; node = node->next)
+            {
+                if (node->data == value)
+                {
+                    n++;
+                }
+            }
+            return n;
+        }
+
+    public:
+        iterator begin() { return iterator(this->table.begin()); }
+        const_iterator begin() const { return const_iterator(this->table.begin()); }
+        iterator end() { return iterator(this->table.end()); }
+        const_iterator end() const { return const_iterator(this->table.end()); }
+
+        bool empty() const { return this->number == 0; }
+        size_type size() const { return this->number; }
+        size_type max_size() const { return this->alloc.max_size(); }
+
+    public:
+        size_type bucket_count() const { return this->table.bucket_count(); }
+        float load_factor() const { return this->table.load_factor(); }
+        float max_load_factor() const { return this->table.max_load_factor(); }
+        void max_load_factor(float ml) { this->table.max_load_factor(ml); }
+        void rehash(size_type n) { this->table.rehash(n); }
+
+        // slots are taken per distinct key, so n elements never need more than n slots
+        void reserve(size_type n) { this->table.reserve(n); }
+
+    public:
+        void clear() { this->destruct(); }
+
+        iterator insert_equal(const value_type& value)
+        {
+            return this->link_node(this->create_node(value));
+        }
+
+#if __cplusplus >= 201103L
+        iterator insert_equal(value_type&& value)
+        {
+            return this->link_node(this->create_node(ft::move(value)));
+        }
+
+        template <typename... Args>
+        iterator emplace_equal(Args&&... args)
+        {
+            return this->link_node(this->create_node(ft::forward<Args>(args)...));
+        }
+#endif
+
+        template <typename UIter>
+        void insert_range_equal(UIter first, UIter last)
+        {
+            for (; first != last; ++first)
+            {
+                this->insert_equal(*first);
+            }
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            node_type*& head = this->table.value_at(pos.slot);
+            node_type* next = pos.node->next;
+            if (head == pos.node)
+            {
+                if (next == NULL)
+                {
+                    this->destroy_node(pos.node);
+                    this->number--;
+                    return iterator(this->table.erase(pos.slot));
+                }
+                head = next;
+            }
+            else
+            {
+                node_type* prev = head;
+                while (prev->next != pos.node)
+                {
+                    prev = prev->next;
+                }
+                prev->next = next;
+            }
+            this->destroy_node(pos.node);
+            this->number--;
+            if (next == NULL)
+            {
+                typename table_type::const_iterator slot = pos.slot;
+                return iterator(++slot);
+            }
+            return iterator(pos.slot, next);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            while (first != last)
+            {
+                first = this->erase(first);
+            }
+            return iterator(last.slot, last.node);
+        }
+
+        size_type erase_equal(const key_type& key)
+        {
+            typename table_type::const_iterator slot = this->table.find(key);
+            if (slot == this->table.end())
+            {
+                return 0;
+            }
+            size_type n = this->destroy_chain(*slot);
+            this->table.erase(slot);
+            this->number -= n;
+            return n;
+        }
+
+        void swap(_hash_multi_table& that)
+        {
+            this->table.swap(that.table);
+            ft::swap(this->alloc, that.alloc);
+            ft::swap(this->number, that.number);
+        }
+
+    public:
+        iterator find(const key_type& key) { return iterator(typename table_type::const_iterator(this->table.find(key))); }
+        const_iterator find(const key_type& key) const { return const_iterator(this->table.find(key)); }
+
+        size_type count(const key_type& key) const
+        {
+            typename table_type::const_iterator slot = this->table.find(key);
+            return slot == this->table.end() ? 0 : chain_length(*slot);
+        }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key)
+        {
+            typename table_type::const_iterator slot = this->table.find(key);
+            if (slot == this->table.end())
+            {
+                return ft::make_pair(this->end(), this->end());
+            }
+            typename table_type::const_iterator next = slot;
+            return ft::make_pair(iterator(slot), iterator(++next));
+        }
+
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+        {
+            typename table_type::const_iterator slot = this->table.find(key);
+            if (slot == this->table.end())
+            {
+                return ft::make_pair(this->end(), this->end());
+            }
+            typename table_type::const_iterator next = slot;
+            return ft::make_pair(const_iterator(slot), const_iterator(++next));
+        }
+
+    public:
+        friend bool operator==(const _hash_multi_table& lhs, const _hash_multi_table& rhs)
+        {
+            if (lhs.size() != rhs.size() || lhs.table.size() != rhs.table.size())
+            {
+                return false;
+            }
+            for (typename table_type::const_iterator it = lhs.table.begin(); it != lhs.table.end(); ++it)
+            {
+                typename table_type::const_iterator found = rhs.table.find(key_selector()((*it)->data));
+                if (found == rhs.table.end() || chain_length(*it) != chain_length(*found))
+                {
+                    return false;
+                }
+                // same multiset of values
+                for (const node_type* node = *it; node != NULL; node = node->next)
+                {
+                    if (chain_count(*it, node->data) != chain_count(*found, node->data))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        friend bool operator!=(const _hash_multi_table& lhs, const _hash_multi_table& rhs)
+        {
+            return !(lhs == rhs);
+        }
+    };
+}
@@ -0,0 +1,136 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "_tree.hpp"
+#include "utility.hpp"
+
+#if __cplusplus >= 201103L
+namespace ft
+{
+    // Owns a node taken out of a tree, it goes back in (here or in another container
+    // with an equal allocator) without copying the value or touching the allocator.
+    template <typename T, typename TNodeAlloc>
+    class _node_handle_base
+    {
+    public:
+        typedef T value_type;
+        typedef typename TNodeAlloc::template rebind<T>::other allocator_type;
+
+    protected:
+        typedef _tree_node<T> node_type;
+
+        node_type* node;
+        TNodeAlloc alloc;
+
+    public:
+        _node_handle_base() noexcept
+            : node(), alloc() {}
+
+        // for the containers
+        _node_handle_base(node_type* node, const TNodeAlloc& alloc)
+            : node(node), alloc(alloc) {}
+
+        _node_handle_base(_node_handle_base&& that) noexcept
+            : node(that.node), alloc(ft::move(that.alloc))
+        {
+            that.node = NULL;
+        }
+
+        ~_node_handle_base()
+        {
+            this->reset();
+        }
+
+        _node_handle_base& operator=(_node_handle_base&& that) noexcept
+        {
+            if (this != &that)
+            {
+                this->reset();
+                this->node = that.node;
+                this->alloc = ft::move(that.alloc);
+                that.node = NULL;
+            }
+            return *this;
+        }
+
+    private:
+        _node_handle_base(const _node_handle_base&);
+        _node_handle_base& operator=(const _node_handle_base&);
+
+        void reset()
+        {
+            if (this->node != NULL)
+            {
+                this->alloc.destroy(this->node);
+                this->alloc.deallocate(this->node, 1);
+                this->node = NULL;
+            }
+        }
+
+    public:
+        bool empty() const noexcept { return this->node == NULL; }
+        explicit operator bool() const noexcept { return this->node != NULL; }
+        allocator_type get_allocator() const { return allocator_type(this->alloc); }
+
+        // for the containers, gives up the node
+        node_type* get() const noexcept { return this->node; }
+        node_type* release() noexcept
+        {
+            node_type* result = this->node;
+            this->node = NULL;
+            return result;
+        }
+
+        void swap(_node_handle_base& that) noexcept
+        {
+            ft::swap(this->node, that.node);
+            ft::swap(this->alloc, that.alloc);
+        }
+    };
+
+    template <typename T, typename TNodeAlloc>
+    class _set_node_handle : public _node_handle_base<T, TNodeAlloc>
+    {
+    public:
+        using _node_handle_base<T, TNodeAlloc>::_node_handle_base;
+
+        T& value() const { return this->node->data; }
+    };
+
+    template <typename TKey, typename TMapped, typename TNodeAlloc>
+    class _map_node_handle : public _node_handle_base<ft::pair<const TKey, TMapped>, TNodeAlloc>
+    {
+    public:
+        typedef TKey key_type;
+        typedef TMapped mapped_type;
+
+        using _node_handle_base<ft::pair<const TKey, TMapped>, TNodeAlloc>::_node_handle_base;
+
+        // the node is in no tree, so its key may change
+        key_type& key() const { return const_cast<key_type&>(this->node->data.first); }
+        mapped_type& mapped() const { return this->node->data.second; }
+    };
+
+    template <typename TIter, typename TNodeHandle>
+    struct _insert_return_type
+    {
+        TIter position;
+        bool inserted;
+        TNodeHandle node;
+    };
+
+    template <typename T, typename TNodeAlloc>
+    inline void swap(_set_node_handle<T, TNodeAlloc>& lhs, _set_node_handle<T, TNodeAlloc>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    template <typename TKey, typename TMapped, typename TNodeAlloc>
+    inline void swap(_map_node_handle<TKey, TMapped, TNodeAlloc>& lhs, _map_node_handle<TKey, TMapped, TNodeAlloc>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+}
+#endif
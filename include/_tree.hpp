@@ -7,446 +7,796 @@
 #include "functional.hpp"
 #include "iterator.hpp"
 #include "utility.hpp"
+#include "memory/_allocator_hooks.hpp"
+#include "utility/_in_place.hpp"
 
 #include <cstddef>
 #include <limits>
 #include <memory>
+#include <new>
 
 #ifdef FT_TREE_ASSERT
 #include <cassert>
 #endif
 
+// FT_TREE_ORDER_STATISTICS and FT_TREE_COMPACT_NODE change the node layout, the nodes, the tree
+// and the containers on it are declared in a namespace named after both settings. Translation
+// units built with different settings then use distinct types, which fail to link together
+// instead of sharing inline functions compiled for the other layout.
+// NOTE: ft::map, ft::multimap, ft::set and ft::multiset are therefore not declared in ft itself,
+// a forward declaration `namespace ft { template <...> class map; }` names another class and
+// breaks map.hpp. Include _tree.hpp and declare them inside the layout namespace instead:
+//     namespace ft { namespace FT_TREE_LAYOUT { template <typename K, typename M, typename C, typename A> class map; } }
+#if defined(FT_TREE_ORDER_STATISTICS) && defined(FT_TREE_COMPACT_NODE)
+#define FT_TREE_LAYOUT _tree_layout_counted_compact
+#elif defined(FT_TREE_ORDER_STATISTICS)
+#define FT_TREE_LAYOUT _tree_layout_counted
+#elif defined(FT_TREE_COMPACT_NODE)
+#define FT_TREE_LAYOUT _tree_layout_compact
+#else
+#define FT_TREE_LAYOUT _tree_layout
+#endif
+
 namespace ft
 {
+#if __cplusplus >= 201103L
+    inline namespace FT_TREE_LAYOUT
+    {
+    }
+#else
+    namespace FT_TREE_LAYOUT
+    {
+    }
+    using namespace FT_TREE_LAYOUT;
+#endif
+
     enum _tree_node_color
     {
         black,
         red
     };
 
-    struct _tree_node_base
+    namespace FT_TREE_LAYOUT
     {
-        typedef _tree_node_base* pointer_type;
-
-        pointer_type left, right, parent;
-        _tree_node_color color;
-
-        explicit _tree_node_base(_tree_node_color color = black)
-            : left(), right(), parent(),
-              color(color) {}
+#ifdef FT_TREE_COMPACT_NODE
+        struct _tree_node_base;
 
-        _tree_node_base(const _tree_node_base& that)
-            : left(that.left), right(that.right), parent(that.parent),
-              color(that.color) {}
+        // Parent pointer carrying the node color in its low bit, node alignment keeps that bit clear.
+        // Assigning a pointer leaves the color alone, copying the whole link takes both.
+        class _tree_parent_link
+        {
+        private:
+            std::size_t bits;
 
-        ~_tree_node_base() {}
+            static std::size_t to_bits(_tree_node_base* ptr) { return reinterpret_cast<std::size_t>(ptr); }
 
-        _tree_node_base& operator=(const _tree_node_base& that)
-        {
-            this->left = that.left;
-            this->right = that.right;
-            this->parent = that.parent;
-            this->color = that.color;
-            return *this;
-        }
-    };
+        public:
+            _tree_parent_link() : bits() {}
+            _tree_parent_link(const _tree_parent_link& that) : bits(that.bits) {}
 
-    template <typename T>
-    struct _tree_node : _tree_node_base
-    {
-        T data;
+            _tree_parent_link& operator=(const _tree_parent_link& that)
+            {
+                return *this = static_cast<_tree_node_base*>(that);
+            }
 
-        explicit _tree_node(const T& data)
-            : _tree_node_base(red), data(data) {}
+            _tree_parent_link& operator=(_tree_node_base* ptr)
+            {
+                this->bits = to_bits(ptr) | (this->bits & 1);
+                return *this;
+            }
 
-        _tree_node(const _tree_node& that)
-            : _tree_node_base(that), data(that.data) {}
+            operator _tree_node_base*() const { return reinterpret_cast<_tree_node_base*>(this->bits & ~std::size_t(1)); }
+            _tree_node_base* operator->() const { return *this; }
 
-        ~_tree_node() {}
+            _tree_node_color color() const { return _tree_node_color(this->bits & 1); }
+            void color(_tree_node_color c) { this->bits = (this->bits & ~std::size_t(1)) | std::size_t(c); }
 
-        _tree_node& operator=(const _tree_node& that)
-        {
-            this->_tree_node_base::operator=(that);
-            this->data = that.data;
-            return *this;
-        }
-    };
+            void assign(const _tree_parent_link& that) { this->bits = that.bits; }
+        };
+#endif
 
-    // 참조: 2-3-4 이진 탐색 트리, Red-Black 트리
-    struct _tree_algorithm
-    {
-        typedef _tree_node_base::pointer_type node_pointer;
+        // With FT_TREE_ORDER_STATISTICS every node also counts the nodes of its subtree,
+        // which turns count, rank, nth_element and distance into O(log n) walks.
+        // With FT_TREE_COMPACT_NODE the color lives in the low bit of the parent pointer,
+        // a node then carries three words of links and nothing else.
+        // NOTE: both change the node layout, see FT_TREE_LAYOUT
+        struct _tree_node_base
+        {
+            typedef _tree_node_base* pointer_type;
+
+#ifdef FT_TREE_COMPACT_NODE
+            pointer_type left, right;
+            _tree_parent_link parent;
+#else
+            pointer_type left, right, parent;
+            _tree_node_color color;
+#endif
+#ifdef FT_TREE_ORDER_STATISTICS
+            std::size_t size;
+#endif
 
-        // BEGIN Binary Search Tree
-        static node_pointer successor(node_pointer node)
-        {
-            node_pointer succ = node->right;
-            if (succ != NULL)
+            explicit _tree_node_base(_tree_node_color color = black)
+#ifdef FT_TREE_COMPACT_NODE
+                : left(), right(), parent()
+#else
+                : left(), right(), parent(),
+                  color(color)
+#endif
+#ifdef FT_TREE_ORDER_STATISTICS
+                  ,
+                  size(1)
+#endif
             {
-                succ = minimum(succ);
+#ifdef FT_TREE_COMPACT_NODE
+                this->parent.color(color);
+#endif
             }
-            else
+
+            _tree_node_base(const _tree_node_base& that)
+#ifdef FT_TREE_COMPACT_NODE
+                : left(that.left), right(that.right), parent(that.parent)
+#else
+                : left(that.left), right(that.right), parent(that.parent),
+                  color(that.color)
+#endif
+#ifdef FT_TREE_ORDER_STATISTICS
+                  ,
+                  size(that.size)
+#endif
             {
-                for (succ = node->parent; node == succ->right; succ = succ->parent)
-                {
-                    node = succ;
-                }
-                if (node->right == succ)
-                {
-                    // node is header and tree of size 1
-                    succ = node;
-                }
             }
-            return succ;
-        }
 
-        static node_pointer predecessor(node_pointer node)
-        {
-            if (is_header(node))
+            ~_tree_node_base() {}
+
+            _tree_node_base& operator=(const _tree_node_base& that)
             {
-                // maximum of tree
-                return node->right;
+                this->left = that.left;
+                this->right = that.right;
+#ifdef FT_TREE_COMPACT_NODE
+                this->parent.assign(that.parent);
+#else
+                this->parent = that.parent;
+                this->color = that.color;
+#endif
+#ifdef FT_TREE_ORDER_STATISTICS
+                this->size = that.size;
+#endif
+                return *this;
             }
 
-            node_pointer pred = node->left;
-            if (pred != NULL)
+#ifdef FT_TREE_COMPACT_NODE
+            _tree_node_color get_color() const { return this->parent.color(); }
+            void set_color(_tree_node_color c) { this->parent.color(c); }
+#else
+            _tree_node_color get_color() const { return this->color; }
+            void set_color(_tree_node_color c) { this->color = c; }
+#endif
+        };
+
+        template <typename T>
+        struct _tree_node : _tree_node_base
+        {
+            T data;
+
+            explicit _tree_node(const T& data)
+                : _tree_node_base(red), data(data) {}
+
+#if __cplusplus >= 201103L
+            template <typename... Args>
+            explicit _tree_node(_internal::_in_place_t, Args&&... args)
+                : _tree_node_base(red), data(ft::forward<Args>(args)...) {}
+#endif
+
+            _tree_node(const _tree_node& that)
+                : _tree_node_base(that), data(that.data) {}
+
+            ~_tree_node() {}
+
+            _tree_node& operator=(const _tree_node& that)
             {
-                pred = maximum(pred);
+                this->_tree_node_base::operator=(that);
+                this->data = that.data;
+                return *this;
             }
-            else
+        };
+
+        // 참조: 2-3-4 이진 탐색 트리, Red-Black 트리
+        struct _tree_algorithm
+        {
+            typedef _tree_node_base::pointer_type node_pointer;
+
+            // BEGIN Binary Search Tree
+            static node_pointer successor(node_pointer node)
             {
-                for (pred = node->parent; node == pred->left; pred = pred->parent)
+                node_pointer succ = node->right;
+                if (succ != NULL)
+                {
+                    succ = minimum(succ);
+                }
+                else
                 {
-                    node = pred;
+                    for (succ = node->parent; node == succ->right; succ = succ->parent)
+                    {
+                        node = succ;
+                    }
+                    if (node->right == succ)
+                    {
+                        // node is header and tree of size 1
+                        succ = node;
+                    }
                 }
+                return succ;
             }
-            return pred;
-        }
 
-        static node_pointer minimum(node_pointer node)
-        {
-            while (node->left != NULL)
+            static node_pointer predecessor(node_pointer node)
             {
-                node = node->left;
+                if (is_header(node))
+                {
+                    // maximum of tree
+                    return node->right;
+                }
+
+                node_pointer pred = node->left;
+                if (pred != NULL)
+                {
+                    pred = maximum(pred);
+                }
+                else
+                {
+                    for (pred = node->parent; node == pred->left; pred = pred->parent)
+                    {
+                        node = pred;
+                    }
+                }
+                return pred;
             }
-            return node;
-        }
 
-        static node_pointer maximum(node_pointer node)
-        {
-            while (node->right != NULL)
+            static node_pointer minimum(node_pointer node)
             {
-                node = node->right;
+                while (node->left != NULL)
+                {
+                    node = node->left;
+                }
+                return node;
             }
-            return node;
-        }
 
-        static bool is_header(node_pointer node)
-        {
-            if (node->parent == NULL)
+            static node_pointer maximum(node_pointer node)
             {
-                // header of empty tree
-                return true;
+                while (node->right != NULL)
+                {
+                    node = node->right;
+                }
+                return node;
             }
 
-            node_pointer left = node->left;
-            node_pointer right = node->right;
-            if (left && right)
+            static bool is_header(node_pointer node)
             {
-                // header always has following children.
-                // left: minimum, right: maximum
-                if (left == right)
+                if (node->parent == NULL)
                 {
-                    // header for tree of size 1
+                    // header of empty tree
                     return true;
                 }
-                if (!(left->parent == node && right->parent == node))
+
+                node_pointer left = node->left;
+                node_pointer right = node->right;
+                if (left && right)
                 {
-                    // children of common nodes have the same parents.
-                    // but minimum and maximum cannot have same parent.
-                    return true;
+                    // header always has following children.
+                    // left: minimum, right: maximum
+                    if (left == right)
+                    {
+                        // header for tree of size 1
+                        return true;
+                    }
+                    if (!(left->parent == node && right->parent == node))
+                    {
+                        // children of common nodes have the same parents.
+                        // but minimum and maximum cannot have same parent.
+                        return true;
+                    }
                 }
-            }
 
-            return false;
-        }
-
-        static node_pointer get_header(node_pointer node)
-        {
-            if (node->parent == NULL)
-            {
-                // header of empty node
-                return node;
+                return false;
             }
 
-            if (node->parent->parent == node)
+            static node_pointer get_header(node_pointer node)
             {
-                // header or root node
-                if (is_header(node))
+                if (node->parent == NULL)
                 {
+                    // header of empty node
                     return node;
                 }
-                else
+
+                if (node->parent->parent == node)
                 {
-                    return node->parent;
+                    // header or root node
+                    if (is_header(node))
+                    {
+                        return node;
+                    }
+                    else
+                    {
+                        return node->parent;
+                    }
                 }
-            }
 
-            node_pointer head;
-            for (head = node->parent; node == head->parent; head = head->parent)
-            {
-                node = head;
+                // climb to the root, the only node whose parent (the header) points back at it
+                while (node->parent->parent != node)
+                {
+                    node = node->parent;
+                }
+                return node->parent;
             }
-            return head;
-        }
 
-        static void set_child(node_pointer parent_node, bool left, node_pointer child_node, node_pointer header)
-        {
-            if (parent_node == header)
-            {
-                header->parent = child_node;
-            }
-            else if (left)
+            static void set_child(node_pointer parent_node, bool left, node_pointer child_node, node_pointer header)
             {
-                parent_node->left = child_node;
+                if (parent_node == header)
+                {
+                    header->parent = child_node;
+                }
+                else if (left)
+                {
+                    parent_node->left = child_node;
+                }
+                else // if (!left)
+                {
+                    parent_node->right = child_node;
+                }
             }
-            else // if (!left)
+
+            static void rotate_left_raw(node_pointer node, node_pointer node_right)
             {
-                parent_node->right = child_node;
-            }
-        }
+                node_pointer node_right_left = node_right->left;
 
-        static void rotate_left_raw(node_pointer node, node_pointer node_right)
-        {
-            node_pointer node_right_left = node_right->left;
+                node->right = node_right_left;
+                if (node_right_left != NULL)
+                {
+                    node_right_left->parent = node;
+                }
+
+                node_right->left = node;
+                node->parent = node_right;
+
+#ifdef FT_TREE_ORDER_STATISTICS
+                node_right->size = node->size;
+                update_size(node);
+#endif
+            }
 
-            node->right = node_right_left;
-            if (node_right_left != NULL)
+            static void rotate_left(node_pointer node, node_pointer node_right, node_pointer node_parent, node_pointer header)
             {
-                node_right_left->parent = node;
+                bool left = node == node_parent->left;
+                rotate_left_raw(node, node_right);
+
+                node_right->parent = node_parent;
+                set_child(node_parent, left, node_right, header);
             }
 
-            node_right->left = node;
-            node->parent = node_right;
-        }
+            static void rotate_right_raw(node_pointer node, node_pointer node_left)
+            {
+                node_pointer node_left_right = node_left->right;
 
-        static void rotate_left(node_pointer node, node_pointer node_right, node_pointer node_parent, node_pointer header)
-        {
-            bool left = node == node_parent->left;
-            rotate_left_raw(node, node_right);
+                node->left = node_left_right;
+                if (node_left_right != NULL)
+                {
+                    node_left_right->parent = node;
+                }
 
-            node_right->parent = node_parent;
-            set_child(node_parent, left, node_right, header);
-        }
+                node_left->right = node;
+                node->parent = node_left;
 
-        static void rotate_right_raw(node_pointer node, node_pointer node_left)
-        {
-            node_pointer node_left_right = node_left->right;
+#ifdef FT_TREE_ORDER_STATISTICS
+                node_left->size = node->size;
+                update_size(node);
+#endif
+            }
 
-            node->left = node_left_right;
-            if (node_left_right != NULL)
+            static void rotate_right(node_pointer node, node_pointer node_left, node_pointer node_parent, node_pointer header)
             {
-                node_left_right->parent = node;
-            }
+                bool left = node == node_parent->left;
+                rotate_right_raw(node, node_left);
 
-            node_left->right = node;
-            node->parent = node_left;
-        }
+                node_left->parent = node_parent;
+                set_child(node_parent, left, node_left, header);
+            }
+            // END Binary Search Tree
 
-        static void rotate_right(node_pointer node, node_pointer node_left, node_pointer node_parent, node_pointer header)
-        {
-            bool left = node == node_parent->left;
-            rotate_right_raw(node, node_left);
+#ifdef FT_TREE_ORDER_STATISTICS
+            // BEGIN Order Statistics
+            static std::size_t subtree_size(node_pointer node)
+            {
+                return node == NULL ? 0 : node->size;
+            }
 
-            node_left->parent = node_parent;
-            set_child(node_parent, left, node_left, header);
-        }
-        // END Binary Search Tree
+            static void update_size(node_pointer node)
+            {
+                node->size = 1 + subtree_size(node->left) + subtree_size(node->right);
+            }
 
-        static void repair_after_insert(node_pointer header, node_pointer node)
-        {
-            node->color = red;
-            for (;;)
+            // adds delta to node and every ancestor below the header
+            static void adjust_size(node_pointer header, node_pointer node, std::ptrdiff_t delta)
             {
-                node_pointer parent = node->parent;
-                if (parent == header || parent->color == black)
+                for (; node != header; node = node->parent)
                 {
-                    break;
+                    node->size += delta;
                 }
+            }
 
-                node_pointer grandparent = parent->parent;
-                if (grandparent == header)
+            // k-th node in order (0-based), NULL past the end
+            static node_pointer select(node_pointer root, std::size_t k)
+            {
+                while (root != NULL)
                 {
-                    break;
+                    std::size_t left_size = subtree_size(root->left);
+                    if (k < left_size)
+                    {
+                        root = root->left;
+                    }
+                    else if (k == left_size)
+                    {
+                        return root;
+                    }
+                    else
+                    {
+                        k -= left_size + 1;
+                        root = root->right;
+                    }
                 }
+                return NULL;
+            }
 
-                node_pointer uncle;
-                if (parent == grandparent->left)
+            // number of nodes before node in order, the size of the tree for the header
+            static std::size_t rank(node_pointer header, node_pointer node)
+            {
+                if (node == header)
                 {
-                    uncle = grandparent->right;
+                    return subtree_size(header->parent);
                 }
-                else
+                std::size_t result = subtree_size(node->left);
+                for (; node->parent != header; node = node->parent)
                 {
-                    uncle = grandparent->left;
+                    if (node == node->parent->right)
+                    {
+                        result += subtree_size(node->parent->left) + 1;
+                    }
                 }
+                return result;
+            }
 
-                grandparent->color = red;
-                if (uncle != NULL && uncle->color == red)
+            // node n steps away in order (either direction), the header one past the maximum
+            static node_pointer advance(node_pointer node, std::ptrdiff_t n)
+            {
+                node_pointer header = get_header(node);
+                std::size_t k = rank(header, node) + n;
+                if (k >= subtree_size(header->parent))
                 {
-                    uncle->color = black;
-                    parent->color = black;
-                    node = grandparent;
+                    return header;
                 }
-                else // if (uncle->color == black) aka final step
+                return select(header->parent, k);
+            }
+
+            static std::ptrdiff_t distance(node_pointer first, node_pointer last)
+            {
+                node_pointer header = get_header(first);
+                return static_cast<std::ptrdiff_t>(rank(header, last)) - static_cast<std::ptrdiff_t>(rank(header, first));
+            }
+            // END Order Statistics
+#endif
+
+            static void repair_after_insert(node_pointer header, node_pointer node)
+            {
+                node->set_color(red);
+                for (;;)
                 {
+                    node_pointer parent = node->parent;
+                    if (parent == header || parent->get_color() == black)
+                    {
+                        break;
+                    }
+
+                    node_pointer grandparent = parent->parent;
+                    if (grandparent == header)
+                    {
+                        break;
+                    }
+
+                    node_pointer uncle;
                     if (parent == grandparent->left)
                     {
-                        if (node == parent->right)
-                        {
-                            rotate_left_raw(parent, node);
-                            parent = node;
-                        }
-                        rotate_right(grandparent, parent, grandparent->parent, header);
+                        uncle = grandparent->right;
                     }
                     else
                     {
-                        if (node == parent->left)
+                        uncle = grandparent->left;
+                    }
+
+                    grandparent->set_color(red);
+                    if (uncle != NULL && uncle->get_color() == red)
+                    {
+                        uncle->set_color(black);
+                        parent->set_color(black);
+                        node = grandparent;
+                    }
+                    else // if (uncle->color == black) aka final step
+                    {
+                        if (parent == grandparent->left)
+                        {
+                            if (node == parent->right)
+                            {
+                                rotate_left_raw(parent, node);
+                                parent = node;
+                            }
+                            rotate_right(grandparent, parent, grandparent->parent, header);
+                        }
+                        else
                         {
-                            rotate_right_raw(parent, node);
-                            parent = node;
+                            if (node == parent->left)
+                            {
+                                rotate_right_raw(parent, node);
+                                parent = node;
+                            }
+                            rotate_left(grandparent, parent, grandparent->parent, header);
                         }
-                        rotate_left(grandparent, parent, grandparent->parent, header);
+                        parent->set_color(black);
+                        break;
                     }
-                    parent->color = black;
-                    break;
                 }
-            }
-            header->parent->color = black;
-        }
-
-        static void repair_after_erase(node_pointer header, node_pointer z, node_pointer y, node_pointer x, node_pointer x_parent)
-        {
-            _tree_node_color z_color;
-            if (y == z)
-            {
-                z_color = z->color;
-            }
-            else
-            {
-                z_color = y->color;
-                y->color = z->color;
-            }
-
-            if (z_color == red)
-            {
-                return;
+                header->parent->set_color(black);
             }
 
-            for (;;)
+            static void repair_after_erase(node_pointer header, node_pointer z, node_pointer y, node_pointer x, node_pointer x_parent)
             {
-                if (x_parent == header)
+                _tree_node_color z_color;
+                if (y == z)
                 {
-                    break;
+                    z_color = z->get_color();
+                }
+                else
+                {
+                    z_color = y->get_color();
+                    y->set_color(z->get_color());
                 }
 
-                if (x != NULL && x->color != black)
+                if (z_color == red)
                 {
-                    break;
+                    return;
                 }
 
-                node_pointer sibling;
-                if (x == x_parent->left)
+                for (;;)
                 {
-                    sibling = x_parent->right;
-                    if (sibling->color == red)
+                    if (x_parent == header)
                     {
-                        sibling->color = black;
-                        x_parent->color = red;
-                        rotate_left(x_parent, sibling, x_parent->parent, header);
-                        sibling = x_parent->right;
-                        // assert(sibling != NULL);
+                        break;
                     }
 
-                    node_pointer s_left = sibling->left;
-                    node_pointer s_right = sibling->right;
-                    if ((s_left == NULL || s_left->color == black) && (s_right == NULL || s_right->color == black))
+                    if (x != NULL && x->get_color() != black)
                     {
-                        sibling->color = red;
-                        x = x_parent;
-                        x_parent = x_parent->parent;
+                        break;
                     }
-                    else
+
+                    node_pointer sibling;
+                    if (x == x_parent->left)
                     {
-                        if (s_right == NULL || s_right->color == black)
+                        sibling = x_parent->right;
+                        if (sibling->get_color() == red)
                         {
-                            s_left->color = black;
-                            sibling->color = red;
-                            rotate_right(sibling, s_left, sibling->parent, header);
+                            sibling->set_color(black);
+                            x_parent->set_color(red);
+                            rotate_left(x_parent, sibling, x_parent->parent, header);
                             sibling = x_parent->right;
                             // assert(sibling != NULL);
                         }
 
-                        sibling->color = x_parent->color;
-                        x_parent->color = black;
-                        s_right = sibling->right;
-                        if (s_right != NULL)
+                        node_pointer s_left = sibling->left;
+                        node_pointer s_right = sibling->right;
+                        if ((s_left == NULL || s_left->get_color() == black) && (s_right == NULL || s_right->get_color() == black))
                         {
-                            s_right->color = black;
+                            sibling->set_color(red);
+                            x = x_parent;
+                            x_parent = x_parent->parent;
                         }
-                        rotate_left(x_parent, x_parent->right, x_parent->parent, header);
-                        break;
-                    }
-                }
-                else // if (x == x_parent->right)
-                {
-                    sibling = x_parent->left;
-                    if (sibling->color == red)
-                    {
-                        sibling->color = black;
-                        x_parent->color = red;
-                        rotate_right(x_parent, sibling, x_parent->parent, header);
-                        sibling = x_parent->left;
-                        // assert(sibling != NULL);
-                    }
+                        else
+                        {
+                            if (s_right == NULL || s_right->get_color() == black)
+                            {
+                                s_left->set_color(black);
+                                sibling->set_color(red);
+                                rotate_right(sibling, s_left, sibling->parent, header);
+                                sibling = x_parent->right;
+                                // assert(sibling != NULL);
+                            }
 
-                    node_pointer s_left = sibling->left;
-                    node_pointer s_right = sibling->right;
-                    if ((s_left == NULL || s_left->color == black) && (s_right == NULL || s_right->color == black))
-                    {
-                        sibling->color = red;
-                        x = x_parent;
-                        x_parent = x_parent->parent;
+                            sibling->set_color(x_parent->get_color());
+                            x_parent->set_color(black);
+                            s_right = sibling->right;
+                            if (s_right != NULL)
+                            {
+                                s_right->set_color(black);
+                            }
+                            rotate_left(x_parent, x_parent->right, x_parent->parent, header);
+                            break;
+                        }
                     }
-                    else
+                    else // if (x == x_parent->right)
                     {
-                        if (s_left == NULL || s_left->color == black)
+                        sibling = x_parent->left;
+                        if (sibling->get_color() == red)
                         {
-                            s_right->color = black;
-                            sibling->color = red;
-                            rotate_left(sibling, s_right, sibling->parent, header);
+                            sibling->set_color(black);
+                            x_parent->set_color(red);
+                            rotate_right(x_parent, sibling, x_parent->parent, header);
                             sibling = x_parent->left;
                             // assert(sibling != NULL);
                         }
 
-                        sibling->color = x_parent->color;
-                        x_parent->color = black;
-                        s_left = sibling->left;
-                        if (s_left != NULL)
+                        node_pointer s_left = sibling->left;
+                        node_pointer s_right = sibling->right;
+                        if ((s_left == NULL || s_left->get_color() == black) && (s_right == NULL || s_right->get_color() == black))
                         {
-                            s_left->color = black;
+                            sibling->set_color(red);
+                            x = x_parent;
+                            x_parent = x_parent->parent;
+                        }
+                        else
+                        {
+                            if (s_left == NULL || s_left->get_color() == black)
+                            {
+                                s_right->set_color(black);
+                                sibling->set_color(red);
+                                rotate_left(sibling, s_right, sibling->parent, header);
+                                sibling = x_parent->left;
+                                // assert(sibling != NULL);
+                            }
+
+                            sibling->set_color(x_parent->get_color());
+                            x_parent->set_color(black);
+                            s_left = sibling->left;
+                            if (s_left != NULL)
+                            {
+                                s_left->set_color(black);
+                            }
+                            rotate_right(x_parent, x_parent->left, x_parent->parent, header);
+                            break;
                         }
-                        rotate_right(x_parent, x_parent->left, x_parent->parent, header);
-                        break;
                     }
                 }
+
+                if (x != NULL)
+                {
+                    x->set_color(black);
+                }
             }
 
-            if (x != NULL)
+            // BEGIN Join
+            // The following work on detached subtrees, the parent of a returned root is left unset.
+
+            // black nodes on a path from root down to NULL
+            static std::size_t black_height(node_pointer root)
             {
-                x->color = black;
+                std::size_t height = 0;
+                for (; root != NULL; root = root->left)
+                {
+                    if (root->get_color() == black)
+                    {
+                        height++;
+                    }
+                }
+                return height;
+            }
+
+            static void attach(node_pointer node, node_pointer left, node_pointer right)
+            {
+                node->left = left;
+                if (left != NULL)
+                {
+                    left->parent = node;
+                }
+                node->right = right;
+                if (right != NULL)
+                {
+                    right->parent = node;
+                }
+#ifdef FT_TREE_ORDER_STATISTICS
+                update_size(node);
+#endif
+            }
+
+            // Every key of left is before middle and every key of right after it.
+            // Costs O(1 + the difference of the black heights).
+            static node_pointer join(node_pointer left, node_pointer middle, node_pointer right)
+            {
+                if (left != NULL)
+                {
+                    left->set_color(black);
+                }
+                if (right != NULL)
+                {
+                    right->set_color(black);
+                }
+
+                std::size_t left_height = black_height(left);
+                std::size_t right_height = black_height(right);
+                if (left_height == right_height)
+                {
+                    attach(middle, left, right);
+                    middle->set_color(black);
+                    return middle;
+                }
+
+                // hang middle on the facing spine of the taller tree, where the black height matches,
+                // then repair it like an inserted node under a temporary header
+                bool into_left = left_height > right_height;
+                node_pointer root = into_left ? left : right;
+                std::size_t height = into_left ? left_height : right_height;
+                std::size_t target = into_left ? right_height : left_height;
+
+                _tree_node_base header;
+                header.parent = root;
+                root->parent = &header;
+
+                node_pointer parent = &header;
+                node_pointer node = root;
+                while (height != target || (node != NULL && node->get_color() == red))
+                {
+                    if (node->get_color() == black)
+                    {
+                        height--;
+                    }
+                    parent = node;
+                    node = into_left ? node->right : node->left;
+                }
+
+                if (into_left)
+                {
+                    attach(middle, node, right);
+                    parent->right = middle;
+                }
+                else
+                {
+                    attach(middle, left, node);
+                    parent->left = middle;
+                }
+                middle->parent = parent;
+#ifdef FT_TREE_ORDER_STATISTICS
+                adjust_size(&header, parent, static_cast<std::ptrdiff_t>(middle->size - subtree_size(node)));
+#endif
+
+                repair_after_insert(&header, middle);
+                return header.parent;
+            }
+
+            // Takes the minimum out of root, what is left goes to rest.
+            static node_pointer detach_minimum(node_pointer root, node_pointer& rest)
+            {
+                if (root->left == NULL)
+                {
+                    rest = root->right;
+                    return root;
+                }
+                node_pointer left_rest;
+                node_pointer result = detach_minimum(root->left, left_rest);
+                rest = join(left_rest, root, root->right);
+                return result;
             }
-        }
-    };
+
+            // join without a middle node
+            static node_pointer join(node_pointer left, node_pointer right)
+            {
+                if (left == NULL)
+                {
+                    return right;
+                }
+                if (right == NULL)
+                {
+                    return left;
+                }
+                node_pointer rest;
+                node_pointer middle = detach_minimum(right, rest);
+                return join(left, middle, rest);
+            }
+            // END Join
+        };
+    }
 
     template <typename TTree>
     struct _tree_iterator
@@ -609,471 +959,241 @@ namespace ft
         }
     };
 
-    // TKeySelector: const TKey& (*keySelector)(const T&)
-    // TComp: bool (*comp)(const TKey&, const TKey&)
-    template <typename TKey, typename T, typename TKeySelector, typename TComp = ft::less<TKey>, typename TAlloc = std::allocator<T> >
-    class _tree
+#ifdef FT_TREE_ORDER_STATISTICS
+    // Jump through the subtree sizes instead of stepping node by node.
+    template <typename TTree, typename TDistance>
+    inline void advance(_tree_iterator<TTree>& it, TDistance n)
     {
-    public:
-        typedef TKey key_type;
-        typedef T value_type;
-        typedef _tree_algorithm algo;
-        typedef _tree_node<T> node_type;
-        typedef TKeySelector key_selector;
-        typedef TComp key_compare;
-        typedef typename TAlloc::template rebind<node_type>::other allocator_type;
-        typedef std::size_t size_type;
-        typedef std::ptrdiff_t difference_type;
+        it = _tree_iterator<TTree>(TTree::algo::advance(it.base(), n));
+    }
 
-        typedef _tree_iterator<_tree> iterator;
-        typedef _tree_const_iterator<_tree> const_iterator;
-        typedef ft::reverse_iterator<iterator> reverse_iterator;
-        typedef ft::reverse_iterator<const_iterator> reverse_const_iterator;
-
-    private:
-        _tree_node_base header;
-
-        key_compare comp;
-        allocator_type alloc;
-        size_type number;
-
-    public:
-        _tree(const TComp& comp = TComp(), const TAlloc& alloc = TAlloc())
-            : header(), comp(comp), alloc(alloc), number()
-        {
-            this->reset();
-        }
+    template <typename TTree, typename TDistance>
+    inline void advance(_tree_const_iterator<TTree>& it, TDistance n)
+    {
+        it = _tree_const_iterator<TTree>(TTree::algo::advance(it.base(), n));
+    }
 
-        _tree(const _tree& that)
-            : header(), comp(that.comp), alloc(that.alloc), number(that.number)
-        {
-            this->copy(that.root_node());
-        }
+    template <typename TTree>
+    inline typename _tree_iterator<TTree>::difference_type distance(_tree_iterator<TTree> first, _tree_iterator<TTree> last)
+    {
+        return TTree::algo::distance(first.base(), last.base());
+    }
 
-        ~_tree()
-        {
-            this->destruct(this->root_node());
-        }
+    template <typename TTree>
+    inline typename _tree_const_iterator<TTree>::difference_type distance(_tree_const_iterator<TTree> first, _tree_const_iterator<TTree> last)
+    {
+        return TTree::algo::distance(first.base(), last.base());
+    }
+#endif
 
-        _tree& operator=(const _tree& that)
-        {
-            if (this != &that)
+    namespace FT_TREE_LAYOUT
+    {
+        // TKeySelector: const TKey& (*keySelector)(const T&)
+        // TComp: bool (*comp)(const TKey&, const TKey&)
+        template <typename TKey, typename T, typename TKeySelector, typename TComp = ft::less<TKey>, typename TAlloc = std::allocator<T> >
+        class _tree
+        {
+        public:
+            typedef TKey key_type;
+            typedef T value_type;
+            typedef _tree_algorithm algo;
+            typedef _tree_node<T> node_type;
+            typedef TKeySelector key_selector;
+            typedef TComp key_compare;
+            typedef typename TAlloc::template rebind<node_type>::other allocator_type;
+            typedef std::size_t size_type;
+            typedef std::ptrdiff_t difference_type;
+
+            typedef _tree_iterator<_tree> iterator;
+            typedef _tree_const_iterator<_tree> const_iterator;
+            typedef ft::reverse_iterator<iterator> reverse_iterator;
+            typedef ft::reverse_iterator<const_iterator> reverse_const_iterator;
+
+        private:
+            _tree_node_base header;
+
+            key_compare comp;
+            allocator_type alloc;
+            size_type number;
+
+        public:
+            _tree(const TComp& comp = TComp(), const TAlloc& alloc = TAlloc())
+                : header(), comp(comp), alloc(alloc), number()
             {
-                _tree temp = that;
-                this->swap(temp);
+                this->reset();
             }
-            return *this;
-        }
 
-    public:
-        allocator_type get_allocator() const { return this->alloc; }
-        key_compare key_comp() const { return this->comp; }
-
-    protected:
-        node_type* insert_raw(algo::node_pointer parent, bool left, const value_type& data)
-        {
-            node_type* node = this->alloc.allocate(1);
-            try
-            {
-                this->alloc.construct(node, node_type(data));
-            }
-            catch (...)
+            _tree(const _tree& that)
+                : header(), comp(that.comp), alloc(that.alloc), number()
             {
-                this->alloc.deallocate(node, 1);
-                throw;
+                // the source is already sorted, rebuilding it is linear and needs no comparison
+                this->reset();
+                this->assign_sorted(that.begin(), that.size());
             }
 
-            node->parent = parent;
-            if (parent == this->end_node())
-            {
-                this->header.parent = node;
-                // update minimum
-                this->header.left = node;
-                // update maximum
-                this->header.right = node;
-            }
-            else if (left)
-            {
-                parent->left = node;
-                if (parent == this->begin_node())
-                {
-                    // update minimum
-                    this->header.left = node;
-                }
-            }
-            else // if (!left)
+#if __cplusplus >= 201103L
+            _tree(_tree&& that) noexcept(_internal::_is_nothrow_copy_constructible<key_compare>::value && _internal::_is_nothrow_copy_constructible<allocator_type>::value)
+                : header(), comp(that.comp), alloc(that.alloc), number()
             {
-                parent->right = node;
-                if (parent == this->header.right)
-                {
-                    // update maximum
-                    this->header.right = node;
-                }
+                this->reset();
+                this->swap(that);
             }
-
-            algo::repair_after_insert(this->header_node(), node);
-            this->number++;
-
-#ifdef FT_TREE_ASSERT
-            this->validate();
 #endif
 
-            return node;
-        }
-
-        ft::pair<algo::node_pointer, algo::node_pointer> equal_range_raw(const TKey& lower_key, const TKey& upper_key) const
-        {
-            algo::node_pointer x = this->root_node();
-            algo::node_pointer y = this->header_node();
-            while (x != NULL)
+            ~_tree()
             {
-                if (this->comp(key_selector()(static_cast<node_type*>(x)->data), lower_key))
-                {
-                    x = x->right;
-                }
-                else if (this->comp(upper_key, key_selector()(static_cast<node_type*>(x)->data)))
-                {
-                    y = x;
-                    x = x->left;
-                }
-                else
-                {
-                    y = upper_bound_raw(x->right, y, upper_key);
-                    x = lower_bound_raw(x->left, x, lower_key);
-                    return ft::make_pair<algo::node_pointer, algo::node_pointer>(x, y);
-                }
+                static_cast<void>(this->destruct(this->root_node()));
             }
-            return ft::make_pair<algo::node_pointer, algo::node_pointer>(y, y);
-        }
 
-        algo::node_pointer lower_bound_raw(algo::node_pointer root, algo::node_pointer end, const TKey& key) const
-        {
-            algo::node_pointer it = root;
-            algo::node_pointer result = end;
-            while (it != NULL)
+            _tree& operator=(const _tree& that)
             {
-                if (!this->comp(key_selector()(static_cast<node_type*>(it)->data), key))
-                {
-                    result = it;
-                    it = it->left;
-                }
-                else
+                if (this != &that)
                 {
-                    it = it->right;
+                    _tree temp = that;
+                    this->swap(temp);
                 }
+                return *this;
             }
-            return result;
-        }
 
-        algo::node_pointer upper_bound_raw(algo::node_pointer root, algo::node_pointer end, const TKey& key) const
-        {
-            algo::node_pointer it = root;
-            algo::node_pointer result = end;
-            while (it != NULL)
+#if __cplusplus >= 201103L
+            _tree& operator=(_tree&& that)
             {
-                if (this->comp(key, key_selector()(static_cast<node_type*>(it)->data)))
-                {
-                    result = it;
-                    it = it->left;
-                }
-                else
+                if (this != &that)
                 {
-                    it = it->right;
+                    _tree temp(ft::move(that));
+                    this->swap(temp);
                 }
+                return *this;
             }
-            return result;
-        }
-
-        void reset()
-        {
-            this->header.left = this->end_node();
-            this->header.right = this->end_node();
-            this->header.parent = NULL;
-        }
-
-        void copy(algo::node_pointer source)
-        {
-            if (source == NULL)
-            {
-                this->reset();
-                return;
-            }
-
-            node_type* src_root = static_cast<node_type*>(source);
-            node_type* dest_root = this->alloc.allocate(1);
-            this->alloc.construct(dest_root, *src_root);
-
-            this->header.left = dest_root;
-            this->header.right = dest_root;
-            this->header.parent = dest_root;
-
-            algo::node_pointer src_current = src_root;
-            algo::node_pointer dest_current = dest_root;
+#endif
 
-            dest_current->left = NULL;
-            dest_current->right = NULL;
-            dest_current->parent = this->header_node();
+        public:
+            allocator_type get_allocator() const { return this->alloc; }
+            key_compare key_comp() const { return this->comp; }
 
-            for (;;)
+        protected:
+#if __cplusplus >= 201103L
+            template <typename... Args>
+            node_type* create_node(Args&&... args)
             {
-                if (src_current->left != NULL && dest_current->left == NULL)
-                {
-                    // Down left
-                    src_current = src_current->left;
-                    node_type* src_node = static_cast<node_type*>(src_current);
-                    node_type* dest_node = this->alloc.allocate(1);
-                    this->alloc.construct(dest_node, *src_node);
-
-                    dest_current->left = dest_node;
-
-                    dest_node->left = NULL;
-                    dest_node->right = NULL;
-                    dest_node->parent = dest_current;
-
-                    dest_current = dest_node;
-                    if (this->header.parent == this->header.right)
-                    {
-                        this->header.left = dest_node;
-                    }
-                }
-                else if (src_current->right != NULL && dest_current->right == NULL)
-                {
-                    // Down right
-                    src_current = src_current->right;
-                    node_type* src_node = static_cast<node_type*>(src_current);
-                    node_type* dest_node = this->alloc.allocate(1);
-                    this->alloc.construct(dest_node, *src_node);
-
-                    dest_current->right = dest_node;
-
-                    dest_node->left = NULL;
-                    dest_node->right = NULL;
-                    dest_node->parent = dest_current;
-
-                    dest_current = dest_node;
-                    this->header.right = dest_node;
-                }
-                else if (src_current != source)
+                node_type* node = this->alloc.allocate(1);
+                try
                 {
-                    // Up parent
-                    src_current = src_current->parent;
-                    dest_current = dest_current->parent;
+                    _internal::_construct_node(this->alloc, node, _internal::_in_place_t(), ft::forward<Args>(args)...);
                 }
-                else
+                catch (...)
                 {
-                    break;
+                    this->alloc.deallocate(node, 1);
+                    throw;
                 }
+                return node;
             }
-        }
-
-        void destruct(algo::node_pointer node)
-        {
-            while (node != NULL)
+#else
+            node_type* create_node(const value_type& data)
             {
-                algo::node_pointer next = node->left;
-                if (next != NULL)
+                node_type* node = this->alloc.allocate(1);
+                try
                 {
-                    // if left is alive
-                    // rotate_right_rough
-                    node->left = next->right;
-                    next->right = node;
+                    _internal::_construct_node(this->alloc, node, data);
                 }
-                else
+                catch (...)
                 {
-                    // trying dispose right
-                    next = node->right;
-
-                    node_type* data_node = static_cast<node_type*>(node);
-                    this->alloc.destroy(data_node);
-                    this->alloc.deallocate(data_node, 1);
+                    this->alloc.deallocate(node, 1);
+                    throw;
                 }
-                node = next;
-            }
-        }
-
-        algo::node_pointer header_node() { return &this->header; }
-        algo::node_pointer header_node() const { return const_cast<algo::node_pointer>(&this->header); }
-        algo::node_pointer root_node() { return this->header.parent; }
-        algo::node_pointer root_node() const { return this->header.parent; }
-        algo::node_pointer begin_node() { return this->header.left; }
-        algo::node_pointer begin_node() const { return this->header.left; }
-        algo::node_pointer end_node() { return this->header_node(); }
-        algo::node_pointer end_node() const { return this->header_node(); }
-
-#ifdef FT_TREE_ASSERT
-        void validate()
-        {
-            assert(this->header.color == black);
-            if (this->header.parent != NULL)
-            {
-                assert(this->header.parent->color == black);
-            }
-
-            (void)validate_internal(this->header.parent, std::size_t());
-        }
-
-        std::size_t validate_internal(algo::node_pointer node, std::size_t depth)
-        {
-            if (node == NULL)
-            {
-                return 1;
+                return node;
             }
+#endif
 
-            if (node->color == red)
+            void destroy_node(node_type* node)
             {
-                assert(node->left == NULL || node->left->color == black);
-                assert(node->right == NULL || node->right->color == black);
+                _internal::_destroy_node(this->alloc, node);
+                this->alloc.deallocate(node, 1);
             }
 
-            std::size_t black_count_left = validate_internal(node->left, depth + 1);
-            std::size_t black_count_right = validate_internal(node->right, depth + 1);
-            assert(black_count_left == black_count_right);
-
-            std::size_t black_count = black_count_left;
-            if (node->color == black)
+            node_type* insert_raw(algo::node_pointer parent, bool left, const value_type& data)
             {
-                black_count++;
+                return this->link_node(parent, left, this->create_node(data));
             }
-            return black_count;
-        }
-#endif
-
-    public:
-        iterator begin() { return iterator(this->begin_node()); }
-        const_iterator begin() const { return const_iterator(this->begin_node()); }
-        iterator end() { return iterator(this->end_node()); }
-        const_iterator end() const { return const_iterator(this->end_node()); }
-        reverse_iterator rbegin() { return reverse_iterator(this->end()); }
-        reverse_const_iterator rbegin() const { return reverse_const_iterator(this->end()); }
-        reverse_iterator rend() { return reverse_iterator(this->begin()); }
-        reverse_const_iterator rend() const { return reverse_const_iterator(this->begin()); }
-
-        bool empty() const { return this->root_node() == NULL; }
-        size_type size() const { return this->number; }
-        size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(node_type); }
-
-        void clear()
-        {
-            this->destruct(this->root_node());
-            this->reset();
-            this->number = size_type();
-        }
-
-        ft::pair<node_type*, bool> insert_unique(algo::node_pointer hint, const value_type& data)
-        {
-            const key_type& key = key_selector()(data);
-            algo::node_pointer parent = this->end_node();
-            bool left = true;
 
-            do
+            node_type* link_node(algo::node_pointer parent, bool left, node_type* node)
             {
-                if (hint != NULL)
+                node->parent = parent;
+                if (parent == this->end_node())
                 {
-                    if (hint == this->end_node() || this->comp(key, key_selector()(static_cast<node_type*>(hint)->data)))
-                    {
-                        algo::node_pointer hint_prev;
-                        if (hint == this->begin_node())
-                        {
-                            hint_prev = NULL;
-                        }
-                        else
-                        {
-                            hint_prev = algo::predecessor(hint);
-                        }
-                        if (hint_prev == NULL || this->comp(key_selector()(static_cast<node_type*>(hint_prev)->data), key))
-                        {
-                            left = this->root_node() == NULL || hint->left == NULL;
-                            if (left)
-                            {
-                                parent = hint;
-                            }
-                            else
-                            {
-                                parent = hint_prev;
-                            }
-                            break;
-                        }
-                    }
+                    this->header.parent = node;
+                    // update minimum
+                    this->header.left = node;
+                    // update maximum
+                    this->header.right = node;
                 }
-
-                algo::node_pointer it = this->root_node();
-                algo::node_pointer result = this->header_node();
-                while (it != NULL)
+                else if (left)
                 {
-                    parent = it;
-                    left = this->comp(key, key_selector()(static_cast<node_type*>(it)->data));
-                    if (left)
-                    {
-                        it = it->left;
-                    }
-                    else
+                    parent->left = node;
+                    if (parent == this->begin_node())
                     {
-                        result = it;
-                        it = it->right;
+                        // update minimum
+                        this->header.left = node;
                     }
                 }
-                if (result != this->end_node() && !this->comp(key_selector()(static_cast<node_type*>(result)->data), key))
+                else // if (!left)
                 {
-                    return ft::make_pair(static_cast<node_type*>(result), false);
+                    parent->right = node;
+                    if (parent == this->header.right)
+                    {
+                        // update maximum
+                        this->header.right = node;
+                    }
                 }
-            } while (0);
 
-            return ft::make_pair(this->insert_raw(parent, left, data), true);
-        }
+#ifdef FT_TREE_ORDER_STATISTICS
+                node->size = 1;
+                algo::adjust_size(this->header_node(), parent, 1);
+#endif
+                algo::repair_after_insert(this->header_node(), node);
+                this->number++;
 
-        node_type* insert(algo::node_pointer hint, const value_type& data)
-        {
-            const key_type& key = key_selector()(data);
-            algo::node_pointer parent = this->end_node();
-            bool left = true;
+#ifdef FT_TREE_ASSERT
+                this->validate();
+#endif
+
+                return node;
+            }
 
-            do
+            ft::pair<algo::node_pointer, algo::node_pointer> equal_range_raw(const TKey& lower_key, const TKey& upper_key) const
             {
-                if (hint != NULL)
+                algo::node_pointer x = this->root_node();
+                algo::node_pointer y = this->header_node();
+                while (x != NULL)
                 {
-                    if (hint == this->end_node() || !this->comp(key_selector()(static_cast<node_type*>(hint)->data), key))
+                    if (this->comp(key_selector()(static_cast<node_type*>(x)->data), lower_key))
                     {
-                        algo::node_pointer hint_prev;
-                        if (hint == this->begin_node())
-                        {
-                            hint_prev = NULL;
-                        }
-                        else
-                        {
-                            hint_prev = algo::predecessor(hint);
-                        }
-                        if (hint_prev == NULL || !this->comp(key, key_selector()(static_cast<node_type*>(hint_prev)->data)))
-                        {
-                            left = this->root_node() == NULL || hint->left == NULL;
-                            if (left)
-                            {
-                                parent = hint;
-                            }
-                            else
-                            {
-                                parent = hint_prev;
-                            }
-                            break;
-                        }
-                        else
-                        {
-                            goto LABEL_INSERT_UPPER_BOUND;
-                        }
+                        x = x->right;
+                    }
+                    else if (this->comp(upper_key, key_selector()(static_cast<node_type*>(x)->data)))
+                    {
+                        y = x;
+                        x = x->left;
                     }
                     else
                     {
-                        goto LABEL_INSERT_LOWER_BOUND;
+                        y = upper_bound_raw(x->right, y, upper_key);
+                        x = lower_bound_raw(x->left, x, lower_key);
+                        return ft::make_pair<algo::node_pointer, algo::node_pointer>(x, y);
                     }
                 }
+                return ft::make_pair<algo::node_pointer, algo::node_pointer>(y, y);
+            }
 
-            LABEL_INSERT_UPPER_BOUND:
+            algo::node_pointer lower_bound_raw(algo::node_pointer root, algo::node_pointer end, const TKey& key) const
             {
-                algo::node_pointer it = this->root_node();
+                algo::node_pointer it = root;
+                algo::node_pointer result = end;
                 while (it != NULL)
                 {
-                    parent = it;
-                    if (this->comp(key, key_selector()(static_cast<node_type*>(it)->data)))
+                    if (!this->comp(key_selector()(static_cast<node_type*>(it)->data), key))
                     {
+                        result = it;
                         it = it->left;
                     }
                     else
@@ -1081,18 +1201,18 @@ namespace ft
                         it = it->right;
                     }
                 }
-                left = parent == this->end_node() || this->comp(key, key_selector()(static_cast<node_type*>(parent)->data));
-                break;
+                return result;
             }
 
-            LABEL_INSERT_LOWER_BOUND:
+            algo::node_pointer upper_bound_raw(algo::node_pointer root, algo::node_pointer end, const TKey& key) const
             {
-                algo::node_pointer it = this->root_node();
+                algo::node_pointer it = root;
+                algo::node_pointer result = end;
                 while (it != NULL)
                 {
-                    parent = it;
-                    if (!this->comp(key_selector()(static_cast<node_type*>(it)->data), key))
+                    if (this->comp(key, key_selector()(static_cast<node_type*>(it)->data)))
                     {
+                        result = it;
                         it = it->left;
                     }
                     else
@@ -1100,242 +1220,1295 @@ namespace ft
                         it = it->right;
                     }
                 }
-                left = parent == this->end_node() || !this->comp(key_selector()(static_cast<node_type*>(parent)->data), key);
-                break;
+                return result;
             }
-            } while (0);
-
-            return this->insert_raw(parent, left, data);
-        }
 
-        void erase(algo::node_pointer z)
-        {
-            algo::node_pointer y;
-            algo::node_pointer x;
-
-            algo::node_pointer z_left = z->left;
-            algo::node_pointer z_right = z->right;
-
-            if (z_left == NULL)
-            {
-                y = z;
-                // maybe null
-                x = z_right;
-            }
-            else if (z_right == NULL)
-            {
-                y = z;
-                // not null
-                x = z_left;
-            }
-            else
+            void reset()
             {
-                // assert(algo::successor(z) == algo::minimum(z_right));
-                y = algo::minimum(z_right);
-                // maybe null
-                x = y->right;
-                // goto LABEL_COMPLETE_NODE;
+                this->header.left = this->end_node();
+                this->header.right = this->end_node();
+                this->header.parent = NULL;
             }
 
-            algo::node_pointer x_parent;
-            if (y == z)
+            // Builds a subtree of n nodes in order from first. Every level above red_depth is full,
+            // so painting the partial bottom level red keeps the black height uniform.
+            template <typename UIter>
+            algo::node_pointer build_sorted(UIter& first, size_type n, size_type depth, size_type red_depth)
             {
-                // assert(z_left == NULL || z_right == NULL);
-                if (x != NULL)
+                if (n == 0)
                 {
-                    x->parent = z->parent;
+                    return NULL;
                 }
-                x_parent = z->parent;
-                algo::set_child(z->parent, z == z->parent->left, x, this->header_node());
 
-                if (this->begin_node() == z)
+                algo::node_pointer left = this->build_sorted(first, (n - 1) / 2, depth + 1, red_depth);
+                node_type* node;
+                try
                 {
-                    // update minimum
-                    // assert(z_left == NULL);
-                    if (z_right != NULL)
-                    {
-                        z_left = algo::minimum(z_right);
-                    }
-                    else
-                    {
-                        z_left = z->parent;
-                    }
-                    this->header.left = z_left;
-                    z_left = NULL;
+                    node = this->create_node(*first);
                 }
-                if (this->header.right == z)
+                catch (...)
                 {
-                    // update maximum
-                    // assert(z_right == NULL);
-                    if (z_left != NULL)
-                    {
-                        z_right = algo::maximum(z_left);
-                    }
-                    else
-                    {
-                        z_right = z->parent;
-                    }
-                    this->header.right = z_right;
-                    z_right = NULL;
+                    static_cast<void>(this->destruct(left));
+                    throw;
                 }
-            }
-            else
-            {
-                // LABEL_COMPLETE_NODE:
-                z_left->parent = y;
-                y->left = z_left;
-                if (y == z_right)
+                node->left = left;
+                if (left != NULL)
                 {
-                    x_parent = y;
-                    // assert(x == NULL)
+                    left->parent = node;
                 }
-                else
-                {
-                    y->right = z_right;
-                    z_right->parent = y;
 
-                    x_parent = y->parent;
-                    // assert(x_parent->left == y);
+                algo::node_pointer right;
+                try
+                {
+                    ++first;
+                    right = this->build_sorted(first, n - 1 - (n - 1) / 2, depth + 1, red_depth);
+                }
+                catch (...)
+                {
+                    static_cast<void>(this->destruct(node));
+                    throw;
+                }
+                node->right = right;
+                if (right != NULL)
+                {
+                    right->parent = node;
+                }
+
+                node->set_color(depth == red_depth ? red : black);
+#ifdef FT_TREE_ORDER_STATISTICS
+                algo::update_size(node);
+#endif
+                return node;
+            }
+
+            template <typename UIter>
+            void assign_sorted(UIter first, size_type n)
+            {
+                // assert(this->empty());
+                if (n == 0)
+                {
+                    return;
+                }
+
+                size_type red_depth = size_type();
+                for (size_type full = n + 1; full > 1; full >>= 1)
+                {
+                    red_depth++;
+                }
+
+                // nodes are created in order, an allocator that can reserve a run lays them out contiguously
+                _internal::reserve(this->alloc, n);
+                algo::node_pointer root = this->build_sorted(first, n, size_type(), red_depth);
+                root->parent = this->header_node();
+                this->header.parent = root;
+                this->header.left = algo::minimum(root);
+                this->header.right = algo::maximum(root);
+                this->number = n;
+
+#ifdef FT_TREE_ASSERT
+                this->validate();
+#endif
+            }
+
+            template <typename UIter>
+            bool is_sorted_range(UIter first, UIter last, bool unique) const
+            {
+                if (first == last)
+                {
+                    return true;
+                }
+                for (UIter prev = first; ++first != last; prev = first)
+                {
+                    // the iterators may yield another type, keep the converted values alive
+                    const value_type& prev_value = *prev;
+                    const value_type& value = *first;
+                    const key_type& prev_key = key_selector()(prev_value);
+                    const key_type& key = key_selector()(value);
+                    if (unique ? !this->comp(prev_key, key) : this->comp(key, prev_key))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            template <typename UIter>
+            void insert_range(UIter first, UIter last, bool unique, bool sorted, ft::forward_iterator_tag)
+            {
+                if (this->empty() && (sorted || this->is_sorted_range(first, last, unique)))
+                {
+                    this->assign_sorted(first, ft::distance(first, last));
+                    return;
+                }
+                this->insert_range(first, last, unique, sorted, ft::input_iterator_tag());
+            }
+
+            template <typename UIter>
+            void insert_range(UIter first, UIter last, bool unique, bool, ft::input_iterator_tag)
+            {
+                // the next key of an ordered run belongs right after the previous one
+                algo::node_pointer hint = this->end_node();
+                for (; first != last; ++first)
+                {
+                    algo::node_pointer node;
+                    if (unique)
+                    {
+                        node = this->insert_unique(hint, *first).first;
+                    }
+                    else
+                    {
+                        // equal keys go after the ones already there, as a plain insert puts them;
+                        // a hint at an equal key would put the new one in front
+                        const value_type& value = *first;
+                        if (hint != this->end_node() && !this->comp(key_selector()(value), this->node_key(hint)))
+                        {
+                            hint = NULL;
+                        }
+                        node = this->insert(hint, value);
+                    }
+                    hint = algo::successor(node);
+                }
+            }
+
+            size_type destruct(algo::node_pointer node)
+            {
+                size_type count = size_type();
+                while (node != NULL)
+                {
+                    algo::node_pointer next = node->left;
+                    if (next != NULL)
+                    {
+                        // if left is alive
+                        // rotate_right_rough
+                        node->left = next->right;
+                        next->right = node;
+                    }
+                    else
+                    {
+                        // trying dispose right
+                        next = node->right;
+
+                        this->destroy_node(static_cast<node_type*>(node));
+                        count++;
+                    }
+                    node = next;
+                }
+                return count;
+            }
+
+            const key_type& node_key(algo::node_pointer node) const
+            {
+                return key_selector()(static_cast<node_type*>(node)->data);
+            }
+
+            // Moves the keys before key to left and the ones after it to right.
+            // Returns the detached node with an equivalent key, or NULL.
+            algo::node_pointer split_nodes(algo::node_pointer node, const key_type& key, algo::node_pointer& left, algo::node_pointer& right)
+            {
+                if (node == NULL)
+                {
+                    left = NULL;
+                    right = NULL;
+                    return NULL;
+                }
+
+                algo::node_pointer node_left = node->left;
+                algo::node_pointer node_right = node->right;
+                algo::node_pointer found;
+                if (this->comp(key, this->node_key(node)))
+                {
+                    found = this->split_nodes(node_left, key, left, right);
+                    right = algo::join(right, node, node_right);
+                }
+                else if (this->comp(this->node_key(node), key))
+                {
+                    found = this->split_nodes(node_right, key, left, right);
+                    left = algo::join(node_left, node, left);
+                }
+                else
+                {
+                    left = node_left;
+                    right = node_right;
+                    found = node;
+                }
+                return found;
+            }
+
+            // The recursions below merge b into a and leave b NULL. The comparator only runs in split_nodes,
+            // which changes nothing before its last comparison, so if it throws the pieces held at each level
+            // are joined back: a and b are again disjoint trees of every node not yet released.
+
+            // The nodes of b holding a key already in a are released and counted in removed.
+            void union_nodes(algo::node_pointer& a, algo::node_pointer& b, size_type& removed)
+            {
+                if (b == NULL)
+                {
+                    return;
+                }
+                if (a == NULL)
+                {
+                    a = b;
+                    b = NULL;
+                    return;
+                }
+
+                algo::node_pointer left;
+                algo::node_pointer right;
+                algo::node_pointer found = this->split_nodes(b, this->node_key(a), left, right);
+                if (found != NULL)
+                {
+                    this->destroy_node(static_cast<node_type*>(found));
+                    removed++;
+                }
+                algo::node_pointer node = a;
+                algo::node_pointer a_left = node->left;
+                algo::node_pointer a_right = node->right;
+                try
+                {
+                    this->union_nodes(a_left, left, removed);
+                    this->union_nodes(a_right, right, removed);
+                }
+                catch (...)
+                {
+                    a = algo::join(a_left, node, a_right);
+                    b = algo::join(left, right);
+                    throw;
+                }
+                a = algo::join(a_left, node, a_right);
+                b = NULL;
+            }
+
+            // Every node of b is released, the ones of a without a match in b are counted in removed.
+            void intersection_nodes(algo::node_pointer& a, algo::node_pointer& b, size_type& removed)
+            {
+                if (a == NULL)
+                {
+                    static_cast<void>(this->destruct(b));
+                    b = NULL;
+                    return;
+                }
+                if (b == NULL)
+                {
+                    removed += this->destruct(a);
+                    a = NULL;
+                    return;
+                }
+
+                algo::node_pointer left;
+                algo::node_pointer right;
+                algo::node_pointer found = this->split_nodes(b, this->node_key(a), left, right);
+                algo::node_pointer node = a;
+                algo::node_pointer a_left = node->left;
+                algo::node_pointer a_right = node->right;
+                try
+                {
+                    this->intersection_nodes(a_left, left, removed);
+                    this->intersection_nodes(a_right, right, removed);
+                }
+                catch (...)
+                {
+                    a = algo::join(a_left, node, a_right);
+                    b = found != NULL ? algo::join(left, found, right) : algo::join(left, right);
+                    throw;
+                }
+                if (found != NULL)
+                {
+                    this->destroy_node(static_cast<node_type*>(found));
+                    a = algo::join(a_left, node, a_right);
+                }
+                else
+                {
+                    this->destroy_node(static_cast<node_type*>(node));
+                    removed++;
+                    a = algo::join(a_left, a_right);
+                }
+                b = NULL;
+            }
+
+            // Every node of b is released, the ones of a with a match in b too and counted in removed.
+            void difference_nodes(algo::node_pointer& a, algo::node_pointer& b, size_type& removed)
+            {
+                if (a == NULL)
+                {
+                    static_cast<void>(this->destruct(b));
+                    b = NULL;
+                    return;
+                }
+                if (b == NULL)
+                {
+                    return;
+                }
+
+                algo::node_pointer left;
+                algo::node_pointer right;
+                algo::node_pointer found = this->split_nodes(a, this->node_key(b), left, right);
+                algo::node_pointer node = b;
+                algo::node_pointer b_left = node->left;
+                algo::node_pointer b_right = node->right;
+                try
+                {
+                    this->difference_nodes(left, b_left, removed);
+                    this->difference_nodes(right, b_right, removed);
+                }
+                catch (...)
+                {
+                    a = found != NULL ? algo::join(left, found, right) : algo::join(left, right);
+                    b = algo::join(b_left, node, b_right);
+                    throw;
+                }
+                if (found != NULL)
+                {
+                    this->destroy_node(static_cast<node_type*>(found));
+                    removed++;
+                }
+                this->destroy_node(static_cast<node_type*>(node));
+                a = algo::join(left, right);
+                b = NULL;
+            }
+
+            static size_type count_nodes(algo::node_pointer node)
+            {
+                return node == NULL ? size_type() : 1 + count_nodes(node->left) + count_nodes(node->right);
+            }
+
+            // after a set operation threw, this and that take back what a and b still hold
+            void reinstall(algo::node_pointer a, _tree& that, algo::node_pointer b)
+            {
+                this->install(a, count_nodes(a));
+                that.install(b, count_nodes(b));
+            }
+
+            // hangs a detached tree of n nodes under the header
+            void install(algo::node_pointer root, size_type n)
+            {
+                this->reset();
+                if (root != NULL)
+                {
+                    root->parent = this->header_node();
+                    root->set_color(black);
+                    this->header.parent = root;
+                    this->header.left = algo::minimum(root);
+                    this->header.right = algo::maximum(root);
+                }
+                this->number = n;
+
+#ifdef FT_TREE_ASSERT
+                this->validate();
+#endif
+            }
+
+            // The nodes of that change hands below, so they have to come from an equal allocator.
+            // Otherwise operation runs on a copy of that made with the allocator here,
+            // and that, which keeps its own allocator, is cleared once it is done.
+            bool adopt(_tree& that, void (_tree::*operation)(_tree&))
+            {
+                if (this->alloc == that.alloc)
+                {
+                    return false;
+                }
+                _tree temp(that.comp, TAlloc(this->alloc));
+                temp.assign_sorted(that.begin(), that.size());
+                (this->*operation)(temp);
+                that.clear();
+                return true;
+            }
+
+            algo::node_pointer release_root()
+            {
+                algo::node_pointer root = this->root_node();
+                this->reset();
+                this->number = size_type();
+                return root;
+            }
+
+            algo::node_pointer header_node() { return &this->header; }
+            algo::node_pointer header_node() const { return const_cast<algo::node_pointer>(&this->header); }
+            algo::node_pointer root_node() { return this->header.parent; }
+            algo::node_pointer root_node() const { return this->header.parent; }
+            algo::node_pointer begin_node() { return this->header.left; }
+            algo::node_pointer begin_node() const { return this->header.left; }
+            algo::node_pointer end_node() { return this->header_node(); }
+            algo::node_pointer end_node() const { return this->header_node(); }
+
+#ifdef FT_TREE_ASSERT
+            void validate()
+            {
+                assert(this->header.get_color() == black);
+                if (this->header.parent != NULL)
+                {
+                    assert(this->header.parent->get_color() == black);
+                }
+
+                (void)validate_internal(this->header.parent, std::size_t());
+            }
+
+            std::size_t validate_internal(algo::node_pointer node, std::size_t depth)
+            {
+                if (node == NULL)
+                {
+                    return 1;
+                }
+
+                if (node->get_color() == red)
+                {
+                    assert(node->left == NULL || node->left->get_color() == black);
+                    assert(node->right == NULL || node->right->get_color() == black);
+                }
+
+                std::size_t black_count_left = validate_internal(node->left, depth + 1);
+                std::size_t black_count_right = validate_internal(node->right, depth + 1);
+                assert(black_count_left == black_count_right);
+#ifdef FT_TREE_ORDER_STATISTICS
+                assert(node->size == 1 + algo::subtree_size(node->left) + algo::subtree_size(node->right));
+#endif
+
+                std::size_t black_count = black_count_left;
+                if (node->get_color() == black)
+                {
+                    black_count++;
+                }
+                return black_count;
+            }
+#endif
+
+        public:
+            iterator begin() { return iterator(this->begin_node()); }
+            const_iterator begin() const { return const_iterator(this->begin_node()); }
+            iterator end() { return iterator(this->end_node()); }
+            const_iterator end() const { return const_iterator(this->end_node()); }
+            reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+            reverse_const_iterator rbegin() const { return reverse_const_iterator(this->end()); }
+            reverse_iterator rend() { return reverse_iterator(this->begin()); }
+            reverse_const_iterator rend() const { return reverse_const_iterator(this->begin()); }
+
+            bool empty() const { return this->root_node() == NULL; }
+            size_type size() const { return this->number; }
+            size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(node_type); }
+
+            void clear()
+            {
+                static_cast<void>(this->destruct(this->root_node()));
+                this->reset();
+                this->number = size_type();
+                _internal::release_all(this->alloc);
+            }
+
+            // Range insertion builds the tree in linear time when it is empty and the range is sorted.
+            template <typename UIter>
+            void insert_range_unique(UIter first, UIter last)
+            {
+                this->insert_range(first, last, true, false, typename ft::iterator_traits<UIter>::iterator_category());
+            }
+
+            template <typename UIter>
+            void insert_range_equal(UIter first, UIter last)
+            {
+                this->insert_range(first, last, false, false, typename ft::iterator_traits<UIter>::iterator_category());
+            }
+
+            // The caller guarantees the range is sorted (and unique, for sorted_unique).
+            template <typename UIter>
+            void insert_range_unique(ft::sorted_unique_t, UIter first, UIter last)
+            {
+                this->insert_range(first, last, true, true, typename ft::iterator_traits<UIter>::iterator_category());
+            }
+
+            template <typename UIter>
+            void insert_range_equal(ft::sorted_equivalent_t, UIter first, UIter last)
+            {
+                this->insert_range(first, last, false, true, typename ft::iterator_traits<UIter>::iterator_category());
+            }
+
+            // Returns the node holding an equivalent key, or NULL with the insertion point in parent/left.
+            algo::node_pointer unique_position(algo::node_pointer hint, const key_type& key, algo::node_pointer& parent, bool& left)
+            {
+                parent = this->end_node();
+                left = true;
+
+                do
+                {
+                    if (hint == NULL && this->root_node() != NULL && this->comp(key_selector()(static_cast<node_type*>(this->header.right)->data), key))
+                    {
+                        // greater than maximum
+                        parent = this->header.right;
+                        left = false;
+                        break;
+                    }
+
+                    if (hint != NULL)
+                    {
+                        if (hint == this->end_node() || this->comp(key, key_selector()(static_cast<node_type*>(hint)->data)))
+                        {
+                            algo::node_pointer hint_prev;
+                            if (hint == this->begin_node())
+                            {
+                                hint_prev = NULL;
+                            }
+                            else
+                            {
+                                hint_prev = algo::predecessor(hint);
+                            }
+                            if (hint_prev == NULL || this->comp(key_selector()(static_cast<node_type*>(hint_prev)->data), key))
+                            {
+                                left = this->root_node() == NULL || hint->left == NULL;
+                                if (left)
+                                {
+                                    parent = hint;
+                                }
+                                else
+                                {
+                                    parent = hint_prev;
+                                }
+                                break;
+                            }
+                        }
+                    }
+
+                    algo::node_pointer it = this->root_node();
+                    algo::node_pointer result = this->header_node();
+                    while (it != NULL)
+                    {
+                        parent = it;
+                        left = this->comp(key, key_selector()(static_cast<node_type*>(it)->data));
+                        if (left)
+                        {
+                            it = it->left;
+                        }
+                        else
+                        {
+                            result = it;
+                            it = it->right;
+                        }
+                    }
+                    if (result != this->end_node() && !this->comp(key_selector()(static_cast<node_type*>(result)->data), key))
+                    {
+                        return result;
+                    }
+                } while (0);
+
+                return NULL;
+            }
+
+            ft::pair<node_type*, bool> insert_unique(algo::node_pointer hint, const value_type& data)
+            {
+                algo::node_pointer parent;
+                bool left;
+                algo::node_pointer result = this->unique_position(hint, key_selector()(data), parent, left);
+                if (result != NULL)
+                {
+                    return ft::make_pair(static_cast<node_type*>(result), false);
+                }
+                return ft::make_pair(this->insert_raw(parent, left, data), true);
+            }
+
+            void equal_position(algo::node_pointer hint, const key_type& key, algo::node_pointer& parent, bool& left)
+            {
+                parent = this->end_node();
+                left = true;
+
+                do
+                {
+                    if (hint == NULL && this->root_node() != NULL && !this->comp(key, key_selector()(static_cast<node_type*>(this->header.right)->data)))
+                    {
+                        // not less than maximum
+                        parent = this->header.right;
+                        left = false;
+                        break;
+                    }
+
+                    if (hint != NULL)
+                    {
+                        if (hint == this->end_node() || !this->comp(key_selector()(static_cast<node_type*>(hint)->data), key))
+                        {
+                            algo::node_pointer hint_prev;
+                            if (hint == this->begin_node())
+                            {
+                                hint_prev = NULL;
+                            }
+                            else
+                            {
+                                hint_prev = algo::predecessor(hint);
+                            }
+                            if (hint_prev == NULL || !this->comp(key, key_selector()(static_cast<node_type*>(hint_prev)->data)))
+                            {
+                                left = this->root_node() == NULL || hint->left == NULL;
+                                if (left)
+                                {
+                                    parent = hint;
+                                }
+                                else
+                                {
+                                    parent = hint_prev;
+                                }
+                                break;
+                            }
+                            else
+                            {
+                                goto LABEL_INSERT_UPPER_BOUND;
+                            }
+                        }
+                        else
+                        {
+                            goto LABEL_INSERT_LOWER_BOUND;
+                        }
+                    }
+
+                LABEL_INSERT_UPPER_BOUND:
+                {
+                    algo::node_pointer it = this->root_node();
+                    while (it != NULL)
+                    {
+                        parent = it;
+                        if (this->comp(key, key_selector()(static_cast<node_type*>(it)->data)))
+                        {
+                            it = it->left;
+                        }
+                        else
+                        {
+                            it = it->right;
+                        }
+                    }
+                    left = parent == this->end_node() || this->comp(key, key_selector()(static_cast<node_type*>(parent)->data));
+                    break;
+                }
+
+                LABEL_INSERT_LOWER_BOUND:
+                {
+                    algo::node_pointer it = this->root_node();
+                    while (it != NULL)
+                    {
+                        parent = it;
+                        if (!this->comp(key_selector()(static_cast<node_type*>(it)->data), key))
+                        {
+                            it = it->left;
+                        }
+                        else
+                        {
+                            it = it->right;
+                        }
+                    }
+                    left = parent == this->end_node() || !this->comp(key_selector()(static_cast<node_type*>(parent)->data), key);
+                    break;
+                }
+                } while (0);
+            }
+
+            node_type* insert(algo::node_pointer hint, const value_type& data)
+            {
+                algo::node_pointer parent;
+                bool left;
+                this->equal_position(hint, key_selector()(data), parent, left);
+                return this->insert_raw(parent, left, data);
+            }
+
+#if __cplusplus >= 201103L
+            ft::pair<node_type*, bool> insert_unique(algo::node_pointer hint, value_type&& data)
+            {
+                algo::node_pointer parent;
+                bool left;
+                algo::node_pointer result = this->unique_position(hint, key_selector()(data), parent, left);
+                if (result != NULL)
+                {
+                    return ft::make_pair(static_cast<node_type*>(result), false);
+                }
+                return ft::make_pair(this->emplace_at(parent, left, ft::move(data)), true);
+            }
 
-                    if (x != NULL)
+            node_type* insert(algo::node_pointer hint, value_type&& data)
+            {
+                algo::node_pointer parent;
+                bool left;
+                this->equal_position(hint, key_selector()(data), parent, left);
+                return this->emplace_at(parent, left, ft::move(data));
+            }
+
+            // The value is built in its node first, the key is only known afterwards.
+            template <typename... Args>
+            ft::pair<node_type*, bool> emplace_unique(algo::node_pointer hint, Args&&... args)
+            {
+                node_type* node = this->create_node(ft::forward<Args>(args)...);
+                algo::node_pointer parent;
+                bool left;
+                algo::node_pointer result;
+                try
+                {
+                    result = this->unique_position(hint, key_selector()(node->data), parent, left);
+                }
+                catch (...)
+                {
+                    this->destroy_node(node);
+                    throw;
+                }
+                if (result != NULL)
+                {
+                    this->destroy_node(node);
+                    return ft::make_pair(static_cast<node_type*>(result), false);
+                }
+                return ft::make_pair(this->link_node(parent, left, node), true);
+            }
+
+            template <typename... Args>
+            node_type* emplace_equal(algo::node_pointer hint, Args&&... args)
+            {
+                node_type* node = this->create_node(ft::forward<Args>(args)...);
+                algo::node_pointer parent;
+                bool left;
+                try
+                {
+                    this->equal_position(hint, key_selector()(node->data), parent, left);
+                }
+                catch (...)
+                {
+                    this->destroy_node(node);
+                    throw;
+                }
+                return this->link_node(parent, left, node);
+            }
+
+            // Constructs at a position found by unique_position or equal_position.
+            template <typename... Args>
+            node_type* emplace_at(algo::node_pointer parent, bool left, Args&&... args)
+            {
+                return this->link_node(parent, left, this->create_node(ft::forward<Args>(args)...));
+            }
+#endif
+
+            void erase(algo::node_pointer z)
+            {
+                this->unlink(z);
+                this->destroy_node(static_cast<node_type*>(z));
+            }
+
+            // Takes z out of the tree, it is still constructed and owned by the caller.
+            node_type* extract(algo::node_pointer z)
+            {
+                this->unlink(z);
+                return static_cast<node_type*>(z);
+            }
+
+            // Links a node extracted from a tree with an equal allocator.
+            ft::pair<node_type*, bool> insert_node_unique(algo::node_pointer hint, node_type* node)
+            {
+                algo::node_pointer parent;
+                bool left;
+                algo::node_pointer result = this->unique_position(hint, key_selector()(node->data), parent, left);
+                if (result != NULL)
+                {
+                    return ft::make_pair(static_cast<node_type*>(result), false);
+                }
+                return ft::make_pair(this->relink_node(parent, left, node), true);
+            }
+
+            node_type* insert_node_equal(algo::node_pointer hint, node_type* node)
+            {
+                algo::node_pointer parent;
+                bool left;
+                this->equal_position(hint, key_selector()(node->data), parent, left);
+                return this->relink_node(parent, left, node);
+            }
+
+            // Moves the nodes of source whose key is not here yet, the others stay behind.
+            void merge_unique(_tree& source)
+            {
+                if (this == &source)
+                {
+                    return;
+                }
+                bool same_alloc = this->alloc == source.alloc;
+                for (algo::node_pointer it = source.begin_node(); it != source.end_node();)
+                {
+                    algo::node_pointer next = algo::successor(it);
+                    algo::node_pointer parent;
+                    bool left;
+                    if (this->unique_position(NULL, source.node_key(it), parent, left) == NULL)
+                    {
+                        if (same_alloc)
+                        {
+                            this->relink_node(parent, left, source.extract(it));
+                        }
+                        else
+                        {
+                            this->insert_raw(parent, left, static_cast<node_type*>(it)->data);
+                            source.erase(it);
+                        }
+                    }
+                    it = next;
+                }
+            }
+
+            void merge_equal(_tree& source)
+            {
+                if (this == &source)
+                {
+                    return;
+                }
+                bool same_alloc = this->alloc == source.alloc;
+                for (algo::node_pointer it = source.begin_node(); it != source.end_node();)
+                {
+                    algo::node_pointer next = algo::successor(it);
+                    algo::node_pointer parent;
+                    bool left;
+                    this->equal_position(NULL, source.node_key(it), parent, left);
+                    if (same_alloc)
+                    {
+                        this->relink_node(parent, left, source.extract(it));
+                    }
+                    else
                     {
-                        x->parent = x_parent;
+                        this->insert_raw(parent, left, static_cast<node_type*>(it)->data);
+                        source.erase(it);
                     }
-                    x_parent->left = x;
+                    it = next;
                 }
+            }
 
-                y->parent = z->parent;
-                algo::set_child(z->parent, z == z->parent->left, y, this->header_node());
+        protected:
+            node_type* relink_node(algo::node_pointer parent, bool left, node_type* node)
+            {
+                node->left = NULL;
+                node->right = NULL;
+                return this->link_node(parent, left, node);
             }
 
-            algo::repair_after_erase(this->header_node(), z, y, x, x_parent);
+            void unlink(algo::node_pointer z)
+            {
+                algo::node_pointer y;
+                algo::node_pointer x;
+
+                algo::node_pointer z_left = z->left;
+                algo::node_pointer z_right = z->right;
+
+                if (z_left == NULL)
+                {
+                    y = z;
+                    // maybe null
+                    x = z_right;
+                }
+                else if (z_right == NULL)
+                {
+                    y = z;
+                    // not null
+                    x = z_left;
+                }
+                else
+                {
+                    // assert(algo::successor(z) == algo::minimum(z_right));
+                    y = algo::minimum(z_right);
+                    // maybe null
+                    x = y->right;
+                    // goto LABEL_COMPLETE_NODE;
+                }
+
+#ifdef FT_TREE_ORDER_STATISTICS
+                // y leaves its place, z when it has a free side
+                algo::adjust_size(this->header_node(), y->parent, -1);
+#endif
+
+                algo::node_pointer x_parent;
+                if (y == z)
+                {
+                    // assert(z_left == NULL || z_right == NULL);
+                    if (x != NULL)
+                    {
+                        x->parent = z->parent;
+                    }
+                    x_parent = z->parent;
+                    algo::set_child(z->parent, z == z->parent->left, x, this->header_node());
+
+                    if (this->begin_node() == z)
+                    {
+                        // update minimum
+                        // assert(z_left == NULL);
+                        if (z_right != NULL)
+                        {
+                            z_left = algo::minimum(z_right);
+                        }
+                        else
+                        {
+                            z_left = z->parent;
+                        }
+                        this->header.left = z_left;
+                        z_left = NULL;
+                    }
+                    if (this->header.right == z)
+                    {
+                        // update maximum
+                        // assert(z_right == NULL);
+                        if (z_left != NULL)
+                        {
+                            z_right = algo::maximum(z_left);
+                        }
+                        else
+                        {
+                            z_right = z->parent;
+                        }
+                        this->header.right = z_right;
+                        z_right = NULL;
+                    }
+                }
+                else
+                {
+                    // LABEL_COMPLETE_NODE:
+                    z_left->parent = y;
+                    y->left = z_left;
+                    if (y == z_right)
+                    {
+                        x_parent = y;
+                        // assert(x == NULL)
+                    }
+                    else
+                    {
+                        y->right = z_right;
+                        z_right->parent = y;
+
+                        x_parent = y->parent;
+                        // assert(x_parent->left == y);
+
+                        if (x != NULL)
+                        {
+                            x->parent = x_parent;
+                        }
+                        x_parent->left = x;
+                    }
+
+                    y->parent = z->parent;
+                    algo::set_child(z->parent, z == z->parent->left, y, this->header_node());
+#ifdef FT_TREE_ORDER_STATISTICS
+                    y->size = z->size;
+#endif
+                }
+
+                algo::repair_after_erase(this->header_node(), z, y, x, x_parent);
 
-            node_type* data_z = static_cast<node_type*>(z);
-            this->alloc.destroy(data_z);
-            this->alloc.deallocate(data_z, 1);
-            this->number--;
+                this->number--;
 
 #ifdef FT_TREE_ASSERT
-            this->validate();
+                this->validate();
 #endif
-        }
+            }
 
-        void swap(_tree& that)
-        {
-            ft::swap(this->header.left, that.header.left);
-            if (this->header.left == &that.header)
+        public:
+
+            void swap(_tree& that)
+            {
+                ft::swap(this->header.left, that.header.left);
+                if (this->header.left == &that.header)
+                {
+                    this->header.left = &this->header;
+                }
+                if (that.header.left == &this->header)
+                {
+                    that.header.left = &that.header;
+                }
+
+                ft::swap(this->header.right, that.header.right);
+                if (this->header.right == &that.header)
+                {
+                    this->header.right = &this->header;
+                }
+                if (that.header.right == &this->header)
+                {
+                    that.header.right = &that.header;
+                }
+
+                ft::swap(this->header.parent, that.header.parent);
+                if (this->header.parent != NULL)
+                {
+                    this->header.parent->parent = &this->header;
+                }
+                if (that.header.parent != NULL)
+                {
+                    that.header.parent->parent = &that.header;
+                }
+
+                ft::swap(this->comp, that.comp);
+                ft::swap(this->alloc, that.alloc);
+                ft::swap(this->number, that.number);
+            }
+
+            // Bulk operations on unique keys. The nodes change hands instead of being copied
+            // when both allocators compare equal, and that is left empty unless noted.
+            // Merging sizes m <= n costs O(m log(n / m + 1)).
+            // If the comparator throws, both trees stay valid and hold every element not yet
+            // released: the ones merged so far here, the rest in that.
+
+            // keys after key move to greater, replacing its content;
+            // without order statistics index_of walks to the split point from the nearer end
+            void split(const key_type& key, _tree& greater)
             {
-                this->header.left = &this->header;
+                greater.clear();
+                if (!(this->alloc == greater.alloc))
+                {
+                    _tree temp(this->comp, TAlloc(this->alloc));
+                    this->split(key, temp);
+                    try
+                    {
+                        greater.assign_sorted(temp.begin(), temp.size());
+                    }
+                    catch (...)
+                    {
+                        // the keys of temp come after the ones here, nothing to compare
+                        size_type n = this->number + temp.number;
+                        this->install(algo::join(this->release_root(), temp.release_root()), n);
+                        throw;
+                    }
+                    return;
+                }
+
+                size_type n = this->number;
+                size_type lower = this->index_of(this->upper_bound(key).base());
+                algo::node_pointer root = this->release_root();
+                algo::node_pointer left;
+                algo::node_pointer right;
+                algo::node_pointer found;
+                try
+                {
+                    found = this->split_nodes(root, key, left, right);
+                }
+                catch (...)
+                {
+                    // split_nodes takes root apart only after its last comparison
+                    this->install(root, n);
+                    throw;
+                }
+                if (found != NULL)
+                {
+                    left = algo::join(left, found, NULL);
+                }
+                greater.install(right, n - lower);
+                this->install(left, lower);
             }
-            if (that.header.left == &this->header)
+
+            // O(log n) when every key of greater comes after the keys here, a union otherwise
+            void join(_tree& greater)
             {
-                that.header.left = &that.header;
+                if (greater.empty())
+                {
+                    return;
+                }
+                if (this->empty() || !this->comp(this->node_key(this->header.right), greater.node_key(greater.header.left)))
+                {
+                    this->set_union(greater);
+                    return;
+                }
+
+                if (this->adopt(greater, &_tree::join))
+                {
+                    return;
+                }
+                size_type n = this->number + greater.number;
+                this->install(algo::join(this->release_root(), greater.release_root()), n);
             }
 
-            ft::swap(this->header.right, that.header.right);
-            if (this->header.right == &that.header)
+            // keeps the element here when both hold a key
+            void set_union(_tree& that)
             {
-                this->header.right = &this->header;
+                if (this->adopt(that, &_tree::set_union))
+                {
+                    return;
+                }
+                size_type removed = size_type();
+                size_type n = this->number + that.number;
+                algo::node_pointer root = this->release_root();
+                algo::node_pointer other = that.release_root();
+                try
+                {
+                    this->union_nodes(root, other, removed);
+                }
+                catch (...)
+                {
+                    this->reinstall(root, that, other);
+                    throw;
+                }
+                this->install(root, n - removed);
             }
-            if (that.header.right == &this->header)
+
+            void set_intersection(_tree& that)
             {
-                that.header.right = &that.header;
+                if (this->adopt(that, &_tree::set_intersection))
+                {
+                    return;
+                }
+                size_type removed = size_type();
+                size_type n = this->number;
+                algo::node_pointer root = this->release_root();
+                algo::node_pointer other = that.release_root();
+                try
+                {
+                    this->intersection_nodes(root, other, removed);
+                }
+                catch (...)
+                {
+                    this->reinstall(root, that, other);
+                    throw;
+                }
+                this->install(root, n - removed);
             }
 
-            ft::swap(this->header.parent, that.header.parent);
-            if (this->header.parent != NULL)
+            void set_difference(_tree& that)
             {
-                this->header.parent->parent = &this->header;
+                if (this->adopt(that, &_tree::set_difference))
+                {
+                    return;
+                }
+                size_type removed = size_type();
+                size_type n = this->number;
+                algo::node_pointer root = this->release_root();
+                algo::node_pointer other = that.release_root();
+                try
+                {
+                    this->difference_nodes(root, other, removed);
+                }
+                catch (...)
+                {
+                    this->reinstall(root, that, other);
+                    throw;
+                }
+                this->install(root, n - removed);
             }
-            if (that.header.parent != NULL)
+
+            size_type count(const key_type& key) const
             {
-                that.header.parent->parent = &that.header;
+                ft::pair<const_iterator, const_iterator> range = this->equal_range(key);
+                return this->distance(range.first.base(), range.second.base());
             }
 
-            ft::swap(this->comp, that.comp);
-            ft::swap(this->alloc, that.alloc);
-            ft::swap(this->number, that.number);
-        }
+            // Without FT_TREE_ORDER_STATISTICS the following walk the tree in order.
 
-        size_type count(const key_type& key) const
-        {
-            ft::pair<const_iterator, const_iterator> range = this->equal_range(key);
-            size_type i = size_type();
-            for (const_iterator it = range.first; it != range.second; ++it)
+            // position of node in order, size() for the end
+            size_type index_of(algo::node_pointer node) const
             {
-                i++;
+#ifdef FT_TREE_ORDER_STATISTICS
+                return algo::rank(this->header_node(), node);
+#else
+                // walks in from both ends, so the cost is the distance to the nearer one
+                algo::node_pointer forward = this->begin_node();
+                algo::node_pointer backward = this->end_node();
+                for (size_type i = size_type();; i++)
+                {
+                    if (forward == node)
+                    {
+                        return i;
+                    }
+                    if (backward == node)
+                    {
+                        return this->number - i;
+                    }
+                    forward = algo::successor(forward);
+                    backward = algo::predecessor(backward);
+                }
+#endif
             }
-            return i;
-        }
 
-        algo::node_pointer find(const key_type& key) { return const_cast<const _tree*>(this)->find(key); }
-        algo::node_pointer find(const key_type& key) const
-        {
-            const_iterator it = this->lower_bound(key);
-            if (it == this->end() || this->comp(key, key_selector()(*it)))
+            // number of elements ordered before key
+            size_type rank(const key_type& key) const
             {
-                return this->end_node();
+                return this->index_of(this->lower_bound(key).base());
             }
-            return it.base();
-        }
 
-        ft::pair<iterator, iterator> equal_range(const key_type& key)
-        {
-            ft::pair<algo::node_pointer, algo::node_pointer> range = const_cast<const _tree*>(this)->equal_range_raw(key, key);
-            return ft::make_pair(iterator(range.first), iterator(range.second));
-        }
-        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
-        {
-            ft::pair<algo::node_pointer, algo::node_pointer> range = this->equal_range_raw(key, key);
-            return ft::make_pair(const_iterator(range.first), const_iterator(range.second));
-        }
+            // k-th element in order, the end for k >= size()
+            algo::node_pointer nth_element(size_type k) const
+            {
+                if (k >= this->size())
+                {
+                    return this->end_node();
+                }
+#ifdef FT_TREE_ORDER_STATISTICS
+                return algo::select(this->root_node(), k);
+#else
+                algo::node_pointer it = this->begin_node();
+                for (; k != 0; --k)
+                {
+                    it = algo::successor(it);
+                }
+                return it;
+#endif
+            }
 
-        iterator lower_bound(const key_type& key)
-        {
-            return iterator(const_cast<const _tree*>(this)->lower_bound_raw(this->root_node(), this->end_node(), key));
-        }
-        const_iterator lower_bound(const key_type& key) const
-        {
-            return const_iterator(this->lower_bound_raw(this->root_node(), this->end_node(), key));
-        }
+            // first must not come after last
+            size_type distance(algo::node_pointer first, algo::node_pointer last) const
+            {
+#ifdef FT_TREE_ORDER_STATISTICS
+                return this->index_of(last) - this->index_of(first);
+#else
+                size_type i = size_type();
+                for (; first != last; first = algo::successor(first))
+                {
+                    i++;
+                }
+                return i;
+#endif
+            }
 
-        iterator upper_bound(const key_type& key)
-        {
-            return iterator(const_cast<const _tree*>(this)->upper_bound_raw(this->root_node(), this->end_node(), key));
-        }
-        const_iterator upper_bound(const key_type& key) const
-        {
-            return const_iterator(this->upper_bound_raw(this->root_node(), this->end_node(), key));
-        }
+            algo::node_pointer find(const key_type& key) { return const_cast<const _tree*>(this)->find(key); }
+            algo::node_pointer find(const key_type& key) const
+            {
+                const_iterator it = this->lower_bound(key);
+                if (it == this->end() || this->comp(key, key_selector()(*it)))
+                {
+                    return this->end_node();
+                }
+                return it.base();
+            }
 
-        friend bool operator==(const _tree& lhs, const _tree& rhs)
-        {
-            return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
-        }
+            ft::pair<iterator, iterator> equal_range(const key_type& key)
+            {
+                ft::pair<algo::node_pointer, algo::node_pointer> range = const_cast<const _tree*>(this)->equal_range_raw(key, key);
+                return ft::make_pair(iterator(range.first), iterator(range.second));
+            }
+            ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+            {
+                ft::pair<algo::node_pointer, algo::node_pointer> range = this->equal_range_raw(key, key);
+                return ft::make_pair(const_iterator(range.first), const_iterator(range.second));
+            }
 
-        friend bool operator!=(const _tree& lhs, const _tree& rhs)
-        {
-            return !(lhs == rhs);
-        }
+            iterator lower_bound(const key_type& key)
+            {
+                return iterator(const_cast<const _tree*>(this)->lower_bound_raw(this->root_node(), this->end_node(), key));
+            }
+            const_iterator lower_bound(const key_type& key) const
+            {
+                return const_iterator(this->lower_bound_raw(this->root_node(), this->end_node(), key));
+            }
 
-        friend bool operator<(const _tree& lhs, const _tree& rhs)
-        {
-            return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-        }
+            iterator upper_bound(const key_type& key)
+            {
+                return iterator(const_cast<const _tree*>(this)->upper_bound_raw(this->root_node(), this->end_node(), key));
+            }
+            const_iterator upper_bound(const key_type& key) const
+            {
+                return const_iterator(this->upper_bound_raw(this->root_node(), this->end_node(), key));
+            }
 
-        friend bool operator<=(const _tree& lhs, const _tree& rhs)
-        {
-            return !(rhs < lhs);
-        }
+            friend bool operator==(const _tree& lhs, const _tree& rhs)
+            {
+                return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+            }
 
-        friend bool operator>(const _tree& lhs, const _tree& rhs)
-        {
-            return rhs < lhs;
-        }
+            friend bool operator!=(const _tree& lhs, const _tree& rhs)
+            {
+                return !(lhs == rhs);
+            }
 
-        friend bool operator>=(const _tree& lhs, const _tree& rhs)
-        {
-            return !(lhs < rhs);
-        }
-    };
+            friend bool operator<(const _tree& lhs, const _tree& rhs)
+            {
+                return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+            }
+
+            friend bool operator<=(const _tree& lhs, const _tree& rhs)
+            {
+                return !(rhs < lhs);
+            }
+
+            friend bool operator>(const _tree& lhs, const _tree& rhs)
+            {
+                return rhs < lhs;
+            }
+
+            friend bool operator>=(const _tree& lhs, const _tree& rhs)
+            {
+                return !(lhs < rhs);
+            }
+        };
+    }
 }
@@ -0,0 +1,944 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "stdexcept.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+#include <climits>
+#include <cstddef>
+#include <limits>
+
+namespace ft
+{
+    namespace _internal
+    {
+        // vector<bool> packs its bits into unsigned longs, bit i of the vector being bit i % width of word i / width
+        typedef unsigned long _bit_word;
+
+        enum
+        {
+            _bit_word_width = sizeof(_bit_word) * CHAR_BIT
+        };
+
+        inline std::size_t _bit_popcount(_bit_word w)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_popcountl(w));
+#else
+            std::size_t n = 0;
+            for (; w != 0; w &= w - 1)
+            {
+                ++n;
+            }
+            return n;
+#endif
+        }
+
+        // index of the lowest set bit, w is not 0
+        inline std::size_t _bit_lowest(_bit_word w)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_ctzl(w));
+#else
+            std::size_t n = 0;
+            for (; (w & 1) == 0; w >>= 1)
+            {
+                ++n;
+            }
+            return n;
+#endif
+        }
+
+        struct _bit_reference
+        {
+            _bit_word* word;
+            _bit_word mask;
+
+            _bit_reference(_bit_word* word, _bit_word mask) throw()
+                : word(word), mask(mask) {}
+
+            _bit_reference(const _bit_reference& that) throw()
+                : word(that.word), mask(that.mask) {}
+
+            operator bool() const throw()
+            {
+                return (*this->word & this->mask) != 0;
+            }
+
+            _bit_reference& operator=(bool value) throw()
+            {
+                if (value)
+                {
+                    *this->word |= this->mask;
+                }
+                else
+                {
+                    *this->word &= ~this->mask;
+                }
+                return *this;
+            }
+
+            // assigns the bit, a reference is never reseated
+            _bit_reference& operator=(const _bit_reference& that) throw()
+            {
+                return *this = bool(that);
+            }
+
+            bool operator~() const throw()
+            {
+                return !bool(*this);
+            }
+
+            void flip() throw()
+            {
+                *this->word ^= this->mask;
+            }
+        };
+
+        struct _bit_iterator_base
+        {
+            typedef ft::random_access_iterator_tag iterator_category;
+            typedef std::ptrdiff_t difference_type;
+
+            _bit_word* word;
+            std::size_t offset;
+
+            _bit_iterator_base(_bit_word* word, std::size_t offset) throw()
+                : word(word), offset(offset) {}
+
+            void increment() throw()
+            {
+                if (++this->offset == std::size_t(_bit_word_width))
+                {
+                    this->offset = 0;
+                    ++this->word;
+                }
+            }
+
+            void decrement() throw()
+            {
+                if (this->offset-- == 0)
+                {
+                    this->offset = _bit_word_width - 1;
+                    --this->word;
+                }
+            }
+
+            void advance(difference_type n) throw()
+            {
+                difference_type bit = n + static_cast<difference_type>(this->offset);
+                difference_type words = bit >= 0 ? bit / _bit_word_width : -((-bit - 1) / _bit_word_width) - 1;
+                this->word += words;
+                this->offset = static_cast<std::size_t>(bit - words * _bit_word_width);
+            }
+
+            friend difference_type operator-(const _bit_iterator_base& lhs, const _bit_iterator_base& rhs) throw()
+            {
+                return _bit_word_width * (lhs.word - rhs.word) + static_cast<difference_type>(lhs.offset) - static_cast<difference_type>(rhs.offset);
+            }
+
+            friend bool operator==(const _bit_iterator_base& lhs, const _bit_iterator_base& rhs) throw()
+            {
+                return lhs.word == rhs.word && lhs.offset == rhs.offset;
+            }
+
+            friend bool operator!=(const _bit_iterator_base& lhs, const _bit_iterator_base& rhs) throw()
+            {
+                return !(lhs == rhs);
+            }
+
+            friend bool operator<(const _bit_iterator_base& lhs, const _bit_iterator_base& rhs) throw()
+            {
+                return lhs.word == rhs.word ? lhs.offset < rhs.offset : lhs.word < rhs.word;
+            }
+
+            friend bool operator<=(const _bit_iterator_base& lhs, const _bit_iterator_base& rhs) throw()
+            {
+                return !(rhs < lhs);
+            }
+
+            friend bool operator>(const _bit_iterator_base& lhs, const _bit_iterator_base& rhs) throw()
+            {
+                return rhs < lhs;
+            }
+
+            friend bool operator>=(const _bit_iterator_base& lhs, const _bit_iterator_base& rhs) throw()
+            {
+                return !(lhs < rhs);
+            }
+        };
+
+        struct _bit_iterator : _bit_iterator_base
+        {
+            typedef bool value_type;
+            typedef _bit_reference reference;
+            typedef void pointer;
+
+            _bit_iterator() throw()
+                : _bit_iterator_base(0, 0) {}
+
+            _bit_iterator(_bit_word* word, std::size_t offset) throw()
+                : _bit_iterator_base(word, offset) {}
+
+            reference operator*() const throw()
+            {
+                return reference(this->word, _bit_word(1) << this->offset);
+            }
+
+            reference operator[](difference_type n) const throw()
+            {
+                return *(*this + n);
+            }
+
+            _bit_iterator& operator++() throw()
+            {
+                this->increment();
+                return *this;
+            }
+
+            _bit_iterator operator++(int) throw()
+            {
+                _bit_iterator tmp = *this;
+                this->increment();
+                return tmp;
+            }
+
+            _bit_iterator& operator--() throw()
+            {
+                this->decrement();
+                return *this;
+            }
+
+            _bit_iterator operator--(int) throw()
+            {
+                _bit_iterator tmp = *this;
+                this->decrement();
+                return tmp;
+            }
+
+            _bit_iterator& operator+=(difference_type n) throw()
+            {
+                this->advance(n);
+                return *this;
+            }
+
+            _bit_iterator& operator-=(difference_type n) throw()
+            {
+                this->advance(-n);
+                return *this;
+            }
+
+            _bit_iterator operator+(difference_type n) const throw()
+            {
+                _bit_iterator tmp = *this;
+                return tmp += n;
+            }
+
+            _bit_iterator operator-(difference_type n) const throw()
+            {
+                _bit_iterator tmp = *this;
+                return tmp -= n;
+            }
+
+            friend _bit_iterator operator+(difference_type n, const _bit_iterator& it) throw()
+            {
+                return it + n;
+            }
+        };
+
+        struct _bit_const_iterator : _bit_iterator_base
+        {
+            typedef bool value_type;
+            typedef bool reference;
+            typedef void pointer;
+
+            _bit_const_iterator() throw()
+                : _bit_iterator_base(0, 0) {}
+
+            _bit_const_iterator(const _bit_word* word, std::size_t offset) throw()
+                : _bit_iterator_base(const_cast<_bit_word*>(word), offset) {}
+
+            _bit_const_iterator(const _bit_iterator& that) throw()
+                : _bit_iterator_base(that.word, that.offset) {}
+
+            reference operator*() const throw()
+            {
+                return (*this->word >> this->offset & 1) != 0;
+            }
+
+            reference operator[](difference_type n) const throw()
+            {
+                return *(*this + n);
+            }
+
+            _bit_const_iterator& operator++() throw()
+            {
+                this->increment();
+                return *this;
+            }
+
+            _bit_const_iterator operator++(int) throw()
+            {
+                _bit_const_iterator tmp = *this;
+                this->increment();
+                return tmp;
+            }
+
+            _bit_const_iterator& operator--() throw()
+            {
+                this->decrement();
+                return *this;
+            }
+
+            _bit_const_iterator operator--(int) throw()
+            {
+                _bit_const_iterator tmp = *this;
+                this->decrement();
+                return tmp;
+            }
+
+            _bit_const_iterator& operator+=(difference_type n) throw()
+            {
+                this->advance(n);
+                return *this;
+            }
+
+            _bit_const_iterator& operator-=(difference_type n) throw()
+            {
+                this->advance(-n);
+                return *this;
+            }
+
+            _bit_const_iterator operator+(difference_type n) const throw()
+            {
+                _bit_const_iterator tmp = *this;
+                return tmp += n;
+            }
+
+            _bit_const_iterator operator-(difference_type n) const throw()
+            {
+                _bit_const_iterator tmp = *this;
+                return tmp -= n;
+            }
+
+            friend _bit_const_iterator operator+(difference_type n, const _bit_const_iterator& it) throw()
+            {
+                return it + n;
+            }
+        };
+    }
+
+    // the references are rvalues, the generic swap cannot bind them
+    inline void swap(_internal::_bit_reference a, _internal::_bit_reference b) throw()
+    {
+        bool value = a;
+        a = b;
+        b = value;
+    }
+
+    // Packed vector of bits. The words live in a vector of their own, so growth and relocation are
+    // the primary template's; comparisons, count, find and the bitwise operators run a word at a time.
+    // Bits past size() in the last word are kept at 0, whole words can then be compared and counted.
+    template <typename TAlloc, typename TGrowth>
+    class vector<bool, TAlloc, TGrowth>
+    {
+    public:
+        typedef bool value_type;
+        typedef TAlloc allocator_type;
+        typedef TGrowth growth_policy;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef ft::_internal::_bit_reference reference;
+        typedef bool const_reference;
+        typedef void pointer;
+        typedef void const_pointer;
+        typedef ft::_internal::_bit_iterator iterator;
+        typedef ft::_internal::_bit_const_iterator const_iterator;
+        typedef ft::reverse_iterator<iterator> reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    protected:
+        typedef ft::_internal::_bit_word word_type;
+        typedef typename TAlloc::template rebind<word_type>::other word_allocator_type;
+        typedef ft::vector<word_type, word_allocator_type, TGrowth> storage_type;
+
+        enum
+        {
+            width = ft::_internal::_bit_word_width
+        };
+
+    private:
+        storage_type words;
+        size_type length;
+
+    public:
+        vector()
+            : words(), length() {}
+
+        explicit vector(const allocator_type& alloc)
+            : words(word_allocator_type(alloc)), length() {}
+
+        explicit vector(size_type count, const value_type& value = value_type(), const allocator_type& alloc = allocator_type())
+            : words(word_allocator_type(alloc)), length()
+        {
+            this->assign(count, value);
+        }
+
+        template <typename UIter>
+        // vector(UIter first, UIter last, const allocator_type& alloc = allocator_type())
+        vector(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const allocator_type& alloc = allocator_type())
+            : words(word_allocator_type(alloc)), length()
+        {
+            this->assign(first, last);
+        }
+
+        vector(const vector& that)
+            : words(that.words), length(that.length) {}
+
+#if __cplusplus >= 201103L
+        vector(vector&& that) noexcept
+            : words(ft::move(that.words)), length(that.length)
+        {
+            that.length = size_type();
+        }
+#endif
+
+        ~vector() {}
+
+        vector& operator=(const vector& that)
+        {
+            if (this != &that)
+            {
+                this->words = that.words;
+                this->length = that.length;
+            }
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        vector& operator=(vector&& that)
+        {
+            if (this != &that)
+            {
+                this->words = ft::move(that.words);
+                this->length = that.length;
+                that.length = size_type();
+            }
+            return *this;
+        }
+#endif
+
+    protected:
+        static size_type word_count(size_type bits) { return bits / width + (bits % width != 0); }
+
+        // the n low bits set, n <= width
+        static word_type low_mask(size_type n) { return n == size_type(width) ? ~word_type() : (word_type(1) << n) - 1; }
+
+        // n <= width bits starting at bit pos
+        static word_type read_bits(const word_type* w, size_type pos, size_type n)
+        {
+            size_type i = pos / width;
+            size_type offset = pos % width;
+            word_type value = w[i] >> offset;
+            if (offset != 0 && offset + n > size_type(width))
+            {
+                value |= w[i + 1] << (width - offset);
+            }
+            return value & vector::low_mask(n);
+        }
+
+        static void write_bits(word_type* w, size_type pos, size_type n, word_type value)
+        {
+            size_type i = pos / width;
+            size_type offset = pos % width;
+            word_type mask = vector::low_mask(n);
+            value &= mask;
+            w[i] = (w[i] & ~(mask << offset)) | (value << offset);
+            if (offset != 0 && offset + n > size_type(width))
+            {
+                size_type shift = width - offset;
+                w[i + 1] = (w[i + 1] & ~(mask >> shift)) | (value >> shift);
+            }
+        }
+
+        // [src, src + n) -> [dest, dest + n) a word at a time, the ranges may overlap
+        void move_bits(size_type dest, size_type src, size_type n)
+        {
+            word_type* w = this->words.data();
+            if (dest < src)
+            {
+                for (size_type done = 0; done < n; done += width)
+                {
+                    size_type k = n - done < size_type(width) ? n - done : size_type(width);
+                    vector::write_bits(w, dest + done, k, vector::read_bits(w, src + done, k));
+                }
+            }
+            else if (src < dest)
+            {
+                for (size_type left = n; left != 0;)
+                {
+                    size_type k = left < size_type(width) ? left : size_type(width);
+                    left -= k;
+                    vector::write_bits(w, dest + left, k, vector::read_bits(w, src + left, k));
+                }
+            }
+        }
+
+        void fill_bits(size_type first, size_type last, bool value)
+        {
+            word_type* w = this->words.data();
+            word_type fill = value ? ~word_type() : word_type();
+            while (first < last)
+            {
+                size_type k = width - first % width;
+                k = last - first < k ? last - first : k;
+                vector::write_bits(w, first, k, fill);
+                first += k;
+            }
+        }
+
+        void clear_tail()
+        {
+            if (this->length % width != 0)
+            {
+                this->words.back() &= vector::low_mask(this->length % width);
+            }
+        }
+
+        // the new bits are 0
+        void grow_to(size_type count, const char* caller)
+        {
+            if (count > this->max_size())
+            {
+                throw ft::length_error(caller);
+            }
+            this->words.resize(vector::word_count(count), word_type());
+            this->length = count;
+        }
+
+        void shrink_to(size_type count)
+        {
+            this->words.resize(vector::word_count(count));
+            this->length = count;
+            this->clear_tail();
+        }
+
+        void set(size_type pos, bool value)
+        {
+            word_type mask = word_type(1) << (pos % width);
+            if (value)
+            {
+                this->words[pos / width] |= mask;
+            }
+            else
+            {
+                this->words[pos / width] &= ~mask;
+            }
+        }
+
+        // room for count bits at index, their values are unspecified until written
+        void open_gap(size_type index, size_type count)
+        {
+            size_type length = this->size();
+            if (this->max_size() - length < count)
+            {
+                throw ft::length_error("vector::insert");
+            }
+            this->grow_to(length + count, "vector::insert");
+            this->move_bits(index + count, index, length - index);
+        }
+
+    public:
+        void assign(size_type count, const value_type& value)
+        {
+            if (count > this->max_size())
+            {
+                throw ft::length_error("vector::assign");
+            }
+            this->words.assign(vector::word_count(count), value ? ~word_type() : word_type());
+            this->length = count;
+            this->clear_tail();
+        }
+
+        template <typename UIter>
+        // void assign(UIter first, UIter last)
+        typename ft::enable_if<ft::is_forward_iterator<UIter>::value, void>::type assign(UIter first, UIter last)
+        {
+            size_type count = ft::distance(first, last);
+            if (count > this->max_size())
+            {
+                throw ft::length_error("vector::assign");
+            }
+            this->words.assign(vector::word_count(count), word_type());
+            this->length = count;
+            for (size_type i = 0; i != count; ++i)
+            {
+                if (*first)
+                {
+                    this->words[i / width] |= word_type(1) << (i % width);
+                }
+                ++first;
+            }
+        }
+
+        template <typename UIter>
+        // void assign(UIter first, UIter last)
+        typename ft::enable_if<!ft::is_forward_iterator<UIter>::value && ft::is_input_iterator<UIter>::value, void>::type assign(UIter first, UIter last)
+        {
+            this->clear();
+            for (; first != last; ++first)
+            {
+                this->push_back(*first);
+            }
+        }
+
+    public:
+        allocator_type get_allocator() const { return allocator_type(this->words.get_allocator()); }
+
+    public:
+        reference at(size_type pos)
+        {
+            if (!(pos < this->size()))
+            {
+                throw ft::out_of_range("vector::at");
+            }
+            return (*this)[pos];
+        }
+        const_reference at(size_type pos) const
+        {
+            if (!(pos < this->size()))
+            {
+                throw ft::out_of_range("vector::at");
+            }
+            return (*this)[pos];
+        }
+
+        reference operator[](size_type pos) { return reference(this->words.data() + pos / width, word_type(1) << (pos % width)); }
+        const_reference operator[](size_type pos) const { return (this->words[pos / width] >> (pos % width) & 1) != 0; }
+
+        reference front() { return (*this)[0]; }
+        const_reference front() const { return (*this)[0]; }
+        reference back() { return (*this)[this->length - 1]; }
+        const_reference back() const { return (*this)[this->length - 1]; }
+
+    public:
+        iterator begin() { return iterator(this->words.data(), 0); }
+        const_iterator begin() const { return const_iterator(this->words.data(), 0); }
+        iterator end() { return iterator(this->words.data() + this->length / width, this->length % width); }
+        const_iterator end() const { return const_iterator(this->words.data() + this->length / width, this->length % width); }
+        reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+        reverse_iterator rend() { return reverse_iterator(this->begin()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+    public:
+        bool empty() const { return this->size() == size_type(); }
+        size_type size() const { return this->length; }
+        size_type max_size() const
+        {
+            // iterator distances must fit in difference_type
+            size_type words = this->words.max_size();
+            size_type limit = std::numeric_limits<difference_type>::max();
+            return words > limit / width ? limit : words * width;
+        }
+
+        void reserve(size_type new_cap)
+        {
+            if (new_cap > this->max_size())
+            {
+                throw ft::length_error("vector::reserve");
+            }
+            this->words.reserve(vector::word_count(new_cap));
+        }
+
+        size_type capacity() const { return this->words.capacity() * width; }
+
+        void shrink_to_fit()
+        {
+            this->words.shrink_to_fit();
+        }
+
+    public:
+        void clear()
+        {
+            this->words.clear();
+            this->length = size_type();
+        }
+
+        iterator insert(const_iterator pos, const value_type& value)
+        {
+            size_type index = pos - this->begin();
+            this->insert(pos, size_type(1), value);
+            return this->begin() + index;
+        }
+
+        void insert(const_iterator pos, size_type count, const value_type& value)
+        {
+            size_type index = pos - this->begin();
+            bool copy = value;
+            this->open_gap(index, count);
+            this->fill_bits(index, index + count, copy);
+        }
+
+        template <typename UIter>
+        // void insert(const_iterator pos, UIter first, UIter last)
+        typename ft::enable_if<ft::is_forward_iterator<UIter>::value, void>::type insert(const_iterator pos, UIter first, UIter last)
+        {
+            size_type index = pos - this->begin();
+            size_type count = ft::distance(first, last);
+            this->open_gap(index, count);
+            for (size_type i = index; i != index + count; ++i)
+            {
+                this->set(i, *first);
+                ++first;
+            }
+        }
+
+        template <typename UIter>
+        // void insert(const_iterator pos, UIter first, UIter last)
+        typename ft::enable_if<!ft::is_forward_iterator<UIter>::value && ft::is_input_iterator<UIter>::value, void>::type insert(const_iterator pos, UIter first, UIter last)
+        {
+            // the length is only known once the range is read, it is buffered and inserted in one go
+            vector buffer(first, last, this->get_allocator());
+            this->insert(pos, buffer.begin(), buffer.end());
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return this->erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            size_type index = first - this->begin();
+            size_type count = last - first;
+            this->move_bits(index, index + count, this->length - index - count);
+            this->shrink_to(this->length - count);
+            return this->begin() + index;
+        }
+
+        void push_back(const value_type& value)
+        {
+            if (this->length % width == 0)
+            {
+                if (this->length == this->max_size())
+                {
+                    throw ft::length_error("vector::push_back");
+                }
+                this->words.push_back(word_type());
+            }
+            this->length++;
+            this->set(this->length - 1, value);
+        }
+
+#if __cplusplus >= 201103L
+        template <typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
+        {
+            return this->insert(pos, value_type(ft::forward<Args>(args)...));
+        }
+
+        template <typename... Args>
+        void emplace_back(Args&&... args)
+        {
+            this->push_back(value_type(ft::forward<Args>(args)...));
+        }
+#endif
+
+        void pop_back()
+        {
+            this->length--;
+            this->set(this->length, false);
+            if (this->length % width == 0)
+            {
+                this->words.pop_back();
+            }
+        }
+
+        void resize(size_type count, value_type value = value_type())
+        {
+            size_type size = this->size();
+            if (count > size)
+            {
+                this->grow_to(count, "vector::resize");
+                if (value)
+                {
+                    this->fill_bits(size, count, true);
+                }
+            }
+            else if (count < size)
+            {
+                this->shrink_to(count);
+            }
+        }
+
+        void swap(vector& that)
+        {
+            this->words.swap(that.words);
+            ft::swap(this->length, that.length);
+        }
+
+        static void swap(reference a, reference b)
+        {
+            ft::swap(a, b);
+        }
+
+    public:
+        void flip()
+        {
+            for (typename storage_type::iterator it = this->words.begin(); it != this->words.end(); ++it)
+            {
+                *it = ~*it;
+            }
+            this->clear_tail();
+        }
+
+        // number of set bits
+        size_type count() const
+        {
+            size_type n = 0;
+            for (typename storage_type::const_iterator it = this->words.begin(); it != this->words.end(); ++it)
+            {
+                n += ft::_internal::_bit_popcount(*it);
+            }
+            return n;
+        }
+
+        // index of the first set bit, size() when there is none
+        size_type find_first() const
+        {
+            return this->find_next(0);
+        }
+
+        // index of the first set bit at or after pos, size() when there is none
+        size_type find_next(size_type pos) const
+        {
+            if (pos >= this->length)
+            {
+                return this->length;
+            }
+            size_type i = pos / width;
+            word_type w = this->words[i] & ~vector::low_mask(pos % width);
+            for (;;)
+            {
+                if (w != 0)
+                {
+                    return i * width + ft::_internal::_bit_lowest(w);
+                }
+                if (++i == this->words.size())
+                {
+                    return this->length;
+                }
+                w = this->words[i];
+            }
+        }
+
+        // Bitwise operators combine the bits of both vectors up to this size(),
+        // that is read as cut or padded with false to the same length.
+        vector& operator&=(const vector& that)
+        {
+            size_type n = this->words.size() < that.words.size() ? this->words.size() : that.words.size();
+            for (size_type i = 0; i != n; ++i)
+            {
+                this->words[i] &= that.words[i];
+            }
+            for (size_type i = n; i != this->words.size(); ++i)
+            {
+                this->words[i] = word_type();
+            }
+            return *this;
+        }
+
+        vector& operator|=(const vector& that)
+        {
+            size_type n = this->words.size() < that.words.size() ? this->words.size() : that.words.size();
+            for (size_type i = 0; i != n; ++i)
+            {
+                this->words[i] |= that.words[i];
+            }
+            this->clear_tail();
+            return *this;
+        }
+
+        vector& operator^=(const vector& that)
+        {
+            size_type n = this->words.size() < that.words.size() ? this->words.size() : that.words.size();
+            for (size_type i = 0; i != n; ++i)
+            {
+                this->words[i] ^= that.words[i];
+            }
+            this->clear_tail();
+            return *this;
+        }
+
+        friend vector operator&(const vector& lhs, const vector& rhs)
+        {
+            vector result = lhs;
+            return result &= rhs;
+        }
+
+        friend vector operator|(const vector& lhs, const vector& rhs)
+        {
+            vector result = lhs;
+            return result |= rhs;
+        }
+
+        friend vector operator^(const vector& lhs, const vector& rhs)
+        {
+            vector result = lhs;
+            return result ^= rhs;
+        }
+
+    public:
+        friend bool operator==(const vector& lhs, const vector& rhs)
+        {
+            return lhs.size() == rhs.size() && ft::equal(lhs.words.begin(), lhs.words.end(), rhs.words.begin());
+        }
+
+        friend bool operator!=(const vector& lhs, const vector& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const vector& lhs, const vector& rhs)
+        {
+            // the lowest differing bit of the first differing word decides
+            size_type n = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+            size_type words = vector::word_count(n);
+            for (size_type i = 0; i != words; ++i)
+            {
+                word_type diff = lhs.words[i] ^ rhs.words[i];
+                if (i == n / width)
+                {
+                    diff &= vector::low_mask(n % width);
+                }
+                if (diff != 0)
+                {
+                    return (rhs.words[i] & (diff & (~diff + 1))) != 0;
+                }
+            }
+            return lhs.size() < rhs.size();
+        }
+
+        friend bool operator<=(const vector& lhs, const vector& rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>(const vector& lhs, const vector& rhs)
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator>=(const vector& lhs, const vector& rhs)
+        {
+            return !(lhs < rhs);
+        }
+    };
+}
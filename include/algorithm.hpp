@@ -5,5 +5,10 @@
 
 #include "algorithm/copy.hpp"
 #include "algorithm/equal.hpp"
+#include "algorithm/heap.hpp"
 #include "algorithm/lexicographical_compare.hpp"
+#include "algorithm/move.hpp"
+#include "algorithm/reverse.hpp"
+#include "algorithm/rotate.hpp"
+#include "algorithm/sort.hpp"
 #include "algorithm/swap.hpp"
@@ -4,32 +4,104 @@
 #pragma once
 
 #include "../iterator.hpp"
+#include "../iterator/_pointer_iterator.hpp"
+#include "../type_traits.hpp"
+
+#include <cstddef>
+#include <cstring>
 
 namespace ft
 {
-    // TODO: if is_trivially_copyable then use std::memmove
-    template <typename TIter, typename UIter>
-    inline UIter copy(TIter first, TIter last, UIter pos)
+    namespace _internal
     {
-        UIter it = pos;
-        for (TIter val = first; val != last; ++val)
+        // Default
+        template <typename TSource, typename TDest>
+        struct _is_bitwise_copyable_raw : ft::false_type
+        {
+        };
+
+        // Same element type, contiguous
+        template <typename T>
+        struct _is_bitwise_copyable_raw<T*, T*> : ft::is_trivially_copyable<T>
+        {
+        };
+        template <typename T>
+        struct _is_bitwise_copyable_raw<const T*, T*> : ft::is_trivially_copyable<T>
+        {
+        };
+        template <typename T>
+        struct _is_bitwise_copyable_raw<const T*, const T*> : ft::false_type
+        {
+        };
+
+        template <typename TSource, typename TDest>
+        struct is_bitwise_copyable
+            : _is_bitwise_copyable_raw<
+                  typename _unwrap_iterator<TSource>::type,
+                  typename _unwrap_iterator<TDest>::type>
+        {
+        };
+
+        template <typename TIter, typename UIter>
+        inline UIter copy(TIter first, TIter last, UIter pos, ft::false_type)
+        {
+            UIter it = pos;
+            for (TIter val = first; val != last; ++val)
+            {
+                *it = *val;
+                ++it;
+            }
+            return it;
+        }
+
+        template <typename TIter, typename UIter>
+        inline UIter copy(TIter first, TIter last, UIter pos, ft::true_type)
         {
-            *it = *val;
-            ++it;
+            typename _unwrap_iterator<TIter>::type src = _unwrap_iterator<TIter>::unwrap(first);
+            std::ptrdiff_t n = _unwrap_iterator<TIter>::unwrap(last) - src;
+            if (n > 0)
+            {
+                std::memmove(_unwrap_iterator<UIter>::unwrap(pos), src, n * sizeof(*src));
+            }
+            return pos + n;
+        }
+
+        template <typename TIter, typename UIter>
+        inline UIter copy_backward(TIter first, TIter last, UIter pos, ft::false_type)
+        {
+            UIter it = pos;
+            for (TIter val = last; val != first;)
+            {
+                --val;
+                --it;
+                *it = *val;
+            }
+            return it;
+        }
+
+        template <typename TIter, typename UIter>
+        inline UIter copy_backward(TIter first, TIter last, UIter pos, ft::true_type)
+        {
+            typename _unwrap_iterator<TIter>::type src = _unwrap_iterator<TIter>::unwrap(first);
+            std::ptrdiff_t n = _unwrap_iterator<TIter>::unwrap(last) - src;
+            UIter it = pos - n;
+            if (n > 0)
+            {
+                std::memmove(_unwrap_iterator<UIter>::unwrap(it), src, n * sizeof(*src));
+            }
+            return it;
         }
-        return it;
+    }
+
+    template <typename TIter, typename UIter>
+    inline UIter copy(TIter first, TIter last, UIter pos)
+    {
+        return _internal::copy(first, last, pos, typename _internal::is_bitwise_copyable<TIter, UIter>::type());
     }
 
     template <typename TIter, typename UIter>
     inline UIter copy_backward(TIter first, TIter last, UIter pos)
     {
-        UIter it = pos;
-        for (TIter val = last; val != first;)
-        {
-            --val;
-            --it;
-            *it = *val;
-        }
-        return it;
+        return _internal::copy_backward(first, last, pos, typename _internal::is_bitwise_copyable<TIter, UIter>::type());
     }
 }
@@ -3,22 +3,77 @@
 
 #pragma once
 
+#include "../iterator/_pointer_iterator.hpp"
+#include "../type_traits.hpp"
+
+#include <cstddef>
+#include <cstring>
+
 namespace ft
 {
+    namespace _internal
+    {
+        // Default
+        template <typename TFirst, typename TSecond>
+        struct _is_bitwise_comparable_raw : ft::false_type
+        {
+        };
+
+        // Same integral element type, contiguous: equal values have equal bytes
+        template <typename T>
+        struct _is_bitwise_comparable_raw<T*, T*> : ft::is_integral<T>
+        {
+        };
+        template <typename T>
+        struct _is_bitwise_comparable_raw<const T*, T*> : ft::is_integral<T>
+        {
+        };
+        template <typename T>
+        struct _is_bitwise_comparable_raw<T*, const T*> : ft::is_integral<T>
+        {
+        };
+        template <typename T>
+        struct _is_bitwise_comparable_raw<const T*, const T*> : ft::is_integral<T>
+        {
+        };
+
+        template <typename TFirst, typename TSecond>
+        struct is_bitwise_comparable
+            : _is_bitwise_comparable_raw<
+                  typename _unwrap_iterator<TFirst>::type,
+                  typename _unwrap_iterator<TSecond>::type>
+        {
+        };
+
+        template <typename TIterFirst, typename TIterSecond>
+        inline bool equal(TIterFirst first1, TIterFirst last1, TIterSecond first2, ft::false_type)
+        {
+            for (; first1 != last1; ++first1, ++first2)
+            {
+                if (!(*first1 == *first2))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename TIterFirst, typename TIterSecond>
+        inline bool equal(TIterFirst first1, TIterFirst last1, TIterSecond first2, ft::true_type)
+        {
+            typename _unwrap_iterator<TIterFirst>::type src = _unwrap_iterator<TIterFirst>::unwrap(first1);
+            std::ptrdiff_t n = _unwrap_iterator<TIterFirst>::unwrap(last1) - src;
+            return n <= 0 || std::memcmp(src, _unwrap_iterator<TIterSecond>::unwrap(first2), n * sizeof(*src)) == 0;
+        }
+    }
+
     template <typename TIterFirst, typename TIterSecond>
     inline bool
     equal(
         TIterFirst first1, TIterFirst last1,
         TIterSecond first2)
     {
-        for (; first1 != last1; ++first1, ++first2)
-        {
-            if (!(*first1 == *first2))
-            {
-                return false;
-            }
-        }
-        return true;
+        return _internal::equal(first1, last1, first2, typename _internal::is_bitwise_comparable<TIterFirst, TIterSecond>::type());
     }
 
     template <typename TIterFirst, typename TIterSecond, typename TBinaryPredicate>
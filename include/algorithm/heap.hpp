@@ -0,0 +1,101 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "sort.hpp"
+
+#include "../functional.hpp"
+#include "../iterator.hpp"
+
+namespace ft
+{
+    // Max heaps over random access ranges, on the same sift routines as heap_sort.
+    template <typename TIter, typename TComp>
+    void make_heap(TIter first, TIter last, TComp comp)
+    {
+        typedef typename ft::iterator_traits<TIter>::difference_type difference_type;
+        typedef typename ft::iterator_traits<TIter>::value_type value_type;
+
+        difference_type length = last - first;
+        if (length < 2)
+        {
+            return;
+        }
+        for (difference_type parent = (length - 2) / 2;; --parent)
+        {
+            value_type value(_internal::_move_or_copy(first[parent]));
+            _internal::adjust_heap(first, parent, length, value, comp);
+            if (parent == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    template <typename TIter>
+    inline void make_heap(TIter first, TIter last)
+    {
+        ft::make_heap(first, last, ft::less<typename ft::iterator_traits<TIter>::value_type>());
+    }
+
+    // [first, last - 1) is a heap, the last element joins it.
+    template <typename TIter, typename TComp>
+    void push_heap(TIter first, TIter last, TComp comp)
+    {
+        typedef typename ft::iterator_traits<TIter>::difference_type difference_type;
+        typedef typename ft::iterator_traits<TIter>::value_type value_type;
+
+        difference_type length = last - first;
+        if (length < 2)
+        {
+            return;
+        }
+        value_type value(_internal::_move_or_copy(first[length - 1]));
+        _internal::push_heap(first, length - 1, difference_type(), value, comp);
+    }
+
+    template <typename TIter>
+    inline void push_heap(TIter first, TIter last)
+    {
+        ft::push_heap(first, last, ft::less<typename ft::iterator_traits<TIter>::value_type>());
+    }
+
+    // Moves the largest element to last - 1, the rest stays a heap.
+    template <typename TIter, typename TComp>
+    void pop_heap(TIter first, TIter last, TComp comp)
+    {
+        typedef typename ft::iterator_traits<TIter>::difference_type difference_type;
+        typedef typename ft::iterator_traits<TIter>::value_type value_type;
+
+        if (last - first < 2)
+        {
+            return;
+        }
+        --last;
+        value_type value(_internal::_move_or_copy(*last));
+        *last = _internal::_move_or_copy(*first);
+        _internal::adjust_heap(first, difference_type(), difference_type(last - first), value, comp);
+    }
+
+    template <typename TIter>
+    inline void pop_heap(TIter first, TIter last)
+    {
+        ft::pop_heap(first, last, ft::less<typename ft::iterator_traits<TIter>::value_type>());
+    }
+
+    template <typename TIter, typename TComp>
+    void sort_heap(TIter first, TIter last, TComp comp)
+    {
+        for (; last - first > 1; --last)
+        {
+            ft::pop_heap(first, last, comp);
+        }
+    }
+
+    template <typename TIter>
+    inline void sort_heap(TIter first, TIter last)
+    {
+        ft::sort_heap(first, last, ft::less<typename ft::iterator_traits<TIter>::value_type>());
+    }
+}
@@ -3,22 +3,87 @@
 
 #pragma once
 
+#include "equal.hpp"
+
+#include "../iterator/_pointer_iterator.hpp"
+#include "../type_traits.hpp"
+
+#include <cstddef>
+#include <cstring>
+
 namespace ft
 {
+    namespace _internal
+    {
+        enum
+        {
+            // memcmp finds the block holding the first mismatch, the elements of that block are then compared
+            _compare_block_bytes = 256
+        };
+
+        // memcmp orders unsigned bytes as their values
+        template <typename T>
+        struct _is_byte_ordered
+            : ft::integral_constant<bool, sizeof(T) == 1 && (T(-1) > T(0))>
+        {
+        };
+
+        template <typename TIterFirst, typename TIterSecond>
+        inline bool lexicographical_compare(TIterFirst first1, TIterFirst last1, TIterSecond first2, TIterSecond last2, ft::false_type)
+        {
+            for (; (first1 != last1) && (first2 != last2); ++first1, (void)++first2)
+            {
+                if (*first1 < *first2)
+                    return true;
+                if (*first2 < *first1)
+                    return false;
+            }
+            return (first1 == last1) && (first2 != last2);
+        }
+
+        template <typename TIterFirst, typename TIterSecond>
+        inline bool lexicographical_compare(TIterFirst first1, TIterFirst last1, TIterSecond first2, TIterSecond last2, ft::true_type)
+        {
+            typename _unwrap_iterator<TIterFirst>::type lhs = _unwrap_iterator<TIterFirst>::unwrap(first1);
+            typename _unwrap_iterator<TIterSecond>::type rhs = _unwrap_iterator<TIterSecond>::unwrap(first2);
+            std::ptrdiff_t lhs_count = _unwrap_iterator<TIterFirst>::unwrap(last1) - lhs;
+            std::ptrdiff_t rhs_count = _unwrap_iterator<TIterSecond>::unwrap(last2) - rhs;
+            std::size_t n = static_cast<std::size_t>(lhs_count < rhs_count ? lhs_count : rhs_count);
+            if (_is_byte_ordered<typename ft::remove_cv<typename ft::iterator_traits<TIterFirst>::value_type>::type>::value)
+            {
+                int order = n != 0 ? std::memcmp(lhs, rhs, n) : 0;
+                if (order != 0)
+                {
+                    return order < 0;
+                }
+                return lhs_count < rhs_count;
+            }
+            const std::size_t block = _compare_block_bytes / sizeof(*lhs);
+            for (std::size_t i = 0; i < n; i += block)
+            {
+                std::size_t k = n - i < block ? n - i : block;
+                if (std::memcmp(lhs + i, rhs + i, k * sizeof(*lhs)) != 0)
+                {
+                    for (;; ++i)
+                    {
+                        if (lhs[i] != rhs[i])
+                        {
+                            return lhs[i] < rhs[i];
+                        }
+                    }
+                }
+            }
+            return lhs_count < rhs_count;
+        }
+    }
+
     template <typename TIterFirst, typename TIterSecond>
     inline bool
     lexicographical_compare(
         TIterFirst first1, TIterFirst last1,
         TIterSecond first2, TIterSecond last2)
     {
-        for (; (first1 != last1) && (first2 != last2); ++first1, (void)++first2)
-        {
-            if (*first1 < *first2)
-                return true;
-            if (*first2 < *first1)
-                return false;
-        }
-        return (first1 == last1) && (first2 != last2);
+        return _internal::lexicographical_compare(first1, last1, first2, last2, typename _internal::is_bitwise_comparable<TIterFirst, TIterSecond>::type());
     }
 
     template <typename TIterFirst, typename TIterSecond, typename TComp>
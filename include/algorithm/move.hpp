@@ -0,0 +1,94 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "copy.hpp"
+
+#include "../utility/move.hpp"
+
+namespace ft
+{
+    // Without rvalue references (C++98) moving a range degrades to copying it.
+#if __cplusplus >= 201103L
+    namespace _internal
+    {
+        template <typename TIter, typename UIter>
+        inline UIter move(TIter first, TIter last, UIter pos, ft::false_type)
+        {
+            UIter it = pos;
+            for (TIter val = first; val != last; ++val)
+            {
+                *it = ft::move(*val);
+                ++it;
+            }
+            return it;
+        }
+
+        template <typename TIter, typename UIter>
+        inline UIter move(TIter first, TIter last, UIter pos, ft::true_type)
+        {
+            return _internal::copy(first, last, pos, ft::true_type());
+        }
+
+        template <typename TIter, typename UIter>
+        inline UIter move_backward(TIter first, TIter last, UIter pos, ft::false_type)
+        {
+            UIter it = pos;
+            for (TIter val = last; val != first;)
+            {
+                --val;
+                --it;
+                *it = ft::move(*val);
+            }
+            return it;
+        }
+
+        template <typename TIter, typename UIter>
+        inline UIter move_backward(TIter first, TIter last, UIter pos, ft::true_type)
+        {
+            return _internal::copy_backward(first, last, pos, ft::true_type());
+        }
+
+        // a single value, for algorithms that shuffle elements through a hole
+        template <typename T>
+        inline typename ft::remove_reference<T>::type&& _move_or_copy(T&& value) noexcept
+        {
+            return ft::move(value);
+        }
+    }
+
+    template <typename TIter, typename UIter>
+    inline UIter move(TIter first, TIter last, UIter pos)
+    {
+        return _internal::move(first, last, pos, typename _internal::is_bitwise_copyable<TIter, UIter>::type());
+    }
+
+    template <typename TIter, typename UIter>
+    inline UIter move_backward(TIter first, TIter last, UIter pos)
+    {
+        return _internal::move_backward(first, last, pos, typename _internal::is_bitwise_copyable<TIter, UIter>::type());
+    }
+#else
+    namespace _internal
+    {
+        template <typename T>
+        inline const T& _move_or_copy(const T& value)
+        {
+            return value;
+        }
+    }
+
+    template <typename TIter, typename UIter>
+    inline UIter move(TIter first, TIter last, UIter pos)
+    {
+        return ft::copy(first, last, pos);
+    }
+
+    template <typename TIter, typename UIter>
+    inline UIter move_backward(TIter first, TIter last, UIter pos)
+    {
+        return ft::copy_backward(first, last, pos);
+    }
+#endif
+}
@@ -0,0 +1,19 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "swap.hpp"
+
+namespace ft
+{
+    template <typename TIter>
+    inline void reverse(TIter first, TIter last)
+    {
+        while (first != last && first != --last)
+        {
+            ft::iter_swap(first, last);
+            ++first;
+        }
+    }
+}
@@ -0,0 +1,54 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "swap.hpp"
+
+namespace ft
+{
+    // Swaps the shorter block into place and repeats on the rest, one forward pass
+    // over each block. Returns where the first element ended up.
+    template <typename TIter>
+    TIter rotate(TIter first, TIter middle, TIter last)
+    {
+        if (first == middle)
+        {
+            return last;
+        }
+        if (middle == last)
+        {
+            return first;
+        }
+
+        TIter next = middle;
+        do
+        {
+            ft::iter_swap(first, next);
+            ++first;
+            ++next;
+            if (first == middle)
+            {
+                middle = next;
+            }
+        } while (next != last);
+
+        TIter result = first;
+        next = middle;
+        while (next != last)
+        {
+            ft::iter_swap(first, next);
+            ++first;
+            ++next;
+            if (first == middle)
+            {
+                middle = next;
+            }
+            else if (next == last)
+            {
+                next = middle;
+            }
+        }
+        return result;
+    }
+}
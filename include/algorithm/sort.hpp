@@ -0,0 +1,216 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "copy.hpp"
+#include "move.hpp"
+#include "swap.hpp"
+
+#include "../functional.hpp"
+#include "../iterator.hpp"
+
+namespace ft
+{
+    namespace _internal
+    {
+        enum
+        {
+            _sort_threshold = 16
+        };
+
+        template <typename TIter, typename TComp>
+        void insertion_sort(TIter first, TIter last, TComp& comp)
+        {
+            if (first == last)
+            {
+                return;
+            }
+            for (TIter it = first + 1; it != last; ++it)
+            {
+                typename ft::iterator_traits<TIter>::value_type value(_internal::_move_or_copy(*it));
+                if (comp(value, *first))
+                {
+                    ft::move_backward(first, it, it + 1);
+                    *first = _internal::_move_or_copy(value);
+                }
+                else
+                {
+                    TIter hole = it;
+                    for (TIter prev = hole - 1; comp(value, *prev); --prev)
+                    {
+                        *hole = _internal::_move_or_copy(*prev);
+                        hole = prev;
+                    }
+                    *hole = _internal::_move_or_copy(value);
+                }
+            }
+        }
+
+        // BEGIN Heap
+        // value is the caller's copy of the element taken out of the hole, it is moved into place
+        template <typename TIter, typename TDistance, typename T, typename TComp>
+        void push_heap(TIter first, TDistance hole, TDistance top, T& value, TComp& comp)
+        {
+            TDistance parent = (hole - 1) / 2;
+            while (hole > top && comp(first[parent], value))
+            {
+                first[hole] = _internal::_move_or_copy(first[parent]);
+                hole = parent;
+                parent = (hole - 1) / 2;
+            }
+            first[hole] = _internal::_move_or_copy(value);
+        }
+
+        template <typename TIter, typename TDistance, typename T, typename TComp>
+        void adjust_heap(TIter first, TDistance hole, TDistance length, T& value, TComp& comp)
+        {
+            const TDistance top = hole;
+            TDistance child = hole;
+            while (child < (length - 1) / 2)
+            {
+                child = 2 * (child + 1);
+                if (comp(first[child], first[child - 1]))
+                {
+                    --child;
+                }
+                first[hole] = _internal::_move_or_copy(first[child]);
+                hole = child;
+            }
+            if ((length & 1) == 0 && child == (length - 2) / 2)
+            {
+                child = 2 * (child + 1);
+                first[hole] = _internal::_move_or_copy(first[child - 1]);
+                hole = child - 1;
+            }
+            _internal::push_heap(first, hole, top, value, comp);
+        }
+
+        template <typename TIter, typename TComp>
+        void heap_sort(TIter first, TIter last, TComp& comp)
+        {
+            typedef typename ft::iterator_traits<TIter>::difference_type difference_type;
+            typedef typename ft::iterator_traits<TIter>::value_type value_type;
+
+            difference_type length = last - first;
+            if (length < 2)
+            {
+                return;
+            }
+            for (difference_type parent = (length - 2) / 2;; --parent)
+            {
+                value_type value(_internal::_move_or_copy(first[parent]));
+                _internal::adjust_heap(first, parent, length, value, comp);
+                if (parent == 0)
+                {
+                    break;
+                }
+            }
+            while (last - first > 1)
+            {
+                --last;
+                value_type value(_internal::_move_or_copy(*last));
+                *last = _internal::_move_or_copy(*first);
+                _internal::adjust_heap(first, difference_type(), difference_type(last - first), value, comp);
+            }
+        }
+        // END Heap
+
+        template <typename TIter, typename TComp>
+        void move_median_to_first(TIter result, TIter a, TIter b, TIter c, TComp& comp)
+        {
+            if (comp(*a, *b))
+            {
+                if (comp(*b, *c))
+                {
+                    ft::swap(*result, *b);
+                }
+                else if (comp(*a, *c))
+                {
+                    ft::swap(*result, *c);
+                }
+                else
+                {
+                    ft::swap(*result, *a);
+                }
+            }
+            else if (comp(*a, *c))
+            {
+                ft::swap(*result, *a);
+            }
+            else if (comp(*b, *c))
+            {
+                ft::swap(*result, *c);
+            }
+            else
+            {
+                ft::swap(*result, *b);
+            }
+        }
+
+        // pivot is *first, the median of three guards both scans
+        template <typename TIter, typename TComp>
+        TIter partition_pivot(TIter first, TIter last, TComp& comp)
+        {
+            _internal::move_median_to_first(first, first + 1, first + (last - first) / 2, last - 1, comp);
+            TIter pivot = first;
+            ++first;
+            for (;;)
+            {
+                while (comp(*first, *pivot))
+                {
+                    ++first;
+                }
+                --last;
+                while (comp(*pivot, *last))
+                {
+                    --last;
+                }
+                if (!(first < last))
+                {
+                    return first;
+                }
+                ft::swap(*first, *last);
+                ++first;
+            }
+        }
+
+        template <typename TIter, typename TSize, typename TComp>
+        void introsort_loop(TIter first, TIter last, TSize depth_limit, TComp& comp)
+        {
+            while (last - first > _sort_threshold)
+            {
+                if (depth_limit == 0)
+                {
+                    _internal::heap_sort(first, last, comp);
+                    return;
+                }
+                --depth_limit;
+                TIter cut = _internal::partition_pivot(first, last, comp);
+                _internal::introsort_loop(cut, last, depth_limit, comp);
+                last = cut;
+            }
+        }
+    }
+
+    // Introsort: quicksort with median of three, heapsort past 2 log n levels, insertion sort for short runs.
+    template <typename TIter, typename TComp>
+    inline void sort(TIter first, TIter last, TComp comp)
+    {
+        typedef typename ft::iterator_traits<TIter>::difference_type difference_type;
+
+        difference_type depth_limit = difference_type();
+        for (difference_type n = last - first; n > 1; n >>= 1)
+        {
+            depth_limit += 2;
+        }
+        _internal::introsort_loop(first, last, depth_limit, comp);
+        _internal::insertion_sort(first, last, comp);
+    }
+
+    template <typename TIter>
+    inline void sort(TIter first, TIter last)
+    {
+        ft::sort(first, last, ft::less<typename ft::iterator_traits<TIter>::value_type>());
+    }
+}
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include "../iterator/iterator_traits.hpp"
+#include "../utility/move.hpp"
+
 #include <cstddef>
 
 namespace ft
@@ -12,9 +15,15 @@ namespace ft
     swap(
         T& a, T& b)
     {
+#if __cplusplus >= 201103L
+        T x(ft::move(a));
+        a = ft::move(b);
+        b = ft::move(x);
+#else
         T x(a);
         a = b;
         b = x;
+#endif
     }
 
     template <typename T, std::size_t N>
@@ -27,4 +36,20 @@ namespace ft
             swap(a[i], b[i]);
         }
     }
+
+    // Exchanges the values behind two iterators, moving rather than copying when rvalue references exist.
+    template <typename TIter>
+    inline void iter_swap(TIter a, TIter b)
+    {
+#if __cplusplus >= 201103L
+        typename ft::iterator_traits<TIter>::value_type value(ft::move(*a));
+        *a = ft::move(*b);
+        *b = ft::move(value);
+#else
+        // through value_type rather than ft::swap, a proxy reference is an rvalue
+        typename ft::iterator_traits<TIter>::value_type value(*a);
+        *a = *b;
+        *b = value;
+#endif
+    }
 }
@@ -0,0 +1,1124 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "memory.hpp"
+#include "stdexcept.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+#include <cstddef>
+#include <limits>
+
+namespace ft
+{
+    namespace _internal
+    {
+        enum
+        {
+            _deque_block_bytes = 512,
+            _deque_min_block_size = 8,
+            _deque_initial_map_size = 8
+        };
+
+        // as many elements as fit in _deque_block_bytes, but never fewer than _deque_min_block_size
+        template <typename T>
+        struct _deque_block_size
+        {
+            static const std::size_t value = sizeof(T) * _deque_min_block_size < _deque_block_bytes
+                                                 ? _deque_block_bytes / sizeof(T)
+                                                 : std::size_t(_deque_min_block_size);
+        };
+    }
+
+    // cur walks the block [first, last), node is the map entry holding that block
+    template <typename TDeque>
+    struct _deque_iterator
+    {
+        typedef typename TDeque::value_type value_type;
+        typedef value_type& reference;
+        typedef value_type* pointer;
+
+        typedef ft::random_access_iterator_tag iterator_category;
+        typedef std::ptrdiff_t difference_type;
+
+        typedef typename TDeque::value_type** map_pointer;
+
+        static difference_type block_size() throw() { return _internal::_deque_block_size<typename TDeque::value_type>::value; }
+
+        typename TDeque::value_type* cur;
+        typename TDeque::value_type* first;
+        typename TDeque::value_type* last;
+        map_pointer node;
+
+        _deque_iterator() throw()
+            : cur(), first(), last(), node() {}
+
+        _deque_iterator(typename TDeque::value_type* cur, map_pointer node) throw()
+            : cur(cur), first(*node), last(*node + block_size()), node(node) {}
+
+        _deque_iterator(const _deque_iterator& that) throw()
+            : cur(that.cur), first(that.first), last(that.last), node(that.node) {}
+
+        _deque_iterator& operator=(const _deque_iterator& that) throw()
+        {
+            this->cur = that.cur;
+            this->first = that.first;
+            this->last = that.last;
+            this->node = that.node;
+            return *this;
+        }
+
+        void set_node(map_pointer node) throw()
+        {
+            this->node = node;
+            this->first = *node;
+            this->last = *node + block_size();
+        }
+
+        reference operator*() const throw()
+        {
+            return *this->cur;
+        }
+
+        pointer operator->() const throw()
+        {
+            return this->cur;
+        }
+
+        reference operator[](difference_type n) const throw()
+        {
+            return *(*this + n);
+        }
+
+        _deque_iterator& operator++() throw()
+        {
+            if (++this->cur == this->last)
+            {
+                this->set_node(this->node + 1);
+                this->cur = this->first;
+            }
+            return *this;
+        }
+
+        _deque_iterator operator++(int) throw()
+        {
+            _deque_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        _deque_iterator& operator--() throw()
+        {
+            if (this->cur == this->first)
+            {
+                this->set_node(this->node - 1);
+                this->cur = this->last;
+            }
+            --this->cur;
+            return *this;
+        }
+
+        _deque_iterator operator--(int) throw()
+        {
+            _deque_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        _deque_iterator& operator+=(difference_type n) throw()
+        {
+            difference_type offset = n + (this->cur - this->first);
+            if (offset >= 0 && offset < block_size())
+            {
+                this->cur += n;
+            }
+            else
+            {
+                difference_type node_offset = offset > 0 ? offset / block_size() : -((-offset - 1) / block_size()) - 1;
+                this->set_node(this->node + node_offset);
+                this->cur = this->first + (offset - node_offset * block_size());
+            }
+            return *this;
+        }
+
+        _deque_iterator& operator-=(difference_type n) throw()
+        {
+            return *this += -n;
+        }
+
+        _deque_iterator operator+(difference_type n) const throw()
+        {
+            _deque_iterator tmp = *this;
+            return tmp += n;
+        }
+
+        _deque_iterator operator-(difference_type n) const throw()
+        {
+            _deque_iterator tmp = *this;
+            return tmp += -n;
+        }
+
+        friend _deque_iterator operator+(difference_type n, const _deque_iterator& it) throw()
+        {
+            return it + n;
+        }
+
+        friend difference_type operator-(const _deque_iterator& lhs, const _deque_iterator& rhs) throw()
+        {
+            return block_size() * (lhs.node - rhs.node) + (lhs.cur - lhs.first) - (rhs.cur - rhs.first);
+        }
+
+        friend bool operator==(const _deque_iterator& lhs, const _deque_iterator& rhs) throw()
+        {
+            return lhs.cur == rhs.cur;
+        }
+
+        friend bool operator!=(const _deque_iterator& lhs, const _deque_iterator& rhs) throw()
+        {
+            return lhs.cur != rhs.cur;
+        }
+
+        friend bool operator<(const _deque_iterator& lhs, const _deque_iterator& rhs) throw()
+        {
+            return lhs.node == rhs.node ? lhs.cur < rhs.cur : lhs.node < rhs.node;
+        }
+
+        friend bool operator<=(const _deque_iterator& lhs, const _deque_iterator& rhs) throw()
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>(const _deque_iterator& lhs, const _deque_iterator& rhs) throw()
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator>=(const _deque_iterator& lhs, const _deque_iterator& rhs) throw()
+        {
+            return !(lhs < rhs);
+        }
+    };
+
+    template <typename TDeque>
+    struct _deque_const_iterator
+    {
+        typedef const typename TDeque::value_type value_type;
+        typedef value_type& reference;
+        typedef value_type* pointer;
+
+        typedef ft::random_access_iterator_tag iterator_category;
+        typedef std::ptrdiff_t difference_type;
+
+        typedef typename TDeque::value_type** map_pointer;
+
+        static difference_type block_size() throw() { return _internal::_deque_block_size<typename TDeque::value_type>::value; }
+
+        typename TDeque::value_type* cur;
+        typename TDeque::value_type* first;
+        typename TDeque::value_type* last;
+        map_pointer node;
+
+        _deque_const_iterator() throw()
+            : cur(), first(), last(), node() {}
+
+        _deque_const_iterator(typename TDeque::value_type* cur, map_pointer node) throw()
+            : cur(cur), first(*node), last(*node + block_size()), node(node) {}
+
+        _deque_const_iterator(const _deque_const_iterator& that) throw()
+            : cur(that.cur), first(that.first), last(that.last), node(that.node) {}
+
+        _deque_const_iterator(const _deque_iterator<TDeque>& that) throw()
+            : cur(that.cur), first(that.first), last(that.last), node(that.node) {}
+
+        _deque_const_iterator& operator=(const _deque_const_iterator& that) throw()
+        {
+            this->cur = that.cur;
+            this->first = that.first;
+            this->last = that.last;
+            this->node = that.node;
+            return *this;
+        }
+
+        void set_node(map_pointer node) throw()
+        {
+            this->node = node;
+            this->first = *node;
+            this->last = *node + block_size();
+        }
+
+        reference operator*() const throw()
+        {
+            return *this->cur;
+        }
+
+        pointer operator->() const throw()
+        {
+            return this->cur;
+        }
+
+        reference operator[](difference_type n) const throw()
+        {
+            return *(*this + n);
+        }
+
+        _deque_const_iterator& operator++() throw()
+        {
+            if (++this->cur == this->last)
+            {
+                this->set_node(this->node + 1);
+                this->cur = this->first;
+            }
+            return *this;
+        }
+
+        _deque_const_iterator operator++(int) throw()
+        {
+            _deque_const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        _deque_const_iterator& operator--() throw()
+        {
+            if (this->cur == this->first)
+            {
+                this->set_node(this->node - 1);
+                this->cur = this->last;
+            }
+            --this->cur;
+            return *this;
+        }
+
+        _deque_const_iterator operator--(int) throw()
+        {
+            _deque_const_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        _deque_const_iterator& operator+=(difference_type n) throw()
+        {
+            difference_type offset = n + (this->cur - this->first);
+            if (offset >= 0 && offset < block_size())
+            {
+                this->cur += n;
+            }
+            else
+            {
+                difference_type node_offset = offset > 0 ? offset / block_size() : -((-offset - 1) / block_size()) - 1;
+                this->set_node(this->node + node_offset);
+                this->cur = this->first + (offset - node_offset * block_size());
+            }
+            return *this;
+        }
+
+        _deque_const_iterator& operator-=(difference_type n) throw()
+        {
+            return *this += -n;
+        }
+
+        _deque_const_iterator operator+(difference_type n) const throw()
+        {
+            _deque_const_iterator tmp = *this;
+            return tmp += n;
+        }
+
+        _deque_const_iterator operator-(difference_type n) const throw()
+        {
+            _deque_const_iterator tmp = *this;
+            return tmp += -n;
+        }
+
+        friend _deque_const_iterator operator+(difference_type n, const _deque_const_iterator& it) throw()
+        {
+            return it + n;
+        }
+
+        friend difference_type operator-(const _deque_const_iterator& lhs, const _deque_const_iterator& rhs) throw()
+        {
+            return block_size() * (lhs.node - rhs.node) + (lhs.cur - lhs.first) - (rhs.cur - rhs.first);
+        }
+
+        friend bool operator==(const _deque_const_iterator& lhs, const _deque_const_iterator& rhs) throw()
+        {
+            return lhs.cur == rhs.cur;
+        }
+
+        friend bool operator!=(const _deque_const_iterator& lhs, const _deque_const_iterator& rhs) throw()
+        {
+            return lhs.cur != rhs.cur;
+        }
+
+        friend bool operator<(const _deque_const_iterator& lhs, const _deque_const_iterator& rhs) throw()
+        {
+            return lhs.node == rhs.node ? lhs.cur < rhs.cur : lhs.node < rhs.node;
+        }
+
+        friend bool operator<=(const _deque_const_iterator& lhs, const _deque_const_iterator& rhs) throw()
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>(const _deque_const_iterator& lhs, const _deque_const_iterator& rhs) throw()
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator>=(const _deque_const_iterator& lhs, const _deque_const_iterator& rhs) throw()
+        {
+            return !(lhs < rhs);
+        }
+    };
+
+    // Fixed size blocks reached through a map of block pointers, the map is kept centered
+    // so both ends grow in O(1) and elements never move once constructed.
+    // An empty deque owns nothing until the first push.
+    template <typename T, typename TAlloc = std::allocator<T> >
+    class deque
+    {
+    public:
+        typedef T value_type;
+        typedef TAlloc allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+        typedef _deque_iterator<deque> iterator;
+        typedef _deque_const_iterator<deque> const_iterator;
+        typedef ft::reverse_iterator<iterator> reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    protected:
+        typedef value_type** map_pointer;
+        typedef typename TAlloc::template rebind<value_type*>::other map_allocator_type;
+
+        static size_type block_size() { return _internal::_deque_block_size<value_type>::value; }
+
+    private:
+        map_pointer map;
+        size_type map_size;
+        iterator start;
+        iterator finish;
+
+        allocator_type alloc;
+
+    public:
+        deque()
+            : map(), map_size(), start(), finish(), alloc() {}
+
+        explicit deque(const allocator_type& alloc)
+            : map(), map_size(), start(), finish(), alloc(alloc) {}
+
+        explicit deque(size_type count, const value_type& value = value_type(), const allocator_type& alloc = allocator_type())
+            : map(), map_size(), start(), finish(), alloc(alloc)
+        {
+            this->assign(count, value);
+        }
+
+        template <typename UIter>
+        // deque(UIter first, UIter last, const allocator_type& alloc = allocator_type())
+        deque(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const allocator_type& alloc = allocator_type())
+            : map(), map_size(), start(), finish(), alloc(alloc)
+        {
+            this->assign(first, last);
+        }
+
+        deque(const deque& that)
+            : map(), map_size(), start(), finish(), alloc(that.alloc)
+        {
+            this->assign(that.begin(), that.end());
+        }
+
+#if __cplusplus >= 201103L
+        deque(deque&& that)
+            : map(), map_size(), start(), finish(), alloc(that.alloc)
+        {
+            this->swap(that);
+        }
+#endif
+
+        ~deque()
+        {
+            this->destruct();
+        }
+
+        deque& operator=(const deque& that)
+        {
+            if (this != &that)
+            {
+                this->assign(that.begin(), that.end());
+            }
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        deque& operator=(deque&& that)
+        {
+            if (this != &that)
+            {
+                deque temp(ft::move(that));
+                this->swap(temp);
+            }
+            return *this;
+        }
+#endif
+
+    protected:
+        value_type* allocate_block()
+        {
+            return this->alloc.allocate(deque::block_size());
+        }
+
+        void deallocate_block(value_type* block)
+        {
+            this->alloc.deallocate(block, deque::block_size());
+        }
+
+        void destroy_range(iterator first, iterator last)
+        {
+            for (; first != last; ++first)
+            {
+                this->alloc.destroy(ft::addressof(*first));
+            }
+        }
+
+        void destruct()
+        {
+            if (this->map != NULL)
+            {
+                this->destroy_range(this->start, this->finish);
+                for (map_pointer node = this->start.node; node <= this->finish.node; ++node)
+                {
+                    this->deallocate_block(*node);
+                }
+                map_allocator_type(this->alloc).deallocate(this->map, this->map_size);
+            }
+        }
+
+        // A map with a single block in its middle, the first element goes to the start of the block.
+        void initialize_map()
+        {
+            map_allocator_type map_alloc(this->alloc);
+            map_pointer map = map_alloc.allocate(_internal::_deque_initial_map_size);
+            map_pointer node = map + _internal::_deque_initial_map_size / 2;
+            try
+            {
+                *node = this->allocate_block();
+            }
+            catch (...)
+            {
+                map_alloc.deallocate(map, _internal::_deque_initial_map_size);
+                throw;
+            }
+            this->map = map;
+            this->map_size = _internal::_deque_initial_map_size;
+            this->start.set_node(node);
+            this->start.cur = this->start.first;
+            this->finish = this->start;
+        }
+
+        // Makes room for nodes_to_add block pointers at one end, by centering the used
+        // part of the map again when it is at most half full or by growing the map.
+        void reallocate_map(size_type nodes_to_add, bool add_at_front)
+        {
+            size_type old_nodes = this->finish.node - this->start.node + 1;
+            size_type new_nodes = old_nodes + nodes_to_add;
+
+            map_pointer new_start;
+            if (this->map_size > 2 * new_nodes)
+            {
+                new_start = this->map + (this->map_size - new_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+                if (new_start < this->start.node)
+                {
+                    ft::copy(this->start.node, this->finish.node + 1, new_start);
+                }
+                else
+                {
+                    ft::copy_backward(this->start.node, this->finish.node + 1, new_start + old_nodes);
+                }
+            }
+            else
+            {
+                map_allocator_type map_alloc(this->alloc);
+                size_type new_map_size = this->map_size + (this->map_size < nodes_to_add ? nodes_to_add : this->map_size) + 2;
+                map_pointer new_map = map_alloc.allocate(new_map_size);
+                new_start = new_map + (new_map_size - new_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+                ft::copy(this->start.node, this->finish.node + 1, new_start);
+                map_alloc.deallocate(this->map, this->map_size);
+                this->map = new_map;
+                this->map_size = new_map_size;
+            }
+
+            this->start.set_node(new_start);
+            this->finish.set_node(new_start + old_nodes - 1);
+        }
+
+        void reserve_map_at_back()
+        {
+            if (this->finish.node + 1 == this->map + this->map_size)
+            {
+                this->reallocate_map(1, false);
+            }
+        }
+
+        void reserve_map_at_front()
+        {
+            if (this->start.node == this->map)
+            {
+                this->reallocate_map(1, true);
+            }
+        }
+
+        // the last slot of the last block is taken, finish moves on to a new block
+#if __cplusplus >= 201103L
+        template <typename... Args>
+        void push_back_block(Args&&... args)
+#else
+        void push_back_block(const value_type& value)
+#endif
+        {
+            if (this->map == NULL)
+            {
+                this->initialize_map();
+#if __cplusplus >= 201103L
+                this->alloc.construct(this->finish.cur, ft::forward<Args>(args)...);
+#else
+                this->alloc.construct(this->finish.cur, value);
+#endif
+                ++this->finish.cur;
+                return;
+            }
+
+            this->reserve_map_at_back();
+            *(this->finish.node + 1) = this->allocate_block();
+            try
+            {
+#if __cplusplus >= 201103L
+                this->alloc.construct(this->finish.cur, ft::forward<Args>(args)...);
+#else
+                this->alloc.construct(this->finish.cur, value);
+#endif
+            }
+            catch (...)
+            {
+                this->deallocate_block(*(this->finish.node + 1));
+                throw;
+            }
+            this->finish.set_node(this->finish.node + 1);
+            this->finish.cur = this->finish.first;
+        }
+
+        // the first block is full up to its front, start moves back to a new block
+#if __cplusplus >= 201103L
+        template <typename... Args>
+        void push_front_block(Args&&... args)
+#else
+        void push_front_block(const value_type& value)
+#endif
+        {
+            if (this->map == NULL)
+            {
+                this->initialize_map();
+            }
+
+            this->reserve_map_at_front();
+            *(this->start.node - 1) = this->allocate_block();
+            try
+            {
+#if __cplusplus >= 201103L
+                this->alloc.construct(*(this->start.node - 1) + (deque::block_size() - 1), ft::forward<Args>(args)...);
+#else
+                this->alloc.construct(*(this->start.node - 1) + (deque::block_size() - 1), value);
+#endif
+            }
+            catch (...)
+            {
+                this->deallocate_block(*(this->start.node - 1));
+                throw;
+            }
+            this->start.set_node(this->start.node - 1);
+            this->start.cur = this->start.last - 1;
+        }
+
+        static void move_assign(value_type& dest, value_type& src)
+        {
+#if __cplusplus >= 201103L
+            dest = ft::move(src);
+#else
+            dest = src;
+#endif
+        }
+
+        // Inserts value (a temporary the caller owns) at index, shifting the shorter side by one.
+        iterator insert_at(difference_type index, value_type& value)
+        {
+            if (static_cast<size_type>(index) < this->size() / 2)
+            {
+#if __cplusplus >= 201103L
+                this->push_front(ft::move(this->front()));
+#else
+                this->push_front(this->front());
+#endif
+                ft::move(this->start + 2, this->start + (index + 1), this->start + 1);
+            }
+            else
+            {
+#if __cplusplus >= 201103L
+                this->push_back(ft::move(this->back()));
+#else
+                this->push_back(this->back());
+#endif
+                ft::move_backward(this->start + index, this->finish - 2, this->finish - 1);
+            }
+            iterator pos = this->start + index;
+            deque::move_assign(*pos, value);
+            return pos;
+        }
+
+        // Pushes the new elements on the nearer end, then rotates them into place.
+        // If a push throws the elements pushed so far are popped again.
+        template <typename UIter>
+        iterator insert_range(difference_type index, UIter first, UIter last)
+        {
+            size_type size = this->size();
+            size_type count = size_type();
+            if (static_cast<size_type>(index) < size / 2)
+            {
+                try
+                {
+                    for (; first != last; ++first, ++count)
+                    {
+                        this->push_front(*first);
+                    }
+                }
+                catch (...)
+                {
+                    for (; count != 0; --count)
+                    {
+                        this->pop_front();
+                    }
+                    throw;
+                }
+                ft::reverse(this->start, this->start + count);
+                ft::rotate(this->start, this->start + count, this->start + (count + index));
+            }
+            else
+            {
+                try
+                {
+                    for (; first != last; ++first, ++count)
+                    {
+                        this->push_back(*first);
+                    }
+                }
+                catch (...)
+                {
+                    for (; count != 0; --count)
+                    {
+                        this->pop_back();
+                    }
+                    throw;
+                }
+                ft::rotate(this->start + index, this->start + size, this->finish);
+            }
+            return this->start + index;
+        }
+
+        // a counting iterator over one value, for insert(pos, count, value)
+        struct repeat_iterator
+        {
+            const value_type* value;
+            size_type count;
+
+            repeat_iterator(const value_type* value, size_type count)
+                : value(value), count(count) {}
+
+            const value_type& operator*() const { return *this->value; }
+            repeat_iterator& operator++()
+            {
+                --this->count;
+                return *this;
+            }
+            bool operator!=(const repeat_iterator& that) const { return this->count != that.count; }
+        };
+
+    public:
+        void assign(size_type count, const value_type& value)
+        {
+            iterator it = this->begin();
+            iterator end = this->end();
+            for (; it != end && count != 0; --count)
+            {
+                *it = value;
+                ++it;
+            }
+            if (it != end)
+            {
+                this->erase(it, end);
+            }
+            else if (count != 0)
+            {
+                this->insert(it, count, value);
+            }
+        }
+
+        template <typename UIter>
+        // void assign(UIter first, UIter last)
+        typename ft::enable_if<ft::is_input_iterator<UIter>::value, void>::type assign(UIter first, UIter last)
+        {
+            iterator it = this->begin();
+            iterator end = this->end();
+            for (; it != end && first != last; ++first)
+            {
+                *it = *first;
+                ++it;
+            }
+            if (it != end)
+            {
+                this->erase(it, end);
+            }
+            else if (first != last)
+            {
+                this->insert(it, first, last);
+            }
+        }
+
+    public:
+        allocator_type get_allocator() const { return this->alloc; }
+
+    public:
+        reference at(size_type pos)
+        {
+            if (!(pos < this->size()))
+            {
+                throw ft::out_of_range("deque::at");
+            }
+            return this->start[pos];
+        }
+        const_reference at(size_type pos) const
+        {
+            if (!(pos < this->size()))
+            {
+                throw ft::out_of_range("deque::at");
+            }
+            return this->start[pos];
+        }
+        reference operator[](size_type pos) { return this->start[pos]; }
+        const_reference operator[](size_type pos) const { return this->start[pos]; }
+        reference front() { return *this->start; }
+        const_reference front() const { return *this->start; }
+        reference back() { return *(this->finish - 1); }
+        const_reference back() const { return *(this->finish - 1); }
+
+    public:
+        iterator begin() { return this->start; }
+        const_iterator begin() const { return this->start; }
+        iterator end() { return this->finish; }
+        const_iterator end() const { return this->finish; }
+        reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+        reverse_iterator rend() { return reverse_iterator(this->begin()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+    public:
+        bool empty() const { return this->start == this->finish; }
+        size_type size() const { return this->finish - this->start; }
+        size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(value_type); }
+
+        // blocks are freed as soon as they empty, only an empty deque has its map and last block to give back
+        void shrink_to_fit()
+        {
+            if (this->empty() && this->map != NULL)
+            {
+                this->destruct();
+                this->map = map_pointer();
+                this->map_size = size_type();
+                this->start = iterator();
+                this->finish = iterator();
+            }
+        }
+
+    public:
+        // keeps the block of the first element
+        void clear()
+        {
+            if (this->map == NULL)
+            {
+                return;
+            }
+            this->destroy_range(this->start, this->finish);
+            for (map_pointer node = this->start.node + 1; node <= this->finish.node; ++node)
+            {
+                this->deallocate_block(*node);
+            }
+            this->finish = this->start;
+        }
+
+        iterator insert(iterator pos, const value_type& value)
+        {
+            if (pos == this->start)
+            {
+                this->push_front(value);
+                return this->start;
+            }
+            if (pos == this->finish)
+            {
+                this->push_back(value);
+                return this->finish - 1;
+            }
+            // value may be one of the elements the insertion moves
+            value_type copy(value);
+            return this->insert_at(pos - this->start, copy);
+        }
+
+        iterator insert(iterator pos, size_type count, const value_type& value)
+        {
+            value_type copy(value);
+            return this->insert_range(pos - this->start, repeat_iterator(&copy, count), repeat_iterator(&copy, 0));
+        }
+
+        template <typename UIter>
+        // iterator insert(iterator pos, UIter first, UIter last)
+        typename ft::enable_if<ft::is_input_iterator<UIter>::value, iterator>::type insert(iterator pos, UIter first, UIter last)
+        {
+            return this->insert_range(pos - this->start, first, last);
+        }
+
+        iterator erase(iterator pos)
+        {
+            difference_type index = pos - this->start;
+            if (static_cast<size_type>(index) < this->size() / 2)
+            {
+                ft::move_backward(this->start, pos, pos + 1);
+                this->pop_front();
+            }
+            else
+            {
+                ft::move(pos + 1, this->finish, pos);
+                this->pop_back();
+            }
+            return this->start + index;
+        }
+
+        // the elements on the shorter side close the gap
+        iterator erase(iterator first, iterator last)
+        {
+            difference_type count = last - first;
+            difference_type index = first - this->start;
+            if (count == 0)
+            {
+                return first;
+            }
+            if (static_cast<size_type>(index) < (this->size() - count) / 2)
+            {
+                ft::move_backward(this->start, first, last);
+                for (; count != 0; --count)
+                {
+                    this->pop_front();
+                }
+            }
+            else
+            {
+                ft::move(last, this->finish, first);
+                for (; count != 0; --count)
+                {
+                    this->pop_back();
+                }
+            }
+            return this->start + index;
+        }
+
+        void push_back(const value_type& value)
+        {
+            if (this->finish.last - this->finish.cur > 1)
+            {
+                this->alloc.construct(this->finish.cur, value);
+                ++this->finish.cur;
+            }
+            else
+            {
+                this->push_back_block(value);
+            }
+        }
+
+        void pop_back()
+        {
+            if (this->finish.cur == this->finish.first)
+            {
+                this->deallocate_block(this->finish.first);
+                this->finish.set_node(this->finish.node - 1);
+                this->finish.cur = this->finish.last;
+            }
+            --this->finish.cur;
+            this->alloc.destroy(this->finish.cur);
+        }
+
+        void push_front(const value_type& value)
+        {
+            if (this->start.cur != this->start.first)
+            {
+                this->alloc.construct(this->start.cur - 1, value);
+                --this->start.cur;
+            }
+            else
+            {
+                this->push_front_block(value);
+            }
+        }
+
+        void pop_front()
+        {
+            this->alloc.destroy(this->start.cur);
+            if (this->start.cur + 1 == this->start.last)
+            {
+                this->deallocate_block(this->start.first);
+                this->start.set_node(this->start.node + 1);
+                this->start.cur = this->start.first;
+            }
+            else
+            {
+                ++this->start.cur;
+            }
+        }
+
+#if __cplusplus >= 201103L
+        iterator insert(iterator pos, value_type&& value)
+        {
+            return this->emplace(pos, ft::move(value));
+        }
+
+        template <typename... Args>
+        iterator emplace(iterator pos, Args&&... args)
+        {
+            if (pos == this->start)
+            {
+                this->emplace_front(ft::forward<Args>(args)...);
+                return this->start;
+            }
+            if (pos == this->finish)
+            {
+                this->emplace_back(ft::forward<Args>(args)...);
+                return this->finish - 1;
+            }
+            value_type value(ft::forward<Args>(args)...);
+            return this->insert_at(pos - this->start, value);
+        }
+
+        void push_back(value_type&& value)
+        {
+            this->emplace_back(ft::move(value));
+        }
+
+        template <typename... Args>
+        void emplace_back(Args&&... args)
+        {
+            if (this->finish.last - this->finish.cur > 1)
+            {
+                this->alloc.construct(this->finish.cur, ft::forward<Args>(args)...);
+                ++this->finish.cur;
+            }
+            else
+            {
+                this->push_back_block(ft::forward<Args>(args)...);
+            }
+        }
+
+        void push_front(value_type&& value)
+        {
+            this->emplace_front(ft::move(value));
+        }
+
+        template <typename... Args>
+        void emplace_front(Args&&... args)
+        {
+            if (this->start.cur != this->start.first)
+            {
+                this->alloc.construct(this->start.cur - 1, ft::forward<Args>(args)...);
+                --this->start.cur;
+            }
+            else
+            {
+                this->push_front_block(ft::forward<Args>(args)...);
+            }
+        }
+#endif
+
+        void resize(size_type count, value_type value = value_type())
+        {
+            size_type size = this->size();
+            if (count > size)
+            {
+                this->insert(this->end(), count - size, value);
+            }
+            else if (count < size)
+            {
+                this->erase(this->begin() + count, this->end());
+            }
+        }
+
+        void swap(deque& that)
+        {
+            ft::swap(this->map, that.map);
+            ft::swap(this->map_size, that.map_size);
+            ft::swap(this->start, that.start);
+            ft::swap(this->finish, that.finish);
+            ft::swap(this->alloc, that.alloc);
+        }
+
+    public:
+        friend bool operator==(const deque& lhs, const deque& rhs)
+        {
+            return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        friend bool operator!=(const deque& lhs, const deque& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const deque& lhs, const deque& rhs)
+        {
+            return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator<=(const deque& lhs, const deque& rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>(const deque& lhs, const deque& rhs)
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator>=(const deque& lhs, const deque& rhs)
+        {
+            return !(lhs < rhs);
+        }
+    };
+
+    template <typename T, typename TAlloc>
+    inline void swap(
+        deque<T, TAlloc>& lhs,
+        deque<T, TAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+namespace std
+{
+    template <typename T, typename TAlloc>
+    inline void swap(
+        ft::deque<T, TAlloc>& lhs,
+        ft::deque<T, TAlloc>& rhs)
+    {
+        ft::swap(lhs, rhs);
+    }
+}
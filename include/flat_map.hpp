@@ -0,0 +1,604 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "_flat_tree.hpp"
+#include "functional.hpp"
+#include "stdexcept.hpp"
+#include "utility.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace ft
+{
+    // Sorted vector map: keys and mapped values are kept in separate contiguous arrays.
+    // Iterators are proxies yielding ft::pair<const TKey&, TMapped&> and are invalidated by every insert and erase.
+    template <typename TKey, typename TMapped, typename TComp = ft::less<TKey>, typename TAlloc = std::allocator<ft::pair<const TKey, TMapped> > >
+    class flat_map
+    {
+    public:
+        typedef TKey key_type;
+        typedef TMapped mapped_type;
+        typedef ft::pair<const TKey, TMapped> value_type;
+        typedef TComp key_compare;
+        typedef TAlloc allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+    protected:
+        typedef ft::_flat_pair_storage<key_type, mapped_type, allocator_type> storage_type;
+        typedef ft::_flat_tree<storage_type, key_compare> container_type;
+
+    public:
+        typedef typename container_type::iterator iterator;
+        typedef typename container_type::const_iterator const_iterator;
+        typedef typename iterator::reference reference;
+        typedef typename const_iterator::reference const_reference;
+        typedef typename iterator::pointer pointer;
+        typedef typename const_iterator::pointer const_pointer;
+        typedef typename ft::reverse_iterator<iterator> reverse_iterator;
+        typedef typename ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        class value_compare
+        {
+            friend class flat_map;
+
+        public:
+            typedef bool result_type;
+            typedef value_type first_argument_type;
+            typedef value_type second_argument_type;
+
+        protected:
+            key_compare comp;
+
+            value_compare(const key_compare& comp)
+                : comp(comp) {}
+
+        public:
+            result_type operator()(const first_argument_type& lhs, const second_argument_type& rhs)
+            {
+                return this->comp(lhs.first, rhs.first);
+            }
+        };
+
+    private:
+        container_type c;
+
+    public:
+        flat_map()
+            : c() {}
+
+        explicit flat_map(const key_compare& comp, const allocator_type& alloc = allocator_type())
+            : c(comp, alloc) {}
+
+        template <typename UIter>
+        // flat_map(UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        flat_map(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            : c(comp, alloc)
+        {
+            this->insert(first, last);
+        }
+
+        template <typename UIter>
+        // flat_map(ft::sorted_unique_t, UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        flat_map(ft::sorted_unique_t, typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            : c(comp, alloc)
+        {
+            this->insert(ft::sorted_unique, first, last);
+        }
+
+        flat_map(const flat_map& that)
+            : c(that.c) {}
+
+#if __cplusplus >= 201103L
+        flat_map(flat_map&& that) noexcept(noexcept(container_type(ft::declval<container_type>())))
+            : c(ft::move(that.c)) {}
+#endif
+
+        ~flat_map() {}
+
+        flat_map& operator=(const flat_map& that)
+        {
+            this->c = that.c;
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        flat_map& operator=(flat_map&& that)
+        {
+            this->c = ft::move(that.c);
+            return *this;
+        }
+#endif
+
+    public:
+        allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
+
+    public:
+        mapped_type& at(const key_type& key)
+        {
+            iterator it = this->find(key);
+            if (it == this->end())
+            {
+                throw ft::out_of_range("flat_map::at");
+            }
+            return it->second;
+        }
+        const mapped_type& at(const key_type& key) const
+        {
+            const_iterator it = this->find(key);
+            if (it == this->end())
+            {
+                throw ft::out_of_range("flat_map::at");
+            }
+            return it->second;
+        }
+
+        mapped_type& operator[](const key_type& key)
+        {
+            iterator it = this->lower_bound(key);
+            if (it == this->end() || this->key_comp()(key, it->first))
+            {
+                it = this->insert(it, ft::make_pair(key, mapped_type()));
+            }
+            return it->second;
+        }
+
+#if __cplusplus >= 201103L
+        mapped_type& operator[](key_type&& key)
+        {
+            return this->try_emplace(ft::move(key)).first->second;
+        }
+#endif
+
+    public:
+        iterator begin() { return this->c.begin(); }
+        const_iterator begin() const { return this->c.begin(); }
+        iterator end() { return this->c.end(); }
+        const_iterator end() const { return this->c.end(); }
+        reverse_iterator rbegin() { return this->c.rbegin(); }
+        const_reverse_iterator rbegin() const { return this->c.rbegin(); }
+        reverse_iterator rend() { return this->c.rend(); }
+        const_reverse_iterator rend() const { return this->c.rend(); }
+
+    public:
+        bool empty() const { return this->c.empty(); }
+        size_type size() const { return this->c.size(); }
+        size_type max_size() const { return this->c.max_size(); }
+        size_type capacity() const { return this->c.capacity(); }
+        void reserve(size_type n) { this->c.reserve(n); }
+
+    public:
+        void clear() { return this->c.clear(); }
+
+        ft::pair<iterator, bool> insert(const value_type& value)
+        {
+            return this->c.insert_unique(this->c.end(), value);
+        }
+
+        iterator insert(iterator hint, const value_type& value)
+        {
+            return this->c.insert_unique(hint, value).first;
+        }
+
+        template <typename UIter>
+        // void insert(UIter first, UIter last)
+        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
+        {
+            this->c.insert_range_unique(first, last);
+        }
+
+        template <typename UIter>
+        // void insert(ft::sorted_unique_t, UIter first, UIter last)
+        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(ft::sorted_unique_t, UIter first, UIter last)
+        {
+            this->c.insert_range_unique(ft::sorted_unique, first, last);
+        }
+
+#if __cplusplus >= 201103L
+        // the key is const in value, only the mapped value can be moved
+        ft::pair<iterator, bool> insert(value_type&& value)
+        {
+            return this->c.emplace_unique(this->c.end(), value.first, ft::move(value.second));
+        }
+
+        iterator insert(iterator hint, value_type&& value)
+        {
+            return this->c.emplace_unique(hint, value.first, ft::move(value.second)).first;
+        }
+
+        // The key is only known once the arguments are turned into a pair, whose halves then move into the arrays.
+        template <typename... Args>
+        ft::pair<iterator, bool> emplace(Args&&... args)
+        {
+            ft::pair<key_type, mapped_type> value(ft::forward<Args>(args)...);
+            return this->c.emplace_unique(this->c.end(), ft::move(value.first), ft::move(value.second));
+        }
+
+        template <typename... Args>
+        iterator emplace_hint(iterator hint, Args&&... args)
+        {
+            ft::pair<key_type, mapped_type> value(ft::forward<Args>(args)...);
+            return this->c.emplace_unique(hint, ft::move(value.first), ft::move(value.second)).first;
+        }
+
+        // Nothing is constructed (and the key is not moved from) when the key is already present.
+        template <typename... Args>
+        ft::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+        {
+            return this->c.emplace_unique(this->c.end(), key, ft::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        ft::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+        {
+            return this->c.emplace_unique(this->c.end(), ft::move(key), ft::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        iterator try_emplace(iterator hint, const key_type& key, Args&&... args)
+        {
+            return this->c.emplace_unique(hint, key, ft::forward<Args>(args)...).first;
+        }
+
+        template <typename... Args>
+        iterator try_emplace(iterator hint, key_type&& key, Args&&... args)
+        {
+            return this->c.emplace_unique(hint, ft::move(key), ft::forward<Args>(args)...).first;
+        }
+#endif
+
+        iterator erase(iterator pos)
+        {
+            return this->c.erase(pos, pos + 1);
+        }
+
+        iterator erase(iterator first, iterator last)
+        {
+            return this->c.erase(first, last);
+        }
+
+        size_type erase(const key_type& key)
+        {
+            iterator it = this->find(key);
+            if (it == this->end())
+            {
+                return 0;
+            }
+            this->erase(it);
+            return 1;
+        }
+
+        void swap(flat_map& that) { this->c.swap(that.c); }
+
+    public:
+        size_type count(const key_type& key) const { return this->c.count(key); }
+
+        iterator find(const key_type& key) { return this->c.find(key); }
+        const_iterator find(const key_type& key) const { return this->c.find(key); }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+
+        iterator lower_bound(const key_type& key) { return this->c.lower_bound(key); }
+        const_iterator lower_bound(const key_type& key) const { return this->c.lower_bound(key); }
+
+        iterator upper_bound(const key_type& key) { return this->c.upper_bound(key); }
+        const_iterator upper_bound(const key_type& key) const { return this->c.upper_bound(key); }
+
+    public:
+        key_compare key_comp() const { return this->c.key_comp(); }
+        value_compare value_comp() const { return value_compare(this->c.key_comp()); }
+
+    public:
+        friend bool operator==(const flat_map& lhs, const flat_map& rhs)
+        {
+            return lhs.c == rhs.c;
+        }
+
+        friend bool operator!=(const flat_map& lhs, const flat_map& rhs)
+        {
+            return lhs.c != rhs.c;
+        }
+
+        friend bool operator<(const flat_map& lhs, const flat_map& rhs)
+        {
+            return lhs.c < rhs.c;
+        }
+
+        friend bool operator<=(const flat_map& lhs, const flat_map& rhs)
+        {
+            return lhs.c <= rhs.c;
+        }
+
+        friend bool operator>(const flat_map& lhs, const flat_map& rhs)
+        {
+            return lhs.c > rhs.c;
+        }
+
+        friend bool operator>=(const flat_map& lhs, const flat_map& rhs)
+        {
+            return lhs.c >= rhs.c;
+        }
+    };
+
+    template <typename TKey, typename TMapped, typename TComp, typename TAlloc>
+    inline void swap(
+        flat_map<TKey, TMapped, TComp, TAlloc>& lhs,
+        flat_map<TKey, TMapped, TComp, TAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <typename TKey, typename TMapped, typename TComp = ft::less<TKey>, typename TAlloc = std::allocator<ft::pair<const TKey, TMapped> > >
+    class flat_multimap
+    {
+    public:
+        typedef TKey key_type;
+        typedef TMapped mapped_type;
+        typedef ft::pair<const TKey, TMapped> value_type;
+        typedef TComp key_compare;
+        typedef TAlloc allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+    protected:
+        typedef ft::_flat_pair_storage<key_type, mapped_type, allocator_type> storage_type;
+        typedef ft::_flat_tree<storage_type, key_compare> container_type;
+
+    public:
+        typedef typename container_type::iterator iterator;
+        typedef typename container_type::const_iterator const_iterator;
+        typedef typename iterator::reference reference;
+        typedef typename const_iterator::reference const_reference;
+        typedef typename iterator::pointer pointer;
+        typedef typename const_iterator::pointer const_pointer;
+        typedef typename ft::reverse_iterator<iterator> reverse_iterator;
+        typedef typename ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        class value_compare
+        {
+            friend class flat_multimap;
+
+        public:
+            typedef bool result_type;
+            typedef value_type first_argument_type;
+            typedef value_type second_argument_type;
+
+        protected:
+            key_compare comp;
+
+            value_compare(const key_compare& comp)
+                : comp(comp) {}
+
+        public:
+            result_type operator()(const first_argument_type& lhs, const second_argument_type& rhs)
+            {
+                return this->comp(lhs.first, rhs.first);
+            }
+        };
+
+    private:
+        container_type c;
+
+    public:
+        flat_multimap()
+            : c() {}
+
+        explicit flat_multimap(const key_compare& comp, const allocator_type& alloc = allocator_type())
+            : c(comp, alloc) {}
+
+        template <typename UIter>
+        // flat_multimap(UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        flat_multimap(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            : c(comp, alloc)
+        {
+            this->insert(first, last);
+        }
+
+        template <typename UIter>
+        // flat_multimap(ft::sorted_equivalent_t, UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        flat_multimap(ft::sorted_equivalent_t, typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            : c(comp, alloc)
+        {
+            this->insert(ft::sorted_equivalent, first, last);
+        }
+
+        flat_multimap(const flat_multimap& that)
+            : c(that.c) {}
+
+#if __cplusplus >= 201103L
+        flat_multimap(flat_multimap&& that) noexcept(noexcept(container_type(ft::declval<container_type>())))
+            : c(ft::move(that.c)) {}
+#endif
+
+        ~flat_multimap() {}
+
+        flat_multimap& operator=(const flat_multimap& that)
+        {
+            this->c = that.c;
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        flat_multimap& operator=(flat_multimap&& that)
+        {
+            this->c = ft::move(that.c);
+            return *this;
+        }
+#endif
+
+    public:
+        allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
+
+    public:
+        iterator begin() { return this->c.begin(); }
+        const_iterator begin() const { return this->c.begin(); }
+        iterator end() { return this->c.end(); }
+        const_iterator end() const { return this->c.end(); }
+        reverse_iterator rbegin() { return this->c.rbegin(); }
+        const_reverse_iterator rbegin() const { return this->c.rbegin(); }
+        reverse_iterator rend() { return this->c.rend(); }
+        const_reverse_iterator rend() const { return this->c.rend(); }
+
+    public:
+        bool empty() const { return this->c.empty(); }
+        size_type size() const { return this->c.size(); }
+        size_type max_size() const { return this->c.max_size(); }
+        size_type capacity() const { return this->c.capacity(); }
+        void reserve(size_type n) { this->c.reserve(n); }
+
+    public:
+        void clear() { return this->c.clear(); }
+
+        iterator insert(const value_type& value)
+        {
+            return this->c.insert_equal(this->c.end(), value);
+        }
+
+        iterator insert(iterator hint, const value_type& value)
+        {
+            return this->c.insert_equal(hint, value);
+        }
+
+        template <typename UIter>
+        // void insert(UIter first, UIter last)
+        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
+        {
+            this->c.insert_range_equal(first, last);
+        }
+
+        template <typename UIter>
+        // void insert(ft::sorted_equivalent_t, UIter first, UIter last)
+        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(ft::sorted_equivalent_t, UIter first, UIter last)
+        {
+            this->c.insert_range_equal(ft::sorted_equivalent, first, last);
+        }
+
+#if __cplusplus >= 201103L
+        // the key is const in value, only the mapped value can be moved
+        iterator insert(value_type&& value)
+        {
+            return this->c.emplace_equal(this->c.end(), value.first, ft::move(value.second));
+        }
+
+        iterator insert(iterator hint, value_type&& value)
+        {
+            return this->c.emplace_equal(hint, value.first, ft::move(value.second));
+        }
+
+        template <typename... Args>
+        iterator emplace(Args&&... args)
+        {
+            ft::pair<key_type, mapped_type> value(ft::forward<Args>(args)...);
+            return this->c.emplace_equal(this->c.end(), ft::move(value.first), ft::move(value.second));
+        }
+
+        template <typename... Args>
+        iterator emplace_hint(iterator hint, Args&&... args)
+        {
+            ft::pair<key_type, mapped_type> value(ft::forward<Args>(args)...);
+            return this->c.emplace_equal(hint, ft::move(value.first), ft::move(value.second));
+        }
+#endif
+
+        iterator erase(iterator pos)
+        {
+            return this->c.erase(pos, pos + 1);
+        }
+
+        iterator erase(iterator first, iterator last)
+        {
+            return this->c.erase(first, last);
+        }
+
+        size_type erase(const key_type& key)
+        {
+            ft::pair<iterator, iterator> range = this->equal_range(key);
+            size_type n = range.second - range.first;
+            this->c.erase(range.first, range.second);
+            return n;
+        }
+
+        void swap(flat_multimap& that) { this->c.swap(that.c); }
+
+    public:
+        size_type count(const key_type& key) const { return this->c.count(key); }
+
+        iterator find(const key_type& key) { return this->c.find(key); }
+        const_iterator find(const key_type& key) const { return this->c.find(key); }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+
+        iterator lower_bound(const key_type& key) { return this->c.lower_bound(key); }
+        const_iterator lower_bound(const key_type& key) const { return this->c.lower_bound(key); }
+
+        iterator upper_bound(const key_type& key) { return this->c.upper_bound(key); }
+        const_iterator upper_bound(const key_type& key) const { return this->c.upper_bound(key); }
+
+    public:
+        key_compare key_comp() const { return this->c.key_comp(); }
+        value_compare value_comp() const { return value_compare(this->c.key_comp()); }
+
+    public:
+        friend bool operator==(const flat_multimap& lhs, const flat_multimap& rhs)
+        {
+            return lhs.c == rhs.c;
+        }
+
+        friend bool operator!=(const flat_multimap& lhs, const flat_multimap& rhs)
+        {
+            return lhs.c != rhs.c;
+        }
+
+        friend bool operator<(const flat_multimap& lhs, const flat_multimap& rhs)
+        {
+            return lhs.c < rhs.c;
+        }
+
+        friend bool operator<=(const flat_multimap& lhs, const flat_multimap& rhs)
+        {
+            return lhs.c <= rhs.c;
+        }
+
+        friend bool operator>(const flat_multimap& lhs, const flat_multimap& rhs)
+        {
+            return lhs.c > rhs.c;
+        }
+
+        friend bool operator>=(const flat_multimap& lhs, const flat_multimap& rhs)
+        {
+            return lhs.c >= rhs.c;
+        }
+    };
+
+    template <typename TKey, typename TMapped, typename TComp, typename TAlloc>
+    inline void swap(
+        flat_multimap<TKey, TMapped, TComp, TAlloc>& lhs,
+        flat_multimap<TKey, TMapped, TComp, TAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+namespace std
+{
+    template <typename TKey, typename TMapped, typename TComp, typename TAlloc>
+    inline void swap(
+        ft::flat_map<TKey, TMapped, TComp, TAlloc>& lhs,
+        ft::flat_map<TKey, TMapped, TComp, TAlloc>& rhs)
+    {
+        ft::swap(lhs, rhs);
+    }
+
+    template <typename TKey, typename TMapped, typename TComp, typename TAlloc>
+    inline void swap(
+        ft::flat_multimap<TKey, TMapped, TComp, TAlloc>& lhs,
+        ft::flat_multimap<TKey, TMapped, TComp, TAlloc>& rhs)
+    {
+        ft::swap(lhs, rhs);
+    }
+}
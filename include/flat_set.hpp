@@ -0,0 +1,496 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "_flat_tree.hpp"
+#include "functional.hpp"
+#include "utility.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace ft
+{
+    // Sorted vector set, iterators are invalidated by every insert and erase.
+    template <typename T, typename TComp = ft::less<T>, typename TAlloc = std::allocator<T> >
+    class flat_set
+    {
+    public:
+        typedef T key_type;
+        typedef T value_type;
+        typedef TComp key_compare;
+        typedef TComp value_compare;
+        typedef TAlloc allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+    protected:
+        typedef ft::_flat_key_storage<value_type, allocator_type> storage_type;
+        typedef ft::_flat_tree<storage_type, key_compare> container_type;
+
+    public:
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+        typedef typename container_type::iterator iterator; // const value cause key equals value
+        typedef typename container_type::const_iterator const_iterator;
+        typedef typename ft::reverse_iterator<iterator> reverse_iterator;
+        typedef typename ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        container_type c;
+
+    public:
+        flat_set()
+            : c() {}
+
+        explicit flat_set(const key_compare& comp, const allocator_type& alloc = allocator_type())
+            : c(comp, alloc) {}
+
+        template <typename UIter>
+        // flat_set(UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        flat_set(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            : c(comp, alloc)
+        {
+            this->insert(first, last);
+        }
+
+        template <typename UIter>
+        // flat_set(ft::sorted_unique_t, UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        flat_set(ft::sorted_unique_t, typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            : c(comp, alloc)
+        {
+            this->insert(ft::sorted_unique, first, last);
+        }
+
+        flat_set(const flat_set& that)
+            : c(that.c) {}
+
+#if __cplusplus >= 201103L
+        flat_set(flat_set&& that) noexcept(noexcept(container_type(ft::declval<container_type>())))
+            : c(ft::move(that.c)) {}
+#endif
+
+        ~flat_set() {}
+
+    public:
+        flat_set& operator=(const flat_set& that)
+        {
+            this->c = that.c;
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        flat_set& operator=(flat_set&& that)
+        {
+            this->c = ft::move(that.c);
+            return *this;
+        }
+#endif
+
+    public:
+        allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
+
+    public:
+        iterator begin() { return this->c.begin(); }
+        const_iterator begin() const { return this->c.begin(); }
+        iterator end() { return this->c.end(); }
+        const_iterator end() const { return this->c.end(); }
+        reverse_iterator rbegin() { return this->c.rbegin(); }
+        const_reverse_iterator rbegin() const { return this->c.rbegin(); }
+        reverse_iterator rend() { return this->c.rend(); }
+        const_reverse_iterator rend() const { return this->c.rend(); }
+
+    public:
+        bool empty() const { return this->c.empty(); }
+        size_type size() const { return this->c.size(); }
+        size_type max_size() const { return this->c.max_size(); }
+        size_type capacity() const { return this->c.capacity(); }
+        void reserve(size_type n) { this->c.reserve(n); }
+
+    public:
+        void clear() { return this->c.clear(); }
+
+        ft::pair<iterator, bool> insert(const value_type& value)
+        {
+            return this->c.insert_unique(this->c.end(), value);
+        }
+
+        iterator insert(iterator hint, const value_type& value)
+        {
+            return this->c.insert_unique(hint, value).first;
+        }
+
+        template <typename UIter>
+        // void insert(UIter first, UIter last)
+        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
+        {
+            this->c.insert_range_unique(first, last);
+        }
+
+        template <typename UIter>
+        // void insert(ft::sorted_unique_t, UIter first, UIter last)
+        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(ft::sorted_unique_t, UIter first, UIter last)
+        {
+            this->c.insert_range_unique(ft::sorted_unique, first, last);
+        }
+
+#if __cplusplus >= 201103L
+        ft::pair<iterator, bool> insert(value_type&& value)
+        {
+            return this->c.emplace_unique(this->c.end(), ft::move(value));
+        }
+
+        iterator insert(iterator hint, value_type&& value)
+        {
+            return this->c.emplace_unique(hint, ft::move(value)).first;
+        }
+
+        // the key has to exist before it can be compared, it then moves into the array
+        template <typename... Args>
+        ft::pair<iterator, bool> emplace(Args&&... args)
+        {
+            value_type value(ft::forward<Args>(args)...);
+            return this->c.emplace_unique(this->c.end(), ft::move(value));
+        }
+
+        template <typename... Args>
+        iterator emplace_hint(iterator hint, Args&&... args)
+        {
+            value_type value(ft::forward<Args>(args)...);
+            return this->c.emplace_unique(hint, ft::move(value)).first;
+        }
+#endif
+
+        iterator erase(iterator pos)
+        {
+            return this->c.erase(pos, pos + 1);
+        }
+
+        iterator erase(iterator first, iterator last)
+        {
+            return this->c.erase(first, last);
+        }
+
+        size_type erase(const key_type& key)
+        {
+            iterator it = this->find(key);
+            if (it == this->end())
+            {
+                return 0;
+            }
+            this->erase(it);
+            return 1;
+        }
+
+        void swap(flat_set& that) { this->c.swap(that.c); }
+
+    public:
+        size_type count(const key_type& key) const { return this->c.count(key); }
+
+        iterator find(const key_type& key) { return this->c.find(key); }
+        const_iterator find(const key_type& key) const { return this->c.find(key); }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+
+        iterator lower_bound(const key_type& key) { return this->c.lower_bound(key); }
+        const_iterator lower_bound(const key_type& key) const { return this->c.lower_bound(key); }
+
+        iterator upper_bound(const key_type& key) { return this->c.upper_bound(key); }
+        const_iterator upper_bound(const key_type& key) const { return this->c.upper_bound(key); }
+
+    public:
+        key_compare key_comp() const { return this->c.key_comp(); }
+        value_compare value_comp() const { return this->c.key_comp(); }
+
+    public:
+        friend bool operator==(const flat_set& lhs, const flat_set& rhs)
+        {
+            return lhs.c == rhs.c;
+        }
+
+        friend bool operator!=(const flat_set& lhs, const flat_set& rhs)
+        {
+            return lhs.c != rhs.c;
+        }
+
+        friend bool operator<(const flat_set& lhs, const flat_set& rhs)
+        {
+            return lhs.c < rhs.c;
+        }
+
+        friend bool operator<=(const flat_set& lhs, const flat_set& rhs)
+        {
+            return lhs.c <= rhs.c;
+        }
+
+        friend bool operator>(const flat_set& lhs, const flat_set& rhs)
+        {
+            return lhs.c > rhs.c;
+        }
+
+        friend bool operator>=(const flat_set& lhs, const flat_set& rhs)
+        {
+            return lhs.c >= rhs.c;
+        }
+    };
+
+    template <typename T, typename TComp, typename TAlloc>
+    inline void swap(
+        flat_set<T, TComp, TAlloc>& lhs,
+        flat_set<T, TComp, TAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <typename T, typename TComp = ft::less<T>, typename TAlloc = std::allocator<T> >
+    class flat_multiset
+    {
+    public:
+        typedef T key_type;
+        typedef T value_type;
+        typedef TComp key_compare;
+        typedef TComp value_compare;
+        typedef TAlloc allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+    protected:
+        typedef ft::_flat_key_storage<value_type, allocator_type> storage_type;
+        typedef ft::_flat_tree<storage_type, key_compare> container_type;
+
+    public:
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+        typedef typename container_type::iterator iterator; // const value cause key equals value
+        typedef typename container_type::const_iterator const_iterator;
+        typedef typename ft::reverse_iterator<iterator> reverse_iterator;
+        typedef typename ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        container_type c;
+
+    public:
+        flat_multiset()
+            : c() {}
+
+        explicit flat_multiset(const key_compare& comp, const allocator_type& alloc = allocator_type())
+            : c(comp, alloc) {}
+
+        template <typename UIter>
+        // flat_multiset(UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        flat_multiset(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            : c(comp, alloc)
+        {
+            this->insert(first, last);
+        }
+
+        template <typename UIter>
+        // flat_multiset(ft::sorted_equivalent_t, UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        flat_multiset(ft::sorted_equivalent_t, typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            : c(comp, alloc)
+        {
+            this->insert(ft::sorted_equivalent, first, last);
+        }
+
+        flat_multiset(const flat_multiset& that)
+            : c(that.c) {}
+
+#if __cplusplus >= 201103L
+        flat_multiset(flat_multiset&& that) noexcept(noexcept(container_type(ft::declval<container_type>())))
+            : c(ft::move(that.c)) {}
+#endif
+
+        ~flat_multiset() {}
+
+    public:
+        flat_multiset& operator=(const flat_multiset& that)
+        {
+            this->c = that.c;
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        flat_multiset& operator=(flat_multiset&& that)
+        {
+            this->c = ft::move(that.c);
+            return *this;
+        }
+#endif
+
+    public:
+        allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
+
+    public:
+        iterator begin() { return this->c.begin(); }
+        const_iterator begin() const { return this->c.begin(); }
+        iterator end() { return this->c.end(); }
+        const_iterator end() const { return this->c.end(); }
+        reverse_iterator rbegin() { return this->c.rbegin(); }
+        const_reverse_iterator rbegin() const { return this->c.rbegin(); }
+        reverse_iterator rend() { return this->c.rend(); }
+        const_reverse_iterator rend() const { return this->c.rend(); }
+
+    public:
+        bool empty() const { return this->c.empty(); }
+        size_type size() const { return this->c.size(); }
+        size_type max_size() const { return this->c.max_size(); }
+        size_type capacity() const { return this->c.capacity(); }
+        void reserve(size_type n) { this->c.reserve(n); }
+
+    public:
+        void clear() { return this->c.clear(); }
+
+        iterator insert(const value_type& value)
+        {
+            return this->c.insert_equal(this->c.end(), value);
+        }
+
+        iterator insert(iterator hint, const value_type& value)
+        {
+            return this->c.insert_equal(hint, value);
+        }
+
+        template <typename UIter>
+        // void insert(UIter first, UIter last)
+        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
+        {
+            this->c.insert_range_equal(first, last);
+        }
+
+        template <typename UIter>
+        // void insert(ft::sorted_equivalent_t, UIter first, UIter last)
+        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(ft::sorted_equivalent_t, UIter first, UIter last)
+        {
+            this->c.insert_range_equal(ft::sorted_equivalent, first, last);
+        }
+
+#if __cplusplus >= 201103L
+        iterator insert(value_type&& value)
+        {
+            return this->c.emplace_equal(this->c.end(), ft::move(value));
+        }
+
+        iterator insert(iterator hint, value_type&& value)
+        {
+            return this->c.emplace_equal(hint, ft::move(value));
+        }
+
+        template <typename... Args>
+        iterator emplace(Args&&... args)
+        {
+            value_type value(ft::forward<Args>(args)...);
+            return this->c.emplace_equal(this->c.end(), ft::move(value));
+        }
+
+        template <typename... Args>
+        iterator emplace_hint(iterator hint, Args&&... args)
+        {
+            value_type value(ft::forward<Args>(args)...);
+            return this->c.emplace_equal(hint, ft::move(value));
+        }
+#endif
+
+        iterator erase(iterator pos)
+        {
+            return this->c.erase(pos, pos + 1);
+        }
+
+        iterator erase(iterator first, iterator last)
+        {
+            return this->c.erase(first, last);
+        }
+
+        size_type erase(const key_type& key)
+        {
+            ft::pair<iterator, iterator> range = this->equal_range(key);
+            size_type n = range.second - range.first;
+            this->c.erase(range.first, range.second);
+            return n;
+        }
+
+        void swap(flat_multiset& that) { this->c.swap(that.c); }
+
+    public:
+        size_type count(const key_type& key) const { return this->c.count(key); }
+
+        iterator find(const key_type& key) { return this->c.find(key); }
+        const_iterator find(const key_type& key) const { return this->c.find(key); }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+
+        iterator lower_bound(const key_type& key) { return this->c.lower_bound(key); }
+        const_iterator lower_bound(const key_type& key) const { return this->c.lower_bound(key); }
+
+        iterator upper_bound(const key_type& key) { return this->c.upper_bound(key); }
+        const_iterator upper_bound(const key_type& key) const { return this->c.upper_bound(key); }
+
+    public:
+        key_compare key_comp() const { return this->c.key_comp(); }
+        value_compare value_comp() const { return this->c.key_comp(); }
+
+    public:
+        friend bool operator==(const flat_multiset& lhs, const flat_multiset& rhs)
+        {
+            return lhs.c == rhs.c;
+        }
+
+        friend bool operator!=(const flat_multiset& lhs, const flat_multiset& rhs)
+        {
+            return lhs.c != rhs.c;
+        }
+
+        friend bool operator<(const flat_multiset& lhs, const flat_multiset& rhs)
+        {
+            return lhs.c < rhs.c;
+        }
+
+        friend bool operator<=(const flat_multiset& lhs, const flat_multiset& rhs)
+        {
+            return lhs.c <= rhs.c;
+        }
+
+        friend bool operator>(const flat_multiset& lhs, const flat_multiset& rhs)
+        {
+            return lhs.c > rhs.c;
+        }
+
+        friend bool operator>=(const flat_multiset& lhs, const flat_multiset& rhs)
+        {
+            return lhs.c >= rhs.c;
+        }
+    };
+
+    template <typename T, typename TComp, typename TAlloc>
+    inline void swap(
+        flat_multiset<T, TComp, TAlloc>& lhs,
+        flat_multiset<T, TComp, TAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+namespace std
+{
+    template <typename T, typename TComp, typename TAlloc>
+    inline void swap(
+        ft::flat_set<T, TComp, TAlloc>& lhs,
+        ft::flat_set<T, TComp, TAlloc>& rhs)
+    {
+        ft::swap(lhs, rhs);
+    }
+
+    template <typename T, typename TComp, typename TAlloc>
+    inline void swap(
+        ft::flat_multiset<T, TComp, TAlloc>& lhs,
+        ft::flat_multiset<T, TComp, TAlloc>& rhs)
+    {
+        ft::swap(lhs, rhs);
+    }
+}
@@ -3,4 +3,5 @@
 
 #pragma once
 
+#include "functional/hash.hpp"
 #include "functional/operator_function_objects.hpp"
@@ -0,0 +1,26 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+namespace ft
+{
+    // Key selectors of the associative containers
+    template <typename T>
+    struct _select_first
+    {
+        const typename T::first_type& operator()(const T& t) const
+        {
+            return t.first;
+        }
+    };
+
+    template <typename T>
+    struct _select_self
+    {
+        const T& operator()(const T& t) const
+        {
+            return t;
+        }
+    };
+}
@@ -0,0 +1,123 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace ft
+{
+    namespace _internal
+    {
+        // FNV-1a over the object representation
+        inline std::size_t hash_bytes(const void* p, std::size_t n)
+        {
+            const std::size_t prime = sizeof(std::size_t) > 4 ? (std::size_t(0x100) << 16 << 16) | 0x1B3 : 0x01000193;
+            std::size_t h = sizeof(std::size_t) > 4 ? (std::size_t(0xCBF29CE4) << 16 << 16) | 0x84222325 : 0x811C9DC5;
+            const unsigned char* bytes = static_cast<const unsigned char*>(p);
+            for (std::size_t i = 0; i < n; i++)
+            {
+                h ^= bytes[i];
+                h *= prime;
+            }
+            return h;
+        }
+
+        template <typename T>
+        struct _hash_integral
+        {
+            std::size_t operator()(T value) const { return static_cast<std::size_t>(value); }
+        };
+
+        template <typename T>
+        struct _hash_floating_point
+        {
+            std::size_t operator()(T value) const
+            {
+                // 0.0 and -0.0 compare equal
+                return value == T() ? 0 : _internal::hash_bytes(&value, sizeof(value));
+            }
+        };
+    }
+
+    // Hash functors are only defined for the types below, plus any user specialization.
+    // Integral hashes are the identity; the unordered containers mix the bits themselves.
+    template <typename T>
+    struct hash;
+
+    template <typename T>
+    struct hash<T*>
+    {
+        std::size_t operator()(T* value) const { return reinterpret_cast<std::size_t>(value); }
+    };
+
+    /// Integral types
+    template <>
+    struct hash<bool> : _internal::_hash_integral<bool>
+    {
+    };
+    template <>
+    struct hash<char> : _internal::_hash_integral<char>
+    {
+    };
+    template <>
+    struct hash<signed char> : _internal::_hash_integral<signed char>
+    {
+    };
+    template <>
+    struct hash<unsigned char> : _internal::_hash_integral<unsigned char>
+    {
+    };
+    template <>
+    struct hash<wchar_t> : _internal::_hash_integral<wchar_t>
+    {
+    };
+    template <>
+    struct hash<short int> : _internal::_hash_integral<short int>
+    {
+    };
+    template <>
+    struct hash<unsigned short int> : _internal::_hash_integral<unsigned short int>
+    {
+    };
+    template <>
+    struct hash<int> : _internal::_hash_integral<int>
+    {
+    };
+    template <>
+    struct hash<unsigned int> : _internal::_hash_integral<unsigned int>
+    {
+    };
+    template <>
+    struct hash<long int> : _internal::_hash_integral<long int>
+    {
+    };
+    template <>
+    struct hash<unsigned long int> : _internal::_hash_integral<unsigned long int>
+    {
+    };
+
+    /// Floating point types
+    template <>
+    struct hash<float> : _internal::_hash_floating_point<float>
+    {
+    };
+    template <>
+    struct hash<double> : _internal::_hash_floating_point<double>
+    {
+    };
+    template <>
+    struct hash<long double>
+    {
+        // the object representation of long double may contain padding
+        std::size_t operator()(long double value) const { return hash<double>()(static_cast<double>(value)); }
+    };
+
+    /// Strings
+    template <>
+    struct hash<std::string>
+    {
+        std::size_t operator()(const std::string& value) const { return _internal::hash_bytes(value.data(), value.size()); }
+    };
+}
@@ -170,5 +170,22 @@ namespace ft
         {
             return lhs.base() - rhs.base();
         }
+
+        // Strip contiguous iterator wrappers down to the raw pointer.
+        template <typename TIter>
+        struct _unwrap_iterator
+        {
+            typedef TIter type;
+
+            static type unwrap(const TIter& it) { return it; }
+        };
+
+        template <typename TIter, typename _TCont>
+        struct _unwrap_iterator<_pointer_iterator<TIter, _TCont> >
+        {
+            typedef TIter type;
+
+            static type unwrap(const _pointer_iterator<TIter, _TCont>& it) { return it.base(); }
+        };
     }
 }
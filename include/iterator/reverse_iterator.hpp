@@ -10,6 +10,22 @@
 
 namespace ft
 {
+    namespace _internal
+    {
+        // Class iterators may hand out a proxy pointer, so forward to their operator->.
+        template <typename TIter>
+        inline typename ft::iterator_traits<TIter>::pointer arrow(const TIter& it)
+        {
+            return it.operator->();
+        }
+
+        template <typename T>
+        inline T* arrow(T* it)
+        {
+            return it;
+        }
+    }
+
     template <typename TIter>
     class reverse_iterator
         : public iterator<typename ft::iterator_traits<TIter>::iterator_category,
@@ -48,7 +64,8 @@ namespace ft
 
         pointer operator->() const
         {
-            return ft::addressof(*(*this));
+            TIter tmp = this->current;
+            return _internal::arrow(--tmp);
         }
 
         reference operator[](difference_type n) const
@@ -6,14 +6,35 @@
 #include "algorithm.hpp"
 #include "functional.hpp"
 #include "iterator.hpp"
+#include "memory/_allocator_hooks.hpp"
 #include "stdexcept.hpp"
 #include "type_traits.hpp"
+#include "utility.hpp"
+#include "utility/_in_place.hpp"
 
+#include <cassert>
 #include <cstddef>
 #include <limits>
+#include <new>
+
+#if __cplusplus >= 201103L
+#include <exception>
+#include <thread>
+#endif
 
 namespace ft
 {
+    namespace _internal
+    {
+        enum
+        {
+            _list_buffer_sort_threshold = 1 << 12,
+            _list_sorted_run_length = 16,
+            _parallel_sort_grain = 1 << 14,
+            _parallel_sort_max_threads = 64
+        };
+    }
+
     struct _list_node_base
     {
         typedef _list_node_base* pointer_type;
@@ -44,6 +65,12 @@ namespace ft
         explicit _list_node(const T& data)
             : _list_node_base(), data(data) {}
 
+#if __cplusplus >= 201103L
+        template <typename... Args>
+        explicit _list_node(_internal::_in_place_t, Args&&... args)
+            : _list_node_base(), data(ft::forward<Args>(args)...) {}
+#endif
+
         _list_node(const _list_node& that)
             : _list_node_base(that), data(that.data) {}
 
@@ -281,6 +308,15 @@ namespace ft
             this->assign(that.begin(), that.end());
         }
 
+#if __cplusplus >= 201103L
+        list(list&& that) noexcept(_internal::_is_nothrow_copy_constructible<node_allocator_type>::value)
+            : header(), alloc(that.alloc), number()
+        {
+            this->reset();
+            this->swap(that);
+        }
+#endif
+
         ~list()
         {
             static_cast<void>(this->destruct(this->header.next, &this->header));
@@ -295,6 +331,18 @@ namespace ft
             return *this;
         }
 
+#if __cplusplus >= 201103L
+        list& operator=(list&& that)
+        {
+            if (this != &that)
+            {
+                list temp(ft::move(that));
+                this->swap(temp);
+            }
+            return *this;
+        }
+#endif
+
     protected:
         size_type destruct(_list_node_base::pointer_type node, _list_node_base::pointer_type node_end)
         {
@@ -304,7 +352,7 @@ namespace ft
                 _list_node_base::pointer_type next = node->next;
 
                 node_type* data_node = static_cast<node_type*>(node);
-                this->alloc.destroy(data_node);
+                _internal::_destroy_node(this->alloc, data_node);
                 this->alloc.deallocate(data_node, 1);
                 distance++;
 
@@ -319,12 +367,29 @@ namespace ft
             this->header.next = &this->header;
         }
 
+#if __cplusplus >= 201103L
+        template <typename... Args>
+        node_type* create_node(Args&&... args)
+        {
+            node_type* node = this->alloc.allocate(1);
+            try
+            {
+                _internal::_construct_node(this->alloc, node, _internal::_in_place_t(), ft::forward<Args>(args)...);
+                return node;
+            }
+            catch (...)
+            {
+                this->alloc.deallocate(node, 1);
+                throw;
+            }
+        }
+#else
         node_type* create_node(const value_type& value)
         {
             node_type* node = this->alloc.allocate(1);
             try
             {
-                this->alloc.construct(node, node_type(value));
+                _internal::_construct_node(this->alloc, node, value);
                 return node;
             }
             catch (...)
@@ -333,6 +398,7 @@ namespace ft
                 throw;
             }
         }
+#endif
 
     public:
         void assign(size_type count, const value_type& value)
@@ -425,6 +491,7 @@ namespace ft
             static_cast<void>(this->destruct(this->header.next, &this->header));
             this->reset();
             this->number = size_type();
+            _internal::release_all(this->alloc);
         }
 
         iterator insert(iterator pos, const value_type& value)
@@ -551,6 +618,44 @@ namespace ft
             static_cast<void>(this->erase(this->begin()));
         }
 
+#if __cplusplus >= 201103L
+        iterator insert(iterator pos, value_type&& value)
+        {
+            return this->emplace(pos, ft::move(value));
+        }
+
+        template <typename... Args>
+        iterator emplace(iterator pos, Args&&... args)
+        {
+            node_type* node = this->create_node(ft::forward<Args>(args)...);
+            this->link(pos.base(), node, node);
+            this->number++;
+            return iterator(node);
+        }
+
+        void push_back(value_type&& value)
+        {
+            static_cast<void>(this->emplace(this->end(), ft::move(value)));
+        }
+
+        template <typename... Args>
+        void emplace_back(Args&&... args)
+        {
+            static_cast<void>(this->emplace(this->end(), ft::forward<Args>(args)...));
+        }
+
+        void push_front(value_type&& value)
+        {
+            static_cast<void>(this->emplace(this->begin(), ft::move(value)));
+        }
+
+        template <typename... Args>
+        void emplace_front(Args&&... args)
+        {
+            static_cast<void>(this->emplace(this->begin(), ft::forward<Args>(args)...));
+        }
+#endif
+
         void resize(size_type count, value_type value = value_type())
         {
             size_type size = this->size();
@@ -623,6 +728,7 @@ namespace ft
             {
                 return;
             }
+            assert(this->alloc == that.alloc);
 
             iterator b1 = this->begin();
             iterator e1 = this->end();
@@ -669,6 +775,8 @@ namespace ft
                 // NOTE: Undefined behavior
                 return;
             }
+            // the nodes are relinked, that must be able to free them here
+            assert(this->alloc == that.alloc);
 
             _list_node_base::pointer_type head = that.header.next;
             if (head != &that.header)
@@ -688,6 +796,7 @@ namespace ft
                 _list_node_base::pointer_type node = it.base();
                 if (this != &that)
                 {
+                    assert(this->alloc == that.alloc);
                     this->number++;
                     that.number--;
                 }
@@ -706,6 +815,7 @@ namespace ft
                 _list_node_base::pointer_type head = first.base();
                 if (this != &that)
                 {
+                    assert(this->alloc == that.alloc);
                     difference_type distance = ft::distance(first, last);
                     this->number += distance;
                     that.number -= distance;
@@ -806,77 +916,419 @@ namespace ft
             this->sort(ft::less<value_type>());
         }
 
+        // Bottom-up merge of the runs already in order, presorted input costs a single pass.
         template <typename TComp>
         void sort(TComp comp)
         {
-            this->sort_internal(this->begin(), this->end(), this->size(), comp);
+            if (this->number < 2)
+            {
+                return;
+            }
+            if (this->number >= _internal::_list_buffer_sort_threshold && this->buffer_sort(comp))
+            {
+                return;
+            }
+
+            _list_node_base::pointer_type chain = this->detach_chain();
+            try
+            {
+                list::sort_chain(chain, comp);
+            }
+            catch (...)
+            {
+                this->attach_chain(chain);
+                throw;
+            }
+            this->attach_chain(chain);
+        }
+
+#if __cplusplus >= 201103L
+        void parallel_sort()
+        {
+            this->parallel_sort(ft::less<value_type>());
         }
 
+        // Sorts consecutive slices on their own threads, each with a copy of comp, then merges them.
+        // threads == 0 asks the hardware, short lists are sorted in place.
+        template <typename TComp>
+        void parallel_sort(TComp comp, unsigned threads = 0)
+        {
+            if (threads == 0)
+            {
+                threads = std::thread::hardware_concurrency();
+            }
+            if (threads > _internal::_parallel_sort_max_threads)
+            {
+                threads = _internal::_parallel_sort_max_threads;
+            }
+            if (threads > this->number / _internal::_parallel_sort_grain)
+            {
+                threads = static_cast<unsigned>(this->number / _internal::_parallel_sort_grain);
+            }
+            if (threads < 2)
+            {
+                this->sort(comp);
+                return;
+            }
+
+            _list_node_base::pointer_type chains[_internal::_parallel_sort_max_threads];
+            std::exception_ptr errors[_internal::_parallel_sort_max_threads];
+            std::thread workers[_internal::_parallel_sort_max_threads];
+
+            size_type slice = this->number / threads;
+            _list_node_base::pointer_type chain = this->detach_chain();
+            for (unsigned i = 0; i < threads; ++i)
+            {
+                chains[i] = chain;
+                if (i + 1 < threads)
+                {
+                    for (size_type n = 1; n < slice; ++n)
+                    {
+                        chain = chain->next;
+                    }
+                    _list_node_base::pointer_type next = chain->next;
+                    chain->next = _list_node_base::pointer_type();
+                    chain = next;
+                }
+            }
+
+            for (unsigned i = 1; i < threads; ++i)
+            {
+                try
+                {
+                    workers[i] = std::thread(&list::sort_slice<TComp>, &chains[i], comp, &errors[i]);
+                }
+                catch (...)
+                {
+                    // no thread to spare, the slice is sorted here
+                    list::sort_slice(&chains[i], comp, &errors[i]);
+                }
+            }
+            list::sort_slice(&chains[0], comp, &errors[0]);
+
+            std::exception_ptr error;
+            for (unsigned i = 0; i < threads; ++i)
+            {
+                if (workers[i].joinable())
+                {
+                    workers[i].join();
+                }
+                if (!error && errors[i])
+                {
+                    error = errors[i];
+                }
+            }
+
+            if (!error)
+            {
+                try
+                {
+                    // pairwise, the earlier slice first keeps the sort stable
+                    for (unsigned width = 1; width < threads; width *= 2)
+                    {
+                        for (unsigned i = 0; i + width < threads; i += 2 * width)
+                        {
+                            _list_node_base::pointer_type b = chains[i + width];
+                            chains[i + width] = _list_node_base::pointer_type();
+                            list::merge_chains(chains[i], b, comp);
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+            }
+
+            if (error)
+            {
+                chain = _list_node_base::pointer_type();
+                for (unsigned i = threads; i-- > 0;)
+                {
+                    chain = list::concat_chains(chains[i], chain);
+                }
+                this->attach_chain(chain);
+                std::rethrow_exception(error);
+            }
+            this->attach_chain(chains[0]);
+        }
+#endif
+
     protected:
-        template <class TComp>
-        typename list::iterator sort_internal(iterator f1, iterator e2, size_type n, TComp& comp)
+#if __cplusplus >= 201103L
+        template <typename TComp>
+        static void sort_slice(_list_node_base::pointer_type* chain, TComp comp, std::exception_ptr* error)
         {
-            switch (n)
+            try
+            {
+                list::sort_chain(*chain, comp);
+            }
+            catch (...)
             {
-            case 0:
-            case 1:
-                return f1;
-            case 2:
-                if (comp(*--e2, *f1))
+                *error = std::current_exception();
+            }
+        }
+#endif
+
+        static const value_type& chain_value(_list_node_base::pointer_type node)
+        {
+            return static_cast<node_type*>(node)->data;
+        }
+
+        struct sort_entry
+        {
+            _list_node_base::pointer_type node;
+            size_type order;
+        };
+
+        // ties fall back to the order in the list, which keeps an unstable sort stable
+        template <typename TComp>
+        struct sort_entry_compare
+        {
+            TComp* comp;
+
+            explicit sort_entry_compare(TComp& comp)
+                : comp(&comp) {}
+
+            bool operator()(const sort_entry& lhs, const sort_entry& rhs) const
+            {
+                if ((*this->comp)(chain_value(lhs.node), chain_value(rhs.node)))
                 {
-                    _list_node_base::pointer_type f = e2.base();
-                    this->unlink(f, f);
-                    this->link(f1.base(), f, f);
-                    return e2;
+                    return true;
                 }
-                return f1;
-            }
-            size_type n2 = n / 2;
-            iterator e1 = f1;
-            ft::advance(e1, n2);
-            iterator r = f1 = this->sort_internal(f1, e1, n2, comp);
-            iterator f2 = e1 = this->sort_internal(e1, e2, n - n2, comp);
-            if (comp(*f2, *f1))
-            {
-                iterator m2 = f2;
-                ++m2;
-                for (; m2 != e2 && comp(*m2, *f1); ++m2)
-                    ;
-                _list_node_base::pointer_type f = f2.base();
-                _list_node_base::pointer_type l = m2.base()->prev;
-                r = f2;
-                e1 = f2 = m2;
-                this->unlink(f, l);
-                m2 = f1;
-                ++m2;
-                this->link(f1.base(), f, l);
-                f1 = m2;
+                if ((*this->comp)(chain_value(rhs.node), chain_value(lhs.node)))
+                {
+                    return false;
+                }
+                return lhs.order < rhs.order;
             }
-            else
-                ++f1;
-            while (f1 != e1 && f2 != e2)
+        };
+
+        // Sorts an array of node pointers with ft::sort and relinks the nodes in one pass,
+        // so no merge level chases next pointers across the heap.
+        // Declines (false) when the buffer cannot be had or the list is mostly long runs,
+        // which the run merge handles in fewer passes. The list is untouched if comp throws.
+        template <typename TComp>
+        bool buffer_sort(TComp& comp)
+        {
+            typedef typename TAlloc::template rebind<sort_entry>::other entry_allocator_type;
+
+            entry_allocator_type entry_alloc(this->alloc);
+            size_type n = this->number;
+            sort_entry* entries;
+            try
+            {
+                entries = entry_alloc.allocate(n);
+            }
+            catch (const std::bad_alloc&)
+            {
+                return false;
+            }
+
+            try
             {
-                if (comp(*f2, *f1))
+                size_type descents = size_type();
+                size_type i = size_type();
+                for (_list_node_base::pointer_type node = this->header.next; node != &this->header; node = node->next, ++i)
                 {
-                    iterator m2 = f2;
-                    ++m2;
-                    for (; m2 != e2 && comp(*m2, *f1); ++m2)
-                        ;
-                    _list_node_base::pointer_type f = f2.base();
-                    _list_node_base::pointer_type l = m2.base()->prev;
-                    if (e1 == f2)
-                        e1 = m2;
-                    f2 = m2;
-                    this->unlink(f, l);
-                    m2 = f1;
-                    ++m2;
-                    this->link(f1.base(), f, l);
-                    f1 = m2;
+                    entries[i].node = node;
+                    entries[i].order = i;
+                    if (i != 0 && comp(chain_value(node), chain_value(entries[i - 1].node)))
+                    {
+                        descents++;
+                    }
                 }
-                else
-                    ++f1;
+
+                if (descents == 0)
+                {
+                    entry_alloc.deallocate(entries, n);
+                    return true;
+                }
+                if ((descents + 1) * _internal::_list_sorted_run_length <= n)
+                {
+                    entry_alloc.deallocate(entries, n);
+                    return false;
+                }
+
+                ft::sort(entries, entries + n, sort_entry_compare<TComp>(comp));
+            }
+            catch (...)
+            {
+                entry_alloc.deallocate(entries, n);
+                throw;
+            }
+
+            _list_node_base::pointer_type prev = &this->header;
+            for (size_type i = size_type(); i != n; ++i)
+            {
+                _list_node_base::pointer_type node = entries[i].node;
+                prev->next = node;
+                node->prev = prev;
+                prev = node;
+            }
+            prev->next = &this->header;
+            this->header.prev = prev;
+
+            entry_alloc.deallocate(entries, n);
+            return true;
+        }
+
+        // Hands out the nodes as a chain linked by next and ended by NULL, the size is kept.
+        _list_node_base::pointer_type detach_chain()
+        {
+            _list_node_base::pointer_type chain = this->header.next;
+            this->header.prev->next = _list_node_base::pointer_type();
+            this->header.next = &this->header;
+            this->header.prev = &this->header;
+            return chain;
+        }
+
+        void attach_chain(_list_node_base::pointer_type chain)
+        {
+            _list_node_base::pointer_type prev = &this->header;
+            for (; chain != NULL; chain = chain->next)
+            {
+                prev->next = chain;
+                chain->prev = prev;
+                prev = chain;
+            }
+            prev->next = &this->header;
+            this->header.prev = prev;
+        }
+
+        static _list_node_base::pointer_type concat_chains(_list_node_base::pointer_type a, _list_node_base::pointer_type b)
+        {
+            if (a == NULL)
+            {
+                return b;
+            }
+            _list_node_base::pointer_type tail = a;
+            while (tail->next != NULL)
+            {
+                tail = tail->next;
+            }
+            tail->next = b;
+            return a;
+        }
+
+        // Stable, a wins ties. If comp throws every node is left in a.
+        template <typename TComp>
+        static void merge_chains(_list_node_base::pointer_type& a, _list_node_base::pointer_type b, TComp& comp)
+        {
+            _list_node_base head;
+            _list_node_base::pointer_type tail = &head;
+            try
+            {
+                while (a != NULL && b != NULL)
+                {
+                    if (comp(chain_value(b), chain_value(a)))
+                    {
+                        tail->next = b;
+                        tail = b;
+                        b = b->next;
+                    }
+                    else
+                    {
+                        tail->next = a;
+                        tail = a;
+                        a = a->next;
+                    }
+                }
+            }
+            catch (...)
+            {
+                tail->next = list::concat_chains(a, b);
+                a = head.next;
+                throw;
+            }
+            tail->next = a != NULL ? a : b;
+            a = head.next;
+        }
+
+        // Takes the ascending (or strictly descending, reversed) runs one by one and merges
+        // them like a binary counter: levels[i] holds 2^i runs, so the work is O(n log runs).
+        // If comp throws every node is left in chain.
+        template <typename TComp>
+        static void sort_chain(_list_node_base::pointer_type& chain, TComp& comp)
+        {
+            _list_node_base::pointer_type levels[std::numeric_limits<size_type>::digits];
+            size_type depth = size_type();
+            _list_node_base::pointer_type rest = chain;
+            _list_node_base::pointer_type run = _list_node_base::pointer_type();
+            try
+            {
+                while (rest != NULL)
+                {
+                    _list_node_base::pointer_type next = rest->next;
+                    if (next != NULL && comp(chain_value(next), chain_value(rest)))
+                    {
+                        // reversing a strictly descending run keeps equal elements in order
+                        run = rest;
+                        rest = next;
+                        run->next = _list_node_base::pointer_type();
+                        do
+                        {
+                            next = rest->next;
+                            rest->next = run;
+                            run = rest;
+                            rest = next;
+                        } while (rest != NULL && comp(chain_value(rest), chain_value(run)));
+                    }
+                    else
+                    {
+                        _list_node_base::pointer_type last = rest;
+                        if (next != NULL)
+                        {
+                            last = next;
+                            next = next->next;
+                        }
+                        while (next != NULL && !comp(chain_value(next), chain_value(last)))
+                        {
+                            last = next;
+                            next = next->next;
+                        }
+                        last->next = _list_node_base::pointer_type();
+                        run = rest;
+                        rest = next;
+                    }
+
+                    size_type i = size_type();
+                    for (; i < depth && levels[i] != NULL; ++i)
+                    {
+                        _list_node_base::pointer_type b = run;
+                        run = levels[i];
+                        levels[i] = _list_node_base::pointer_type();
+                        list::merge_chains(run, b, comp);
+                    }
+                    if (i == depth)
+                    {
+                        depth++;
+                    }
+                    levels[i] = run;
+                    run = _list_node_base::pointer_type();
+                }
+
+                for (size_type i = size_type(); i < depth; ++i)
+                {
+                    if (levels[i] != NULL)
+                    {
+                        _list_node_base::pointer_type b = run;
+                        run = levels[i];
+                        levels[i] = _list_node_base::pointer_type();
+                        list::merge_chains(run, b, comp);
+                    }
+                }
+            }
+            catch (...)
+            {
+                chain = list::concat_chains(run, rest);
+                for (size_type i = size_type(); i < depth; ++i)
+                {
+                    chain = list::concat_chains(levels[i], chain);
+                }
+                throw;
             }
-            return r;
+            chain = run;
         }
 
     public:
@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include "_node_handle.hpp"
 #include "_tree.hpp"
 #include "functional.hpp"
+#include "functional/_select.hpp"
 #include "stdexcept.hpp"
 #include "utility.hpp"
 
@@ -13,480 +15,756 @@
 
 namespace ft
 {
-    template <typename T>
-    struct _select_first
+    namespace FT_TREE_LAYOUT
     {
-        typename T::first_type operator()(const T& t) const
-        {
-            return t.first;
-        }
-    };
+        template <typename TKey, typename TMapped, typename TComp, typename TAlloc>
+        class multimap;
 
-    template <typename TKey, typename TMapped, typename TComp = ft::less<TKey>, typename TAlloc = std::allocator<ft::pair<const TKey, TMapped> > >
-    class map
-    {
-    public:
-        typedef TKey key_type;
-        typedef TMapped mapped_type;
-        typedef ft::pair<const TKey, TMapped> value_type;
-        typedef TComp key_compare;
-        typedef TAlloc allocator_type;
-        typedef std::size_t size_type;
-        typedef std::ptrdiff_t difference_type;
-
-    protected:
-        typedef _select_first<value_type> key_select;
-        typedef ft::_tree<key_type, value_type, key_select, key_compare, allocator_type> container_type;
-
-    public:
-        typedef value_type& reference;
-        typedef const value_type& const_reference;
-        typedef typename allocator_type::pointer pointer;
-        typedef typename allocator_type::const_pointer const_pointer;
-        typedef typename container_type::iterator iterator;
-        typedef typename container_type::const_iterator const_iterator;
-        typedef typename ft::reverse_iterator<iterator> reverse_iterator;
-        typedef typename ft::reverse_iterator<const_iterator> const_reverse_iterator;
-
-        class value_compare
+        template <typename TKey, typename TMapped, typename TComp = ft::less<TKey>, typename TAlloc = std::allocator<ft::pair<const TKey, TMapped> > >
+        class map
         {
-            friend class map;
-
         public:
-            typedef bool result_type;
-            typedef value_type first_argument_type;
-            typedef value_type second_argument_type;
+            typedef TKey key_type;
+            typedef TMapped mapped_type;
+            typedef ft::pair<const TKey, TMapped> value_type;
+            typedef TComp key_compare;
+            typedef TAlloc allocator_type;
+            typedef std::size_t size_type;
+            typedef std::ptrdiff_t difference_type;
 
         protected:
-            key_compare comp;
+            typedef _select_first<value_type> key_select;
+            typedef ft::_tree<key_type, value_type, key_select, key_compare, allocator_type> container_type;
+
+        public:
+            typedef value_type& reference;
+            typedef const value_type& const_reference;
+            typedef typename allocator_type::pointer pointer;
+            typedef typename allocator_type::const_pointer const_pointer;
+            typedef typename container_type::iterator iterator;
+            typedef typename container_type::const_iterator const_iterator;
+            typedef typename ft::reverse_iterator<iterator> reverse_iterator;
+            typedef typename ft::reverse_iterator<const_iterator> const_reverse_iterator;
+#if __cplusplus >= 201103L
+            typedef ft::_map_node_handle<TKey, TMapped, typename container_type::allocator_type> node_type;
+            typedef ft::_insert_return_type<iterator, node_type> insert_return_type;
+#endif
+
+            class value_compare
+            {
+                friend class map;
+
+            public:
+                typedef bool result_type;
+                typedef value_type first_argument_type;
+                typedef value_type second_argument_type;
+
+            protected:
+                key_compare comp;
 
-            value_compare(const key_compare& comp)
-                : comp(comp) {}
+                value_compare(const key_compare& comp)
+                    : comp(comp) {}
+
+            public:
+                result_type operator()(const first_argument_type& lhs, const second_argument_type& rhs)
+                {
+                    return this->comp(key_select()(lhs), key_select()(rhs));
+                }
+            };
+
+        private:
+            friend class multimap<TKey, TMapped, TComp, TAlloc>;
+
+            container_type c;
 
         public:
-            result_type operator()(const first_argument_type& lhs, const second_argument_type& rhs)
+            map()
+                : c() {}
+
+            explicit map(const key_compare& comp, const allocator_type& alloc = allocator_type())
+                : c(comp, alloc) {}
+
+            template <typename UIter>
+            // map(UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            map(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : c(comp, alloc)
             {
-                return this->comp(key_select()(lhs), key_select()(rhs));
+                this->insert(first, last);
             }
-        };
 
-    private:
-        container_type c;
+            template <typename UIter>
+            // map(ft::sorted_unique_t, UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            map(ft::sorted_unique_t, typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : c(comp, alloc)
+            {
+                this->insert(ft::sorted_unique, first, last);
+            }
 
-    public:
-        map()
-            : c() {}
+            map(const map& that)
+                : c(that.c) {}
 
-        explicit map(const key_compare& comp, const allocator_type& alloc = allocator_type())
-            : c(comp, alloc) {}
+#if __cplusplus >= 201103L
+            map(map&& that) noexcept(noexcept(container_type(ft::declval<container_type>())))
+                : c(ft::move(that.c)) {}
+#endif
 
-        template <typename UIter>
-        // map(UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
-        map(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
-            : c(comp, alloc)
-        {
-            this->insert(first, last);
-        }
+            ~map() {}
 
-        map(const map& that)
-            : c(that.c) {}
+            map& operator=(const map& that)
+            {
+                this->c = that.c;
+                return *this;
+            }
 
-        ~map() {}
+#if __cplusplus >= 201103L
+            map& operator=(map&& that)
+            {
+                this->c = ft::move(that.c);
+                return *this;
+            }
+#endif
 
-        map& operator=(const map& that)
-        {
-            this->c = that.c;
-            return *this;
-        }
+        public:
+            allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
 
-    public:
-        allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
+        public:
+            mapped_type& at(const key_type& key)
+            {
+                iterator it = this->find(key);
+                if (it == this->end())
+                {
+                    throw ft::out_of_range("map::at");
+                }
+                return it->second;
+            }
+            const mapped_type& at(const key_type& key) const
+            {
+                const_iterator it = this->find(key);
+                if (it == this->end())
+                {
+                    throw ft::out_of_range("map::at");
+                }
+                return it->second;
+            }
 
-    public:
-        mapped_type& at(const key_type& key)
-        {
-            iterator it = this->find(key);
-            if (it == this->end())
+            mapped_type& operator[](const key_type& key)
             {
-                throw ft::out_of_range("map::at");
+                iterator it = this->find(key);
+                if (it == this->end())
+                {
+                    it = this->insert(ft::make_pair(key, mapped_type())).first;
+                }
+                return it->second;
             }
-            return it->second;
-        }
-        const mapped_type& at(const key_type& key) const
-        {
-            const_iterator it = this->find(key);
-            if (it == this->end())
+
+#if __cplusplus >= 201103L
+            mapped_type& operator[](key_type&& key)
             {
-                throw ft::out_of_range("map::at");
+                return this->try_emplace(ft::move(key)).first->second;
             }
-            return it->second;
-        }
+#endif
 
-        mapped_type& operator[](const key_type& key)
-        {
-            iterator it = this->find(key);
-            if (it == this->end())
+        public:
+            iterator begin() { return this->c.begin(); }
+            const_iterator begin() const { return this->c.begin(); }
+            iterator end() { return this->c.end(); }
+            const_iterator end() const { return this->c.end(); }
+            reverse_iterator rbegin() { return this->c.rbegin(); }
+            const_reverse_iterator rbegin() const { return this->c.rbegin(); }
+            reverse_iterator rend() { return this->c.rend(); }
+            const_reverse_iterator rend() const { return this->c.rend(); }
+
+        public:
+            bool empty() const { return this->c.empty(); }
+            size_type size() const { return this->c.size(); }
+            size_type max_size() const { return this->c.max_size(); }
+
+        public:
+            void clear() { return this->c.clear(); }
+
+            ft::pair<iterator, bool> insert(const value_type& value)
             {
-                it = this->insert(ft::make_pair(key, mapped_type())).first;
+                ft::pair<typename container_type::node_type*, bool> result = this->c.insert_unique(NULL, value);
+                return ft::make_pair(iterator(result.first), result.second);
             }
-            return it->second;
-        }
 
-    public:
-        iterator begin() { return this->c.begin(); }
-        const_iterator begin() const { return this->c.begin(); }
-        iterator end() { return this->c.end(); }
-        const_iterator end() const { return this->c.end(); }
-        reverse_iterator rbegin() { return this->c.rbegin(); }
-        const_reverse_iterator rbegin() const { return this->c.rbegin(); }
-        reverse_iterator rend() { return this->c.rend(); }
-        const_reverse_iterator rend() const { return this->c.rend(); }
+            iterator insert(iterator hint, const value_type& value)
+            {
+                return iterator(this->c.insert_unique(hint.base(), value).first);
+            }
 
-    public:
-        bool empty() const { return this->c.empty(); }
-        size_type size() const { return this->c.size(); }
-        size_type max_size() const { return this->c.max_size(); }
+            template <typename UIter>
+            // void insert(UIter first, UIter last)
+            typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
+            {
+                this->c.insert_range_unique(first, last);
+            }
 
-    public:
-        void clear() { return this->c.clear(); }
+            template <typename UIter>
+            // void insert(ft::sorted_unique_t, UIter first, UIter last)
+            typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(ft::sorted_unique_t, UIter first, UIter last)
+            {
+                this->c.insert_range_unique(ft::sorted_unique, first, last);
+            }
 
-        ft::pair<iterator, bool> insert(const value_type& value)
-        {
-            ft::pair<typename container_type::node_type*, bool> result = this->c.insert_unique(NULL, value);
-            return ft::make_pair(iterator(result.first), result.second);
-        }
+#if __cplusplus >= 201103L
+            ft::pair<iterator, bool> insert(value_type&& value)
+            {
+                ft::pair<typename container_type::node_type*, bool> result = this->c.insert_unique(NULL, ft::move(value));
+                return ft::make_pair(iterator(result.first), result.second);
+            }
 
-        iterator insert(iterator hint, const value_type& value)
-        {
-            return iterator(this->c.insert_unique(hint.base(), value).first);
-        }
+            iterator insert(iterator hint, value_type&& value)
+            {
+                return iterator(this->c.insert_unique(hint.base(), ft::move(value)).first);
+            }
 
-        template <typename UIter>
-        // void insert(UIter first, UIter last)
-        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
-        {
-            for (UIter it = first; it != last; ++it)
+            template <typename... Args>
+            ft::pair<iterator, bool> emplace(Args&&... args)
             {
-                this->c.insert_unique(NULL, *it);
+                ft::pair<typename container_type::node_type*, bool> result = this->c.emplace_unique(NULL, ft::forward<Args>(args)...);
+                return ft::make_pair(iterator(result.first), result.second);
             }
-        }
 
-        void erase(iterator pos)
-        {
-            iterator it = pos++;
-            this->c.erase(it.base());
-        }
+            template <typename... Args>
+            iterator emplace_hint(iterator hint, Args&&... args)
+            {
+                return iterator(this->c.emplace_unique(hint.base(), ft::forward<Args>(args)...).first);
+            }
 
-        void erase(iterator first, iterator last)
-        {
-            while (first != last)
+            // Nothing is constructed (and the key is not moved from) when the key is already present.
+            template <typename... Args>
+            ft::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
             {
-                iterator it = first++;
-                this->c.erase(it.base());
+                return this->try_emplace_internal(NULL, key, ft::forward<Args>(args)...);
             }
-        }
 
-        size_type erase(const key_type& key)
-        {
-            iterator it = this->find(key);
-            if (it == this->end())
+            template <typename... Args>
+            ft::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
             {
-                return 0;
+                return this->try_emplace_internal(NULL, ft::move(key), ft::forward<Args>(args)...);
             }
-            this->erase(it);
-            return 1;
-        }
 
-        void swap(map& that) { this->c.swap(that.c); }
+            template <typename... Args>
+            iterator try_emplace(iterator hint, const key_type& key, Args&&... args)
+            {
+                return this->try_emplace_internal(hint.base(), key, ft::forward<Args>(args)...).first;
+            }
 
-    public:
-        size_type count(const key_type& key) const { return this->c.count(key); }
+            template <typename... Args>
+            iterator try_emplace(iterator hint, key_type&& key, Args&&... args)
+            {
+                return this->try_emplace_internal(hint.base(), ft::move(key), ft::forward<Args>(args)...).first;
+            }
 
-        iterator find(const key_type& key) { return iterator(this->c.find(key)); }
-        const_iterator find(const key_type& key) const { return const_iterator(this->c.find(key)); }
+        private:
+            template <typename UKey, typename... Args>
+            ft::pair<iterator, bool> try_emplace_internal(typename container_type::algo::node_pointer hint, UKey&& key, Args&&... args)
+            {
+                typename container_type::algo::node_pointer parent;
+                bool left;
+                typename container_type::algo::node_pointer result = this->c.unique_position(hint, key, parent, left);
+                if (result != NULL)
+                {
+                    return ft::make_pair(iterator(result), false);
+                }
+                return ft::make_pair(iterator(this->c.emplace_at(parent, left, _internal::_piecewise_second_t(), ft::forward<UKey>(key), ft::forward<Args>(args)...)), true);
+            }
 
-        ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
-        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+        public:
+#endif
 
-        iterator lower_bound(const key_type& key) { return this->c.lower_bound(key); }
-        const_iterator lower_bound(const key_type& key) const { return this->c.lower_bound(key); }
+            void erase(iterator pos)
+            {
+                iterator it = pos++;
+                this->c.erase(it.base());
+            }
 
-        iterator upper_bound(const key_type& key) { return this->c.upper_bound(key); }
-        const_iterator upper_bound(const key_type& key) const { return this->c.upper_bound(key); }
+            void erase(iterator first, iterator last)
+            {
+                while (first != last)
+                {
+                    iterator it = first++;
+                    this->c.erase(it.base());
+                }
+            }
 
-    public:
-        key_compare key_comp() const { return this->c.key_comp(); }
-        value_compare value_comp() const { return value_compare(this->c.key_comp()); }
+            size_type erase(const key_type& key)
+            {
+                iterator it = this->find(key);
+                if (it == this->end())
+                {
+                    return 0;
+                }
+                this->erase(it);
+                return 1;
+            }
 
-    public:
-        friend bool operator==(const map& lhs, const map& rhs)
-        {
-            return lhs.c == rhs.c;
-        }
+            void swap(map& that) { this->c.swap(that.c); }
 
-        friend bool operator!=(const map& lhs, const map& rhs)
-        {
-            return lhs.c != rhs.c;
-        }
+        public:
+            // Relinks the nodes of source whose key is not here yet, the others stay behind.
+            void merge(map& source) { this->c.merge_unique(source.c); }
+            void merge(multimap<TKey, TMapped, TComp, TAlloc>& source) { this->c.merge_unique(source.c); }
 
-        friend bool operator<(const map& lhs, const map& rhs)
-        {
-            return lhs.c < rhs.c;
-        }
+#if __cplusplus >= 201103L
+            void merge(map&& source) { this->merge(source); }
+            void merge(multimap<TKey, TMapped, TComp, TAlloc>&& source) { this->merge(source); }
 
-        friend bool operator<=(const map& lhs, const map& rhs)
-        {
-            return lhs.c <= rhs.c;
-        }
+            node_type extract(iterator pos) { return node_type(this->c.extract(pos.base()), this->c.get_allocator()); }
 
-        friend bool operator>(const map& lhs, const map& rhs)
-        {
-            return lhs.c > rhs.c;
-        }
+            node_type extract(const key_type& key)
+            {
+                iterator it = this->find(key);
+                if (it == this->end())
+                {
+                    return node_type();
+                }
+                return this->extract(it);
+            }
 
-        friend bool operator>=(const map& lhs, const map& rhs)
-        {
-            return lhs.c >= rhs.c;
-        }
-    };
+            // The node comes back in the result when its key is already present.
+            insert_return_type insert(node_type&& node)
+            {
+                if (node.empty())
+                {
+                    return insert_return_type{this->end(), false, node_type()};
+                }
+                ft::pair<typename container_type::node_type*, bool> result = this->c.insert_node_unique(NULL, node.get());
+                if (!result.second)
+                {
+                    return insert_return_type{iterator(result.first), false, ft::move(node)};
+                }
+                node.release();
+                return insert_return_type{iterator(result.first), true, node_type()};
+            }
 
-    template <typename TKey, typename TMapped, typename TComp, typename TAlloc>
-    inline void swap(
-        map<TKey, TMapped, TComp, TAlloc>& lhs,
-        map<TKey, TMapped, TComp, TAlloc>& rhs)
-    {
-        lhs.swap(rhs);
-    }
+            iterator insert(iterator hint, node_type&& node)
+            {
+                if (node.empty())
+                {
+                    return this->end();
+                }
+                ft::pair<typename container_type::node_type*, bool> result = this->c.insert_node_unique(hint.base(), node.get());
+                if (result.second)
+                {
+                    node.release();
+                }
+                return iterator(result.first);
+            }
+#endif
 
-    template <typename TKey, typename TMapped, typename TComp = ft::less<TKey>, typename TAlloc = std::allocator<ft::pair<const TKey, TMapped> > >
-    class multimap
-    {
-    public:
-        typedef TKey key_type;
-        typedef TMapped mapped_type;
-        typedef ft::pair<const TKey, TMapped> value_type;
-        typedef TComp key_compare;
-        typedef TAlloc allocator_type;
-        typedef std::size_t size_type;
-        typedef std::ptrdiff_t difference_type;
-
-    protected:
-        typedef _select_first<value_type> key_select;
-        typedef ft::_tree<key_type, value_type, key_select, key_compare, allocator_type> container_type;
-
-    public:
-        typedef value_type& reference;
-        typedef const value_type& const_reference;
-        typedef typename allocator_type::pointer pointer;
-        typedef typename allocator_type::const_pointer const_pointer;
-        typedef typename container_type::iterator iterator;
-        typedef typename container_type::const_iterator const_iterator;
-        typedef typename ft::reverse_iterator<iterator> reverse_iterator;
-        typedef typename ft::reverse_iterator<const_iterator> const_reverse_iterator;
-
-        class value_compare
-        {
-            friend class multimap;
+        public:
+            // Set algebra relinking the nodes of the argument, which ends up empty (split refills it).
+            // O(m log(n / m + 1)) for sizes m <= n. If the comparator throws, both containers stay
+            // valid and nothing is lost but the duplicates already released by a union.
+
+            // O(log n) with FT_TREE_ORDER_STATISTICS, otherwise counting the elements that stay
+            // adds O(min(k, n - k)) for k of them.
+            void split(const key_type& key, map& greater) { this->c.split(key, greater.c); }
+            void join(map& greater) { this->c.join(greater.c); }
+            void set_union(map& that) { this->c.set_union(that.c); }
+            void set_intersection(map& that) { this->c.set_intersection(that.c); }
+            void set_difference(map& that) { this->c.set_difference(that.c); }
 
         public:
-            typedef bool result_type;
-            typedef value_type first_argument_type;
-            typedef value_type second_argument_type;
+            size_type count(const key_type& key) const { return this->c.count(key); }
 
-        protected:
-            key_compare comp;
+            iterator find(const key_type& key) { return iterator(this->c.find(key)); }
+            const_iterator find(const key_type& key) const { return const_iterator(this->c.find(key)); }
+
+            // O(log n) with FT_TREE_ORDER_STATISTICS, a walk in order otherwise
+            iterator find_by_order(size_type k) { return iterator(this->c.nth_element(k)); }
+            const_iterator find_by_order(size_type k) const { return const_iterator(this->c.nth_element(k)); }
+            size_type order_of_key(const key_type& key) const { return this->c.rank(key); }
+
+            ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
+            ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+
+            iterator lower_bound(const key_type& key) { return this->c.lower_bound(key); }
+            const_iterator lower_bound(const key_type& key) const { return this->c.lower_bound(key); }
+
+            iterator upper_bound(const key_type& key) { return this->c.upper_bound(key); }
+            const_iterator upper_bound(const key_type& key) const { return this->c.upper_bound(key); }
 
-            value_compare(const key_compare& comp)
-                : comp(comp) {}
+        public:
+            key_compare key_comp() const { return this->c.key_comp(); }
+            value_compare value_comp() const { return value_compare(this->c.key_comp()); }
 
         public:
-            result_type operator()(const first_argument_type& lhs, const second_argument_type& rhs)
+            friend bool operator==(const map& lhs, const map& rhs)
             {
-                return this->comp(key_select()(lhs), key_select()(rhs));
+                return lhs.c == rhs.c;
+            }
+
+            friend bool operator!=(const map& lhs, const map& rhs)
+            {
+                return lhs.c != rhs.c;
+            }
+
+            friend bool operator<(const map& lhs, const map& rhs)
+            {
+                return lhs.c < rhs.c;
             }
-        };
 
-    private:
-        container_type c;
+            friend bool operator<=(const map& lhs, const map& rhs)
+            {
+                return lhs.c <= rhs.c;
+            }
 
-    public:
-        multimap()
-            : c() {}
+            friend bool operator>(const map& lhs, const map& rhs)
+            {
+                return lhs.c > rhs.c;
+            }
 
-        explicit multimap(const key_compare& comp, const allocator_type& alloc = allocator_type())
-            : c(comp, alloc) {}
+            friend bool operator>=(const map& lhs, const map& rhs)
+            {
+                return lhs.c >= rhs.c;
+            }
+        };
 
-        template <typename UIter>
-        // multimap(UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
-        multimap(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
-            : c(comp, alloc)
+        template <typename TKey, typename TMapped, typename TComp = ft::less<TKey>, typename TAlloc = std::allocator<ft::pair<const TKey, TMapped> > >
+        class multimap
         {
-            this->insert(first, last);
-        }
+        public:
+            typedef TKey key_type;
+            typedef TMapped mapped_type;
+            typedef ft::pair<const TKey, TMapped> value_type;
+            typedef TComp key_compare;
+            typedef TAlloc allocator_type;
+            typedef std::size_t size_type;
+            typedef std::ptrdiff_t difference_type;
+
+        protected:
+            typedef _select_first<value_type> key_select;
+            typedef ft::_tree<key_type, value_type, key_select, key_compare, allocator_type> container_type;
 
-        multimap(const multimap& that)
-            : c(that.c) {}
+        public:
+            typedef value_type& reference;
+            typedef const value_type& const_reference;
+            typedef typename allocator_type::pointer pointer;
+            typedef typename allocator_type::const_pointer const_pointer;
+            typedef typename container_type::iterator iterator;
+            typedef typename container_type::const_iterator const_iterator;
+            typedef typename ft::reverse_iterator<iterator> reverse_iterator;
+            typedef typename ft::reverse_iterator<const_iterator> const_reverse_iterator;
+#if __cplusplus >= 201103L
+            typedef ft::_map_node_handle<TKey, TMapped, typename container_type::allocator_type> node_type;
+#endif
+
+            class value_compare
+            {
+                friend class multimap;
 
-        ~multimap() {}
+            public:
+                typedef bool result_type;
+                typedef value_type first_argument_type;
+                typedef value_type second_argument_type;
 
-        multimap& operator=(const multimap& that)
-        {
-            this->c = that.c;
-            return *this;
-        }
+            protected:
+                key_compare comp;
 
-    public:
-        allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
+                value_compare(const key_compare& comp)
+                    : comp(comp) {}
 
-    public:
-        mapped_type& at(const key_type& key)
-        {
-            iterator it = this->find(key);
-            if (it == this->end())
+            public:
+                result_type operator()(const first_argument_type& lhs, const second_argument_type& rhs)
+                {
+                    return this->comp(key_select()(lhs), key_select()(rhs));
+                }
+            };
+
+        private:
+            friend class map<TKey, TMapped, TComp, TAlloc>;
+
+            container_type c;
+
+        public:
+            multimap()
+                : c() {}
+
+            explicit multimap(const key_compare& comp, const allocator_type& alloc = allocator_type())
+                : c(comp, alloc) {}
+
+            template <typename UIter>
+            // multimap(UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            multimap(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : c(comp, alloc)
             {
-                throw ft::out_of_range("multimap::at");
+                this->insert(first, last);
             }
-            return it->second;
-        }
-        const mapped_type& at(const key_type& key) const
-        {
-            const_iterator it = this->find(key);
-            if (it == this->end())
+
+            template <typename UIter>
+            // multimap(ft::sorted_equivalent_t, UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            multimap(ft::sorted_equivalent_t, typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : c(comp, alloc)
             {
-                throw ft::out_of_range("multimap::at");
+                this->insert(ft::sorted_equivalent, first, last);
             }
-            return it->second;
-        }
 
-        mapped_type& operator[](const key_type& key)
-        {
-            iterator it = this->find(key);
-            if (it == this->end())
+            multimap(const multimap& that)
+                : c(that.c) {}
+
+#if __cplusplus >= 201103L
+            multimap(multimap&& that) noexcept(noexcept(container_type(ft::declval<container_type>())))
+                : c(ft::move(that.c)) {}
+#endif
+
+            ~multimap() {}
+
+            multimap& operator=(const multimap& that)
             {
-                it = this->insert(ft::make_pair(key, mapped_type())).first;
+                this->c = that.c;
+                return *this;
             }
-            return it->second;
-        }
 
-    public:
-        iterator begin() { return this->c.begin(); }
-        const_iterator begin() const { return this->c.begin(); }
-        iterator end() { return this->c.end(); }
-        const_iterator end() const { return this->c.end(); }
-        reverse_iterator rbegin() { return this->c.rbegin(); }
-        const_reverse_iterator rbegin() const { return this->c.rbegin(); }
-        reverse_iterator rend() { return this->c.rend(); }
-        const_reverse_iterator rend() const { return this->c.rend(); }
+#if __cplusplus >= 201103L
+            multimap& operator=(multimap&& that)
+            {
+                this->c = ft::move(that.c);
+                return *this;
+            }
+#endif
 
-    public:
-        bool empty() const { return this->c.empty(); }
-        size_type size() const { return this->c.size(); }
-        size_type max_size() const { return this->c.max_size(); }
+        public:
+            allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
 
-    public:
-        void clear() { return this->c.clear(); }
+        public:
+            mapped_type& at(const key_type& key)
+            {
+                iterator it = this->find(key);
+                if (it == this->end())
+                {
+                    throw ft::out_of_range("multimap::at");
+                }
+                return it->second;
+            }
+            const mapped_type& at(const key_type& key) const
+            {
+                const_iterator it = this->find(key);
+                if (it == this->end())
+                {
+                    throw ft::out_of_range("multimap::at");
+                }
+                return it->second;
+            }
 
-        iterator insert(const value_type& value)
-        {
-            typename container_type::node_type* result = this->c.insert(NULL, value);
-            return iterator(result);
-        }
+            mapped_type& operator[](const key_type& key)
+            {
+                iterator it = this->find(key);
+                if (it == this->end())
+                {
+                    it = this->insert(ft::make_pair(key, mapped_type())).first;
+                }
+                return it->second;
+            }
 
-        iterator insert(iterator hint, const value_type& value)
-        {
-            return iterator(this->c.insert(hint.base(), value));
-        }
+        public:
+            iterator begin() { return this->c.begin(); }
+            const_iterator begin() const { return this->c.begin(); }
+            iterator end() { return this->c.end(); }
+            const_iterator end() const { return this->c.end(); }
+            reverse_iterator rbegin() { return this->c.rbegin(); }
+            const_reverse_iterator rbegin() const { return this->c.rbegin(); }
+            reverse_iterator rend() { return this->c.rend(); }
+            const_reverse_iterator rend() const { return this->c.rend(); }
 
-        template <typename UIter>
-        // void insert(UIter first, UIter last)
-        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
-        {
-            for (UIter it = first; it != last; ++it)
+        public:
+            bool empty() const { return this->c.empty(); }
+            size_type size() const { return this->c.size(); }
+            size_type max_size() const { return this->c.max_size(); }
+
+        public:
+            void clear() { return this->c.clear(); }
+
+            iterator insert(const value_type& value)
             {
-                this->c.insert(NULL, *it);
+                typename container_type::node_type* result = this->c.insert(NULL, value);
+                return iterator(result);
             }
-        }
 
-        void erase(iterator pos)
-        {
-            iterator it = pos++;
-            this->c.erase(it.base());
-        }
+            iterator insert(iterator hint, const value_type& value)
+            {
+                return iterator(this->c.insert(hint.base(), value));
+            }
 
-        void erase(iterator first, iterator last)
-        {
-            while (first != last)
+            template <typename UIter>
+            // void insert(UIter first, UIter last)
+            typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
             {
-                iterator it = first++;
-                this->c.erase(it.base());
+                this->c.insert_range_equal(first, last);
             }
-        }
 
-        size_type erase(const key_type& key)
-        {
-            ft::pair<const_iterator, const_iterator> range = this->equal_range(key);
-            size_type n = size_type();
-            while (range.first != range.second)
+            template <typename UIter>
+            // void insert(ft::sorted_equivalent_t, UIter first, UIter last)
+            typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(ft::sorted_equivalent_t, UIter first, UIter last)
+            {
+                this->c.insert_range_equal(ft::sorted_equivalent, first, last);
+            }
+
+#if __cplusplus >= 201103L
+            iterator insert(value_type&& value)
+            {
+                return iterator(this->c.insert(NULL, ft::move(value)));
+            }
+
+            iterator insert(iterator hint, value_type&& value)
             {
-                const_iterator it = range.first++;
+                return iterator(this->c.insert(hint.base(), ft::move(value)));
+            }
+
+            template <typename... Args>
+            iterator emplace(Args&&... args)
+            {
+                return iterator(this->c.emplace_equal(NULL, ft::forward<Args>(args)...));
+            }
+
+            template <typename... Args>
+            iterator emplace_hint(iterator hint, Args&&... args)
+            {
+                return iterator(this->c.emplace_equal(hint.base(), ft::forward<Args>(args)...));
+            }
+#endif
+
+            void erase(iterator pos)
+            {
+                iterator it = pos++;
                 this->c.erase(it.base());
-                n++;
             }
-            return n;
-        }
 
-        void swap(multimap& that) { this->c.swap(that.c); }
+            void erase(iterator first, iterator last)
+            {
+                while (first != last)
+                {
+                    iterator it = first++;
+                    this->c.erase(it.base());
+                }
+            }
 
-    public:
-        size_type count(const key_type& key) const { return this->c.count(key); }
+            size_type erase(const key_type& key)
+            {
+                ft::pair<const_iterator, const_iterator> range = this->equal_range(key);
+                size_type n = size_type();
+                while (range.first != range.second)
+                {
+                    const_iterator it = range.first++;
+                    this->c.erase(it.base());
+                    n++;
+                }
+                return n;
+            }
 
-        iterator find(const key_type& key) { return iterator(this->c.find(key)); }
-        const_iterator find(const key_type& key) const { return const_iterator(this->c.find(key)); }
+            void swap(multimap& that) { this->c.swap(that.c); }
 
-        ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
-        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+        public:
+            // Relinks every node of source.
+            void merge(multimap& source) { this->c.merge_equal(source.c); }
+            void merge(map<TKey, TMapped, TComp, TAlloc>& source) { this->c.merge_equal(source.c); }
 
-        iterator lower_bound(const key_type& key) { return this->c.lower_bound(key); }
-        const_iterator lower_bound(const key_type& key) const { return this->c.lower_bound(key); }
+#if __cplusplus >= 201103L
+            void merge(multimap&& source) { this->merge(source); }
+            void merge(map<TKey, TMapped, TComp, TAlloc>&& source) { this->merge(source); }
 
-        iterator upper_bound(const key_type& key) { return this->c.upper_bound(key); }
-        const_iterator upper_bound(const key_type& key) const { return this->c.upper_bound(key); }
+            node_type extract(iterator pos) { return node_type(this->c.extract(pos.base()), this->c.get_allocator()); }
 
-    public:
-        key_compare key_comp() const { return this->c.key_comp(); }
-        value_compare value_comp() const { return value_compare(this->c.key_comp()); }
+            node_type extract(const key_type& key)
+            {
+                iterator it = this->find(key);
+                if (it == this->end())
+                {
+                    return node_type();
+                }
+                return this->extract(it);
+            }
 
-    public:
-        friend bool operator==(const multimap& lhs, const multimap& rhs)
-        {
-            return lhs.c == rhs.c;
-        }
+            iterator insert(node_type&& node)
+            {
+                if (node.empty())
+                {
+                    return this->end();
+                }
+                // the handle keeps the node until it is linked, the comparator may throw before
+                typename container_type::node_type* linked = this->c.insert_node_equal(NULL, node.get());
+                node.release();
+                return iterator(linked);
+            }
 
-        friend bool operator!=(const multimap& lhs, const multimap& rhs)
-        {
-            return lhs.c != rhs.c;
-        }
+            iterator insert(iterator hint, node_type&& node)
+            {
+                if (node.empty())
+                {
+                    return this->end();
+                }
+                typename container_type::node_type* linked = this->c.insert_node_equal(hint.base(), node.get());
+                node.release();
+                return iterator(linked);
+            }
+#endif
 
-        friend bool operator<(const multimap& lhs, const multimap& rhs)
-        {
-            return lhs.c < rhs.c;
-        }
+        public:
+            size_type count(const key_type& key) const { return this->c.count(key); }
 
-        friend bool operator<=(const multimap& lhs, const multimap& rhs)
-        {
-            return lhs.c <= rhs.c;
-        }
+            iterator find(const key_type& key) { return iterator(this->c.find(key)); }
+            const_iterator find(const key_type& key) const { return const_iterator(this->c.find(key)); }
 
-        friend bool operator>(const multimap& lhs, const multimap& rhs)
-        {
-            return lhs.c > rhs.c;
-        }
+            // O(log n) with FT_TREE_ORDER_STATISTICS, a walk in order otherwise
+            iterator find_by_order(size_type k) { return iterator(this->c.nth_element(k)); }
+            const_iterator find_by_order(size_type k) const { return const_iterator(this->c.nth_element(k)); }
+            size_type order_of_key(const key_type& key) const { return this->c.rank(key); }
 
-        friend bool operator>=(const multimap& lhs, const multimap& rhs)
-        {
-            return lhs.c >= rhs.c;
-        }
-    };
+            ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
+            ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+
+            iterator lower_bound(const key_type& key) { return this->c.lower_bound(key); }
+            const_iterator lower_bound(const key_type& key) const { return this->c.lower_bound(key); }
+
+            iterator upper_bound(const key_type& key) { return this->c.upper_bound(key); }
+            const_iterator upper_bound(const key_type& key) const { return this->c.upper_bound(key); }
+
+        public:
+            key_compare key_comp() const { return this->c.key_comp(); }
+            value_compare value_comp() const { return value_compare(this->c.key_comp()); }
+
+        public:
+            friend bool operator==(const multimap& lhs, const multimap& rhs)
+            {
+                return lhs.c == rhs.c;
+            }
+
+            friend bool operator!=(const multimap& lhs, const multimap& rhs)
+            {
+                return lhs.c != rhs.c;
+            }
+
+            friend bool operator<(const multimap& lhs, const multimap& rhs)
+            {
+                return lhs.c < rhs.c;
+            }
+
+            friend bool operator<=(const multimap& lhs, const multimap& rhs)
+            {
+                return lhs.c <= rhs.c;
+            }
+
+            friend bool operator>(const multimap& lhs, const multimap& rhs)
+            {
+                return lhs.c > rhs.c;
+            }
+
+            friend bool operator>=(const multimap& lhs, const multimap& rhs)
+            {
+                return lhs.c >= rhs.c;
+            }
+        };
+    }
+
+    template <typename TKey, typename TMapped, typename TComp, typename TAlloc>
+    inline void swap(
+        map<TKey, TMapped, TComp, TAlloc>& lhs,
+        map<TKey, TMapped, TComp, TAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
 
     template <typename TKey, typename TMapped, typename TComp, typename TAlloc>
     inline void swap(
@@ -495,6 +773,14 @@ namespace ft
     {
         lhs.swap(rhs);
     }
+
+#if __cplusplus < 201103L
+    // without inline namespaces argument dependent lookup stops at the layout namespace
+    namespace FT_TREE_LAYOUT
+    {
+        using ft::swap;
+    }
+#endif
 }
 
 namespace std
@@ -4,3 +4,6 @@
 #pragma once
 
 #include "memory/addressof.hpp"
+#include "memory/growth_policy.hpp"
+#include "memory/malloc_allocator.hpp"
+#include "memory/pool_allocator.hpp"
@@ -0,0 +1,176 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "../type_traits/integral_constant.hpp"
+
+#include <memory>
+
+namespace ft
+{
+    namespace _internal
+    {
+        // construct of a plain allocator is a placement new, so a container may construct
+        // trivially copyable elements with a byte copy instead.
+        template <typename TAlloc>
+        struct _is_plain_allocator : ft::false_type
+        {
+        };
+
+        template <typename T>
+        struct _is_plain_allocator<std::allocator<T> > : ft::true_type
+        {
+        };
+
+        // An allocator may report the real size of a block through
+        //   size_type usable_size(pointer p, size_type n) const
+        // n being the count passed to allocate, the block may then be used and deallocated as that many elements.
+        template <typename TAlloc>
+        struct _has_usable_size
+        {
+        private:
+            template <typename U, typename U::size_type (U::*)(typename U::pointer, typename U::size_type) const>
+            struct check
+            {
+            };
+
+            template <typename U>
+            static char test(check<U, &U::usable_size>*);
+            template <typename U>
+            static long test(...);
+
+        public:
+            static const bool value = sizeof(test<TAlloc>(0)) == sizeof(char);
+        };
+
+        template <typename TAlloc>
+        inline typename TAlloc::size_type usable_size(const TAlloc& alloc, typename TAlloc::pointer p, typename TAlloc::size_type n, ft::true_type)
+        {
+            typename TAlloc::size_type usable = alloc.usable_size(p, n);
+            return usable < n ? n : usable;
+        }
+
+        template <typename TAlloc>
+        inline typename TAlloc::size_type usable_size(const TAlloc&, typename TAlloc::pointer, typename TAlloc::size_type n, ft::false_type)
+        {
+            return n;
+        }
+
+        template <typename TAlloc>
+        inline typename TAlloc::size_type usable_size(const TAlloc& alloc, typename TAlloc::pointer p, typename TAlloc::size_type n)
+        {
+            return _internal::usable_size(alloc, p, n, ft::integral_constant<bool, _has_usable_size<TAlloc>::value>());
+        }
+
+        // An allocator may resize a block in place (or move its bytes) through
+        //   pointer reallocate(pointer p, size_type n, size_type new_n)
+        // only usable for trivially relocatable elements, the old block is released on success.
+        template <typename TAlloc>
+        struct _has_reallocate
+        {
+        private:
+            template <typename U, typename U::pointer (U::*)(typename U::pointer, typename U::size_type, typename U::size_type)>
+            struct check
+            {
+            };
+
+            template <typename U>
+            static char test(check<U, &U::reallocate>*);
+            template <typename U>
+            static long test(...);
+
+        public:
+            static const bool value = sizeof(test<TAlloc>(0)) == sizeof(char);
+        };
+
+        // a null pointer when the block cannot be reallocated
+        template <typename TAlloc>
+        inline typename TAlloc::pointer reallocate(TAlloc& alloc, typename TAlloc::pointer p, typename TAlloc::size_type n, typename TAlloc::size_type new_n, ft::true_type)
+        {
+            return alloc.reallocate(p, n, new_n);
+        }
+
+        template <typename TAlloc>
+        inline typename TAlloc::pointer reallocate(TAlloc&, typename TAlloc::pointer, typename TAlloc::size_type, typename TAlloc::size_type, ft::false_type)
+        {
+            return typename TAlloc::pointer();
+        }
+
+        // An allocator may prepare for a run of single-object allocations through
+        //   void reserve(size_type n)
+        // a hint only, the next n calls to allocate(1) should then come from one contiguous block.
+        template <typename TAlloc>
+        struct _has_reserve
+        {
+        private:
+            template <typename U, void (U::*)(typename U::size_type)>
+            struct check
+            {
+            };
+
+            template <typename U>
+            static char test(check<U, &U::reserve>*);
+            template <typename U>
+            static long test(...);
+
+        public:
+            static const bool value = sizeof(test<TAlloc>(0)) == sizeof(char);
+        };
+
+        template <typename TAlloc>
+        inline void reserve(TAlloc& alloc, typename TAlloc::size_type n, ft::true_type)
+        {
+            alloc.reserve(n);
+        }
+
+        template <typename TAlloc>
+        inline void reserve(TAlloc&, typename TAlloc::size_type, ft::false_type)
+        {
+        }
+
+        template <typename TAlloc>
+        inline void reserve(TAlloc& alloc, typename TAlloc::size_type n)
+        {
+            _internal::reserve(alloc, n, ft::integral_constant<bool, _has_reserve<TAlloc>::value>());
+        }
+
+        // An allocator may give its memory back in bulk once a container has freed its nodes through
+        //   void release_all()
+        // which does nothing while blocks of its own (or of a copy) are still in use.
+        template <typename TAlloc>
+        struct _has_release_all
+        {
+        private:
+            template <typename U, void (U::*)()>
+            struct check
+            {
+            };
+
+            template <typename U>
+            static char test(check<U, &U::release_all>*);
+            template <typename U>
+            static long test(...);
+
+        public:
+            static const bool value = sizeof(test<TAlloc>(0)) == sizeof(char);
+        };
+
+        template <typename TAlloc>
+        inline void release_all(TAlloc& alloc, ft::true_type)
+        {
+            alloc.release_all();
+        }
+
+        template <typename TAlloc>
+        inline void release_all(TAlloc&, ft::false_type)
+        {
+        }
+
+        template <typename TAlloc>
+        inline void release_all(TAlloc& alloc)
+        {
+            _internal::release_all(alloc, ft::integral_constant<bool, _has_release_all<TAlloc>::value>());
+        }
+    }
+}
@@ -0,0 +1,73 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+namespace ft
+{
+    // Capacity growth policies of vector.
+    // next_capacity is called when required elements no longer fit in capacity,
+    // the result is at least required and at most max_size.
+
+    // capacity * Num / Den: growth_factor<2, 1> doubles, growth_factor<3, 2> lets freed blocks be reused.
+    template <std::size_t Num, std::size_t Den>
+    struct growth_factor
+    {
+        static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t element_size, std::size_t max_size)
+        {
+            static_cast<void>(element_size);
+            std::size_t grown = capacity;
+            if (capacity <= max_size / Num)
+            {
+                grown = capacity * Num / Den;
+            }
+            else
+            {
+                grown = max_size;
+            }
+            return grown < required ? required : grown;
+        }
+    };
+
+    typedef growth_factor<2, 1> growth_double;
+    typedef growth_factor<3, 2> growth_golden;
+
+    // Grows in multiples of Chunk elements, for buffers whose final size is roughly known.
+    template <std::size_t Chunk>
+    struct growth_chunk
+    {
+        static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t element_size, std::size_t max_size)
+        {
+            static_cast<void>(capacity);
+            static_cast<void>(element_size);
+            std::size_t chunks = required / Chunk + (required % Chunk != 0);
+            if (chunks > max_size / Chunk)
+            {
+                return max_size;
+            }
+            return chunks * Chunk;
+        }
+    };
+
+    // Rounds the byte size chosen by TBase up to whole pages once it spans a page,
+    // so the slack of large blocks is usable instead of lost to the page allocator.
+    template <typename TBase = growth_double, std::size_t PageSize = 4096>
+    struct growth_page
+    {
+        static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t element_size, std::size_t max_size)
+        {
+            std::size_t count = TBase::next_capacity(capacity, required, element_size, max_size);
+            std::size_t bytes = count * element_size;
+            if (bytes < PageSize || bytes > std::numeric_limits<std::size_t>::max() - PageSize)
+            {
+                return count;
+            }
+            bytes = (bytes + PageSize - 1) / PageSize * PageSize;
+            count = bytes / element_size;
+            return count < max_size ? count : max_size;
+        }
+    };
+}
@@ -0,0 +1,133 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "addressof.hpp"
+
+#include "../utility/move.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+
+namespace ft
+{
+    // Allocator on top of malloc/free for element buffers (vector and friends).
+    // Reports the size malloc really handed out, so a growing vector can use the slack,
+    // and lets a vector of trivially relocatable elements grow through realloc.
+    template <typename T>
+    class malloc_allocator
+    {
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef malloc_allocator<U> other;
+        };
+
+    public:
+        // copy, assignment and destruction are the implicit ones, the allocator has no state
+        malloc_allocator() throw() {}
+        template <typename U>
+        malloc_allocator(const malloc_allocator<U>&) throw() {}
+
+    public:
+        pointer address(reference x) const { return ft::addressof(x); }
+        const_pointer address(const_reference x) const { return ft::addressof(x); }
+
+        pointer allocate(size_type n, const void* hint = 0)
+        {
+            static_cast<void>(hint);
+            if (n > this->max_size())
+            {
+                throw std::bad_alloc();
+            }
+            void* p = std::malloc(n == 0 ? 1 : n * sizeof(T));
+            if (p == NULL)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<pointer>(p);
+        }
+
+        void deallocate(pointer p, size_type n)
+        {
+            static_cast<void>(n);
+            std::free(p);
+        }
+
+        // For trivially relocatable elements only, the bytes are carried over as is.
+        // On failure the old block is left untouched.
+        pointer reallocate(pointer p, size_type n, size_type new_n)
+        {
+            static_cast<void>(n);
+            if (new_n > this->max_size())
+            {
+                throw std::bad_alloc();
+            }
+            void* q = std::realloc(static_cast<void*>(p), new_n == 0 ? 1 : new_n * sizeof(T));
+            if (q == NULL)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<pointer>(q);
+        }
+
+        size_type usable_size(pointer p, size_type n) const
+        {
+            static_cast<void>(p);
+            static_cast<void>(n);
+#if defined(__GLIBC__)
+            return ::malloc_usable_size(p) / sizeof(T);
+#elif defined(__APPLE__)
+            return ::malloc_size(p) / sizeof(T);
+#else
+            return n;
+#endif
+        }
+
+        size_type max_size() const throw() { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+        void construct(pointer p, const_reference value) { new (static_cast<void*>(p)) T(value); }
+        void destroy(pointer p) { p->~T(); }
+
+#if __cplusplus >= 201103L
+        template <typename U, typename... Args>
+        void construct(U* p, Args&&... args) { new (static_cast<void*>(p)) U(ft::forward<Args>(args)...); }
+        template <typename U>
+        void destroy(U* p) { p->~U(); }
+#endif
+    };
+
+    template <typename T1, typename T2>
+    inline bool operator==(
+        const malloc_allocator<T1>&,
+        const malloc_allocator<T2>&) throw()
+    {
+        return true;
+    }
+
+    template <typename T1, typename T2>
+    inline bool operator!=(
+        const malloc_allocator<T1>&,
+        const malloc_allocator<T2>&) throw()
+    {
+        return false;
+    }
+}
@@ -0,0 +1,330 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "addressof.hpp"
+
+#include "../utility/move.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace ft
+{
+    namespace _internal
+    {
+        template <typename T>
+        struct _alignment_of
+        {
+        private:
+            struct helper
+            {
+                char c;
+                T t;
+            };
+
+        public:
+            static const std::size_t value = sizeof(helper) - sizeof(T);
+        };
+
+        union _pool_max_align
+        {
+            long double ld;
+            double d;
+            long l;
+            void* p;
+        };
+
+        // Slab/free-list arena shared by every copy (and rebind) of a pool_allocator.
+        // Serves single-object requests of one block size; others go to operator new.
+        class _pool_arena
+        {
+        private:
+            union slab
+            {
+                slab* next;
+                _pool_max_align align;
+            };
+
+            struct free_block
+            {
+                free_block* next;
+            };
+
+            enum
+            {
+                initial_blocks = 32,
+                maximum_blocks = 4096
+            };
+
+            std::size_t refs;
+            std::size_t live;
+            std::size_t block_size;
+            std::size_t slab_blocks;
+            slab* slabs;
+            free_block* free_list;
+            char* cursor;
+            char* cursor_end;
+
+        private:
+            _pool_arena()
+                : refs(1), live(), block_size(), slab_blocks(initial_blocks),
+                  slabs(), free_list(), cursor(), cursor_end() {}
+
+            _pool_arena(const _pool_arena&);
+            _pool_arena& operator=(const _pool_arena&);
+
+            ~_pool_arena()
+            {
+                this->free_slabs();
+            }
+
+            // bulk release, nodes are never handed back one by one
+            void free_slabs() throw()
+            {
+                while (this->slabs != NULL)
+                {
+                    slab* next = this->slabs->next;
+                    ::operator delete(this->slabs);
+                    this->slabs = next;
+                }
+            }
+
+            void grow(std::size_t blocks)
+            {
+                std::size_t bytes = sizeof(slab) + blocks * this->block_size;
+                slab* s = static_cast<slab*>(::operator new(bytes));
+                s->next = this->slabs;
+                this->slabs = s;
+                this->cursor = reinterpret_cast<char*>(s + 1);
+                this->cursor_end = reinterpret_cast<char*>(s) + bytes;
+            }
+
+            void grow()
+            {
+                this->grow(this->slab_blocks);
+                if (this->slab_blocks < maximum_blocks)
+                {
+                    this->slab_blocks <<= 1;
+                }
+            }
+
+        public:
+            static _pool_arena* create() { return new _pool_arena(); }
+
+            void retain() throw() { ++this->refs; }
+
+            void release() throw()
+            {
+                if (--this->refs == 0)
+                {
+                    delete this;
+                }
+            }
+
+            bool is_pooled(std::size_t size, std::size_t align)
+            {
+                if (size < sizeof(free_block))
+                {
+                    size = sizeof(free_block);
+                }
+                if (align < _alignment_of<free_block>::value)
+                {
+                    align = _alignment_of<free_block>::value;
+                }
+                size = (size + align - 1) / align * align;
+                if (this->block_size == 0)
+                {
+                    this->block_size = size;
+                }
+                return this->block_size == size;
+            }
+
+            void* allocate()
+            {
+                free_block* block = this->free_list;
+                if (block != NULL)
+                {
+                    this->free_list = block->next;
+                    this->live++;
+                    return block;
+                }
+                if (this->cursor == this->cursor_end)
+                {
+                    this->grow();
+                }
+                void* result = this->cursor;
+                this->cursor += this->block_size;
+                this->live++;
+                return result;
+            }
+
+            // Makes the next n fresh blocks adjacent, the tail of the current slab is left unused.
+            // Recycled blocks are still handed out first.
+            void reserve(std::size_t n)
+            {
+                std::size_t left = static_cast<std::size_t>(this->cursor_end - this->cursor) / this->block_size;
+                if (n > left)
+                {
+                    this->grow(n < this->slab_blocks ? this->slab_blocks : n);
+                }
+            }
+
+            void deallocate(void* p) throw()
+            {
+                free_block* block = static_cast<free_block*>(p);
+                block->next = this->free_list;
+                this->free_list = block;
+                this->live--;
+            }
+
+            // Returns the slabs to operator new once no block is in use, whoever holds the arena.
+            void release_all() throw()
+            {
+                if (this->live != 0)
+                {
+                    return;
+                }
+                this->free_slabs();
+                this->free_list = NULL;
+                this->cursor = NULL;
+                this->cursor_end = NULL;
+                this->slab_blocks = initial_blocks;
+            }
+        };
+    }
+
+    // Node allocator for list and the tree based containers.
+    // Copies share one arena, so nodes can move between containers built from the same allocator.
+    // Each default-constructed allocator has an arena of its own and compares unequal to the others:
+    // containers that splice or merge nodes must be built from one another's get_allocator().
+    // Freed nodes are recycled by the arena. The slabs are returned in bulk by release_all, which
+    // clear() calls, once no node is left in any container of the arena, and with the last copy.
+    // NOTE: not thread safe
+    template <typename T>
+    class pool_allocator
+    {
+        template <typename U>
+        friend class pool_allocator;
+        template <typename T1, typename T2>
+        friend bool operator==(const pool_allocator<T1>& lhs, const pool_allocator<T2>& rhs) throw();
+
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef pool_allocator<U> other;
+        };
+
+    private:
+        _internal::_pool_arena* arena;
+
+    public:
+        pool_allocator()
+            : arena(_internal::_pool_arena::create()) {}
+
+        pool_allocator(const pool_allocator& that) throw()
+            : arena(that.arena)
+        {
+            this->arena->retain();
+        }
+
+        template <typename U>
+        pool_allocator(const pool_allocator<U>& that) throw()
+            : arena(that.arena)
+        {
+            this->arena->retain();
+        }
+
+        ~pool_allocator()
+        {
+            this->arena->release();
+        }
+
+        pool_allocator& operator=(const pool_allocator& that) throw()
+        {
+            that.arena->retain();
+            this->arena->release();
+            this->arena = that.arena;
+            return *this;
+        }
+
+    public:
+        pointer address(reference x) const { return ft::addressof(x); }
+        const_pointer address(const_reference x) const { return ft::addressof(x); }
+
+        pointer allocate(size_type n, const void* hint = 0)
+        {
+            static_cast<void>(hint);
+            if (n == 1 && this->arena->is_pooled(sizeof(T), _internal::_alignment_of<T>::value))
+            {
+                return static_cast<pointer>(this->arena->allocate());
+            }
+            if (n > this->max_size())
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<pointer>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(pointer p, size_type n)
+        {
+            if (n == 1 && this->arena->is_pooled(sizeof(T), _internal::_alignment_of<T>::value))
+            {
+                this->arena->deallocate(p);
+                return;
+            }
+            ::operator delete(p);
+        }
+
+        // Hint that n single nodes follow, a copied tree then sits in one block in order.
+        void reserve(size_type n)
+        {
+            if (n > 1 && n <= this->max_size() && this->arena->is_pooled(sizeof(T), _internal::_alignment_of<T>::value))
+            {
+                this->arena->reserve(n);
+            }
+        }
+
+        // Frees every slab of the arena when none of its nodes is alive, does nothing otherwise.
+        void release_all() throw() { this->arena->release_all(); }
+
+        size_type max_size() const throw() { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+        void construct(pointer p, const_reference value) { new (static_cast<void*>(p)) T(value); }
+        void destroy(pointer p) { p->~T(); }
+
+#if __cplusplus >= 201103L
+        template <typename U, typename... Args>
+        void construct(U* p, Args&&... args) { new (static_cast<void*>(p)) U(ft::forward<Args>(args)...); }
+        template <typename U>
+        void destroy(U* p) { p->~U(); }
+#endif
+    };
+
+    template <typename T1, typename T2>
+    inline bool operator==(
+        const pool_allocator<T1>& lhs,
+        const pool_allocator<T2>& rhs) throw()
+    {
+        return lhs.arena == rhs.arena;
+    }
+
+    template <typename T1, typename T2>
+    inline bool operator!=(
+        const pool_allocator<T1>& lhs,
+        const pool_allocator<T2>& rhs) throw()
+    {
+        return !(lhs == rhs);
+    }
+}
@@ -0,0 +1,201 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "algorithm.hpp"
+#include "deque.hpp"
+#include "functional.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+namespace ft
+{
+    template <typename T, typename TContainer = ft::deque<T> >
+    class queue
+    {
+    public:
+        typedef TContainer container_type;
+        typedef typename TContainer::value_type value_type;
+        typedef typename TContainer::size_type size_type;
+        typedef typename TContainer::reference reference;
+        typedef typename TContainer::const_reference const_reference;
+
+    protected:
+        container_type c;
+
+    public:
+        explicit queue(const container_type& c = container_type())
+            : c(c) {}
+
+        queue(const queue& that)
+            : c(that.c) {}
+
+#if __cplusplus >= 201103L
+        explicit queue(container_type&& c)
+            : c(ft::move(c)) {}
+
+        queue(queue&& that)
+            : c(ft::move(that.c)) {}
+#endif
+
+        ~queue() {}
+
+        queue& operator=(const queue& that)
+        {
+            this->c = that.c;
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        queue& operator=(queue&& that)
+        {
+            this->c = ft::move(that.c);
+            return *this;
+        }
+#endif
+
+    public:
+        reference front() { return c.front(); }
+        const_reference front() const { return c.front(); }
+        reference back() { return c.back(); }
+        const_reference back() const { return c.back(); }
+
+        bool empty() const { return c.empty(); }
+        size_type size() const { return c.size(); }
+
+        void push(const value_type& value) { c.push_back(value); }
+#if __cplusplus >= 201103L
+        void push(value_type&& value) { c.push_back(ft::move(value)); }
+        template <typename... Args>
+        void emplace(Args&&... args) { c.emplace_back(ft::forward<Args>(args)...); }
+#endif
+        void pop() { c.pop_front(); }
+
+    public:
+        friend bool operator==(const queue& lhs, const queue& rhs)
+        {
+            return lhs.c == rhs.c;
+        }
+
+        friend bool operator!=(const queue& lhs, const queue& rhs)
+        {
+            return lhs.c != rhs.c;
+        }
+
+        friend bool operator<(const queue& lhs, const queue& rhs)
+        {
+            return lhs.c < rhs.c;
+        }
+
+        friend bool operator<=(const queue& lhs, const queue& rhs)
+        {
+            return lhs.c <= rhs.c;
+        }
+
+        friend bool operator>(const queue& lhs, const queue& rhs)
+        {
+            return lhs.c > rhs.c;
+        }
+
+        friend bool operator>=(const queue& lhs, const queue& rhs)
+        {
+            return lhs.c >= rhs.c;
+        }
+    };
+
+    // A max heap (with respect to comp) kept in c by ft::push_heap and ft::pop_heap.
+    template <typename T, typename TContainer = ft::vector<T>, typename TComp = ft::less<typename TContainer::value_type> >
+    class priority_queue
+    {
+    public:
+        typedef TContainer container_type;
+        typedef TComp value_compare;
+        typedef typename TContainer::value_type value_type;
+        typedef typename TContainer::size_type size_type;
+        typedef typename TContainer::reference reference;
+        typedef typename TContainer::const_reference const_reference;
+
+    protected:
+        container_type c;
+        value_compare comp;
+
+    public:
+        explicit priority_queue(const value_compare& comp = value_compare(), const container_type& c = container_type())
+            : c(c), comp(comp)
+        {
+            ft::make_heap(this->c.begin(), this->c.end(), this->comp);
+        }
+
+        template <typename UIter>
+        // priority_queue(UIter first, UIter last, const value_compare& comp = value_compare(), const container_type& c = container_type())
+        priority_queue(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const value_compare& comp = value_compare(), const container_type& c = container_type())
+            : c(c), comp(comp)
+        {
+            this->c.insert(this->c.end(), first, last);
+            ft::make_heap(this->c.begin(), this->c.end(), this->comp);
+        }
+
+        priority_queue(const priority_queue& that)
+            : c(that.c), comp(that.comp) {}
+
+#if __cplusplus >= 201103L
+        priority_queue(const value_compare& comp, container_type&& c)
+            : c(ft::move(c)), comp(comp)
+        {
+            ft::make_heap(this->c.begin(), this->c.end(), this->comp);
+        }
+
+        priority_queue(priority_queue&& that)
+            : c(ft::move(that.c)), comp(ft::move(that.comp)) {}
+#endif
+
+        ~priority_queue() {}
+
+        priority_queue& operator=(const priority_queue& that)
+        {
+            this->c = that.c;
+            this->comp = that.comp;
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        priority_queue& operator=(priority_queue&& that)
+        {
+            this->c = ft::move(that.c);
+            this->comp = ft::move(that.comp);
+            return *this;
+        }
+#endif
+
+    public:
+        const_reference top() const { return c.front(); }
+
+        bool empty() const { return c.empty(); }
+        size_type size() const { return c.size(); }
+
+        void push(const value_type& value)
+        {
+            c.push_back(value);
+            ft::push_heap(c.begin(), c.end(), this->comp);
+        }
+#if __cplusplus >= 201103L
+        void push(value_type&& value)
+        {
+            c.push_back(ft::move(value));
+            ft::push_heap(c.begin(), c.end(), this->comp);
+        }
+        template <typename... Args>
+        void emplace(Args&&... args)
+        {
+            c.emplace_back(ft::forward<Args>(args)...);
+            ft::push_heap(c.begin(), c.end(), this->comp);
+        }
+#endif
+        void pop()
+        {
+            ft::pop_heap(c.begin(), c.end(), this->comp);
+            c.pop_back();
+        }
+    };
+}
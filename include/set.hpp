@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include "_node_handle.hpp"
 #include "_tree.hpp"
 #include "functional.hpp"
+#include "functional/_select.hpp"
 #include "utility.hpp"
 
 #include <cstddef>
@@ -12,382 +14,610 @@
 
 namespace ft
 {
-    template <typename T>
-    struct _select_self
+    namespace FT_TREE_LAYOUT
     {
-        const T& operator()(const T& t) const
-        {
-            return t;
-        }
-    };
+        template <typename T, typename TComp, typename TAlloc>
+        class multiset;
 
-    template <typename T, typename TComp = ft::less<T>, typename TAlloc = std::allocator<T> >
-    class set
-    {
-    public:
-        typedef T key_type;
-        typedef T value_type;
-        typedef TComp key_compare;
-        typedef TComp value_compare;
-        typedef TAlloc allocator_type;
-        typedef std::size_t size_type;
-        typedef std::ptrdiff_t difference_type;
-
-    protected:
-        typedef _select_self<value_type> key_select;
-        typedef ft::_tree<key_type, value_type, key_select, key_compare, allocator_type> container_type;
-
-    public:
-        typedef value_type& reference;
-        typedef const value_type& const_reference;
-        typedef typename allocator_type::pointer pointer;
-        typedef typename allocator_type::const_pointer const_pointer;
-        typedef typename container_type::const_iterator iterator; // const value cause key equals value
-        typedef typename container_type::const_iterator const_iterator;
-        typedef typename ft::reverse_iterator<iterator> reverse_iterator;
-        typedef typename ft::reverse_iterator<const_iterator> const_reverse_iterator;
-
-    private:
-        container_type c;
-
-    public:
-        set()
-            : c() {}
-
-        explicit set(const key_compare& comp, const allocator_type& alloc = allocator_type())
-            : c(comp, alloc) {}
-
-        template <typename UIter>
-        // set(UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
-        set(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
-            : c(comp, alloc)
+        template <typename T, typename TComp = ft::less<T>, typename TAlloc = std::allocator<T> >
+        class set
         {
-            this->insert(first, last);
-        }
+        public:
+            typedef T key_type;
+            typedef T value_type;
+            typedef TComp key_compare;
+            typedef TComp value_compare;
+            typedef TAlloc allocator_type;
+            typedef std::size_t size_type;
+            typedef std::ptrdiff_t difference_type;
+
+        protected:
+            typedef _select_self<value_type> key_select;
+            typedef ft::_tree<key_type, value_type, key_select, key_compare, allocator_type> container_type;
+
+        public:
+            typedef value_type& reference;
+            typedef const value_type& const_reference;
+            typedef typename allocator_type::pointer pointer;
+            typedef typename allocator_type::const_pointer const_pointer;
+            typedef typename container_type::const_iterator iterator; // const value cause key equals value
+            typedef typename container_type::const_iterator const_iterator;
+            typedef typename ft::reverse_iterator<iterator> reverse_iterator;
+            typedef typename ft::reverse_iterator<const_iterator> const_reverse_iterator;
+#if __cplusplus >= 201103L
+            typedef ft::_set_node_handle<T, typename container_type::allocator_type> node_type;
+            typedef ft::_insert_return_type<iterator, node_type> insert_return_type;
+#endif
+
+        private:
+            friend class multiset<T, TComp, TAlloc>;
+
+            container_type c;
+
+        public:
+            set()
+                : c() {}
+
+            explicit set(const key_compare& comp, const allocator_type& alloc = allocator_type())
+                : c(comp, alloc) {}
+
+            template <typename UIter>
+            // set(UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            set(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : c(comp, alloc)
+            {
+                this->insert(first, last);
+            }
 
-        set(const set& that)
-            : c(that.c) {}
+            template <typename UIter>
+            // set(ft::sorted_unique_t, UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            set(ft::sorted_unique_t, typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : c(comp, alloc)
+            {
+                this->insert(ft::sorted_unique, first, last);
+            }
 
-        ~set() {}
+            set(const set& that)
+                : c(that.c) {}
 
-    public:
-        set& operator=(const set& that)
-        {
-            this->c = that.c;
-            return *this;
-        }
-
-    public:
-        allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
-
-    public:
-        iterator begin() { return this->c.begin(); }
-        const_iterator begin() const { return this->c.begin(); }
-        iterator end() { return this->c.end(); }
-        const_iterator end() const { return this->c.end(); }
-        reverse_iterator rbegin() { return this->c.rbegin(); }
-        const_reverse_iterator rbegin() const { return this->c.rbegin(); }
-        reverse_iterator rend() { return this->c.rend(); }
-        const_reverse_iterator rend() const { return this->c.rend(); }
-
-    public:
-        bool empty() const { return this->c.empty(); }
-        size_type size() const { return this->c.size(); }
-        size_type max_size() const { return this->c.max_size(); }
-
-    public:
-        void clear() { return this->c.clear(); }
-
-        ft::pair<iterator, bool> insert(const value_type& value)
-        {
-            ft::pair<typename container_type::node_type*, bool> result = this->c.insert_unique(NULL, value);
-            return ft::make_pair(iterator(result.first), result.second);
-        }
+#if __cplusplus >= 201103L
+            set(set&& that) noexcept(noexcept(container_type(ft::declval<container_type>())))
+                : c(ft::move(that.c)) {}
+#endif
 
-        iterator insert(iterator hint, const value_type& value)
-        {
-            return iterator(this->c.insert_unique(hint.base(), value).first);
-        }
+            ~set() {}
 
-        template <typename UIter>
-        // void insert(UIter first, UIter last)
-        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
-        {
-            for (UIter it = first; it != last; ++it)
+        public:
+            set& operator=(const set& that)
             {
-                this->c.insert_unique(NULL, *it);
+                this->c = that.c;
+                return *this;
             }
-        }
 
-        iterator erase(iterator pos)
-        {
-            iterator it = pos++;
-            this->c.erase(it.base());
-            return pos;
-        }
+#if __cplusplus >= 201103L
+            set& operator=(set&& that)
+            {
+                this->c = ft::move(that.c);
+                return *this;
+            }
+#endif
+
+        public:
+            allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
+
+        public:
+            iterator begin() { return this->c.begin(); }
+            const_iterator begin() const { return this->c.begin(); }
+            iterator end() { return this->c.end(); }
+            const_iterator end() const { return this->c.end(); }
+            reverse_iterator rbegin() { return this->c.rbegin(); }
+            const_reverse_iterator rbegin() const { return this->c.rbegin(); }
+            reverse_iterator rend() { return this->c.rend(); }
+            const_reverse_iterator rend() const { return this->c.rend(); }
+
+        public:
+            bool empty() const { return this->c.empty(); }
+            size_type size() const { return this->c.size(); }
+            size_type max_size() const { return this->c.max_size(); }
+
+        public:
+            void clear() { return this->c.clear(); }
+
+            ft::pair<iterator, bool> insert(const value_type& value)
+            {
+                ft::pair<typename container_type::node_type*, bool> result = this->c.insert_unique(NULL, value);
+                return ft::make_pair(iterator(result.first), result.second);
+            }
 
-        iterator erase(iterator first, iterator last)
-        {
-            while (first != last)
+            iterator insert(iterator hint, const value_type& value)
             {
-                iterator it = first++;
+                return iterator(this->c.insert_unique(hint.base(), value).first);
+            }
+
+            template <typename UIter>
+            // void insert(UIter first, UIter last)
+            typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
+            {
+                this->c.insert_range_unique(first, last);
+            }
+
+            template <typename UIter>
+            // void insert(ft::sorted_unique_t, UIter first, UIter last)
+            typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(ft::sorted_unique_t, UIter first, UIter last)
+            {
+                this->c.insert_range_unique(ft::sorted_unique, first, last);
+            }
+
+#if __cplusplus >= 201103L
+            ft::pair<iterator, bool> insert(value_type&& value)
+            {
+                ft::pair<typename container_type::node_type*, bool> result = this->c.insert_unique(NULL, ft::move(value));
+                return ft::make_pair(iterator(result.first), result.second);
+            }
+
+            iterator insert(iterator hint, value_type&& value)
+            {
+                return iterator(this->c.insert_unique(hint.base(), ft::move(value)).first);
+            }
+
+            template <typename... Args>
+            ft::pair<iterator, bool> emplace(Args&&... args)
+            {
+                ft::pair<typename container_type::node_type*, bool> result = this->c.emplace_unique(NULL, ft::forward<Args>(args)...);
+                return ft::make_pair(iterator(result.first), result.second);
+            }
+
+            template <typename... Args>
+            iterator emplace_hint(iterator hint, Args&&... args)
+            {
+                return iterator(this->c.emplace_unique(hint.base(), ft::forward<Args>(args)...).first);
+            }
+#endif
+
+            iterator erase(iterator pos)
+            {
+                iterator it = pos++;
                 this->c.erase(it.base());
+                return pos;
             }
-            return last;
-        }
 
-        size_type erase(const key_type& key)
-        {
-            iterator it = this->find(key);
-            if (it == this->end())
+            iterator erase(iterator first, iterator last)
+            {
+                while (first != last)
+                {
+                    iterator it = first++;
+                    this->c.erase(it.base());
+                }
+                return last;
+            }
+
+            size_type erase(const key_type& key)
             {
-                return 0;
+                iterator it = this->find(key);
+                if (it == this->end())
+                {
+                    return 0;
+                }
+                this->erase(it);
+                return 1;
             }
-            this->erase(it);
-            return 1;
-        }
 
-        void swap(set& that) { this->c.swap(that.c); }
+            void swap(set& that) { this->c.swap(that.c); }
 
-    public:
-        size_type count(const key_type& key) const { return this->c.count(key); }
+        public:
+            // Relinks the nodes of source whose key is not here yet, the others stay behind.
+            void merge(set& source) { this->c.merge_unique(source.c); }
+            void merge(multiset<T, TComp, TAlloc>& source) { this->c.merge_unique(source.c); }
 
-        iterator find(const key_type& key) { return iterator(this->c.find(key)); }
-        const_iterator find(const key_type& key) const { return const_iterator(this->c.find(key)); }
+#if __cplusplus >= 201103L
+            void merge(set&& source) { this->merge(source); }
+            void merge(multiset<T, TComp, TAlloc>&& source) { this->merge(source); }
 
-        ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
-        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+            node_type extract(iterator pos) { return node_type(this->c.extract(pos.base()), this->c.get_allocator()); }
 
-        iterator lower_bound(const key_type& key) { return this->c.lower_bound(key); }
-        const_iterator lower_bound(const key_type& key) const { return this->c.lower_bound(key); }
+            node_type extract(const key_type& key)
+            {
+                iterator it = this->find(key);
+                if (it == this->end())
+                {
+                    return node_type();
+                }
+                return this->extract(it);
+            }
 
-        iterator upper_bound(const key_type& key) { return this->c.upper_bound(key); }
-        const_iterator upper_bound(const key_type& key) const { return this->c.upper_bound(key); }
+            // The node comes back in the result when its key is already present.
+            insert_return_type insert(node_type&& node)
+            {
+                if (node.empty())
+                {
+                    return insert_return_type{this->end(), false, node_type()};
+                }
+                ft::pair<typename container_type::node_type*, bool> result = this->c.insert_node_unique(NULL, node.get());
+                if (!result.second)
+                {
+                    return insert_return_type{iterator(result.first), false, ft::move(node)};
+                }
+                node.release();
+                return insert_return_type{iterator(result.first), true, node_type()};
+            }
 
-    public:
-        key_compare key_comp() const { return this->c.key_comp(); }
-        value_compare value_comp() const { return value_compare(this->c.key_comp()); }
+            iterator insert(iterator hint, node_type&& node)
+            {
+                if (node.empty())
+                {
+                    return this->end();
+                }
+                ft::pair<typename container_type::node_type*, bool> result = this->c.insert_node_unique(hint.base(), node.get());
+                if (result.second)
+                {
+                    node.release();
+                }
+                return iterator(result.first);
+            }
+#endif
 
-    public:
-        friend bool operator==(const set& lhs, const set& rhs)
-        {
-            return lhs.c == rhs.c;
-        }
+        public:
+            // Set algebra relinking the nodes of the argument, which ends up empty (split refills it).
+            // O(m log(n / m + 1)) for sizes m <= n. If the comparator throws, both containers stay
+            // valid and nothing is lost but the duplicates already released by a union.
 
-        friend bool operator!=(const set& lhs, const set& rhs)
-        {
-            return lhs.c != rhs.c;
-        }
+            // O(log n) with FT_TREE_ORDER_STATISTICS, otherwise counting the elements that stay
+            // adds O(min(k, n - k)) for k of them.
+            void split(const key_type& key, set& greater) { this->c.split(key, greater.c); }
+            void join(set& greater) { this->c.join(greater.c); }
+            void set_union(set& that) { this->c.set_union(that.c); }
+            void set_intersection(set& that) { this->c.set_intersection(that.c); }
+            void set_difference(set& that) { this->c.set_difference(that.c); }
 
-        friend bool operator<(const set& lhs, const set& rhs)
-        {
-            return lhs.c < rhs.c;
-        }
+        public:
+            size_type count(const key_type& key) const { return this->c.count(key); }
 
-        friend bool operator<=(const set& lhs, const set& rhs)
-        {
-            return lhs.c <= rhs.c;
-        }
+            iterator find(const key_type& key) { return iterator(this->c.find(key)); }
+            const_iterator find(const key_type& key) const { return const_iterator(this->c.find(key)); }
 
-        friend bool operator>(const set& lhs, const set& rhs)
-        {
-            return lhs.c > rhs.c;
-        }
+            // O(log n) with FT_TREE_ORDER_STATISTICS, a walk in order otherwise
+            iterator find_by_order(size_type k) { return iterator(this->c.nth_element(k)); }
+            const_iterator find_by_order(size_type k) const { return const_iterator(this->c.nth_element(k)); }
+            size_type order_of_key(const key_type& key) const { return this->c.rank(key); }
 
-        friend bool operator>=(const set& lhs, const set& rhs)
-        {
-            return lhs.c >= rhs.c;
-        }
-    };
+            ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
+            ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
 
-    template <typename T, typename TComp, typename TAlloc>
-    inline void swap(
-        set<T, TComp, TAlloc>& lhs,
-        set<T, TComp, TAlloc>& rhs)
-    {
-        lhs.swap(rhs);
-    }
+            iterator lower_bound(const key_type& key) { return this->c.lower_bound(key); }
+            const_iterator lower_bound(const key_type& key) const { return this->c.lower_bound(key); }
 
-    template <typename T, typename TComp = ft::less<T>, typename TAlloc = std::allocator<T> >
-    class multiset
-    {
-    public:
-        typedef T key_type;
-        typedef T value_type;
-        typedef TComp key_compare;
-        typedef TComp value_compare;
-        typedef TAlloc allocator_type;
-        typedef std::size_t size_type;
-        typedef std::ptrdiff_t difference_type;
-
-    protected:
-        typedef _select_self<value_type> key_select;
-        typedef ft::_tree<key_type, value_type, key_select, key_compare, allocator_type> container_type;
-
-    public:
-        typedef value_type& reference;
-        typedef const value_type& const_reference;
-        typedef typename allocator_type::pointer pointer;
-        typedef typename allocator_type::const_pointer const_pointer;
-        typedef typename container_type::const_iterator iterator; // const value cause key equals value
-        typedef typename container_type::const_iterator const_iterator;
-        typedef typename ft::reverse_iterator<iterator> reverse_iterator;
-        typedef typename ft::reverse_iterator<const_iterator> const_reverse_iterator;
-
-    private:
-        container_type c;
-
-    public:
-        multiset()
-            : c() {}
-
-        explicit multiset(const key_compare& comp, const allocator_type& alloc = allocator_type())
-            : c(comp, alloc) {}
-
-        template <typename UIter>
-        // multiset(UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
-        multiset(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
-            : c(comp, alloc)
-        {
-            this->insert(first, last);
-        }
+            iterator upper_bound(const key_type& key) { return this->c.upper_bound(key); }
+            const_iterator upper_bound(const key_type& key) const { return this->c.upper_bound(key); }
 
-        multiset(const multiset& that)
-            : c(that.c) {}
+        public:
+            key_compare key_comp() const { return this->c.key_comp(); }
+            value_compare value_comp() const { return value_compare(this->c.key_comp()); }
 
-        ~multiset() {}
+        public:
+            friend bool operator==(const set& lhs, const set& rhs)
+            {
+                return lhs.c == rhs.c;
+            }
 
-    public:
-        multiset& operator=(const multiset& that)
-        {
-            this->c = that.c;
-            return *this;
-        }
-
-    public:
-        allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
-
-    public:
-        iterator begin() { return this->c.begin(); }
-        const_iterator begin() const { return this->c.begin(); }
-        iterator end() { return this->c.end(); }
-        const_iterator end() const { return this->c.end(); }
-        reverse_iterator rbegin() { return this->c.rbegin(); }
-        const_reverse_iterator rbegin() const { return this->c.rbegin(); }
-        reverse_iterator rend() { return this->c.rend(); }
-        const_reverse_iterator rend() const { return this->c.rend(); }
-
-    public:
-        bool empty() const { return this->c.empty(); }
-        size_type size() const { return this->c.size(); }
-        size_type max_size() const { return this->c.max_size(); }
-
-    public:
-        void clear() { return this->c.clear(); }
-
-        iterator insert(const value_type& value)
-        {
-            typename container_type::node_type* result = this->c.insert(NULL, value);
-            return iterator(result);
-        }
+            friend bool operator!=(const set& lhs, const set& rhs)
+            {
+                return lhs.c != rhs.c;
+            }
 
-        iterator insert(iterator hint, const value_type& value)
-        {
-            return iterator(this->c.insert(hint.base(), value));
-        }
+            friend bool operator<(const set& lhs, const set& rhs)
+            {
+                return lhs.c < rhs.c;
+            }
 
-        template <typename UIter>
-        // void insert(UIter first, UIter last)
-        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
-        {
-            for (UIter it = first; it != last; ++it)
+            friend bool operator<=(const set& lhs, const set& rhs)
             {
-                this->c.insert(NULL, *it);
+                return lhs.c <= rhs.c;
             }
-        }
 
-        iterator erase(iterator pos)
-        {
-            iterator it = pos++;
-            this->c.erase(it.base());
-            return pos;
-        }
+            friend bool operator>(const set& lhs, const set& rhs)
+            {
+                return lhs.c > rhs.c;
+            }
 
-        iterator erase(iterator first, iterator last)
-        {
-            while (first != last)
+            friend bool operator>=(const set& lhs, const set& rhs)
             {
-                iterator it = first++;
-                this->c.erase(it.base());
+                return lhs.c >= rhs.c;
             }
-            return last;
-        }
+        };
 
-        size_type erase(const key_type& key)
+        template <typename T, typename TComp = ft::less<T>, typename TAlloc = std::allocator<T> >
+        class multiset
         {
-            ft::pair<const_iterator, const_iterator> range = this->equal_range(key);
-            size_type n = size_type();
-            while (range.first != range.second)
+        public:
+            typedef T key_type;
+            typedef T value_type;
+            typedef TComp key_compare;
+            typedef TComp value_compare;
+            typedef TAlloc allocator_type;
+            typedef std::size_t size_type;
+            typedef std::ptrdiff_t difference_type;
+
+        protected:
+            typedef _select_self<value_type> key_select;
+            typedef ft::_tree<key_type, value_type, key_select, key_compare, allocator_type> container_type;
+
+        public:
+            typedef value_type& reference;
+            typedef const value_type& const_reference;
+            typedef typename allocator_type::pointer pointer;
+            typedef typename allocator_type::const_pointer const_pointer;
+            typedef typename container_type::const_iterator iterator; // const value cause key equals value
+            typedef typename container_type::const_iterator const_iterator;
+            typedef typename ft::reverse_iterator<iterator> reverse_iterator;
+            typedef typename ft::reverse_iterator<const_iterator> const_reverse_iterator;
+#if __cplusplus >= 201103L
+            typedef ft::_set_node_handle<T, typename container_type::allocator_type> node_type;
+#endif
+
+        private:
+            friend class set<T, TComp, TAlloc>;
+
+            container_type c;
+
+        public:
+            multiset()
+                : c() {}
+
+            explicit multiset(const key_compare& comp, const allocator_type& alloc = allocator_type())
+                : c(comp, alloc) {}
+
+            template <typename UIter>
+            // multiset(UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            multiset(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : c(comp, alloc)
+            {
+                this->insert(first, last);
+            }
+
+            template <typename UIter>
+            // multiset(ft::sorted_equivalent_t, UIter first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+            multiset(ft::sorted_equivalent_t, typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : c(comp, alloc)
+            {
+                this->insert(ft::sorted_equivalent, first, last);
+            }
+
+            multiset(const multiset& that)
+                : c(that.c) {}
+
+#if __cplusplus >= 201103L
+            multiset(multiset&& that) noexcept(noexcept(container_type(ft::declval<container_type>())))
+                : c(ft::move(that.c)) {}
+#endif
+
+            ~multiset() {}
+
+        public:
+            multiset& operator=(const multiset& that)
+            {
+                this->c = that.c;
+                return *this;
+            }
+
+#if __cplusplus >= 201103L
+            multiset& operator=(multiset&& that)
+            {
+                this->c = ft::move(that.c);
+                return *this;
+            }
+#endif
+
+        public:
+            allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
+
+        public:
+            iterator begin() { return this->c.begin(); }
+            const_iterator begin() const { return this->c.begin(); }
+            iterator end() { return this->c.end(); }
+            const_iterator end() const { return this->c.end(); }
+            reverse_iterator rbegin() { return this->c.rbegin(); }
+            const_reverse_iterator rbegin() const { return this->c.rbegin(); }
+            reverse_iterator rend() { return this->c.rend(); }
+            const_reverse_iterator rend() const { return this->c.rend(); }
+
+        public:
+            bool empty() const { return this->c.empty(); }
+            size_type size() const { return this->c.size(); }
+            size_type max_size() const { return this->c.max_size(); }
+
+        public:
+            void clear() { return this->c.clear(); }
+
+            iterator insert(const value_type& value)
+            {
+                typename container_type::node_type* result = this->c.insert(NULL, value);
+                return iterator(result);
+            }
+
+            iterator insert(iterator hint, const value_type& value)
+            {
+                return iterator(this->c.insert(hint.base(), value));
+            }
+
+            template <typename UIter>
+            // void insert(UIter first, UIter last)
+            typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
+            {
+                this->c.insert_range_equal(first, last);
+            }
+
+            template <typename UIter>
+            // void insert(ft::sorted_equivalent_t, UIter first, UIter last)
+            typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(ft::sorted_equivalent_t, UIter first, UIter last)
+            {
+                this->c.insert_range_equal(ft::sorted_equivalent, first, last);
+            }
+
+#if __cplusplus >= 201103L
+            iterator insert(value_type&& value)
             {
-                const_iterator it = range.first++;
+                return iterator(this->c.insert(NULL, ft::move(value)));
+            }
+
+            iterator insert(iterator hint, value_type&& value)
+            {
+                return iterator(this->c.insert(hint.base(), ft::move(value)));
+            }
+
+            template <typename... Args>
+            iterator emplace(Args&&... args)
+            {
+                return iterator(this->c.emplace_equal(NULL, ft::forward<Args>(args)...));
+            }
+
+            template <typename... Args>
+            iterator emplace_hint(iterator hint, Args&&... args)
+            {
+                return iterator(this->c.emplace_equal(hint.base(), ft::forward<Args>(args)...));
+            }
+#endif
+
+            iterator erase(iterator pos)
+            {
+                iterator it = pos++;
                 this->c.erase(it.base());
-                n++;
+                return pos;
             }
-            return n;
-        }
 
-        void swap(multiset& that) { this->c.swap(that.c); }
+            iterator erase(iterator first, iterator last)
+            {
+                while (first != last)
+                {
+                    iterator it = first++;
+                    this->c.erase(it.base());
+                }
+                return last;
+            }
 
-    public:
-        size_type count(const key_type& key) const { return this->c.count(key); }
+            size_type erase(const key_type& key)
+            {
+                ft::pair<const_iterator, const_iterator> range = this->equal_range(key);
+                size_type n = size_type();
+                while (range.first != range.second)
+                {
+                    const_iterator it = range.first++;
+                    this->c.erase(it.base());
+                    n++;
+                }
+                return n;
+            }
 
-        iterator find(const key_type& key) { return iterator(this->c.find(key)); }
-        const_iterator find(const key_type& key) const { return const_iterator(this->c.find(key)); }
+            void swap(multiset& that) { this->c.swap(that.c); }
 
-        ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
-        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+        public:
+            // Relinks every node of source.
+            void merge(multiset& source) { this->c.merge_equal(source.c); }
+            void merge(set<T, TComp, TAlloc>& source) { this->c.merge_equal(source.c); }
 
-        iterator lower_bound(const key_type& key) { return this->c.lower_bound(key); }
-        const_iterator lower_bound(const key_type& key) const { return this->c.lower_bound(key); }
+#if __cplusplus >= 201103L
+            void merge(multiset&& source) { this->merge(source); }
+            void merge(set<T, TComp, TAlloc>&& source) { this->merge(source); }
 
-        iterator upper_bound(const key_type& key) { return this->c.upper_bound(key); }
-        const_iterator upper_bound(const key_type& key) const { return this->c.upper_bound(key); }
+            node_type extract(iterator pos) { return node_type(this->c.extract(pos.base()), this->c.get_allocator()); }
 
-    public:
-        key_compare key_comp() const { return this->c.key_comp(); }
-        value_compare value_comp() const { return value_compare(this->c.key_comp()); }
+            node_type extract(const key_type& key)
+            {
+                iterator it = this->find(key);
+                if (it == this->end())
+                {
+                    return node_type();
+                }
+                return this->extract(it);
+            }
 
-    public:
-        friend bool operator==(const multiset& lhs, const multiset& rhs)
-        {
-            return lhs.c == rhs.c;
-        }
+            iterator insert(node_type&& node)
+            {
+                if (node.empty())
+                {
+                    return this->end();
+                }
+                // the handle keeps the node until it is linked, the comparator may throw before
+                typename container_type::node_type* linked = this->c.insert_node_equal(NULL, node.get());
+                node.release();
+                return iterator(linked);
+            }
 
-        friend bool operator!=(const multiset& lhs, const multiset& rhs)
-        {
-            return lhs.c != rhs.c;
-        }
+            iterator insert(iterator hint, node_type&& node)
+            {
+                if (node.empty())
+                {
+                    return this->end();
+                }
+                typename container_type::node_type* linked = this->c.insert_node_equal(hint.base(), node.get());
+                node.release();
+                return iterator(linked);
+            }
+#endif
 
-        friend bool operator<(const multiset& lhs, const multiset& rhs)
-        {
-            return lhs.c < rhs.c;
-        }
+        public:
+            size_type count(const key_type& key) const { return this->c.count(key); }
 
-        friend bool operator<=(const multiset& lhs, const multiset& rhs)
-        {
-            return lhs.c <= rhs.c;
-        }
+            iterator find(const key_type& key) { return iterator(this->c.find(key)); }
+            const_iterator find(const key_type& key) const { return const_iterator(this->c.find(key)); }
 
-        friend bool operator>(const multiset& lhs, const multiset& rhs)
-        {
-            return lhs.c > rhs.c;
-        }
+            // O(log n) with FT_TREE_ORDER_STATISTICS, a walk in order otherwise
+            iterator find_by_order(size_type k) { return iterator(this->c.nth_element(k)); }
+            const_iterator find_by_order(size_type k) const { return const_iterator(this->c.nth_element(k)); }
+            size_type order_of_key(const key_type& key) const { return this->c.rank(key); }
 
-        friend bool operator>=(const multiset& lhs, const multiset& rhs)
-        {
-            return lhs.c >= rhs.c;
-        }
-    };
+            ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
+            ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+
+            iterator lower_bound(const key_type& key) { return this->c.lower_bound(key); }
+            const_iterator lower_bound(const key_type& key) const { return this->c.lower_bound(key); }
+
+            iterator upper_bound(const key_type& key) { return this->c.upper_bound(key); }
+            const_iterator upper_bound(const key_type& key) const { return this->c.upper_bound(key); }
+
+        public:
+            key_compare key_comp() const { return this->c.key_comp(); }
+            value_compare value_comp() const { return value_compare(this->c.key_comp()); }
+
+        public:
+            friend bool operator==(const multiset& lhs, const multiset& rhs)
+            {
+                return lhs.c == rhs.c;
+            }
+
+            friend bool operator!=(const multiset& lhs, const multiset& rhs)
+            {
+                return lhs.c != rhs.c;
+            }
+
+            friend bool operator<(const multiset& lhs, const multiset& rhs)
+            {
+                return lhs.c < rhs.c;
+            }
+
+            friend bool operator<=(const multiset& lhs, const multiset& rhs)
+            {
+                return lhs.c <= rhs.c;
+            }
+
+            friend bool operator>(const multiset& lhs, const multiset& rhs)
+            {
+                return lhs.c > rhs.c;
+            }
+
+            friend bool operator>=(const multiset& lhs, const multiset& rhs)
+            {
+                return lhs.c >= rhs.c;
+            }
+        };
+    }
+
+    template <typename T, typename TComp, typename TAlloc>
+    inline void swap(
+        set<T, TComp, TAlloc>& lhs,
+        set<T, TComp, TAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
 
     template <typename T, typename TComp, typename TAlloc>
     inline void swap(
@@ -396,6 +626,14 @@ namespace ft
     {
         lhs.swap(rhs);
     }
+
+#if __cplusplus < 201103L
+    // without inline namespaces argument dependent lookup stops at the layout namespace
+    namespace FT_TREE_LAYOUT
+    {
+        using ft::swap;
+    }
+#endif
 }
 
 namespace std
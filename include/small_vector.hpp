@@ -0,0 +1,408 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "algorithm.hpp"
+#include "memory.hpp"
+#include "memory/_allocator_hooks.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace ft
+{
+    namespace _internal
+    {
+        // Serves the first request of at most N elements from a block inside the allocator,
+        // anything larger (or made while that block is taken) comes from TAlloc.
+        // A copy starts with its own empty block: the inline storage never changes hands.
+        template <typename T, std::size_t N, typename TAlloc>
+        class _small_vector_allocator
+        {
+        public:
+            typedef typename TAlloc::value_type value_type;
+            typedef typename TAlloc::pointer pointer;
+            typedef typename TAlloc::const_pointer const_pointer;
+            typedef typename TAlloc::reference reference;
+            typedef typename TAlloc::const_reference const_reference;
+            typedef typename TAlloc::size_type size_type;
+            typedef typename TAlloc::difference_type difference_type;
+
+            // a rebound allocator keeps the inline byte budget
+            template <typename U>
+            struct rebind
+            {
+                typedef _small_vector_allocator<U, (N * sizeof(T) + sizeof(U) - 1) / sizeof(U), typename TAlloc::template rebind<U>::other> other;
+            };
+
+        private:
+            union
+            {
+                _internal::_pool_max_align align;
+                unsigned char bytes[sizeof(T) * (N == 0 ? 1 : N)];
+            } storage;
+
+            bool used;
+            TAlloc base;
+
+        public:
+            explicit _small_vector_allocator(const TAlloc& base = TAlloc())
+                : used(false), base(base) {}
+
+            _small_vector_allocator(const _small_vector_allocator& that)
+                : used(false), base(that.base) {}
+
+            template <typename U, std::size_t M, typename UAlloc>
+            _small_vector_allocator(const _small_vector_allocator<U, M, UAlloc>& that)
+                : used(false), base(that.base_allocator()) {}
+
+            _small_vector_allocator& operator=(const _small_vector_allocator& that)
+            {
+                this->base = that.base;
+                return *this;
+            }
+
+        public:
+            const TAlloc& base_allocator() const { return this->base; }
+
+            bool is_inline(const_pointer p) const
+            {
+                return p == reinterpret_cast<const_pointer>(this->storage.bytes);
+            }
+
+            pointer allocate(size_type n)
+            {
+                if (n <= N && !this->used)
+                {
+                    this->used = true;
+                    return reinterpret_cast<pointer>(this->storage.bytes);
+                }
+                return this->base.allocate(n);
+            }
+
+            void deallocate(pointer p, size_type n)
+            {
+                if (this->is_inline(p))
+                {
+                    this->used = false;
+                    return;
+                }
+                this->base.deallocate(p, n);
+            }
+
+            size_type usable_size(pointer p, size_type n) const
+            {
+                if (this->is_inline(p))
+                {
+                    return N;
+                }
+                return _internal::usable_size(this->base, p, n);
+            }
+
+            size_type max_size() const { return this->base.max_size(); }
+
+#if __cplusplus >= 201103L
+            template <typename U, typename... Args>
+            void construct(U* p, Args&&... args)
+            {
+                this->base.construct(p, ft::forward<Args>(args)...);
+            }
+#else
+            void construct(pointer p, const_reference value)
+            {
+                this->base.construct(p, value);
+            }
+#endif
+
+            void destroy(pointer p)
+            {
+                this->base.destroy(p);
+            }
+        };
+
+        template <typename T, std::size_t N, typename TAlloc>
+        struct _is_plain_allocator<_small_vector_allocator<T, N, TAlloc> > : _is_plain_allocator<TAlloc>
+        {
+        };
+    }
+
+    // Vector holding up to N elements inside the object itself, more spill to TAlloc.
+    // Growth and relocation are vector's own, the inline block is simply the first one it gets.
+    // Moving or swapping an inline vector moves the elements, iterators do not carry over.
+    template <typename T, std::size_t N, typename TAlloc = std::allocator<T>, typename TGrowth = ft::growth_double>
+    class small_vector
+        : private ft::vector<T, _internal::_small_vector_allocator<T, N, TAlloc>, TGrowth>
+    {
+    protected:
+        typedef _internal::_small_vector_allocator<T, N, TAlloc> inline_allocator;
+        typedef ft::vector<T, inline_allocator, TGrowth> base_type;
+
+    public:
+        typedef T value_type;
+        typedef TAlloc allocator_type;
+        typedef TGrowth growth_policy;
+        typedef typename base_type::size_type size_type;
+        typedef typename base_type::difference_type difference_type;
+        typedef typename base_type::reference reference;
+        typedef typename base_type::const_reference const_reference;
+        typedef typename base_type::pointer pointer;
+        typedef typename base_type::const_pointer const_pointer;
+        typedef typename base_type::iterator iterator;
+        typedef typename base_type::const_iterator const_iterator;
+        typedef typename base_type::reverse_iterator reverse_iterator;
+        typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+
+    public:
+        small_vector()
+            : base_type()
+        {
+            this->reserve(N);
+        }
+
+        explicit small_vector(const allocator_type& alloc)
+            : base_type(inline_allocator(alloc))
+        {
+            this->reserve(N);
+        }
+
+        explicit small_vector(size_type count, const value_type& value = value_type(), const allocator_type& alloc = allocator_type())
+            : base_type(inline_allocator(alloc))
+        {
+            this->reserve(N);
+            this->assign(count, value);
+        }
+
+        template <typename UIter>
+        // small_vector(UIter first, UIter last, const allocator_type& alloc = allocator_type())
+        small_vector(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const allocator_type& alloc = allocator_type())
+            : base_type(inline_allocator(alloc))
+        {
+            this->reserve(N);
+            this->assign(first, last);
+        }
+
+        small_vector(const small_vector& that)
+            : base_type(inline_allocator(that.get_allocator()))
+        {
+            this->reserve(N);
+            this->assign(that.begin(), that.end());
+        }
+
+#if __cplusplus >= 201103L
+        small_vector(small_vector&& that) noexcept(ft::_internal::_move_if_noexcept<value_type>::value)
+            : base_type(inline_allocator(that.get_allocator()))
+        {
+            if (that.is_inline())
+            {
+                this->reserve(N);
+                small_vector::append_moved(*this, that.begin(), that.end());
+                that.clear();
+            }
+            else
+            {
+                this->take_heap_block(that);
+            }
+        }
+#endif
+
+        ~small_vector() {}
+
+        small_vector& operator=(const small_vector& that)
+        {
+            if (this != &that)
+            {
+                this->assign(that.begin(), that.end());
+            }
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        small_vector& operator=(small_vector&& that)
+        {
+            if (this == &that)
+            {
+                return *this;
+            }
+            if (!that.is_inline())
+            {
+                this->clear();
+                this->base_type::shrink_to_fit();
+                this->take_heap_block(that);
+                return *this;
+            }
+            iterator it = this->begin();
+            iterator src = that.begin();
+            for (; it != this->end() && src != that.end(); ++src)
+            {
+                *it = ft::move(*src);
+                ++it;
+            }
+            if (it != this->end())
+            {
+                static_cast<void>(this->erase(it, this->end()));
+            }
+            small_vector::append_moved(*this, src, that.end());
+            that.clear();
+            return *this;
+        }
+#endif
+
+    protected:
+        bool is_inline() const
+        {
+            return this->get_allocator_ref().is_inline(this->data());
+        }
+
+        // this holds no storage, the heap block of that comes over and that falls back to its inline block
+        void take_heap_block(small_vector& that)
+        {
+            this->base_type::swap(that);
+            that.reserve(N);
+        }
+
+        static void append_moved(small_vector& dest, iterator first, iterator last)
+        {
+#if __cplusplus >= 201103L
+            for (; first != last; ++first)
+            {
+                dest.emplace_back(ft::move(*first));
+            }
+#else
+            dest.insert(dest.end(), first, last);
+#endif
+        }
+
+    public:
+        using base_type::assign;
+
+        allocator_type get_allocator() const { return this->get_allocator_ref().base_allocator(); }
+
+    public:
+        using base_type::at;
+        using base_type::operator[];
+        using base_type::front;
+        using base_type::back;
+        using base_type::data;
+
+    public:
+        using base_type::begin;
+        using base_type::end;
+        using base_type::rbegin;
+        using base_type::rend;
+
+    public:
+        using base_type::empty;
+        using base_type::size;
+        using base_type::max_size;
+        using base_type::reserve;
+        using base_type::capacity;
+
+        void shrink_to_fit()
+        {
+            // the inline block costs nothing to keep, a heap block is given up once the elements fit inline
+            if (!this->is_inline())
+            {
+                this->base_type::shrink_to_fit();
+                if (this->capacity() < N)
+                {
+                    this->reserve(N);
+                }
+            }
+        }
+
+    public:
+        using base_type::clear;
+        using base_type::insert;
+        using base_type::erase;
+        using base_type::push_back;
+        using base_type::pop_back;
+        using base_type::resize;
+        using base_type::resize_default_init;
+        using base_type::resize_uninitialized;
+        using base_type::append_uninitialized;
+#if __cplusplus >= 201103L
+        using base_type::emplace;
+        using base_type::emplace_back;
+#endif
+
+        void swap(small_vector& that)
+        {
+            if (!this->is_inline() && !that.is_inline())
+            {
+                this->base_type::swap(that);
+                return;
+            }
+            // an inline block cannot be handed over: the common prefix is swapped in place
+            // and the rest of the longer vector is moved to the end of the shorter one
+            small_vector& shorter = this->size() < that.size() ? *this : that;
+            small_vector& longer = this->size() < that.size() ? that : *this;
+            size_type common = shorter.size();
+            shorter.reserve(longer.size());
+            for (size_type i = 0; i != common; i++)
+            {
+                ft::iter_swap(shorter.begin() + i, longer.begin() + i);
+            }
+            small_vector::append_moved(shorter, longer.begin() + common, longer.end());
+            static_cast<void>(longer.erase(longer.begin() + common, longer.end()));
+        }
+
+    public:
+        friend bool operator==(const small_vector& lhs, const small_vector& rhs)
+        {
+            return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        friend bool operator!=(const small_vector& lhs, const small_vector& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const small_vector& lhs, const small_vector& rhs)
+        {
+            return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator<=(const small_vector& lhs, const small_vector& rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>(const small_vector& lhs, const small_vector& rhs)
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator>=(const small_vector& lhs, const small_vector& rhs)
+        {
+            return !(lhs < rhs);
+        }
+    };
+
+    // Not provided: the storage of vector<bool> is packed words, 64 flags already fit in one.
+    // Use ft::vector<bool>, or small_vector<char, N> for addressable flags.
+    template <std::size_t N, typename TAlloc, typename TGrowth>
+    class small_vector<bool, N, TAlloc, TGrowth>;
+
+    template <typename T, std::size_t N, typename TAlloc, typename TGrowth>
+    inline void swap(
+        small_vector<T, N, TAlloc, TGrowth>& lhs,
+        small_vector<T, N, TAlloc, TGrowth>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+namespace std
+{
+    template <typename T, std::size_t N, typename TAlloc, typename TGrowth>
+    inline void swap(
+        ft::small_vector<T, N, TAlloc, TGrowth>& lhs,
+        ft::small_vector<T, N, TAlloc, TGrowth>& rhs)
+    {
+        ft::swap(lhs, rhs);
+    }
+}
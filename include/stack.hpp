@@ -3,11 +3,25 @@
 
 #pragma once
 
+#include "deque.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
 #include "vector.hpp"
 
 namespace ft
 {
-    template <typename T, typename TContainer = ft::vector<T> >
+    namespace _internal
+    {
+        // vector grows by relocating, which is a byte copy for trivially relocatable
+        // elements; anything else stays put in the blocks of a deque
+        template <typename T>
+        struct _stack_default_container
+            : ft::conditional<ft::is_trivially_relocatable<T>::value, ft::vector<T>, ft::deque<T> >
+        {
+        };
+    }
+
+    template <typename T, typename TContainer = typename _internal::_stack_default_container<T>::type>
     class stack
     {
     public:
@@ -27,6 +41,14 @@ namespace ft
         stack(const stack& that)
             : c(that.c) {}
 
+#if __cplusplus >= 201103L
+        explicit stack(container_type&& c)
+            : c(ft::move(c)) {}
+
+        stack(stack&& that)
+            : c(ft::move(that.c)) {}
+#endif
+
         ~stack() {}
 
         stack& operator=(const stack& that)
@@ -35,6 +57,14 @@ namespace ft
             return *this;
         }
 
+#if __cplusplus >= 201103L
+        stack& operator=(stack&& that)
+        {
+            this->c = ft::move(that.c);
+            return *this;
+        }
+#endif
+
     public:
         reference top() { return c.back(); }
         const_reference top() const { return c.back(); }
@@ -43,6 +73,11 @@ namespace ft
         size_type size() const { return c.size(); }
 
         void push(const value_type& value) { c.push_back(value); }
+#if __cplusplus >= 201103L
+        void push(value_type&& value) { c.push_back(ft::move(value)); }
+        template <typename... Args>
+        void emplace(Args&&... args) { c.emplace_back(ft::forward<Args>(args)...); }
+#endif
         void pop() { c.pop_back(); }
 
     public:
@@ -3,14 +3,22 @@
 
 #pragma once
 
+#include "type_traits/conditional.hpp"
 #include "type_traits/enable_if.hpp"
 #include "type_traits/integral_constant.hpp"
 #include "type_traits/is_const.hpp"
 #include "type_traits/is_convertible.hpp"
+#include "type_traits/is_floating_point.hpp"
 #include "type_traits/is_function.hpp"
 #include "type_traits/is_integral.hpp"
 #include "type_traits/is_object.hpp"
+#include "type_traits/is_pointer.hpp"
 #include "type_traits/is_reference.hpp"
 #include "type_traits/is_same.hpp"
+#include "type_traits/is_trivially_copyable.hpp"
+#include "type_traits/is_trivially_default_constructible.hpp"
+#include "type_traits/is_trivially_relocatable.hpp"
 #include "type_traits/is_void.hpp"
 #include "type_traits/make_void.hpp"
+#include "type_traits/remove_cv.hpp"
+#include "type_traits/remove_reference.hpp"
@@ -0,0 +1,19 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+namespace ft
+{
+    template <bool B, typename TTrue, typename TFalse>
+    struct conditional
+    {
+        typedef TTrue type;
+    };
+
+    template <typename TTrue, typename TFalse>
+    struct conditional<false, TTrue, TFalse>
+    {
+        typedef TFalse type;
+    };
+}
@@ -0,0 +1,43 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "integral_constant.hpp"
+
+namespace ft
+{
+    // Default
+    template <typename T>
+    struct is_floating_point : ft::false_type
+    {
+    };
+
+    // Remove cv-qualified variants
+    template <typename T>
+    struct is_floating_point<const T> : is_floating_point<T>
+    {
+    };
+    template <typename T>
+    struct is_floating_point<volatile const T> : is_floating_point<T>
+    {
+    };
+    template <typename T>
+    struct is_floating_point<volatile T> : is_floating_point<T>
+    {
+    };
+
+    // Floating point
+    template <>
+    struct is_floating_point<float> : ft::true_type
+    {
+    };
+    template <>
+    struct is_floating_point<double> : ft::true_type
+    {
+    };
+    template <>
+    struct is_floating_point<long double> : ft::true_type
+    {
+    };
+}
@@ -0,0 +1,33 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "integral_constant.hpp"
+
+namespace ft
+{
+    // Default
+    template <typename T>
+    struct is_pointer : ft::false_type
+    {
+    };
+
+    // Pointer
+    template <typename T>
+    struct is_pointer<T*> : ft::true_type
+    {
+    };
+    template <typename T>
+    struct is_pointer<T* const> : ft::true_type
+    {
+    };
+    template <typename T>
+    struct is_pointer<T* volatile> : ft::true_type
+    {
+    };
+    template <typename T>
+    struct is_pointer<T* const volatile> : ft::true_type
+    {
+    };
+}
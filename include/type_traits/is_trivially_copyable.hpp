@@ -0,0 +1,32 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "integral_constant.hpp"
+#include "is_floating_point.hpp"
+#include "is_integral.hpp"
+#include "is_pointer.hpp"
+
+namespace ft
+{
+    // NOTE: C++98 cannot detect triviality on its own, so the compiler builtin
+    // is used where available and scalar types are assumed otherwise.
+#if defined(__GNUC__) || defined(__clang__)
+    template <typename T>
+    struct is_trivially_copyable
+        : ft::integral_constant<bool, __is_trivially_copyable(T)>
+    {
+    };
+#else
+    template <typename T>
+    struct is_trivially_copyable
+        : ft::integral_constant<
+              bool,
+              ft::is_integral<T>::value ||
+                  ft::is_floating_point<T>::value ||
+                  ft::is_pointer<T>::value>
+    {
+    };
+#endif
+}
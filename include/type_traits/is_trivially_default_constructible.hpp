@@ -0,0 +1,33 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "integral_constant.hpp"
+#include "is_floating_point.hpp"
+#include "is_integral.hpp"
+#include "is_pointer.hpp"
+
+namespace ft
+{
+    // A trivially default constructible type may start its lifetime without any initialization,
+    // its value is then indeterminate until written.
+    // NOTE: as for is_trivially_copyable, scalar types are assumed without the compiler builtin.
+#if defined(__GNUC__) || defined(__clang__)
+    template <typename T>
+    struct is_trivially_default_constructible
+        : ft::integral_constant<bool, __is_trivially_constructible(T)>
+    {
+    };
+#else
+    template <typename T>
+    struct is_trivially_default_constructible
+        : ft::integral_constant<
+              bool,
+              ft::is_integral<T>::value ||
+                  ft::is_floating_point<T>::value ||
+                  ft::is_pointer<T>::value>
+    {
+    };
+#endif
+}
@@ -0,0 +1,23 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "is_trivially_copyable.hpp"
+
+namespace ft
+{
+    // An object of a trivially relocatable type may be moved to another address by copying its bytes,
+    // the old bytes then count as destroyed (no move constructor nor destructor runs).
+    // Trivially copyable types qualify; specialize to ft::true_type for types that own resources
+    // but never point into themselves (a unique pointer, a vector, a heap-only string).
+    template <typename T>
+    struct is_trivially_relocatable : ft::is_trivially_copyable<T>
+    {
+    };
+
+    template <typename T>
+    struct is_trivially_relocatable<const T> : is_trivially_relocatable<T>
+    {
+    };
+}
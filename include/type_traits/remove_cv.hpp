@@ -0,0 +1,35 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+namespace ft
+{
+    template <typename T>
+    struct remove_const
+    {
+        typedef T type;
+    };
+    template <typename T>
+    struct remove_const<const T>
+    {
+        typedef T type;
+    };
+
+    template <typename T>
+    struct remove_volatile
+    {
+        typedef T type;
+    };
+    template <typename T>
+    struct remove_volatile<volatile T>
+    {
+        typedef T type;
+    };
+
+    template <typename T>
+    struct remove_cv
+    {
+        typedef typename remove_volatile<typename remove_const<T>::type>::type type;
+    };
+}
@@ -0,0 +1,27 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+namespace ft
+{
+    template <typename T>
+    struct remove_reference
+    {
+        typedef T type;
+    };
+
+    template <typename T>
+    struct remove_reference<T&>
+    {
+        typedef T type;
+    };
+
+#if __cplusplus >= 201103L
+    template <typename T>
+    struct remove_reference<T&&>
+    {
+        typedef T type;
+    };
+#endif
+}
@@ -0,0 +1,462 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "_hash_table.hpp"
+#include "functional.hpp"
+#include "functional/_select.hpp"
+#include "stdexcept.hpp"
+#include "utility.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace ft
+{
+    // Open addressing hash map, see _hash_table.hpp for the layout.
+    // Inserts may rehash and then invalidate every iterator; erase only invalidates the erased element.
+    template <typename TKey, typename TMapped, typename THash = ft::hash<TKey>, typename TEqual = ft::equal_to<TKey>, typename TAlloc = std::allocator<ft::pair<const TKey, TMapped> > >
+    class unordered_map
+    {
+    public:
+        typedef TKey key_type;
+        typedef TMapped mapped_type;
+        typedef ft::pair<const TKey, TMapped> value_type;
+        typedef THash hasher;
+        typedef TEqual key_equal;
+        typedef TAlloc allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+    protected:
+        typedef _select_first<value_type> key_select;
+        typedef ft::_hash_table<key_type, value_type, key_select, hasher, key_equal, allocator_type> container_type;
+
+    public:
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+        typedef typename container_type::iterator iterator;
+        typedef typename container_type::const_iterator const_iterator;
+
+    private:
+        container_type c;
+
+    public:
+        unordered_map()
+            : c() {}
+
+        explicit unordered_map(size_type n, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+            : c(n, hash, equal, alloc) {}
+
+        template <typename UIter>
+        // unordered_map(UIter first, UIter last, size_type n = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+        unordered_map(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, size_type n = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+            : c(n, hash, equal, alloc)
+        {
+            this->insert(first, last);
+        }
+
+        unordered_map(const unordered_map& that)
+            : c(that.c) {}
+
+#if __cplusplus >= 201103L
+        unordered_map(unordered_map&& that) noexcept(noexcept(container_type(ft::declval<container_type>())))
+            : c(ft::move(that.c)) {}
+#endif
+
+        ~unordered_map() {}
+
+        unordered_map& operator=(const unordered_map& that)
+        {
+            this->c = that.c;
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        unordered_map& operator=(unordered_map&& that)
+        {
+            this->c = ft::move(that.c);
+            return *this;
+        }
+#endif
+
+    public:
+        allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
+
+    public:
+        mapped_type& at(const key_type& key)
+        {
+            iterator it = this->find(key);
+            if (it == this->end())
+            {
+                throw ft::out_of_range("unordered_map::at");
+            }
+            return it->second;
+        }
+        const mapped_type& at(const key_type& key) const
+        {
+            const_iterator it = this->find(key);
+            if (it == this->end())
+            {
+                throw ft::out_of_range("unordered_map::at");
+            }
+            return it->second;
+        }
+
+        mapped_type& operator[](const key_type& key)
+        {
+            return this->c.find_or_insert(key)->second;
+        }
+
+#if __cplusplus >= 201103L
+        mapped_type& operator[](key_type&& key)
+        {
+            return this->c.try_emplace_unique(ft::move(key)).first->second;
+        }
+#endif
+
+    public:
+        iterator begin() { return this->c.begin(); }
+        const_iterator begin() const { return this->c.begin(); }
+        iterator end() { return this->c.end(); }
+        const_iterator end() const { return this->c.end(); }
+
+    public:
+        bool empty() const { return this->c.empty(); }
+        size_type size() const { return this->c.size(); }
+        size_type max_size() const { return this->c.max_size(); }
+
+    public:
+        void clear() { return this->c.clear(); }
+
+        ft::pair<iterator, bool> insert(const value_type& value)
+        {
+            return this->c.insert_unique(value);
+        }
+
+        iterator insert(const_iterator hint, const value_type& value)
+        {
+            static_cast<void>(hint);
+            return this->c.insert_unique(value).first;
+        }
+
+        template <typename UIter>
+        // void insert(UIter first, UIter last)
+        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
+        {
+            this->c.insert_range_unique(first, last);
+        }
+
+#if __cplusplus >= 201103L
+        ft::pair<iterator, bool> insert(value_type&& value)
+        {
+            return this->c.insert_unique(ft::move(value));
+        }
+
+        iterator insert(const_iterator hint, value_type&& value)
+        {
+            static_cast<void>(hint);
+            return this->c.insert_unique(ft::move(value)).first;
+        }
+
+        template <typename... Args>
+        ft::pair<iterator, bool> emplace(Args&&... args)
+        {
+            return this->c.emplace_unique(ft::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args)
+        {
+            static_cast<void>(hint);
+            return this->c.emplace_unique(ft::forward<Args>(args)...).first;
+        }
+
+        // Nothing is constructed (and the key is not moved from) when the key is already present.
+        template <typename... Args>
+        ft::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+        {
+            return this->c.try_emplace_unique(key, ft::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        ft::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+        {
+            return this->c.try_emplace_unique(ft::move(key), ft::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        iterator try_emplace(const_iterator hint, const key_type& key, Args&&... args)
+        {
+            static_cast<void>(hint);
+            return this->c.try_emplace_unique(key, ft::forward<Args>(args)...).first;
+        }
+
+        template <typename... Args>
+        iterator try_emplace(const_iterator hint, key_type&& key, Args&&... args)
+        {
+            static_cast<void>(hint);
+            return this->c.try_emplace_unique(ft::move(key), ft::forward<Args>(args)...).first;
+        }
+#endif
+
+        iterator erase(const_iterator pos)
+        {
+            return this->c.erase(pos);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            return this->c.erase(first, last);
+        }
+
+        size_type erase(const key_type& key) { return this->c.erase_unique(key); }
+
+        void swap(unordered_map& that) { this->c.swap(that.c); }
+
+    public:
+        size_type count(const key_type& key) const { return this->c.count(key); }
+
+        iterator find(const key_type& key) { return this->c.find(key); }
+        const_iterator find(const key_type& key) const { return this->c.find(key); }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+
+    public:
+        size_type bucket_count() const { return this->c.bucket_count(); }
+        float load_factor() const { return this->c.load_factor(); }
+        float max_load_factor() const { return this->c.max_load_factor(); }
+        void max_load_factor(float ml) { this->c.max_load_factor(ml); }
+        void rehash(size_type n) { this->c.rehash(n); }
+        void reserve(size_type n) { this->c.reserve(n); }
+
+    public:
+        hasher hash_function() const { return this->c.hash_function(); }
+        key_equal key_eq() const { return this->c.key_eq(); }
+
+    public:
+        friend bool operator==(const unordered_map& lhs, const unordered_map& rhs)
+        {
+            return lhs.c == rhs.c;
+        }
+
+        friend bool operator!=(const unordered_map& lhs, const unordered_map& rhs)
+        {
+            return lhs.c != rhs.c;
+        }
+    };
+
+    template <typename TKey, typename TMapped, typename THash, typename TEqual, typename TAlloc>
+    inline void swap(
+        unordered_map<TKey, TMapped, THash, TEqual, TAlloc>& lhs,
+        unordered_map<TKey, TMapped, THash, TEqual, TAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <typename TKey, typename TMapped, typename THash = ft::hash<TKey>, typename TEqual = ft::equal_to<TKey>, typename TAlloc = std::allocator<ft::pair<const TKey, TMapped> > >
+    class unordered_multimap
+    {
+    public:
+        typedef TKey key_type;
+        typedef TMapped mapped_type;
+        typedef ft::pair<const TKey, TMapped> value_type;
+        typedef THash hasher;
+        typedef TEqual key_equal;
+        typedef TAlloc allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+    protected:
+        typedef _select_first<value_type> key_select;
+        typedef ft::_hash_multi_table<key_type, value_type, key_select, hasher, key_equal, allocator_type> container_type;
+
+    public:
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+        typedef typename container_type::iterator iterator;
+        typedef typename container_type::const_iterator const_iterator;
+
+    private:
+        container_type c;
+
+    public:
+        unordered_multimap()
+            : c() {}
+
+        explicit unordered_multimap(size_type n, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+            : c(n, hash, equal, alloc) {}
+
+        template <typename UIter>
+        // unordered_multimap(UIter first, UIter last, size_type n = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+        unordered_multimap(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, size_type n = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+            : c(n, hash, equal, alloc)
+        {
+            this->insert(first, last);
+        }
+
+        unordered_multimap(const unordered_multimap& that)
+            : c(that.c) {}
+
+#if __cplusplus >= 201103L
+        unordered_multimap(unordered_multimap&& that) noexcept(noexcept(container_type(ft::declval<container_type>())))
+            : c(ft::move(that.c)) {}
+#endif
+
+        ~unordered_multimap() {}
+
+        unordered_multimap& operator=(const unordered_multimap& that)
+        {
+            this->c = that.c;
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        unordered_multimap& operator=(unordered_multimap&& that)
+        {
+            this->c = ft::move(that.c);
+            return *this;
+        }
+#endif
+
+    public:
+        allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
+
+    public:
+        iterator begin() { return this->c.begin(); }
+        const_iterator begin() const { return this->c.begin(); }
+        iterator end() { return this->c.end(); }
+        const_iterator end() const { return this->c.end(); }
+
+    public:
+        bool empty() const { return this->c.empty(); }
+        size_type size() const { return this->c.size(); }
+        size_type max_size() const { return this->c.max_size(); }
+
+    public:
+        void clear() { return this->c.clear(); }
+
+        iterator insert(const value_type& value)
+        {
+            return this->c.insert_equal(value);
+        }
+
+        iterator insert(const_iterator hint, const value_type& value)
+        {
+            static_cast<void>(hint);
+            return this->c.insert_equal(value);
+        }
+
+        template <typename UIter>
+        // void insert(UIter first, UIter last)
+        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
+        {
+            this->c.insert_range_equal(first, last);
+        }
+
+#if __cplusplus >= 201103L
+        iterator insert(value_type&& value)
+        {
+            return this->c.insert_equal(ft::move(value));
+        }
+
+        iterator insert(const_iterator hint, value_type&& value)
+        {
+            static_cast<void>(hint);
+            return this->c.insert_equal(ft::move(value));
+        }
+
+        template <typename... Args>
+        iterator emplace(Args&&... args)
+        {
+            return this->c.emplace_equal(ft::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args)
+        {
+            static_cast<void>(hint);
+            return this->c.emplace_equal(ft::forward<Args>(args)...);
+        }
+#endif
+
+        iterator erase(const_iterator pos)
+        {
+            return this->c.erase(pos);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            return this->c.erase(first, last);
+        }
+
+        size_type erase(const key_type& key) { return this->c.erase_equal(key); }
+
+        void swap(unordered_multimap& that) { this->c.swap(that.c); }
+
+    public:
+        size_type count(const key_type& key) const { return this->c.count(key); }
+
+        iterator find(const key_type& key) { return this->c.find(key); }
+        const_iterator find(const key_type& key) const { return this->c.find(key); }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+
+    public:
+        size_type bucket_count() const { return this->c.bucket_count(); }
+        float load_factor() const { return this->c.load_factor(); }
+        float max_load_factor() const { return this->c.max_load_factor(); }
+        void max_load_factor(float ml) { this->c.max_load_factor(ml); }
+        void rehash(size_type n) { this->c.rehash(n); }
+        void reserve(size_type n) { this->c.reserve(n); }
+
+    public:
+        hasher hash_function() const { return this->c.hash_function(); }
+        key_equal key_eq() const { return this->c.key_eq(); }
+
+    public:
+        friend bool operator==(const unordered_multimap& lhs, const unordered_multimap& rhs)
+        {
+            return lhs.c == rhs.c;
+        }
+
+        friend bool operator!=(const unordered_multimap& lhs, const unordered_multimap& rhs)
+        {
+            return lhs.c != rhs.c;
+        }
+    };
+
+    template <typename TKey, typename TMapped, typename THash, typename TEqual, typename TAlloc>
+    inline void swap(
+        unordered_multimap<TKey, TMapped, THash, TEqual, TAlloc>& lhs,
+        unordered_multimap<TKey, TMapped, THash, TEqual, TAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+namespace std
+{
+    template <typename TKey, typename TMapped, typename THash, typename TEqual, typename TAlloc>
+    inline void swap(
+        ft::unordered_map<TKey, TMapped, THash, TEqual, TAlloc>& lhs,
+        ft::unordered_map<TKey, TMapped, THash, TEqual, TAlloc>& rhs)
+    {
+        ft::swap(lhs, rhs);
+    }
+
+    template <typename TKey, typename TMapped, typename THash, typename TEqual, typename TAlloc>
+    inline void swap(
+        ft::unordered_multimap<TKey, TMapped, THash, TEqual, TAlloc>& lhs,
+        ft::unordered_multimap<TKey, TMapped, THash, TEqual, TAlloc>& rhs)
+    {
+        ft::swap(lhs, rhs);
+    }
+}
@@ -0,0 +1,400 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "_hash_table.hpp"
+#include "functional.hpp"
+#include "functional/_select.hpp"
+#include "utility.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace ft
+{
+    // Open addressing hash set, see _hash_table.hpp for the layout.
+    // Inserts may rehash and then invalidate every iterator; erase only invalidates the erased element.
+    template <typename T, typename THash = ft::hash<T>, typename TEqual = ft::equal_to<T>, typename TAlloc = std::allocator<T> >
+    class unordered_set
+    {
+    public:
+        typedef T key_type;
+        typedef T value_type;
+        typedef THash hasher;
+        typedef TEqual key_equal;
+        typedef TAlloc allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+    protected:
+        typedef _select_self<value_type> key_select;
+        typedef ft::_hash_table<key_type, value_type, key_select, hasher, key_equal, allocator_type> container_type;
+
+    public:
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+        typedef typename container_type::const_iterator iterator; // const value cause key equals value
+        typedef typename container_type::const_iterator const_iterator;
+
+    private:
+        container_type c;
+
+    public:
+        unordered_set()
+            : c() {}
+
+        explicit unordered_set(size_type n, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+            : c(n, hash, equal, alloc) {}
+
+        template <typename UIter>
+        // unordered_set(UIter first, UIter last, size_type n = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+        unordered_set(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, size_type n = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+            : c(n, hash, equal, alloc)
+        {
+            this->insert(first, last);
+        }
+
+        unordered_set(const unordered_set& that)
+            : c(that.c) {}
+
+#if __cplusplus >= 201103L
+        unordered_set(unordered_set&& that) noexcept(noexcept(container_type(ft::declval<container_type>())))
+            : c(ft::move(that.c)) {}
+#endif
+
+        ~unordered_set() {}
+
+        unordered_set& operator=(const unordered_set& that)
+        {
+            this->c = that.c;
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        unordered_set& operator=(unordered_set&& that)
+        {
+            this->c = ft::move(that.c);
+            return *this;
+        }
+#endif
+
+    public:
+        allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
+
+    public:
+        iterator begin() { return this->c.begin(); }
+        const_iterator begin() const { return this->c.begin(); }
+        iterator end() { return this->c.end(); }
+        const_iterator end() const { return this->c.end(); }
+
+    public:
+        bool empty() const { return this->c.empty(); }
+        size_type size() const { return this->c.size(); }
+        size_type max_size() const { return this->c.max_size(); }
+
+    public:
+        void clear() { return this->c.clear(); }
+
+        ft::pair<iterator, bool> insert(const value_type& value)
+        {
+            return this->c.insert_unique(value);
+        }
+
+        iterator insert(const_iterator hint, const value_type& value)
+        {
+            static_cast<void>(hint);
+            return this->c.insert_unique(value).first;
+        }
+
+        template <typename UIter>
+        // void insert(UIter first, UIter last)
+        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
+        {
+            this->c.insert_range_unique(first, last);
+        }
+
+#if __cplusplus >= 201103L
+        ft::pair<iterator, bool> insert(value_type&& value)
+        {
+            return this->c.insert_unique(ft::move(value));
+        }
+
+        iterator insert(const_iterator hint, value_type&& value)
+        {
+            static_cast<void>(hint);
+            return this->c.insert_unique(ft::move(value)).first;
+        }
+
+        template <typename... Args>
+        ft::pair<iterator, bool> emplace(Args&&... args)
+        {
+            return this->c.emplace_unique(ft::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args)
+        {
+            static_cast<void>(hint);
+            return this->c.emplace_unique(ft::forward<Args>(args)...).first;
+        }
+#endif
+
+        iterator erase(const_iterator pos)
+        {
+            return this->c.erase(pos);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            return this->c.erase(first, last);
+        }
+
+        size_type erase(const key_type& key) { return this->c.erase_unique(key); }
+
+        void swap(unordered_set& that) { this->c.swap(that.c); }
+
+    public:
+        size_type count(const key_type& key) const { return this->c.count(key); }
+
+        iterator find(const key_type& key) { return this->c.find(key); }
+        const_iterator find(const key_type& key) const { return this->c.find(key); }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+
+    public:
+        size_type bucket_count() const { return this->c.bucket_count(); }
+        float load_factor() const { return this->c.load_factor(); }
+        float max_load_factor() const { return this->c.max_load_factor(); }
+        void max_load_factor(float ml) { this->c.max_load_factor(ml); }
+        void rehash(size_type n) { this->c.rehash(n); }
+        void reserve(size_type n) { this->c.reserve(n); }
+
+    public:
+        hasher hash_function() const { return this->c.hash_function(); }
+        key_equal key_eq() const { return this->c.key_eq(); }
+
+    public:
+        friend bool operator==(const unordered_set& lhs, const unordered_set& rhs)
+        {
+            return lhs.c == rhs.c;
+        }
+
+        friend bool operator!=(const unordered_set& lhs, const unordered_set& rhs)
+        {
+            return lhs.c != rhs.c;
+        }
+    };
+
+    template <typename T, typename THash, typename TEqual, typename TAlloc>
+    inline void swap(
+        unordered_set<T, THash, TEqual, TAlloc>& lhs,
+        unordered_set<T, THash, TEqual, TAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <typename T, typename THash = ft::hash<T>, typename TEqual = ft::equal_to<T>, typename TAlloc = std::allocator<T> >
+    class unordered_multiset
+    {
+    public:
+        typedef T key_type;
+        typedef T value_type;
+        typedef THash hasher;
+        typedef TEqual key_equal;
+        typedef TAlloc allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+    protected:
+        typedef _select_self<value_type> key_select;
+        typedef ft::_hash_multi_table<key_type, value_type, key_select, hasher, key_equal, allocator_type> container_type;
+
+    public:
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+        typedef typename container_type::const_iterator iterator; // const value cause key equals value
+        typedef typename container_type::const_iterator const_iterator;
+
+    private:
+        container_type c;
+
+    public:
+        unordered_multiset()
+            : c() {}
+
+        explicit unordered_multiset(size_type n, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+            : c(n, hash, equal, alloc) {}
+
+        template <typename UIter>
+        // unordered_multiset(UIter first, UIter last, size_type n = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+        unordered_multiset(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, size_type n = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+            : c(n, hash, equal, alloc)
+        {
+            this->insert(first, last);
+        }
+
+        unordered_multiset(const unordered_multiset& that)
+            : c(that.c) {}
+
+#if __cplusplus >= 201103L
+        unordered_multiset(unordered_multiset&& that) noexcept(noexcept(container_type(ft::declval<container_type>())))
+            : c(ft::move(that.c)) {}
+#endif
+
+        ~unordered_multiset() {}
+
+        unordered_multiset& operator=(const unordered_multiset& that)
+        {
+            this->c = that.c;
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        unordered_multiset& operator=(unordered_multiset&& that)
+        {
+            this->c = ft::move(that.c);
+            return *this;
+        }
+#endif
+
+    public:
+        allocator_type get_allocator() const { return allocator_type(this->c.get_allocator()); }
+
+    public:
+        iterator begin() { return this->c.begin(); }
+        const_iterator begin() const { return this->c.begin(); }
+        iterator end() { return this->c.end(); }
+        const_iterator end() const { return this->c.end(); }
+
+    public:
+        bool empty() const { return this->c.empty(); }
+        size_type size() const { return this->c.size(); }
+        size_type max_size() const { return this->c.max_size(); }
+
+    public:
+        void clear() { return this->c.clear(); }
+
+        iterator insert(const value_type& value)
+        {
+            return this->c.insert_equal(value);
+        }
+
+        iterator insert(const_iterator hint, const value_type& value)
+        {
+            static_cast<void>(hint);
+            return this->c.insert_equal(value);
+        }
+
+        template <typename UIter>
+        // void insert(UIter first, UIter last)
+        typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type insert(UIter first, UIter last)
+        {
+            this->c.insert_range_equal(first, last);
+        }
+
+#if __cplusplus >= 201103L
+        iterator insert(value_type&& value)
+        {
+            return this->c.insert_equal(ft::move(value));
+        }
+
+        iterator insert(const_iterator hint, value_type&& value)
+        {
+            static_cast<void>(hint);
+            return this->c.insert_equal(ft::move(value));
+        }
+
+        template <typename... Args>
+        iterator emplace(Args&&... args)
+        {
+            return this->c.emplace_equal(ft::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args)
+        {
+            static_cast<void>(hint);
+            return this->c.emplace_equal(ft::forward<Args>(args)...);
+        }
+#endif
+
+        iterator erase(const_iterator pos)
+        {
+            return this->c.erase(pos);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            return this->c.erase(first, last);
+        }
+
+        size_type erase(const key_type& key) { return this->c.erase_equal(key); }
+
+        void swap(unordered_multiset& that) { this->c.swap(that.c); }
+
+    public:
+        size_type count(const key_type& key) const { return this->c.count(key); }
+
+        iterator find(const key_type& key) { return this->c.find(key); }
+        const_iterator find(const key_type& key) const { return this->c.find(key); }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key) { return this->c.equal_range(key); }
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return this->c.equal_range(key); }
+
+    public:
+        size_type bucket_count() const { return this->c.bucket_count(); }
+        float load_factor() const { return this->c.load_factor(); }
+        float max_load_factor() const { return this->c.max_load_factor(); }
+        void max_load_factor(float ml) { this->c.max_load_factor(ml); }
+        void rehash(size_type n) { this->c.rehash(n); }
+        void reserve(size_type n) { this->c.reserve(n); }
+
+    public:
+        hasher hash_function() const { return this->c.hash_function(); }
+        key_equal key_eq() const { return this->c.key_eq(); }
+
+    public:
+        friend bool operator==(const unordered_multiset& lhs, const unordered_multiset& rhs)
+        {
+            return lhs.c == rhs.c;
+        }
+
+        friend bool operator!=(const unordered_multiset& lhs, const unordered_multiset& rhs)
+        {
+            return lhs.c != rhs.c;
+        }
+    };
+
+    template <typename T, typename THash, typename TEqual, typename TAlloc>
+    inline void swap(
+        unordered_multiset<T, THash, TEqual, TAlloc>& lhs,
+        unordered_multiset<T, THash, TEqual, TAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+namespace std
+{
+    template <typename T, typename THash, typename TEqual, typename TAlloc>
+    inline void swap(
+        ft::unordered_set<T, THash, TEqual, TAlloc>& lhs,
+        ft::unordered_set<T, THash, TEqual, TAlloc>& rhs)
+    {
+        ft::swap(lhs, rhs);
+    }
+
+    template <typename T, typename THash, typename TEqual, typename TAlloc>
+    inline void swap(
+        ft::unordered_multiset<T, THash, TEqual, TAlloc>& lhs,
+        ft::unordered_multiset<T, THash, TEqual, TAlloc>& rhs)
+    {
+        ft::swap(lhs, rhs);
+    }
+}
@@ -0,0 +1,1466 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "algorithm.hpp"
+#include "functional.hpp"
+#include "iterator.hpp"
+#include "list.hpp"
+#include "memory.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace ft
+{
+    namespace _internal
+    {
+        enum
+        {
+            _unrolled_list_chunk_bytes = 512,
+            _unrolled_list_min_count = 8
+        };
+
+        // as many elements as fit in _unrolled_list_chunk_bytes, but never fewer than _unrolled_list_min_count
+        template <typename T>
+        struct _unrolled_list_default_count
+        {
+            static const std::size_t value = sizeof(T) * _unrolled_list_min_count < _unrolled_list_chunk_bytes
+                                                 ? _unrolled_list_chunk_bytes / sizeof(T)
+                                                 : std::size_t(_unrolled_list_min_count);
+        };
+    }
+
+    // The elements of a chunk sit in the slots [first, last), the header has first == last == 0.
+    struct _unrolled_chunk_base : _list_node_base
+    {
+        typedef _unrolled_chunk_base* pointer_type;
+
+        std::size_t first, last;
+
+        _unrolled_chunk_base()
+            : _list_node_base(), first(), last() {}
+    };
+
+    template <typename T, std::size_t N>
+    struct _unrolled_chunk : _unrolled_chunk_base
+    {
+        union
+        {
+            _internal::_pool_max_align align;
+            unsigned char bytes[sizeof(T) * N];
+        } storage;
+
+        T* data() { return reinterpret_cast<T*>(this->storage.bytes); }
+    };
+
+    template <typename TList>
+    struct _unrolled_list_iterator
+    {
+        typedef typename TList::value_type value_type;
+        typedef value_type& reference;
+        typedef value_type* pointer;
+
+        typedef ft::bidirectional_iterator_tag iterator_category;
+        typedef std::ptrdiff_t difference_type;
+
+        typedef _unrolled_chunk<value_type, TList::chunk_capacity> chunk_type;
+
+        _unrolled_chunk_base::pointer_type chunk;
+        std::size_t slot;
+
+        _unrolled_list_iterator() throw()
+            : chunk(), slot() {}
+
+        _unrolled_list_iterator(_unrolled_chunk_base::pointer_type chunk, std::size_t slot) throw()
+            : chunk(chunk), slot(slot) {}
+
+        _unrolled_list_iterator(const _unrolled_list_iterator& that) throw()
+            : chunk(that.chunk), slot(that.slot) {}
+
+        _unrolled_list_iterator& operator=(const _unrolled_list_iterator& that) throw()
+        {
+            this->chunk = that.chunk;
+            this->slot = that.slot;
+            return *this;
+        }
+
+        reference operator*() const throw()
+        {
+            return static_cast<chunk_type*>(this->chunk)->data()[this->slot];
+        }
+
+        pointer operator->() const throw()
+        {
+            return &static_cast<chunk_type*>(this->chunk)->data()[this->slot];
+        }
+
+        _unrolled_list_iterator& operator++() throw()
+        {
+            if (++this->slot == this->chunk->last)
+            {
+                this->chunk = static_cast<_unrolled_chunk_base::pointer_type>(this->chunk->next);
+                this->slot = this->chunk->first;
+            }
+            return *this;
+        }
+
+        _unrolled_list_iterator operator++(int) throw()
+        {
+            _unrolled_list_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        _unrolled_list_iterator& operator--() throw()
+        {
+            if (this->slot == this->chunk->first)
+            {
+                this->chunk = static_cast<_unrolled_chunk_base::pointer_type>(this->chunk->prev);
+                this->slot = this->chunk->last;
+            }
+            --this->slot;
+            return *this;
+        }
+
+        _unrolled_list_iterator operator--(int) throw()
+        {
+            _unrolled_list_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        friend bool operator==(const _unrolled_list_iterator& lhs, const _unrolled_list_iterator& rhs) throw()
+        {
+            return lhs.chunk == rhs.chunk && lhs.slot == rhs.slot;
+        }
+
+        friend bool operator!=(const _unrolled_list_iterator& lhs, const _unrolled_list_iterator& rhs) throw()
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    template <typename TList>
+    struct _unrolled_list_const_iterator
+    {
+        typedef const typename TList::value_type value_type;
+        typedef value_type& reference;
+        typedef value_type* pointer;
+
+        typedef ft::bidirectional_iterator_tag iterator_category;
+        typedef std::ptrdiff_t difference_type;
+
+        typedef _unrolled_chunk<typename TList::value_type, TList::chunk_capacity> chunk_type;
+
+        _unrolled_chunk_base::pointer_type chunk;
+        std::size_t slot;
+
+        _unrolled_list_const_iterator() throw()
+            : chunk(), slot() {}
+
+        _unrolled_list_const_iterator(_unrolled_chunk_base::pointer_type chunk, std::size_t slot) throw()
+            : chunk(chunk), slot(slot) {}
+
+        _unrolled_list_const_iterator(const _unrolled_list_const_iterator& that) throw()
+            : chunk(that.chunk), slot(that.slot) {}
+
+        _unrolled_list_const_iterator(const _unrolled_list_iterator<TList>& that) throw()
+            : chunk(that.chunk), slot(that.slot) {}
+
+        _unrolled_list_const_iterator& operator=(const _unrolled_list_const_iterator& that) throw()
+        {
+            this->chunk = that.chunk;
+            this->slot = that.slot;
+            return *this;
+        }
+
+        reference operator*() const throw()
+        {
+            return static_cast<chunk_type*>(this->chunk)->data()[this->slot];
+        }
+
+        pointer operator->() const throw()
+        {
+            return &static_cast<chunk_type*>(this->chunk)->data()[this->slot];
+        }
+
+        _unrolled_list_const_iterator& operator++() throw()
+        {
+            if (++this->slot == this->chunk->last)
+            {
+                this->chunk = static_cast<_unrolled_chunk_base::pointer_type>(this->chunk->next);
+                this->slot = this->chunk->first;
+            }
+            return *this;
+        }
+
+        _unrolled_list_const_iterator operator++(int) throw()
+        {
+            _unrolled_list_const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        _unrolled_list_const_iterator& operator--() throw()
+        {
+            if (this->slot == this->chunk->first)
+            {
+                this->chunk = static_cast<_unrolled_chunk_base::pointer_type>(this->chunk->prev);
+                this->slot = this->chunk->last;
+            }
+            --this->slot;
+            return *this;
+        }
+
+        _unrolled_list_const_iterator operator--(int) throw()
+        {
+            _unrolled_list_const_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        friend bool operator==(const _unrolled_list_const_iterator& lhs, const _unrolled_list_const_iterator& rhs) throw()
+        {
+            return lhs.chunk == rhs.chunk && lhs.slot == rhs.slot;
+        }
+
+        friend bool operator!=(const _unrolled_list_const_iterator& lhs, const _unrolled_list_const_iterator& rhs) throw()
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    // A list of chunks holding up to N elements each, scans walk contiguous slots
+    // and pushing or popping at either end touches the allocator once per chunk.
+    // Unlike list, inserting or erasing moves the neighbours in the same chunk,
+    // which invalidates the iterators to them. splice and merge keep whole chunks.
+    template <typename T, std::size_t N = _internal::_unrolled_list_default_count<T>::value, typename TAlloc = std::allocator<T> >
+    class unrolled_list
+    {
+    public:
+        typedef T value_type;
+        typedef TAlloc allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+        typedef _unrolled_list_iterator<unrolled_list> iterator;
+        typedef _unrolled_list_const_iterator<unrolled_list> const_iterator;
+        typedef ft::reverse_iterator<iterator> reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        // a full chunk is split in halves, so it holds two elements at least
+        static const size_type chunk_capacity = N < 2 ? 2 : N;
+
+    protected:
+        typedef _unrolled_chunk<value_type, chunk_capacity> chunk_type;
+        typedef typename TAlloc::template rebind<chunk_type>::other chunk_allocator_type;
+
+    private:
+        _unrolled_chunk_base header;
+
+        allocator_type alloc;
+        size_type number;
+
+    public:
+        unrolled_list()
+            : header(), alloc(), number()
+        {
+            this->reset();
+        }
+
+        explicit unrolled_list(const allocator_type& alloc)
+            : header(), alloc(alloc), number()
+        {
+            this->reset();
+        }
+
+        explicit unrolled_list(size_type count, const value_type& value = value_type(), const allocator_type& alloc = allocator_type())
+            : header(), alloc(alloc), number()
+        {
+            this->reset();
+            this->assign(count, value);
+        }
+
+        template <typename UIter>
+        // unrolled_list(UIter first, UIter last, const allocator_type& alloc = allocator_type())
+        unrolled_list(typename ft::enable_if<ft::is_iterator<UIter>::value, UIter>::type first, UIter last, const allocator_type& alloc = allocator_type())
+            : header(), alloc(alloc), number()
+        {
+            this->reset();
+            this->assign(first, last);
+        }
+
+        unrolled_list(const unrolled_list& that)
+            : header(), alloc(that.alloc), number()
+        {
+            this->reset();
+            this->assign(that.begin(), that.end());
+        }
+
+#if __cplusplus >= 201103L
+        unrolled_list(unrolled_list&& that)
+            : header(), alloc(that.alloc), number()
+        {
+            this->reset();
+            this->swap(that);
+        }
+#endif
+
+        ~unrolled_list()
+        {
+            this->destruct();
+        }
+
+        unrolled_list& operator=(const unrolled_list& that)
+        {
+            if (this != &that)
+            {
+                this->assign(that.begin(), that.end());
+            }
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        unrolled_list& operator=(unrolled_list&& that)
+        {
+            if (this != &that)
+            {
+                unrolled_list temp(ft::move(that));
+                this->swap(temp);
+            }
+            return *this;
+        }
+#endif
+
+    protected:
+        static value_type* slots(_unrolled_chunk_base::pointer_type chunk)
+        {
+            return static_cast<chunk_type*>(chunk)->data();
+        }
+
+        static _unrolled_chunk_base::pointer_type next_chunk(_unrolled_chunk_base::pointer_type chunk)
+        {
+            return static_cast<_unrolled_chunk_base::pointer_type>(chunk->next);
+        }
+
+        static _unrolled_chunk_base::pointer_type prev_chunk(_unrolled_chunk_base::pointer_type chunk)
+        {
+            return static_cast<_unrolled_chunk_base::pointer_type>(chunk->prev);
+        }
+
+        // an empty chunk, its first element goes to the slot at
+        _unrolled_chunk_base::pointer_type create_chunk(size_type at)
+        {
+            chunk_allocator_type chunk_alloc(this->alloc);
+            chunk_type* chunk = chunk_alloc.allocate(1);
+            // default initialized, the slots are left raw
+            ::new (static_cast<void*>(chunk)) chunk_type;
+            chunk->first = at;
+            chunk->last = at;
+            return chunk;
+        }
+
+        void destroy_chunk(_unrolled_chunk_base::pointer_type chunk)
+        {
+            chunk_allocator_type chunk_alloc(this->alloc);
+            chunk_alloc.deallocate(static_cast<chunk_type*>(chunk), 1);
+        }
+
+        void destroy_slots(_unrolled_chunk_base::pointer_type chunk, size_type first, size_type last)
+        {
+            value_type* data = unrolled_list::slots(chunk);
+            for (; first != last; ++first)
+            {
+                this->alloc.destroy(ft::addressof(data[first]));
+            }
+        }
+
+        void destruct()
+        {
+            _list_node_base::pointer_type node = this->header.next;
+            while (node != &this->header)
+            {
+                _unrolled_chunk_base::pointer_type chunk = static_cast<_unrolled_chunk_base::pointer_type>(node);
+                node = node->next;
+                this->destroy_slots(chunk, chunk->first, chunk->last);
+                this->destroy_chunk(chunk);
+            }
+        }
+
+        void reset()
+        {
+            this->header.prev = &this->header;
+            this->header.next = &this->header;
+        }
+
+        // a throwing move would leave the source half moved, it is copied instead
+        void relocate(value_type* dest, value_type& src)
+        {
+#if __cplusplus >= 201103L
+            this->alloc.construct(dest, ft::move_if_noexcept(src));
+#else
+            this->alloc.construct(dest, src);
+#endif
+        }
+
+        static void move_assign(value_type& dest, value_type& src)
+        {
+#if __cplusplus >= 201103L
+            dest = ft::move(src);
+#else
+            dest = src;
+#endif
+        }
+
+        // Moves the slots [first, last) of from to the free slots of to starting at at, the sources are destroyed.
+        // If a copy throws nothing has moved.
+        void relocate_slots(_unrolled_chunk_base::pointer_type from, size_type first, size_type last, _unrolled_chunk_base::pointer_type to, size_type at)
+        {
+            value_type* src = unrolled_list::slots(from);
+            value_type* dest = unrolled_list::slots(to) + at;
+            size_type i = first;
+            try
+            {
+                for (; i != last; ++i)
+                {
+                    this->relocate(dest + (i - first), src[i]);
+                }
+            }
+            catch (...)
+            {
+                for (size_type j = first; j != i; ++j)
+                {
+                    this->alloc.destroy(dest + (j - first));
+                }
+                throw;
+            }
+            this->destroy_slots(from, first, last);
+        }
+
+        void link(_list_node_base::pointer_type pos, _list_node_base::pointer_type head, _list_node_base::pointer_type tail)
+        {
+            _list_node_base::pointer_type prev = pos->prev;
+            _list_node_base::pointer_type next = pos;
+            prev->next = head;
+            head->prev = prev;
+            tail->next = next;
+            next->prev = tail;
+        }
+
+        void unlink(_list_node_base::pointer_type head, _list_node_base::pointer_type tail)
+        {
+            _list_node_base::pointer_type prev = head->prev;
+            _list_node_base::pointer_type next = tail->next;
+            prev->next = next;
+            head->prev = _list_node_base::pointer_type();
+            tail->next = _list_node_base::pointer_type();
+            next->prev = prev;
+        }
+
+        void free_chunk(_unrolled_chunk_base::pointer_type chunk)
+        {
+            this->unlink(chunk, chunk);
+            this->destroy_chunk(chunk);
+        }
+
+        // Moves the elements before slot in its chunk to a new chunk in front of it and returns the chunk
+        // that ends right before the element at slot. That element keeps its place, so do the ones after it.
+        _unrolled_chunk_base::pointer_type split_before(_unrolled_chunk_base::pointer_type chunk, size_type slot)
+        {
+            if (chunk == &this->header || slot == chunk->first)
+            {
+                return unrolled_list::prev_chunk(chunk);
+            }
+
+            _unrolled_chunk_base::pointer_type head = this->create_chunk(0);
+            try
+            {
+                this->relocate_slots(chunk, chunk->first, slot, head, 0);
+            }
+            catch (...)
+            {
+                this->destroy_chunk(head);
+                throw;
+            }
+            head->last = slot - chunk->first;
+            chunk->first = slot;
+            this->link(chunk, head, head);
+            return head;
+        }
+
+        iterator make_iterator(_unrolled_chunk_base::pointer_type chunk, size_type slot)
+        {
+            if (slot == chunk->last)
+            {
+                chunk = unrolled_list::next_chunk(chunk);
+                slot = chunk->first;
+            }
+            return iterator(chunk, slot);
+        }
+
+#if __cplusplus >= 201103L
+        template <typename... Args>
+        _unrolled_chunk_base::pointer_type append_to(_unrolled_chunk_base::pointer_type chunk, Args&&... args)
+#else
+        _unrolled_chunk_base::pointer_type append_to(_unrolled_chunk_base::pointer_type chunk, const value_type& value)
+#endif
+        {
+            if (chunk != &this->header && chunk->last != chunk_capacity)
+            {
+#if __cplusplus >= 201103L
+                this->alloc.construct(unrolled_list::slots(chunk) + chunk->last, ft::forward<Args>(args)...);
+#else
+                this->alloc.construct(unrolled_list::slots(chunk) + chunk->last, value);
+#endif
+                chunk->last++;
+                this->number++;
+                return chunk;
+            }
+
+            _unrolled_chunk_base::pointer_type tail = this->create_chunk(0);
+            try
+            {
+#if __cplusplus >= 201103L
+                this->alloc.construct(unrolled_list::slots(tail), ft::forward<Args>(args)...);
+#else
+                this->alloc.construct(unrolled_list::slots(tail), value);
+#endif
+            }
+            catch (...)
+            {
+                this->destroy_chunk(tail);
+                throw;
+            }
+            tail->last++;
+            this->link(chunk->next, tail, tail);
+            this->number++;
+            return tail;
+        }
+
+#if __cplusplus >= 201103L
+        template <typename... Args>
+        _unrolled_chunk_base::pointer_type prepend_to(_unrolled_chunk_base::pointer_type chunk, Args&&... args)
+#else
+        _unrolled_chunk_base::pointer_type prepend_to(_unrolled_chunk_base::pointer_type chunk, const value_type& value)
+#endif
+        {
+            if (chunk != &this->header && chunk->first != 0)
+            {
+#if __cplusplus >= 201103L
+                this->alloc.construct(unrolled_list::slots(chunk) + (chunk->first - 1), ft::forward<Args>(args)...);
+#else
+                this->alloc.construct(unrolled_list::slots(chunk) + (chunk->first - 1), value);
+#endif
+                chunk->first--;
+                this->number++;
+                return chunk;
+            }
+
+            // filled from the back, the next push_front lands here too
+            _unrolled_chunk_base::pointer_type head = this->create_chunk(chunk_capacity);
+            try
+            {
+#if __cplusplus >= 201103L
+                this->alloc.construct(unrolled_list::slots(head) + (chunk_capacity - 1), ft::forward<Args>(args)...);
+#else
+                this->alloc.construct(unrolled_list::slots(head) + (chunk_capacity - 1), value);
+#endif
+            }
+            catch (...)
+            {
+                this->destroy_chunk(head);
+                throw;
+            }
+            head->first--;
+            this->link(chunk, head, head);
+            this->number++;
+            return head;
+        }
+
+        // Opens slot in a chunk with a free slot at the back and moves value there.
+        iterator insert_shift(_unrolled_chunk_base::pointer_type chunk, size_type slot, value_type& value)
+        {
+            value_type* data = unrolled_list::slots(chunk);
+            size_type last = chunk->last;
+            if (slot == last)
+            {
+                this->relocate(data + last, value);
+                chunk->last++;
+            }
+            else
+            {
+                this->relocate(data + last, data[last - 1]);
+                chunk->last++;
+                ft::move_backward(data + slot, data + last - 1, data + last);
+                unrolled_list::move_assign(data[slot], value);
+            }
+            this->number++;
+            return iterator(chunk, slot);
+        }
+
+        // Inserts value (a temporary the caller owns) before the element at pos.
+        // Shifts toward the free end of the chunk, a full chunk is split in halves first.
+        iterator insert_at(iterator pos, value_type& value)
+        {
+            _unrolled_chunk_base::pointer_type chunk = pos.chunk;
+            size_type slot = pos.slot;
+            if (slot == chunk->first)
+            {
+                _unrolled_chunk_base::pointer_type prev = unrolled_list::prev_chunk(chunk);
+                if (chunk->first == 0 && prev != &this->header && prev->last != chunk_capacity)
+                {
+                    return this->insert_shift(prev, prev->last, value);
+                }
+                if (chunk->first != 0)
+                {
+                    this->relocate(unrolled_list::slots(chunk) + (chunk->first - 1), value);
+                    chunk->first--;
+                    this->number++;
+                    return iterator(chunk, chunk->first);
+                }
+            }
+
+            if (chunk->last != chunk_capacity)
+            {
+                return this->insert_shift(chunk, slot, value);
+            }
+            if (chunk->first != 0)
+            {
+                value_type* data = unrolled_list::slots(chunk);
+                size_type first = chunk->first;
+                this->relocate(data + (first - 1), data[first]);
+                chunk->first--;
+                ft::move(data + first + 1, data + slot, data + first);
+                unrolled_list::move_assign(data[slot - 1], value);
+                this->number++;
+                return iterator(chunk, slot - 1);
+            }
+
+            size_type half = chunk_capacity / 2;
+            _unrolled_chunk_base::pointer_type tail = this->create_chunk(0);
+            try
+            {
+                this->relocate_slots(chunk, half, chunk_capacity, tail, 0);
+            }
+            catch (...)
+            {
+                this->destroy_chunk(tail);
+                throw;
+            }
+            tail->last = chunk_capacity - half;
+            chunk->last = half;
+            this->link(chunk->next, tail, tail);
+            if (slot <= half)
+            {
+                return this->insert_shift(chunk, slot, value);
+            }
+            return this->insert_shift(tail, slot - half, value);
+        }
+
+    public:
+        void assign(size_type count, const value_type& value)
+        {
+            iterator it = this->begin();
+            iterator end = this->end();
+            for (; it != end && count != 0; --count)
+            {
+                *it = value;
+                ++it;
+            }
+            if (it != end)
+            {
+                this->erase(it, end);
+            }
+            else if (count != 0)
+            {
+                this->insert(it, count, value);
+            }
+        }
+
+        template <typename UIter>
+        // void assign(UIter first, UIter last)
+        typename ft::enable_if<ft::is_input_iterator<UIter>::value, void>::type assign(UIter first, UIter last)
+        {
+            iterator it = this->begin();
+            iterator end = this->end();
+            for (; it != end && first != last; ++first)
+            {
+                *it = *first;
+                ++it;
+            }
+            if (it != end)
+            {
+                this->erase(it, end);
+            }
+            else if (first != last)
+            {
+                this->insert(it, first, last);
+            }
+        }
+
+    public:
+        allocator_type get_allocator() const { return this->alloc; }
+
+    public:
+        reference front() { return *this->begin(); }
+        const_reference front() const { return *this->begin(); }
+        reference back() { return *--this->end(); }
+        const_reference back() const { return *--this->end(); }
+
+    public:
+        iterator begin()
+        {
+            _unrolled_chunk_base::pointer_type chunk = unrolled_list::next_chunk(&this->header);
+            return iterator(chunk, chunk->first);
+        }
+        const_iterator begin() const
+        {
+            _unrolled_chunk_base::pointer_type chunk = static_cast<_unrolled_chunk_base::pointer_type>(this->header.next);
+            return const_iterator(chunk, chunk->first);
+        }
+        iterator end() { return iterator(&this->header, 0); }
+        const_iterator end() const { return const_iterator(const_cast<_unrolled_chunk_base*>(&this->header), 0); }
+        reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+        reverse_iterator rend() { return reverse_iterator(this->begin()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+    public:
+        bool empty() const { return this->size() == size_type(); }
+        size_type size() const { return this->number; }
+        size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(value_type); }
+
+    public:
+        void clear()
+        {
+            this->destruct();
+            this->reset();
+            this->number = size_type();
+        }
+
+        iterator insert(iterator pos, const value_type& value)
+        {
+            if (pos.chunk == &this->header)
+            {
+                _unrolled_chunk_base::pointer_type chunk = this->append_to(unrolled_list::prev_chunk(&this->header), value);
+                return iterator(chunk, chunk->last - 1);
+            }
+            if (pos.chunk->prev == &this->header && pos.slot == pos.chunk->first)
+            {
+                _unrolled_chunk_base::pointer_type chunk = this->prepend_to(pos.chunk, value);
+                return iterator(chunk, chunk->first);
+            }
+            // value may be one of the elements the insertion moves
+            value_type copy(value);
+            return this->insert_at(pos, copy);
+        }
+
+        iterator insert(iterator pos, size_type count, const value_type& value)
+        {
+            if (count == 0)
+            {
+                return pos;
+            }
+
+            value_type copy(value);
+            _unrolled_chunk_base::pointer_type chunk = this->split_before(pos.chunk, pos.slot);
+            _unrolled_chunk_base::pointer_type next = unrolled_list::next_chunk(chunk);
+            chunk = this->append_to(chunk, copy);
+            iterator result(chunk, chunk->last - 1);
+            try
+            {
+                for (--count; count != 0; --count)
+                {
+                    chunk = this->append_to(chunk, copy);
+                }
+            }
+            catch (...)
+            {
+                this->erase(result, iterator(next, next->first));
+                throw;
+            }
+            return result;
+        }
+
+        template <typename UIter>
+        // iterator insert(iterator pos, UIter first, UIter last)
+        typename ft::enable_if<ft::is_input_iterator<UIter>::value, iterator>::type insert(iterator pos, UIter first, UIter last)
+        {
+            if (first == last)
+            {
+                return pos;
+            }
+
+            _unrolled_chunk_base::pointer_type chunk = this->split_before(pos.chunk, pos.slot);
+            _unrolled_chunk_base::pointer_type next = unrolled_list::next_chunk(chunk);
+            chunk = this->append_to(chunk, *first);
+            iterator result(chunk, chunk->last - 1);
+            try
+            {
+                for (++first; first != last; ++first)
+                {
+                    chunk = this->append_to(chunk, *first);
+                }
+            }
+            catch (...)
+            {
+                this->erase(result, iterator(next, next->first));
+                throw;
+            }
+            return result;
+        }
+
+        iterator erase(iterator pos)
+        {
+            iterator next = pos;
+            ++next;
+            return this->erase(pos, next);
+        }
+
+        // Within one chunk the shorter side closes the gap, across chunks nothing moves.
+        iterator erase(iterator first, iterator last)
+        {
+            if (first == last)
+            {
+                return last;
+            }
+
+            _unrolled_chunk_base::pointer_type chunk = first.chunk;
+            if (chunk == last.chunk)
+            {
+                size_type count = last.slot - first.slot;
+                value_type* data = unrolled_list::slots(chunk);
+                this->number -= count;
+                if (first.slot - chunk->first < chunk->last - last.slot)
+                {
+                    ft::move_backward(data + chunk->first, data + first.slot, data + last.slot);
+                    this->destroy_slots(chunk, chunk->first, chunk->first + count);
+                    chunk->first += count;
+                    return this->make_iterator(chunk, last.slot);
+                }
+                ft::move(data + last.slot, data + chunk->last, data + first.slot);
+                this->destroy_slots(chunk, chunk->last - count, chunk->last);
+                chunk->last -= count;
+                if (chunk->first == chunk->last)
+                {
+                    _unrolled_chunk_base::pointer_type next = unrolled_list::next_chunk(chunk);
+                    this->free_chunk(chunk);
+                    return iterator(next, next->first);
+                }
+                return this->make_iterator(chunk, first.slot);
+            }
+
+            this->number -= chunk->last - first.slot;
+            this->destroy_slots(chunk, first.slot, chunk->last);
+            chunk->last = first.slot;
+            _unrolled_chunk_base::pointer_type next = unrolled_list::next_chunk(chunk);
+            if (chunk->first == chunk->last)
+            {
+                this->free_chunk(chunk);
+            }
+            for (chunk = next; chunk != last.chunk; chunk = next)
+            {
+                next = unrolled_list::next_chunk(chunk);
+                this->number -= chunk->last - chunk->first;
+                this->destroy_slots(chunk, chunk->first, chunk->last);
+                this->free_chunk(chunk);
+            }
+            if (chunk != &this->header)
+            {
+                this->number -= last.slot - chunk->first;
+                this->destroy_slots(chunk, chunk->first, last.slot);
+                chunk->first = last.slot;
+            }
+            return last;
+        }
+
+        void push_back(const value_type& value)
+        {
+            static_cast<void>(this->append_to(unrolled_list::prev_chunk(&this->header), value));
+        }
+
+        void pop_back()
+        {
+            _unrolled_chunk_base::pointer_type chunk = unrolled_list::prev_chunk(&this->header);
+            chunk->last--;
+            this->alloc.destroy(unrolled_list::slots(chunk) + chunk->last);
+            this->number--;
+            if (chunk->first == chunk->last)
+            {
+                this->free_chunk(chunk);
+            }
+        }
+
+        void push_front(const value_type& value)
+        {
+            static_cast<void>(this->prepend_to(unrolled_list::next_chunk(&this->header), value));
+        }
+
+        void pop_front()
+        {
+            _unrolled_chunk_base::pointer_type chunk = unrolled_list::next_chunk(&this->header);
+            this->alloc.destroy(unrolled_list::slots(chunk) + chunk->first);
+            chunk->first++;
+            this->number--;
+            if (chunk->first == chunk->last)
+            {
+                this->free_chunk(chunk);
+            }
+        }
+
+#if __cplusplus >= 201103L
+        iterator insert(iterator pos, value_type&& value)
+        {
+            return this->emplace(pos, ft::move(value));
+        }
+
+        template <typename... Args>
+        iterator emplace(iterator pos, Args&&... args)
+        {
+            if (pos.chunk == &this->header)
+            {
+                _unrolled_chunk_base::pointer_type chunk = this->append_to(unrolled_list::prev_chunk(&this->header), ft::forward<Args>(args)...);
+                return iterator(chunk, chunk->last - 1);
+            }
+            if (pos.chunk->prev == &this->header && pos.slot == pos.chunk->first)
+            {
+                _unrolled_chunk_base::pointer_type chunk = this->prepend_to(pos.chunk, ft::forward<Args>(args)...);
+                return iterator(chunk, chunk->first);
+            }
+            value_type value(ft::forward<Args>(args)...);
+            return this->insert_at(pos, value);
+        }
+
+        void push_back(value_type&& value)
+        {
+            static_cast<void>(this->append_to(unrolled_list::prev_chunk(&this->header), ft::move(value)));
+        }
+
+        template <typename... Args>
+        void emplace_back(Args&&... args)
+        {
+            static_cast<void>(this->append_to(unrolled_list::prev_chunk(&this->header), ft::forward<Args>(args)...));
+        }
+
+        void push_front(value_type&& value)
+        {
+            static_cast<void>(this->prepend_to(unrolled_list::next_chunk(&this->header), ft::move(value)));
+        }
+
+        template <typename... Args>
+        void emplace_front(Args&&... args)
+        {
+            static_cast<void>(this->prepend_to(unrolled_list::next_chunk(&this->header), ft::forward<Args>(args)...));
+        }
+#endif
+
+        void resize(size_type count, value_type value = value_type())
+        {
+            size_type size = this->size();
+            if (count > size)
+            {
+                this->insert(this->end(), count - size, value);
+            }
+            else if (count < size)
+            {
+                iterator it = this->begin();
+                iterator end = this->end();
+                ft::advance(it, count);
+                this->erase(it, end);
+            }
+        }
+
+        void swap(unrolled_list& that)
+        {
+            ft::swap(this->header.next, that.header.next);
+            if (this->header.next == &that.header)
+            {
+                this->header.next = &this->header;
+            }
+            else
+            {
+                this->header.next->prev = &this->header;
+            }
+            if (that.header.next == &this->header)
+            {
+                that.header.next = &that.header;
+            }
+            else
+            {
+                that.header.next->prev = &that.header;
+            }
+
+            ft::swap(this->header.prev, that.header.prev);
+            if (this->header.prev == &that.header)
+            {
+                this->header.prev = &this->header;
+            }
+            else
+            {
+                this->header.prev->next = &this->header;
+            }
+            if (that.header.prev == &this->header)
+            {
+                that.header.prev = &that.header;
+            }
+            else
+            {
+                that.header.prev->next = &that.header;
+            }
+
+            ft::swap(this->number, that.number);
+
+            ft::swap(this->alloc, that.alloc);
+        }
+
+    public:
+        void merge(unrolled_list& that)
+        {
+            this->merge(that, ft::less<value_type>());
+        }
+
+        // The elements are moved into fresh chunks in merged order, the drained chunks are freed on the way.
+        // If comp throws the merged prefix is put back in front of this list.
+        template <typename TComp>
+        void merge(unrolled_list& that, TComp comp)
+        {
+            if (this == &that || that.empty())
+            {
+                return;
+            }
+            if (this->empty() || !comp(that.front(), this->back()))
+            {
+                this->splice(this->end(), that);
+                return;
+            }
+
+            unrolled_list result(this->alloc);
+            try
+            {
+                while (!this->empty() && !that.empty())
+                {
+                    unrolled_list& from = comp(that.front(), this->front()) ? that : *this;
+                    _unrolled_chunk_base::pointer_type chunk = unrolled_list::next_chunk(&from.header);
+                    result.append_to(unrolled_list::prev_chunk(&result.header), unrolled_list::relocated(unrolled_list::slots(chunk)[chunk->first]));
+                    from.pop_front();
+                }
+            }
+            catch (...)
+            {
+                this->splice(this->begin(), result);
+                throw;
+            }
+            result.splice(result.end(), *this);
+            result.splice(result.end(), that);
+            this->swap(result);
+        }
+
+        void splice(const_iterator pos, unrolled_list& that)
+        {
+            if (this == &that)
+            {
+                // NOTE: Undefined behavior
+                return;
+            }
+
+            _list_node_base::pointer_type head = that.header.next;
+            if (head != &that.header)
+            {
+                _unrolled_chunk_base::pointer_type prev = this->split_before(pos.chunk, pos.slot);
+                _list_node_base::pointer_type tail = that.header.prev;
+                this->number += that.number;
+                that.number = 0;
+                that.unlink(head, tail);
+                this->link(prev->next, head, tail);
+            }
+        }
+
+        void splice(const_iterator pos, unrolled_list& that, const_iterator it)
+        {
+            const_iterator last = it;
+            ++last;
+            this->splice(pos, that, it, last);
+        }
+
+        // Splits the chunks at the three positions, in slot order so that an earlier split
+        // moves none of the later positions, then relinks the chunks in between.
+        void splice(const_iterator pos, unrolled_list& that, const_iterator first, const_iterator last)
+        {
+            if (first == last || pos == first || pos == last)
+            {
+                return;
+            }
+
+            const_iterator* order[3] = {&pos, &first, &last};
+            for (size_type i = 1; i < 3; ++i)
+            {
+                for (size_type j = i; j > 0 && order[j]->slot < order[j - 1]->slot; --j)
+                {
+                    ft::swap(order[j], order[j - 1]);
+                }
+            }
+
+            _unrolled_chunk_base::pointer_type before_pos = _unrolled_chunk_base::pointer_type();
+            _unrolled_chunk_base::pointer_type before_first = _unrolled_chunk_base::pointer_type();
+            _unrolled_chunk_base::pointer_type before_last = _unrolled_chunk_base::pointer_type();
+            for (size_type i = 0; i < 3; ++i)
+            {
+                if (order[i] == &pos)
+                {
+                    before_pos = this->split_before(pos.chunk, pos.slot);
+                }
+                else if (order[i] == &first)
+                {
+                    before_first = that.split_before(first.chunk, first.slot);
+                }
+                else
+                {
+                    before_last = that.split_before(last.chunk, last.slot);
+                }
+            }
+
+            _list_node_base::pointer_type head = before_first->next;
+            _list_node_base::pointer_type tail = before_last;
+            if (this != &that)
+            {
+                size_type distance = size_type();
+                for (_list_node_base::pointer_type node = head;; node = node->next)
+                {
+                    _unrolled_chunk_base::pointer_type chunk = static_cast<_unrolled_chunk_base::pointer_type>(node);
+                    distance += chunk->last - chunk->first;
+                    if (node == tail)
+                    {
+                        break;
+                    }
+                }
+                this->number += distance;
+                that.number -= distance;
+            }
+            that.unlink(head, tail);
+            this->link(before_pos->next, head, tail);
+        }
+
+        void remove(const value_type& value)
+        {
+            // value may be one of the elements overwritten on the way
+            value_type copy(value);
+            iterator it = this->begin();
+            iterator end = this->end();
+            for (; it != end && !(*it == copy); ++it)
+                ;
+            if (it == end)
+            {
+                return;
+            }
+
+            iterator kept = it;
+            try
+            {
+                for (++it; it != end; ++it)
+                {
+                    if (!(*it == copy))
+                    {
+                        unrolled_list::move_assign(*kept, *it);
+                        ++kept;
+                    }
+                }
+            }
+            catch (...)
+            {
+                this->erase(kept, it);
+                throw;
+            }
+            this->erase(kept, end);
+        }
+
+        // Moves the kept elements forward in one pass and cuts the tail.
+        template <typename TPredicate>
+        void remove_if(TPredicate p)
+        {
+            iterator it = this->begin();
+            iterator end = this->end();
+            for (; it != end && !p(*it); ++it)
+                ;
+            if (it == end)
+            {
+                return;
+            }
+
+            iterator kept = it;
+            try
+            {
+                for (++it; it != end; ++it)
+                {
+                    if (!p(*it))
+                    {
+                        unrolled_list::move_assign(*kept, *it);
+                        ++kept;
+                    }
+                }
+            }
+            catch (...)
+            {
+                this->erase(kept, it);
+                throw;
+            }
+            this->erase(kept, end);
+        }
+
+        void reverse()
+        {
+            if (this->number > 1)
+            {
+                for (_list_node_base::pointer_type it = this->header.next; it != &this->header; it = it->prev)
+                {
+                    ft::swap(it->prev, it->next);
+                    _unrolled_chunk_base::pointer_type chunk = static_cast<_unrolled_chunk_base::pointer_type>(it);
+                    value_type* data = unrolled_list::slots(chunk);
+                    for (size_type i = chunk->first, j = chunk->last; i + 1 < j; ++i, --j)
+                    {
+                        ft::swap(data[i], data[j - 1]);
+                    }
+                }
+                ft::swap(this->header.prev, this->header.next);
+            }
+        }
+
+        void unique()
+        {
+            this->unique(ft::equal_to<value_type>());
+        }
+
+        template <typename TBiPredicate>
+        void unique(TBiPredicate p)
+        {
+            iterator kept = this->begin();
+            iterator end = this->end();
+            if (kept == end)
+            {
+                return;
+            }
+
+            iterator it = kept;
+            for (++it; it != end && !p(*kept, *it); ++it)
+            {
+                kept = it;
+            }
+            if (it == end)
+            {
+                return;
+            }
+
+            ++kept;
+            try
+            {
+                // kept is one past the last element kept
+                for (++it; it != end; ++it)
+                {
+                    iterator prev = kept;
+                    --prev;
+                    if (!p(*prev, *it))
+                    {
+                        unrolled_list::move_assign(*kept, *it);
+                        ++kept;
+                    }
+                }
+            }
+            catch (...)
+            {
+                this->erase(kept, it);
+                throw;
+            }
+            this->erase(kept, end);
+        }
+
+        void sort()
+        {
+            this->sort(ft::less<value_type>());
+        }
+
+        // Sorts an array of element pointers and then moves every element once along the
+        // cycles of the permutation. Stable, presorted input costs a single pass.
+        // If comp throws nothing has moved.
+        template <typename TComp>
+        void sort(TComp comp)
+        {
+            typedef typename TAlloc::template rebind<sort_entry>::other entry_allocator_type;
+            typedef typename TAlloc::template rebind<value_type*>::other place_allocator_type;
+
+            size_type n = this->number;
+            if (n < 2)
+            {
+                return;
+            }
+
+            entry_allocator_type entry_alloc(this->alloc);
+            place_allocator_type place_alloc(this->alloc);
+            sort_entry* entries = entry_alloc.allocate(n);
+            value_type** places;
+            try
+            {
+                places = place_alloc.allocate(n);
+            }
+            catch (...)
+            {
+                entry_alloc.deallocate(entries, n);
+                throw;
+            }
+
+            try
+            {
+                size_type descents = size_type();
+                size_type i = size_type();
+                for (iterator it = this->begin(), end = this->end(); it != end; ++it, ++i)
+                {
+                    places[i] = ft::addressof(*it);
+                    entries[i].value = places[i];
+                    entries[i].order = i;
+                    if (i != 0 && comp(*places[i], *places[i - 1]))
+                    {
+                        descents++;
+                    }
+                }
+                if (descents != 0)
+                {
+                    ft::sort(entries, entries + n, sort_entry_compare<TComp>(comp));
+                    unrolled_list::permute(entries, places, n);
+                }
+            }
+            catch (...)
+            {
+                place_alloc.deallocate(places, n);
+                entry_alloc.deallocate(entries, n);
+                throw;
+            }
+            place_alloc.deallocate(places, n);
+            entry_alloc.deallocate(entries, n);
+        }
+
+    protected:
+#if __cplusplus >= 201103L
+        static typename ft::conditional<ft::_internal::_move_if_noexcept<value_type>::value, value_type&&, const value_type&>::type relocated(value_type& value)
+        {
+            return ft::move_if_noexcept(value);
+        }
+#else
+        static const value_type& relocated(value_type& value)
+        {
+            return value;
+        }
+#endif
+
+        struct sort_entry
+        {
+            value_type* value;
+            size_type order;
+        };
+
+        // ties fall back to the order in the list, which keeps an unstable sort stable
+        template <typename TComp>
+        struct sort_entry_compare
+        {
+            TComp* comp;
+
+            explicit sort_entry_compare(TComp& comp)
+                : comp(&comp) {}
+
+            bool operator()(const sort_entry& lhs, const sort_entry& rhs) const
+            {
+                if ((*this->comp)(*lhs.value, *rhs.value))
+                {
+                    return true;
+                }
+                if ((*this->comp)(*rhs.value, *lhs.value))
+                {
+                    return false;
+                }
+                return lhs.order < rhs.order;
+            }
+        };
+
+        // places[i] takes the element at places[entries[i].order], a cycle at a time
+        static void permute(sort_entry* entries, value_type** places, size_type n)
+        {
+            for (size_type i = size_type(); i != n; ++i)
+            {
+                if (entries[i].order == i)
+                {
+                    continue;
+                }
+
+                value_type value(unrolled_list::relocated(*places[i]));
+                size_type j = i;
+                while (entries[j].order != i)
+                {
+                    size_type from = entries[j].order;
+                    unrolled_list::move_assign(*places[j], *places[from]);
+                    entries[j].order = j;
+                    j = from;
+                }
+                unrolled_list::move_assign(*places[j], value);
+                entries[j].order = j;
+            }
+        }
+
+    public:
+        friend bool operator==(const unrolled_list& lhs, const unrolled_list& rhs)
+        {
+            return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        friend bool operator!=(const unrolled_list& lhs, const unrolled_list& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const unrolled_list& lhs, const unrolled_list& rhs)
+        {
+            return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator<=(const unrolled_list& lhs, const unrolled_list& rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>(const unrolled_list& lhs, const unrolled_list& rhs)
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator>=(const unrolled_list& lhs, const unrolled_list& rhs)
+        {
+            return !(lhs < rhs);
+        }
+    };
+
+    template <typename T, std::size_t N, typename TAlloc>
+    const typename unrolled_list<T, N, TAlloc>::size_type unrolled_list<T, N, TAlloc>::chunk_capacity;
+
+    template <typename T, std::size_t N, typename TAlloc>
+    inline void swap(
+        unrolled_list<T, N, TAlloc>& lhs,
+        unrolled_list<T, N, TAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+namespace std
+{
+    template <typename T, std::size_t N, typename TAlloc>
+    inline void swap(
+        ft::unrolled_list<T, N, TAlloc>& lhs,
+        ft::unrolled_list<T, N, TAlloc>& rhs)
+    {
+        ft::swap(lhs, rhs);
+    }
+}
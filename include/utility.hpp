@@ -3,4 +3,6 @@
 
 #pragma once
 
+#include "utility/move.hpp"
 #include "utility/pair.hpp"
+#include "utility/sorted_tag.hpp"
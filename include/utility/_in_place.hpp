@@ -0,0 +1,47 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "move.hpp"
+
+#include <new>
+
+namespace ft
+{
+    namespace _internal
+    {
+        // Selects the node constructors that build the stored value from emplace arguments.
+        struct _in_place_t
+        {
+        };
+
+#if __cplusplus >= 201103L
+        template <typename TAlloc, typename TNode, typename... Args>
+        inline void _construct_node(TAlloc& alloc, TNode* node, Args&&... args)
+        {
+            alloc.construct(node, ft::forward<Args>(args)...);
+        }
+
+        template <typename TAlloc, typename TNode>
+        inline void _destroy_node(TAlloc& alloc, TNode* node)
+        {
+            alloc.destroy(node);
+        }
+#else
+        // A C++98 allocator constructs a node only as a copy of another node, which copies the value twice,
+        // so the node is built from the value in place and destroyed without the allocator as well.
+        template <typename TAlloc, typename TNode, typename TValue>
+        inline void _construct_node(TAlloc&, TNode* node, const TValue& value)
+        {
+            ::new (static_cast<void*>(node)) TNode(value);
+        }
+
+        template <typename TAlloc, typename TNode>
+        inline void _destroy_node(TAlloc&, TNode* node)
+        {
+            node->~TNode();
+        }
+#endif
+    }
+}
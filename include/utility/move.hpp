@@ -0,0 +1,70 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include "../type_traits/conditional.hpp"
+#include "../type_traits/integral_constant.hpp"
+#include "../type_traits/remove_reference.hpp"
+
+#if __cplusplus >= 201103L
+namespace ft
+{
+    template <typename T>
+    inline typename ft::remove_reference<T>::type&& move(T&& value) noexcept
+    {
+        return static_cast<typename ft::remove_reference<T>::type&&>(value);
+    }
+
+    template <typename T>
+    inline T&& forward(typename ft::remove_reference<T>::type& value) noexcept
+    {
+        return static_cast<T&&>(value);
+    }
+
+    template <typename T>
+    inline T&& forward(typename ft::remove_reference<T>::type&& value) noexcept
+    {
+        return static_cast<T&&>(value);
+    }
+
+    template <typename T>
+    T&& declval() noexcept;
+
+    namespace _internal
+    {
+        // A throwing move would leave the source half moved, copy instead (strong guarantee on relocation).
+        template <typename T>
+        struct _move_if_noexcept
+            : ft::integral_constant<bool, noexcept(T(ft::declval<T>()))>
+        {
+        };
+
+        template <typename T>
+        struct _is_copy_constructible
+        {
+        private:
+            template <typename U, typename = decltype(U(ft::declval<const U&>()))>
+            static char test(int);
+            template <typename>
+            static long test(...);
+
+        public:
+            static const bool value = sizeof(test<T>(0)) == sizeof(char);
+        };
+
+        template <typename T>
+        struct _is_nothrow_copy_constructible
+            : ft::integral_constant<bool, noexcept(T(ft::declval<const T&>()))>
+        {
+        };
+    }
+
+    // a move-only type is moved even if that may throw, there is no copy to fall back on
+    template <typename T>
+    inline typename ft::conditional<!ft::_internal::_move_if_noexcept<T>::value && ft::_internal::_is_copy_constructible<T>::value, const T&, T&&>::type move_if_noexcept(T& value) noexcept
+    {
+        return ft::move(value);
+    }
+}
+#endif
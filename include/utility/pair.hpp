@@ -3,8 +3,38 @@
 
 #pragma once
 
+#include "move.hpp"
+
+#include "../type_traits/enable_if.hpp"
+
+#include <new>
+
 namespace ft
 {
+#if __cplusplus >= 201103L
+    namespace _internal
+    {
+        // direct initialization only, a functional cast would accept pointer from integer
+        template <typename T, typename U>
+        struct _is_constructible_from
+        {
+        private:
+            template <typename V, typename = decltype(::new (static_cast<void*>(0)) V(ft::declval<U>()))>
+            static char test(int);
+            template <typename>
+            static long test(...);
+
+        public:
+            static const bool value = sizeof(test<T>(0)) == sizeof(char);
+        };
+
+        // selects the pair constructor that builds second in place from the arguments after first
+        struct _piecewise_second_t
+        {
+        };
+    }
+#endif
+
     template <typename TFirst, typename TSecond>
     struct pair
     {
@@ -19,19 +49,51 @@ namespace ft
         template <typename UFirst, typename USecond>
         pair(const pair<UFirst, USecond>& pair) : first(pair.first), second(pair.second) {}
 
+#if __cplusplus >= 201103L
+        pair(const pair&) = default;
+        pair(pair&&) = default;
+
+        template <typename UFirst, typename USecond,
+                  typename = typename ft::enable_if<_internal::_is_constructible_from<TFirst, UFirst&&>::value &&
+                                                    _internal::_is_constructible_from<TSecond, USecond&&>::value>::type>
+        pair(UFirst&& first, USecond&& second)
+            : first(ft::forward<UFirst>(first)), second(ft::forward<USecond>(second)) {}
+
+        template <typename UFirst, typename USecond>
+        pair(pair<UFirst, USecond>&& pair)
+            : first(ft::forward<UFirst>(pair.first)), second(ft::forward<USecond>(pair.second)) {}
+
+        template <typename UFirst, typename... Args>
+        pair(_internal::_piecewise_second_t, UFirst&& first, Args&&... args)
+            : first(ft::forward<UFirst>(first)), second(ft::forward<Args>(args)...) {}
+#endif
+
         pair& operator=(const pair& that)
         {
             this->first = that.first;
             this->second = that.second;
             return *this;
         }
+
+#if __cplusplus >= 201103L
+        pair& operator=(pair&& that)
+        {
+            this->first = ft::forward<TFirst>(that.first);
+            this->second = ft::forward<TSecond>(that.second);
+            return *this;
+        }
+#endif
     };
 
     template <typename TFirst, typename TSecond>
     inline pair<TFirst, TSecond> make_pair(
         TFirst first, TSecond second)
     {
+#if __cplusplus >= 201103L
+        return pair<TFirst, TSecond>(ft::move(first), ft::move(second));
+#else
         return pair<TFirst, TSecond>(first, second);
+#endif
     }
 
     template <typename TFirst, typename TSecond>
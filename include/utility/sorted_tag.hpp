@@ -0,0 +1,18 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+namespace ft
+{
+    // Tags for range operations whose input is already ordered by the container's comparator.
+    struct sorted_unique_t
+    {
+    };
+    static const sorted_unique_t sorted_unique = sorted_unique_t();
+
+    struct sorted_equivalent_t
+    {
+    };
+    static const sorted_equivalent_t sorted_equivalent = sorted_equivalent_t();
+}
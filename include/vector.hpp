@@ -6,20 +6,27 @@
 #include "algorithm.hpp"
 #include "iterator.hpp"
 #include "iterator/_pointer_iterator.hpp"
+#include "memory.hpp"
+#include "memory/_allocator_hooks.hpp"
 #include "stdexcept.hpp"
 #include "type_traits.hpp"
+#include "utility.hpp"
 
 #include <cstddef>
+#include <cstring>
 #include <limits>
+#include <memory>
 
 namespace ft
 {
-    template <typename T, typename TAlloc = std::allocator<T> >
+    // TGrowth picks the capacity when the elements no longer fit, see memory/growth_policy.hpp
+    template <typename T, typename TAlloc = std::allocator<T>, typename TGrowth = ft::growth_double>
     class vector
     {
     public:
         typedef T value_type;
         typedef TAlloc allocator_type;
+        typedef TGrowth growth_policy;
         typedef std::size_t size_type;
         typedef std::ptrdiff_t difference_type;
         typedef value_type& reference;
@@ -75,6 +82,16 @@ namespace ft
             this->start = assign;
         }
 
+#if __cplusplus >= 201103L
+        vector(vector&& that) noexcept
+            : start(that.start), length(that.length), count(that.count), alloc(ft::move(that.alloc))
+        {
+            that.start = pointer();
+            that.length = size_type();
+            that.count = size_type();
+        }
+#endif
+
         ~vector()
         {
             this->destruct();
@@ -90,6 +107,18 @@ namespace ft
             return *this;
         }
 
+#if __cplusplus >= 201103L
+        vector& operator=(vector&& that)
+        {
+            if (this != &that)
+            {
+                vector temp(ft::move(that));
+                this->swap(temp);
+            }
+            return *this;
+        }
+#endif
+
     protected:
         void destroy_tail_n(size_type count)
         {
@@ -123,6 +152,7 @@ namespace ft
                 : length(length), value(value) {}
 
             inline size_type count() const { return this->length; }
+            inline bool aliases(const vector& v) const { return v.in_storage(this->value); }
             inline void copy_n_head(size_type pivot, iterator dest) const { vector::fill_n(dest, pivot, this->value); }
             inline void copy_n_tail(size_type pivot, iterator dest) const { vector::fill_n(dest, this->count() - pivot, this->value); }
             inline void uninitialized_copy_n_head(size_type pivot, iterator dest, allocator_type& alloc) const { vector::uninitialized_fill_n(dest, pivot, this->value, alloc); }
@@ -144,6 +174,7 @@ namespace ft
             }
 
             inline size_type count() const { return this->length; }
+            inline bool aliases(const vector& v) const { return this->length != 0 && v.in_storage(*this->first); }
             inline void copy_n_head(size_type pivot, iterator dest) const { ft::copy(this->first, vector::next(this->first, pivot), dest); }
             inline void copy_n_tail(size_type pivot, iterator dest) const { ft::copy(vector::next(this->first, pivot), this->last, dest); }
             inline void uninitialized_copy_n_head(size_type pivot, iterator dest, allocator_type& alloc) const { vector::uninitialized_copy(this->first, vector::next(this->first, pivot), dest, alloc); }
@@ -205,7 +236,19 @@ namespace ft
         // void assign(UIter first, UIter last)
         typename ft::enable_if<!ft::is_forward_iterator<UIter>::value && ft::is_input_iterator<UIter>::value, void>::type assign(UIter first, UIter last)
         {
-            this->clear();
+            // one pass: the live elements are assigned over, the rest is appended or dropped
+            iterator it = this->begin();
+            iterator end = this->end();
+            for (; it != end && first != last; ++first)
+            {
+                *it = *first;
+                ++it;
+            }
+            if (it != end)
+            {
+                this->destroy_tail_n(ft::distance(it, end));
+                return;
+            }
             for (; first != last; ++first)
             {
                 this->push_back(*first);
@@ -215,6 +258,10 @@ namespace ft
     public:
         allocator_type get_allocator() const { return this->alloc; }
 
+    protected:
+        allocator_type& get_allocator_ref() { return this->alloc; }
+        const allocator_type& get_allocator_ref() const { return this->alloc; }
+
     public:
         reference at(size_type pos)
         {
@@ -246,8 +293,8 @@ namespace ft
     public:
         iterator begin() { return iterator(this->start); }
         const_iterator begin() const { return const_iterator(this->start); }
-        iterator end() { return iterator(ft::addressof(this->start[this->length])); }
-        const_iterator end() const { return const_iterator(ft::addressof(this->start[this->length])); }
+        iterator end() { return iterator(this->start + this->length); }
+        const_iterator end() const { return const_iterator(this->start + this->length); }
         reverse_iterator rbegin() { return reverse_iterator(this->end()); }
         const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
         reverse_iterator rend() { return reverse_iterator(this->begin()); }
@@ -264,19 +311,19 @@ namespace ft
             {
                 throw ft::length_error("vector::reserve");
             }
-            if (this->capacity() < new_cap)
+            if (this->capacity() < new_cap && !this->reallocate(new_cap))
             {
-                pointer reserve = this->alloc.allocate(new_cap);
+                pointer reserve = this->allocate_at_least(new_cap);
                 try
                 {
-                    vector::uninitialized_copy(this->begin(), this->end(), iterator(reserve), this->alloc);
+                    this->relocate_split(reserve, this->size(), 0);
                 }
                 catch (...)
                 {
                     this->alloc.deallocate(reserve, new_cap);
                     throw;
                 }
-                this->destruct();
+                this->release_relocated();
                 this->start = reserve;
                 this->count = new_cap;
             }
@@ -284,6 +331,33 @@ namespace ft
 
         size_type capacity() const { return this->count; }
 
+        void shrink_to_fit()
+        {
+            size_type length = this->size();
+            if (length == this->capacity() || (length != 0 && this->reallocate(length)))
+            {
+                return;
+            }
+            pointer shrink = pointer();
+            size_type shrink_cap = length;
+            if (length != 0)
+            {
+                shrink = this->allocate_at_least(shrink_cap);
+                try
+                {
+                    this->relocate_split(shrink, length, 0);
+                }
+                catch (...)
+                {
+                    this->alloc.deallocate(shrink, shrink_cap);
+                    throw;
+                }
+            }
+            this->release_relocated();
+            this->start = shrink;
+            this->count = shrink_cap;
+        }
+
     protected:
         inline size_type check(size_type length, const char* caller)
         {
@@ -304,20 +378,19 @@ namespace ft
             size_type count = this->capacity();
             if (length + delta > count)
             {
-                if (delta <= length)
-                {
-                    // same, length *= 2;
-                    length <<= 1;
-                }
-                else
-                {
-                    length += delta;
-                }
-                count = length;
+                count = growth_policy::next_capacity(count, length + delta, sizeof(value_type), this->max_size());
             }
             return count;
         }
 
+        // count may come back larger when the allocator reports slack in the block
+        pointer allocate_at_least(size_type& count)
+        {
+            pointer p = this->alloc.allocate(count);
+            count = ft::_internal::usable_size(this->alloc, p, count);
+            return p;
+        }
+
     private:
         template <typename UIter>
         // static inline UIter next(UIter it, size_type n)
@@ -359,9 +432,30 @@ namespace ft
             }
         }
 
+        // a plain allocator constructs a trivially copyable type with a plain byte copy
+        template <typename UIter>
+        struct bitwise_construct
+            : ft::integral_constant<bool,
+                                    ft::_internal::is_bitwise_copyable<UIter, iterator>::value &&
+                                        ft::_internal::_is_plain_allocator<allocator_type>::value>
+        {
+        };
+
         template <typename UIter>
         // static inline void uninitialized_copy(UIter first, UIter last, iterator pos, allocator_type& alloc)
         static inline typename ft::enable_if<ft::is_iterator<UIter>::value, void>::type uninitialized_copy(UIter first, UIter last, iterator pos, allocator_type& alloc)
+        {
+            vector::uninitialized_copy(first, last, pos, alloc, typename bitwise_construct<UIter>::type());
+        }
+
+        template <typename UIter>
+        static inline void uninitialized_copy(UIter first, UIter last, iterator pos, allocator_type&, ft::true_type)
+        {
+            static_cast<void>(ft::copy(first, last, pos));
+        }
+
+        template <typename UIter>
+        static inline void uninitialized_copy(UIter first, UIter last, iterator pos, allocator_type& alloc, ft::false_type)
         {
             iterator it = pos;
             try
@@ -383,11 +477,133 @@ namespace ft
             }
         }
 
+        // Relocation into fresh storage, the source elements are destroyed by the caller.
+        static inline void uninitialized_move(iterator first, iterator last, iterator pos, allocator_type& alloc)
+        {
+#if __cplusplus >= 201103L
+            vector::uninitialized_move(first, last, pos, alloc, typename bitwise_construct<iterator>::type());
+#else
+            vector::uninitialized_copy(first, last, pos, alloc);
+#endif
+        }
+
+#if __cplusplus >= 201103L
+        static inline void uninitialized_move(iterator first, iterator last, iterator pos, allocator_type&, ft::true_type)
+        {
+            static_cast<void>(ft::copy(first, last, pos));
+        }
+
+        static inline void uninitialized_move(iterator first, iterator last, iterator pos, allocator_type& alloc, ft::false_type)
+        {
+            iterator it = pos;
+            try
+            {
+                for (iterator val = first; val != last; ++val)
+                {
+                    alloc.construct(ft::addressof(*it), ft::move_if_noexcept(*val));
+                    ++it;
+                }
+            }
+            catch (...)
+            {
+                for (; it != pos;)
+                {
+                    --it;
+                    alloc.destroy(ft::addressof(*it));
+                }
+                throw;
+            }
+        }
+#endif
+
     protected:
+        // [begin, begin + index) -> [dest, dest + index), [begin + index, end) -> [dest + index + gap, ...)
+        // Afterwards the old storage is given up with release_relocated.
+        void relocate_split(pointer dest, size_type index, size_type gap)
+        {
+            this->relocate_split(dest, index, gap, typename ft::is_trivially_relocatable<value_type>::type());
+        }
+
+        void relocate_split(pointer dest, size_type index, size_type gap, ft::true_type)
+        {
+            // the bytes are the objects, nothing is constructed here nor destroyed later
+            if (index != 0)
+            {
+                std::memcpy(static_cast<void*>(dest), static_cast<const void*>(this->start), index * sizeof(value_type));
+            }
+            if (this->length != index)
+            {
+                std::memcpy(static_cast<void*>(dest + index + gap), static_cast<const void*>(this->start + index), (this->length - index) * sizeof(value_type));
+            }
+        }
+
+        void relocate_split(pointer dest, size_type index, size_type gap, ft::false_type)
+        {
+            iterator pos = vector::next(this->begin(), index);
+            vector::uninitialized_move(this->begin(), pos, iterator(dest), this->alloc);
+            try
+            {
+                vector::uninitialized_move(pos, this->end(), iterator(dest + index + gap), this->alloc);
+            }
+            catch (...)
+            {
+                for (size_type i = index; i != size_type();)
+                {
+                    --i;
+                    this->alloc.destroy(ft::addressof(dest[i]));
+                }
+                throw;
+            }
+        }
+
+        void release_relocated()
+        {
+            if (ft::is_trivially_relocatable<value_type>::value)
+            {
+                if (this->start != pointer())
+                {
+                    this->alloc.deallocate(this->start, this->count);
+                }
+            }
+            else
+            {
+                this->destruct();
+            }
+        }
+
+        typedef ft::integral_constant<bool,
+                                      ft::is_trivially_relocatable<value_type>::value &&
+                                          ft::_internal::_has_reallocate<allocator_type>::value>
+            reallocatable;
+
+        // Grows or shrinks the storage through the allocator's reallocate, false when unsupported.
+        bool reallocate(size_type new_cap)
+        {
+            pointer p = ft::_internal::reallocate(this->alloc, this->start, this->count, new_cap, typename reallocatable::type());
+            if (p == pointer())
+            {
+                return false;
+            }
+            this->start = p;
+            this->count = ft::_internal::usable_size(this->alloc, p, new_cap);
+            return true;
+        }
+
+        bool in_storage(const value_type& value) const
+        {
+            const_pointer address = ft::addressof(value);
+            return address >= this->start && address < this->start + this->length;
+        }
+
         template <typename TOp>
         void insert_internal(iterator pos, const TOp& adaptor)
         {
             size_type count = adaptor.count();
+            if (count == 0)
+            {
+                // the shift below would move every tail element onto itself
+                return;
+            }
             size_type index = ft::distance(this->begin(), pos);
             size_type len = this->size();
             size_type cap = this->capacity();
@@ -402,7 +618,7 @@ namespace ft
                     this->length += count - difference;
 
                     // [pos, pos + difference) --(move)-> [(end + (count - difference)) == pos + count, (end + (count - difference)) + difference == pos + count + difference)
-                    vector::uninitialized_copy(pos, vector::next(pos, difference), this->end(), this->alloc);
+                    vector::uninitialized_move(pos, vector::next(pos, difference), this->end(), this->alloc);
                     this->length += difference;
 
                     // [pos, pos + difference)
@@ -411,42 +627,36 @@ namespace ft
                 else
                 {
                     // [end - count, end) --(move)-> [end, end + count)
-                    vector::uninitialized_copy(vector::next(this->end(), -count), this->end(), this->end(), this->alloc);
+                    vector::uninitialized_move(vector::next(this->end(), -count), this->end(), this->end(), this->alloc);
                     this->length += count;
 
                     // [pos, pos + (difference - count) == end - count) --(move reverse)-> (end, end - (difference - count) == pos + count]
-                    ft::copy_backward(pos, vector::next(pos, difference - count), vector::next(pos, difference));
+                    ft::move_backward(pos, vector::next(pos, difference - count), vector::next(pos, difference));
 
                     // [pos, pos + count)
                     adaptor.copy_n_head(count, pos);
                 }
             }
+            else if (index == len && !adaptor.aliases(*this) && this->reallocate(new_cap))
+            {
+                // appended in the grown block
+                adaptor.uninitialized_copy_n_head(count, this->end(), this->alloc);
+                this->length += count;
+            }
             else
             {
-                pointer insert = this->alloc.allocate(new_cap);
+                pointer insert = this->allocate_at_least(new_cap);
                 try
                 {
-                    vector::uninitialized_copy(this->begin(), pos, iterator(insert), this->alloc);
+                    // new elements first, the source may live in the storage being relocated
+                    adaptor.uninitialized_copy_n_head(count, vector::next(iterator(insert), index), this->alloc);
                     try
                     {
-                        adaptor.uninitialized_copy_n_head(count, vector::next(iterator(insert), index), this->alloc);
-                        try
-                        {
-                            vector::uninitialized_copy(pos, this->end(), vector::next(iterator(insert), index + count), this->alloc);
-                        }
-                        catch (...)
-                        {
-                            for (size_type i = index + count; i != index;)
-                            {
-                                --i;
-                                this->alloc.destroy(ft::addressof(insert[i]));
-                            }
-                            throw;
-                        }
+                        this->relocate_split(insert, index, count);
                     }
                     catch (...)
                     {
-                        for (size_type i = index; i != size_type();)
+                        for (size_type i = index + count; i != index;)
                         {
                             --i;
                             this->alloc.destroy(ft::addressof(insert[i]));
@@ -459,7 +669,7 @@ namespace ft
                     this->alloc.deallocate(insert, new_cap);
                     throw;
                 }
-                this->destruct();
+                this->release_relocated();
                 this->start = insert;
                 this->length += count;
                 this->count = new_cap;
@@ -481,6 +691,13 @@ namespace ft
 
         void insert(iterator pos, size_type count, const value_type& value)
         {
+            if (this->in_storage(value))
+            {
+                // the element would be shifted (or moved from) under our feet
+                value_type copy = value;
+                this->insert_internal(pos, vector_operation_count(count, copy));
+                return;
+            }
             this->insert_internal(pos, vector_operation_count(count, value));
         }
 
@@ -495,25 +712,43 @@ namespace ft
         // void insert(iterator pos, UIter first, UIter last)
         typename ft::enable_if<!ft::is_forward_iterator<UIter>::value && ft::is_input_iterator<UIter>::value, void>::type insert(iterator pos, UIter first, UIter last)
         {
-            for (; first != last; ++first)
+            // The length is unknown up front: the range is appended with amortized growth and
+            // then rotated into place, so the tail moves once rather than once per element.
+            // If an append throws the appended elements are dropped again.
+            size_type index = ft::distance(this->begin(), pos);
+            size_type length = this->size();
+            try
+            {
+                for (; first != last; ++first)
+                {
+                    this->push_back(*first);
+                }
+            }
+            catch (...)
             {
-                pos = this->insert(pos, *first);
-                ++pos;
+                this->destroy_tail_n(this->size() - length);
+                throw;
             }
+            ft::rotate(vector::next(this->begin(), index), vector::next(this->begin(), length), this->end());
         }
 
         iterator erase(iterator pos)
         {
             size_type count = 1;
-            ft::copy(vector::next(pos, count), this->end(), pos);
+            ft::move(vector::next(pos, count), this->end(), pos);
             this->destroy_tail_n(count);
             return pos;
         }
 
         iterator erase(iterator first, iterator last)
         {
+            if (first == last)
+            {
+                // the tail would be moved onto itself, which leaves moved-from elements behind
+                return first;
+            }
             size_type count = ft::distance(first, last);
-            ft::copy(last, this->end(), first);
+            ft::move(last, this->end(), first);
             this->destroy_tail_n(count);
             return first;
         }
@@ -532,6 +767,112 @@ namespace ft
             }
         }
 
+#if __cplusplus >= 201103L
+        iterator insert(iterator pos, value_type&& value)
+        {
+            size_type index = ft::distance(this->begin(), pos);
+            if (this->size() == this->capacity())
+            {
+                if (index == this->size() && !this->in_storage(value) && this->reallocate(this->expand(1, "vector::insert")))
+                {
+                    this->alloc.construct(ft::addressof(*this->end()), ft::move(value));
+                    this->length++;
+                }
+                else
+                {
+                    this->realloc_insert(index, ft::move(value));
+                }
+            }
+            else if (pos == this->end())
+            {
+                this->alloc.construct(ft::addressof(*this->end()), ft::move(value));
+                this->length++;
+            }
+            else
+            {
+                iterator last = vector::next(this->end(), -1);
+                this->alloc.construct(ft::addressof(*this->end()), ft::move(*last));
+                this->length++;
+                ft::move_backward(pos, last, vector::next(last, 1));
+                *pos = ft::move(value);
+            }
+            return vector::next(this->begin(), index);
+        }
+
+        template <typename... Args>
+        iterator emplace(iterator pos, Args&&... args)
+        {
+            size_type index = ft::distance(this->begin(), pos);
+            if (this->size() == this->capacity())
+            {
+                this->realloc_insert(index, ft::forward<Args>(args)...);
+            }
+            else if (pos == this->end())
+            {
+                this->alloc.construct(ft::addressof(*this->end()), ft::forward<Args>(args)...);
+                this->length++;
+            }
+            else
+            {
+                value_type value(ft::forward<Args>(args)...);
+                static_cast<void>(this->insert(pos, ft::move(value)));
+            }
+            return vector::next(this->begin(), index);
+        }
+
+        void push_back(value_type&& value)
+        {
+            static_cast<void>(this->insert(this->end(), ft::move(value)));
+        }
+
+        template <typename... Args>
+        void emplace_back(Args&&... args)
+        {
+            if (this->size() < this->capacity())
+            {
+                this->alloc.construct(ft::addressof(*this->end()), ft::forward<Args>(args)...);
+                this->length++;
+            }
+            else
+            {
+                this->realloc_insert(this->size(), ft::forward<Args>(args)...);
+            }
+        }
+
+    protected:
+        // grow and construct one element at index in the new storage, the arguments may alias old elements
+        template <typename... Args>
+        void realloc_insert(size_type index, Args&&... args)
+        {
+            size_type new_cap = this->expand(1, "vector::insert");
+            pointer insert = this->allocate_at_least(new_cap);
+            try
+            {
+                this->alloc.construct(ft::addressof(insert[index]), ft::forward<Args>(args)...);
+                try
+                {
+                    this->relocate_split(insert, index, 1);
+                }
+                catch (...)
+                {
+                    this->alloc.destroy(ft::addressof(insert[index]));
+                    throw;
+                }
+            }
+            catch (...)
+            {
+                this->alloc.deallocate(insert, new_cap);
+                throw;
+            }
+            this->release_relocated();
+            this->start = insert;
+            this->length++;
+            this->count = new_cap;
+        }
+
+    public:
+#endif
+
         void pop_back()
         {
             this->erase(vector::next(this->end(), -1));
@@ -550,6 +891,65 @@ namespace ft
             }
         }
 
+        // Like resize, but new elements are default-initialized: a trivially default constructible
+        // value_type is left uninitialized (a buffer about to be filled by read() is not zeroed first),
+        // other types are value-initialized as by resize.
+        void resize_default_init(size_type count)
+        {
+            this->resize_default_init(count, typename ft::is_trivially_default_constructible<value_type>::type());
+        }
+
+        // resize_default_init, only compiles for trivially default constructible types.
+        // A member template so that an explicit instantiation of the vector does not check it.
+        template <typename USize>
+        // void resize_uninitialized(size_type count)
+        typename ft::enable_if<ft::is_trivially_default_constructible<value_type>::value && ft::is_integral<USize>::value, void>::type resize_uninitialized(USize count)
+        {
+            this->resize_default_init(static_cast<size_type>(count), ft::true_type());
+        }
+
+        // Grows by count uninitialized elements and returns the first of them, the caller writes them.
+        // Only compiles for trivially default constructible types, a member template as above.
+        template <typename USize>
+        // pointer append_uninitialized(size_type count)
+        typename ft::enable_if<ft::is_trivially_default_constructible<value_type>::value && ft::is_integral<USize>::value, pointer>::type append_uninitialized(USize count)
+        {
+            size_type index = this->size();
+            this->grow_uninitialized(static_cast<size_type>(count), "vector::append_uninitialized", ft::true_type());
+            return this->start + index;
+        }
+
+    protected:
+        void resize_default_init(size_type count, ft::true_type)
+        {
+            size_type size = this->size();
+            if (count > size)
+            {
+                this->grow_uninitialized(count - size, "vector::resize", ft::true_type());
+            }
+            else
+            {
+                this->destroy_tail_n(size - count);
+            }
+        }
+
+        void resize_default_init(size_type count, ft::false_type)
+        {
+            this->resize(count);
+        }
+
+        // the new elements need no construction, only room: growth is amortized as for insert
+        void grow_uninitialized(size_type count, const char* caller, ft::true_type)
+        {
+            size_type new_cap = this->expand(count, caller);
+            if (new_cap != this->capacity())
+            {
+                this->reserve(new_cap);
+            }
+            this->length += count;
+        }
+
+    public:
         void swap(vector& that)
         {
             ft::swap(this->start, that.start);
@@ -591,10 +991,10 @@ namespace ft
         }
     };
 
-    template <typename T, typename TAlloc>
+    template <typename T, typename TAlloc, typename TGrowth>
     inline void swap(
-        vector<T, TAlloc>& lhs,
-        vector<T, TAlloc>& rhs)
+        vector<T, TAlloc, TGrowth>& lhs,
+        vector<T, TAlloc, TGrowth>& rhs)
     {
         lhs.swap(rhs);
     }
@@ -602,11 +1002,13 @@ namespace ft
 
 namespace std
 {
-    template <typename T, typename TAlloc>
+    template <typename T, typename TAlloc, typename TGrowth>
     inline void swap(
-        ft::vector<T, TAlloc>& lhs,
-        ft::vector<T, TAlloc>& rhs)
+        ft::vector<T, TAlloc, TGrowth>& lhs,
+        ft::vector<T, TAlloc, TGrowth>& rhs)
     {
         ft::swap(lhs, rhs);
     }
 }
+
+#include "_vector_bool.hpp"
@@ -0,0 +1,85 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "algorithm.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+// a value of T spread over the whole range, negative ones included
+template <typename T>
+static T value(unsigned bits)
+{
+    return static_cast<T>(bits * 2654435761u);
+}
+
+// Equal prefixes of every length around the memcmp block, then one changed element
+// at a random place, compared through pointers, const pointers and vector iterators.
+template <typename T>
+static void test_type()
+{
+    for (unsigned round = 0; round < 600; ++round)
+    {
+        std::size_t n = round % 3 == 0 ? round / 3 : test::random() % 600;
+        std::size_t m = round % 4 == 0 ? n : test::random() % 600;
+        std::vector<T> lhs;
+        std::vector<T> rhs;
+        for (std::size_t i = 0; i < n || i < m; ++i)
+        {
+            T v = value<T>(test::random());
+            if (i < n)
+                lhs.push_back(v);
+            if (i < m)
+                rhs.push_back(v);
+        }
+        if (round % 2 == 1 && n != 0 && m != 0)
+        {
+            std::size_t at = test::random() % (n < m ? n : m);
+            rhs[at] = value<T>(test::random());
+        }
+        ft::vector<T> a(lhs.begin(), lhs.end());
+        ft::vector<T> b(rhs.begin(), rhs.end());
+        const T* p = lhs.empty() ? NULL : &lhs[0];
+        T* q = rhs.empty() ? NULL : &rhs[0];
+
+        bool less = std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        bool greater = std::lexicographical_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+        CHECK(ft::lexicographical_compare(p, p + n, q, q + m) == less);
+        CHECK(ft::lexicographical_compare(q, q + m, p, p + n) == greater);
+        CHECK(ft::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()) == less);
+        CHECK(ft::lexicographical_compare(b.begin(), b.end(), lhs.begin(), lhs.end()) == greater);
+        CHECK((a < b) == less && (b < a) == greater);
+
+        std::size_t k = n < m ? n : m;
+        bool same = std::equal(lhs.begin(), lhs.begin() + k, rhs.begin());
+        CHECK(ft::equal(p, p + k, q) == same);
+        CHECK(ft::equal(a.begin(), a.begin() + k, b.begin()) == same);
+        CHECK(ft::equal(lhs.begin(), lhs.begin() + k, b.begin()) == same);
+        CHECK((a == b) == (lhs == rhs));
+    }
+}
+
+int main()
+{
+    CHECK((ft::_internal::is_bitwise_comparable<const int*, int*>::value));
+    CHECK((ft::_internal::is_bitwise_comparable<ft::vector<char>::iterator, ft::vector<char>::const_iterator>::value));
+    CHECK(!(ft::_internal::is_bitwise_comparable<const int*, unsigned*>::value));
+    CHECK(!(ft::_internal::is_bitwise_comparable<const double*, const double*>::value));
+
+    test_type<char>();
+    test_type<signed char>();
+    test_type<unsigned char>();
+    test_type<short>();
+    test_type<unsigned short>();
+    test_type<int>();
+    test_type<unsigned>();
+    test_type<long>();
+    test_type<unsigned long>();
+    test_type<double>();
+    return 0;
+}
@@ -0,0 +1,169 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "algorithm.hpp"
+#include "deque.hpp"
+#include "queue.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <queue>
+#include <string>
+
+static void test_differential()
+{
+    ft::deque<std::string> d;
+    std::deque<std::string> s;
+    for (unsigned round = 0; round < 20000; ++round)
+    {
+        std::size_t n = s.size();
+        switch (test::random() % 8)
+        {
+        case 0:
+        case 1:
+            d.push_back(test::text(round));
+            s.push_back(test::text(round));
+            break;
+        case 2:
+        case 3:
+            d.push_front(test::text(round));
+            s.push_front(test::text(round));
+            break;
+        case 4:
+            if (n != 0)
+            {
+                d.pop_back();
+                s.pop_back();
+            }
+            break;
+        case 5:
+            if (n != 0)
+            {
+                d.pop_front();
+                s.pop_front();
+            }
+            break;
+        case 6:
+        {
+            std::size_t pos = test::random() % (n + 1);
+            // at least one: libstdc++ moves the tail onto itself on an empty fill insert
+            std::size_t count = 1 + test::random() % 9;
+            d.insert(d.begin() + pos, count, test::text(round));
+            s.insert(s.begin() + pos, count, test::text(round));
+            break;
+        }
+        case 7:
+            if (n != 0)
+            {
+                std::size_t first = test::random() % n;
+                std::size_t last = first + test::random() % (n - first + 1) / 4;
+                d.erase(d.begin() + first, d.begin() + last);
+                s.erase(s.begin() + first, s.begin() + last);
+            }
+            break;
+        }
+        if (round % 100 == 0)
+        {
+            CHECK(test::same(d, s));
+            for (std::size_t i = 0; i < s.size(); i += 17)
+            {
+                CHECK(d[i] == s[i] && d.at(i) == s.at(i));
+            }
+        }
+    }
+    CHECK(test::same(d, s));
+}
+
+static void test_priority_queue()
+{
+    ft::priority_queue<unsigned> q;
+    std::priority_queue<unsigned> s;
+    for (unsigned round = 0; round < 5000; ++round)
+    {
+        if (test::random() % 3 != 0 || s.empty())
+        {
+            unsigned value = test::random() % 1000;
+            q.push(value);
+            s.push(value);
+        }
+        else
+        {
+            CHECK(q.top() == s.top());
+            q.pop();
+            s.pop();
+        }
+        CHECK(q.size() == s.size());
+    }
+    for (; !s.empty(); s.pop())
+    {
+        CHECK(q.top() == s.top());
+        q.pop();
+    }
+}
+
+// counts copies, a heap built from rvalue references should not make any
+struct counted
+{
+    static std::size_t copies;
+
+    std::string value;
+
+    explicit counted(const std::string& value) : value(value) {}
+    counted(const counted& that) : value(that.value) { copies++; }
+
+    counted& operator=(const counted& that)
+    {
+        this->value = that.value;
+        copies++;
+        return *this;
+    }
+
+#if __cplusplus >= 201103L
+    counted(counted&&) = default;
+    counted& operator=(counted&&) = default;
+#endif
+
+    bool operator<(const counted& that) const { return this->value < that.value; }
+};
+
+std::size_t counted::copies = 0;
+
+static void test_heap()
+{
+    ft::vector<counted> v;
+    std::deque<std::string> s;
+    for (unsigned i = 0; i < 500; ++i)
+    {
+        v.push_back(counted(test::text(test::random())));
+        s.push_back(v.back().value);
+    }
+    counted::copies = 0;
+    ft::make_heap(v.begin(), v.end());
+    for (std::size_t i = 1; i < v.size(); ++i)
+    {
+        CHECK(!(v[(i - 1) / 2] < v[i]));
+    }
+    ft::pop_heap(v.begin(), v.end());
+    ft::push_heap(v.begin(), v.end());
+    ft::sort_heap(v.begin(), v.end());
+#if __cplusplus >= 201103L
+    CHECK(counted::copies == 0);
+#endif
+    std::sort(s.begin(), s.end());
+    for (std::size_t i = 0; i < s.size(); ++i)
+    {
+        CHECK(v[i].value == s[i]);
+    }
+}
+
+int main()
+{
+    test_differential();
+    test_priority_queue();
+    test_heap();
+    return 0;
+}
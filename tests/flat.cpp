@@ -0,0 +1,306 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "flat_map.hpp"
+#include "flat_set.hpp"
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+typedef ft::pair<unsigned, unsigned> entry;
+typedef std::vector<entry> entries;
+
+// the order field numbers the entries, so equal keys can be told apart in a multimap
+static entries random_entries(std::size_t n, unsigned range, unsigned& order)
+{
+    entries e;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        e.push_back(entry(test::random() % range, order++));
+    }
+    return e;
+}
+
+template <typename TFlat, typename TStd>
+static bool same_map(const TFlat& f, const TStd& s)
+{
+    if (f.size() != s.size())
+    {
+        return false;
+    }
+    typename TFlat::const_iterator it = f.begin();
+    for (typename TStd::const_iterator other = s.begin(); other != s.end(); ++other, ++it)
+    {
+        if (it->first != other->first || it->second != other->second)
+        {
+            return false;
+        }
+    }
+    return it == f.end();
+}
+
+template <typename TFlat, typename TStd>
+static void insert_both(TFlat& f, TStd& s, const entries& e)
+{
+    f.insert(e.begin(), e.end());
+    for (std::size_t i = 0; i < e.size(); ++i)
+    {
+        s.insert(typename TStd::value_type(e[i].first, e[i].second));
+    }
+}
+
+// merges of every size into every size, with keys narrow enough to collide
+template <typename TFlat, typename TStd>
+static void test_merge()
+{
+    const std::size_t sizes[] = { 0, 1, 5, 100, 1000 };
+    unsigned order = 0;
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+        for (std::size_t j = 0; j < 5; ++j)
+        {
+            unsigned range = test::random() % 2 == 0 ? 50 : 5000;
+            TFlat f;
+            TStd s;
+            insert_both(f, s, random_entries(sizes[i], range, order));
+            CHECK(same_map(f, s));
+            insert_both(f, s, random_entries(sizes[j], range, order));
+            CHECK(same_map(f, s));
+        }
+    }
+}
+
+// ascending batches past the current maximum take the append path
+template <typename TFlat, typename TStd>
+static void test_append()
+{
+    TFlat f;
+    TStd s;
+    unsigned order = 0;
+    for (unsigned round = 0; round < 20; ++round)
+    {
+        entries e;
+        for (unsigned k = 0; k < 50; ++k)
+        {
+            // in order with repeats, the first one equal to the current maximum
+            e.push_back(entry(round * 40 + k - k % 3, order++));
+        }
+        insert_both(f, s, e);
+        CHECK(same_map(f, s));
+    }
+
+    // the same keys once more go through the merge, every one of them a tie
+    entries again;
+    for (typename TStd::const_iterator it = s.begin(); it != s.end(); ++it)
+    {
+        again.push_back(entry(it->first, order++));
+    }
+    insert_both(f, s, again);
+    CHECK(same_map(f, s));
+}
+
+template <typename TFlat, typename TStd, typename TTag>
+static void test_sorted_tag(TTag tag, bool unique)
+{
+    unsigned order = 0;
+    entries existing = random_entries(300, 1000, order);
+    TFlat f(existing.begin(), existing.end());
+    TStd s;
+    for (std::size_t i = 0; i < existing.size(); ++i)
+    {
+        s.insert(typename TStd::value_type(existing[i].first, existing[i].second));
+    }
+
+    entries batch;
+    for (unsigned k = 0; k < 400; k += 1 + test::random() % 3)
+    {
+        batch.push_back(entry(k * 3, order++));
+        if (!unique && k % 5 == 0)
+        {
+            batch.push_back(entry(k * 3, order++));
+        }
+    }
+    f.insert(tag, batch.begin(), batch.end());
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        s.insert(typename TStd::value_type(batch[i].first, batch[i].second));
+    }
+    CHECK(same_map(f, s));
+}
+
+// writes through the proxy references land in the mapped array
+static void test_proxy_writes()
+{
+    ft::flat_map<unsigned, unsigned> f;
+    std::map<unsigned, unsigned> s;
+    for (unsigned i = 0; i < 500; ++i)
+    {
+        unsigned key = test::random() % 1000;
+        f[key] = i;
+        s[key] = i;
+    }
+    for (ft::flat_map<unsigned, unsigned>::iterator it = f.begin(); it != f.end(); ++it)
+    {
+        it->second *= 2;
+        (*it).second += 1;
+    }
+    for (ft::flat_map<unsigned, unsigned>::reverse_iterator it = f.rbegin(); it != f.rend(); it += 2)
+    {
+        it->second = 7;
+        if (f.rend() - it < 2)
+        {
+            break;
+        }
+    }
+    std::size_t k = 0;
+    for (std::map<unsigned, unsigned>::reverse_iterator it = s.rbegin(); it != s.rend(); ++it, ++k)
+    {
+        it->second = k % 2 == 0 ? 7 : it->second * 2 + 1;
+    }
+    CHECK(same_map(f, s));
+
+    ft::flat_map<unsigned, unsigned>::iterator middle = f.begin() + f.size() / 2;
+    middle[1].second = 99;
+    s[(++std::map<unsigned, unsigned>::iterator(s.find(middle->first)))->first] = 99;
+    CHECK(same_map(f, s));
+}
+
+static void test_sets()
+{
+    ft::flat_set<unsigned> f;
+    ft::flat_multiset<unsigned> mf;
+    std::set<unsigned> s;
+    std::multiset<unsigned> ms;
+    for (unsigned round = 0; round < 30; ++round)
+    {
+        std::vector<unsigned> batch;
+        std::size_t n = test::random() % 200;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            // every third batch is ascending and above everything so far
+            batch.push_back(round % 3 == 0 ? round * 1000 + static_cast<unsigned>(i) : test::random() % 600);
+        }
+        f.insert(batch.begin(), batch.end());
+        mf.insert(batch.begin(), batch.end());
+        s.insert(batch.begin(), batch.end());
+        ms.insert(batch.begin(), batch.end());
+        CHECK(test::same(f, s) && test::same(mf, ms));
+    }
+}
+
+// throws on the given call, counting from one
+struct throwing_less
+{
+    static long countdown;
+
+    bool operator()(unsigned lhs, unsigned rhs) const
+    {
+        if (countdown > 0 && --countdown == 0)
+        {
+            throw std::runtime_error("comparison");
+        }
+        return lhs < rhs;
+    }
+};
+
+long throwing_less::countdown = 0;
+
+// every comparison comes before the first move, so a throw leaves the map as it was
+template <typename TFlat>
+static void test_throwing()
+{
+    unsigned order = 0;
+    entries existing = random_entries(200, 300, order);
+    entries batch = random_entries(150, 300, order);
+    for (long call = 1;; ++call)
+    {
+        TFlat f(existing.begin(), existing.end());
+        TFlat before(f);
+        throwing_less::countdown = call;
+        try
+        {
+            f.insert(batch.begin(), batch.end());
+            throwing_less::countdown = 0;
+            break;
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        throwing_less::countdown = 0;
+        CHECK(f == before);
+    }
+}
+
+#if __cplusplus >= 201103L
+// counts its copies, moves are free
+struct counted
+{
+    static std::size_t copies;
+
+    unsigned value;
+
+    counted(unsigned value = 0) : value(value) {}
+    counted(const counted& that) : value(that.value) { copies++; }
+    counted(counted&& that) noexcept : value(that.value) {}
+
+    counted& operator=(const counted& that)
+    {
+        this->value = that.value;
+        copies++;
+        return *this;
+    }
+
+    counted& operator=(counted&& that) noexcept
+    {
+        this->value = that.value;
+        return *this;
+    }
+};
+
+std::size_t counted::copies = 0;
+
+// the merge moves the existing elements, only the batch is copied out of its range
+static void test_merge_moves()
+{
+    ft::flat_map<unsigned, counted> f;
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        f.try_emplace(i * 2, i);
+    }
+    std::vector<ft::pair<unsigned, counted> > batch;
+    for (unsigned i = 0; i < 300; ++i)
+    {
+        batch.push_back(ft::pair<unsigned, counted>(test::random() % 2000 * 2 + 1, counted(i)));
+    }
+    counted::copies = 0;
+    f.insert(batch.begin(), batch.end());
+    CHECK(counted::copies == batch.size());
+    for (std::size_t i = 1; i < f.size(); ++i)
+    {
+        CHECK(f.begin()[i - 1].first < f.begin()[i].first);
+    }
+}
+#endif
+
+int main()
+{
+    test_merge<ft::flat_map<unsigned, unsigned>, std::map<unsigned, unsigned> >();
+    test_merge<ft::flat_multimap<unsigned, unsigned>, std::multimap<unsigned, unsigned> >();
+    test_append<ft::flat_map<unsigned, unsigned>, std::map<unsigned, unsigned> >();
+    test_append<ft::flat_multimap<unsigned, unsigned>, std::multimap<unsigned, unsigned> >();
+    test_sorted_tag<ft::flat_map<unsigned, unsigned>, std::map<unsigned, unsigned> >(ft::sorted_unique, true);
+    test_sorted_tag<ft::flat_multimap<unsigned, unsigned>, std::multimap<unsigned, unsigned> >(ft::sorted_equivalent, false);
+    test_proxy_writes();
+    test_sets();
+    test_throwing<ft::flat_map<unsigned, unsigned, throwing_less> >();
+    test_throwing<ft::flat_multimap<unsigned, unsigned, throwing_less> >();
+#if __cplusplus >= 201103L
+    test_merge_moves();
+#endif
+    return 0;
+}
@@ -0,0 +1,139 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "functional.hpp"
+#include "stdexcept.hpp"
+#include "unordered_map.hpp"
+#include "unordered_set.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <map>
+
+struct counting_hash
+{
+    static std::size_t calls;
+
+    std::size_t operator()(unsigned key) const
+    {
+        calls++;
+        return ft::hash<unsigned>()(key);
+    }
+};
+
+std::size_t counting_hash::calls = 0;
+
+typedef ft::unordered_map<unsigned, unsigned, counting_hash> table;
+
+// iteration order differs from std::map, every element is looked up instead
+static bool same_elements(const table& t, const std::map<unsigned, unsigned>& m)
+{
+    if (t.size() != m.size())
+    {
+        return false;
+    }
+    for (std::map<unsigned, unsigned>::const_iterator it = m.begin(); it != m.end(); ++it)
+    {
+        table::const_iterator found = t.find(it->first);
+        if (found == t.end() || found->second != it->second)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_load_factor()
+{
+    const float factors[] = {0.1f, 0.5f, 0.875f, 1.0f, 4.0f};
+    for (std::size_t f = 0; f < sizeof(factors) / sizeof(factors[0]); f++)
+    {
+        table t;
+        std::map<unsigned, unsigned> m;
+        t.max_load_factor(factors[f]);
+        CHECK(t.max_load_factor() <= 1.0f);
+        for (unsigned round = 0; round < 3000; ++round)
+        {
+            unsigned key = test::random() % 500;
+            if (test::random() % 4 == 0)
+            {
+                CHECK(t.erase(key) == m.erase(key));
+            }
+            else
+            {
+                t[key] += round;
+                m[key] += round;
+            }
+            CHECK(t.load_factor() <= t.max_load_factor());
+            if (round % 500 == 0)
+            {
+                t.max_load_factor(factors[(f + round) % 5]);
+                CHECK(same_elements(t, m));
+            }
+        }
+        CHECK(same_elements(t, m));
+        t.rehash(0);
+        CHECK(same_elements(t, m));
+    }
+}
+
+static void test_invalid_load_factor()
+{
+    const float invalid[] = {0.0f, -1.0f, std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::infinity()};
+    for (std::size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+    {
+        ft::unordered_set<int> s;
+        s.insert(1);
+        float before = s.max_load_factor();
+        bool thrown = false;
+        try
+        {
+            s.max_load_factor(invalid[i]);
+        }
+        catch (const ft::invalid_argument&)
+        {
+            thrown = true;
+        }
+        CHECK(thrown);
+        CHECK(s.max_load_factor() == before);
+        for (int k = 0; k < 100; k++)
+        {
+            s.insert(k);
+        }
+        CHECK(s.size() == 100);
+    }
+
+    ft::unordered_set<int> s;
+    s.max_load_factor(std::numeric_limits<float>::infinity());
+    CHECK(s.max_load_factor() == 1.0f);
+    for (int k = 0; k < 100; k++)
+    {
+        s.insert(k);
+    }
+    CHECK(s.size() == 100 && s.count(42) == 1);
+}
+
+static void test_subscript_hashes_once()
+{
+    table t;
+    t.reserve(100);
+    for (unsigned key = 0; key < 100; key++)
+    {
+        counting_hash::calls = 0;
+        t[key] = key;
+        CHECK(counting_hash::calls == 1);
+        counting_hash::calls = 0;
+        t[key] += 1;
+        CHECK(counting_hash::calls == 1);
+    }
+}
+
+int main()
+{
+    test_load_factor();
+    test_invalid_load_factor();
+    test_subscript_hashes_once();
+    return 0;
+}
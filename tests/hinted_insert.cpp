@@ -0,0 +1,187 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+// every insert ends in validate(), which asserts the red-black invariants
+#define FT_TREE_ASSERT
+
+#include "test.hpp"
+
+#include "map.hpp"
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+// counts the comparisons, a good hint costs a constant number of them
+struct counting_less
+{
+    static std::size_t calls;
+
+    bool operator()(unsigned lhs, unsigned rhs) const
+    {
+        calls++;
+        return lhs < rhs;
+    }
+};
+
+std::size_t counting_less::calls = 0;
+
+typedef ft::pair<unsigned, unsigned> entry;
+typedef std::vector<entry> entries;
+
+enum shape
+{
+    ascending,
+    descending,
+    duplicates,
+    random_keys
+};
+
+// the second field numbers the entries, so the order of equal keys can be checked
+static entries make_entries(std::size_t n, shape s, unsigned base, unsigned& order)
+{
+    entries e;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        unsigned key = 0;
+        switch (s)
+        {
+        case ascending:
+            key = base + static_cast<unsigned>(i);
+            break;
+        case descending:
+            key = base + static_cast<unsigned>(n - i);
+            break;
+        case duplicates:
+            key = base + static_cast<unsigned>(i / 4);
+            break;
+        case random_keys:
+            key = base + test::random() % static_cast<unsigned>(n + 1);
+            break;
+        }
+        e.push_back(entry(key, order++));
+    }
+    return e;
+}
+
+template <typename TFlat, typename TStd>
+static bool same_map(const TFlat& f, const TStd& s)
+{
+    if (f.size() != s.size())
+    {
+        return false;
+    }
+    typename TFlat::const_iterator it = f.begin();
+    for (typename TStd::const_iterator other = s.begin(); other != s.end(); ++other, ++it)
+    {
+        if (it->first != other->first || it->second != other->second)
+        {
+            return false;
+        }
+    }
+    return it == f.end();
+}
+
+// A range goes in after some existing keys: runs above the maximum, below it and across it.
+template <typename TMap, typename TStd>
+static void test_range(shape s)
+{
+    const unsigned bases[] = { 0, 250, 1000 };
+    for (std::size_t b = 0; b < 3; ++b)
+    {
+        unsigned order = 0;
+        entries existing = make_entries(500, random_keys, 0, order);
+        entries batch = make_entries(400, s, bases[b], order);
+
+        TMap m(existing.begin(), existing.end());
+        TStd expected;
+        for (std::size_t i = 0; i < existing.size(); ++i)
+        {
+            expected.insert(typename TStd::value_type(existing[i].first, existing[i].second));
+        }
+        m.insert(batch.begin(), batch.end());
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            expected.insert(typename TStd::value_type(batch[i].first, batch[i].second));
+        }
+        CHECK(same_map(m, expected));
+    }
+}
+
+// An ascending run costs a constant number of comparisons an element through the carried hint,
+// past the maximum as well as in a gap between existing keys; a multimap spends one more
+// in the gap, to keep a hint at an equal key from putting the new element first.
+template <typename TMap>
+static void test_range_comparisons(std::size_t per_element)
+{
+    unsigned order = 0;
+    entries existing = make_entries(1000, ascending, 0, order);
+    TMap m(existing.begin(), existing.end());
+
+    entries up = make_entries(1000, ascending, 5000, order);
+    counting_less::calls = 0;
+    m.insert(up.begin(), up.end());
+    CHECK(counting_less::calls <= 2 * up.size());
+
+    // the first key needs a full descent, the others follow it
+    entries gap = make_entries(1000, ascending, 2000, order);
+    counting_less::calls = 0;
+    m.insert(gap.begin(), gap.end());
+    CHECK(counting_less::calls <= per_element * gap.size() + 30);
+    CHECK(m.size() == 3000);
+}
+
+// Single inserts with the hint a caller would have: end() for ascending keys,
+// the previous position for descending ones, a stale hint for random ones.
+template <typename TMap, typename TStd>
+static void test_hinted(shape s)
+{
+    unsigned order = 0;
+    entries e = make_entries(2000, s, 0, order);
+    TMap m;
+    TStd expected;
+    typename TMap::iterator hint = m.end();
+    typename TStd::iterator expected_hint = expected.end();
+    counting_less::calls = 0;
+    for (std::size_t i = 0; i < e.size(); ++i)
+    {
+        typename TMap::value_type value(e[i].first, e[i].second);
+        if (s == ascending)
+        {
+            hint = m.end();
+            expected_hint = expected.end();
+        }
+        hint = m.insert(hint, value);
+        expected_hint = expected.insert(expected_hint, typename TStd::value_type(e[i].first, e[i].second));
+        if (s == random_keys && i % 3 == 0)
+        {
+            hint = m.begin();
+            expected_hint = expected.begin();
+        }
+    }
+    CHECK(same_map(m, expected));
+    if (s == ascending || s == descending)
+    {
+        CHECK(counting_less::calls <= 2 * e.size());
+    }
+}
+
+int main()
+{
+    typedef ft::map<unsigned, unsigned, counting_less> map_type;
+    typedef ft::multimap<unsigned, unsigned, counting_less> multimap_type;
+    typedef std::map<unsigned, unsigned> std_map;
+    typedef std::multimap<unsigned, unsigned> std_multimap;
+
+    const shape shapes[] = { ascending, descending, duplicates, random_keys };
+    for (std::size_t s = 0; s < 4; ++s)
+    {
+        test_range<map_type, std_map>(shapes[s]);
+        test_range<multimap_type, std_multimap>(shapes[s]);
+        test_hinted<map_type, std_map>(shapes[s]);
+        test_hinted<multimap_type, std_multimap>(shapes[s]);
+    }
+    test_range_comparisons<map_type>(2);
+    test_range_comparisons<multimap_type>(3);
+    return 0;
+}
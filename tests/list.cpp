@@ -0,0 +1,241 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "list.hpp"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#if __cplusplus >= 201103L
+#include <atomic>
+#endif
+
+// the order field tells equal keys apart, so a stable sort has exactly one right answer
+struct item
+{
+    unsigned key;
+    unsigned order;
+
+    bool operator==(const item& that) const { return this->key == that.key && this->order == that.order; }
+};
+
+#if __cplusplus >= 201103L
+typedef std::atomic<long> shared_count;
+#else
+typedef long shared_count;
+#endif
+
+// counts its calls and throws on the given one, counting from one
+struct by_key
+{
+    static shared_count countdown;
+    static shared_count calls;
+
+    bool operator()(const item& lhs, const item& rhs) const
+    {
+        calls++;
+        if (countdown > 0 && --countdown == 0)
+        {
+            throw std::runtime_error("comparison");
+        }
+        return lhs.key < rhs.key;
+    }
+};
+
+shared_count by_key::countdown(0);
+shared_count by_key::calls(0);
+
+struct by_key_and_order
+{
+    bool operator()(const item& lhs, const item& rhs) const
+    {
+        return lhs.key != rhs.key ? lhs.key < rhs.key : lhs.order < rhs.order;
+    }
+};
+
+// nodes come one at a time, only the pointer buffer of buffer_sort takes a block of many
+static std::size_t bulk_allocations = 0;
+
+template <typename T>
+struct counting_allocator : std::allocator<T>
+{
+    template <typename U>
+    struct rebind
+    {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator() {}
+
+    template <typename U>
+    counting_allocator(const counting_allocator<U>&) {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > 1)
+        {
+            bulk_allocations++;
+        }
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+typedef ft::list<item, counting_allocator<item> > item_list;
+
+enum shape
+{
+    sorted,
+    reversed,
+    random_ties,
+    long_runs
+};
+
+static std::vector<item> make_items(std::size_t n, shape s)
+{
+    std::vector<item> items(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        items[i].order = static_cast<unsigned>(i);
+        switch (s)
+        {
+        case sorted:
+            items[i].key = static_cast<unsigned>(i / 3);
+            break;
+        case reversed:
+            items[i].key = static_cast<unsigned>((n - i) / 3);
+            break;
+        case random_ties:
+            items[i].key = test::random() % (1 + n / 4);
+            break;
+        case long_runs:
+            // ascending runs of 100, far longer than _list_sorted_run_length
+            items[i].key = i % 100 == 0 ? test::random() % 50 : items[i - 1].key + test::random() % 2;
+            break;
+        }
+    }
+    return items;
+}
+
+// a list whose links break shows up as a wrong count one way or the other
+static bool walks(const item_list& l)
+{
+    std::size_t forward = 0;
+    for (item_list::const_iterator it = l.begin(); it != l.end(); ++it)
+    {
+        forward++;
+    }
+    std::size_t backward = 0;
+    for (item_list::const_reverse_iterator it = l.rbegin(); it != l.rend(); ++it)
+    {
+        backward++;
+    }
+    return forward == l.size() && backward == l.size();
+}
+
+static void check_sort(std::size_t n, shape s, bool parallel)
+{
+    std::vector<item> items = make_items(n, s);
+    item_list l(items.begin(), items.end());
+    std::list<item> expected(items.begin(), items.end());
+    expected.sort(by_key());
+
+    bulk_allocations = 0;
+    by_key::calls = 0;
+#if __cplusplus >= 201103L
+    if (parallel)
+    {
+        l.parallel_sort(by_key(), 4);
+    }
+    else
+#endif
+    {
+        l.sort(by_key());
+    }
+    static_cast<void>(parallel);
+    CHECK(test::same(l, expected) && walks(l));
+
+    if (!parallel)
+    {
+        bool buffered = n >= ft::_internal::_list_buffer_sort_threshold;
+        CHECK(bulk_allocations == (buffered ? 1u : 0u));
+        if (s == sorted && n != 0)
+        {
+            // one pass either way, the buffer path returns as soon as it has found no descent
+            CHECK(by_key::calls == static_cast<long>(n - 1));
+        }
+    }
+}
+
+static void check_throwing(std::size_t n, bool parallel)
+{
+    std::vector<item> items = make_items(n, random_ties);
+    std::list<item> contents(items.begin(), items.end());
+    contents.sort(by_key_and_order());
+    const long calls[] = { 1, 2, 7, static_cast<long>(n / 2), static_cast<long>(n), static_cast<long>(3 * n) };
+    for (std::size_t c = 0; c < sizeof(calls) / sizeof(calls[0]); ++c)
+    {
+        item_list l(items.begin(), items.end());
+        by_key::countdown = calls[c];
+        try
+        {
+#if __cplusplus >= 201103L
+            if (parallel)
+            {
+                l.parallel_sort(by_key(), 4);
+            }
+            else
+#endif
+            {
+                l.sort(by_key());
+            }
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        by_key::countdown = 0;
+        static_cast<void>(parallel);
+
+        CHECK(l.size() == n && walks(l));
+        if (!parallel && n >= ft::_internal::_list_buffer_sort_threshold && calls[c] < static_cast<long>(n))
+        {
+            // the buffer sort throws before it relinks anything
+            CHECK(test::same(l, items));
+        }
+        // every element is still there exactly once
+        std::list<item> left(l.begin(), l.end());
+        left.sort(by_key_and_order());
+        CHECK(test::same(left, contents));
+    }
+}
+
+int main()
+{
+    const std::size_t threshold = ft::_internal::_list_buffer_sort_threshold;
+    const std::size_t sizes[] = { 0, 1, 2, 3, 17, 1000, threshold - 1, threshold, threshold + 1, 3 * threshold };
+    const shape shapes[] = { sorted, reversed, random_ties, long_runs };
+    for (std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        for (std::size_t s = 0; s < 4; ++s)
+        {
+            check_sort(sizes[i], shapes[s], false);
+        }
+    }
+    check_throwing(100, false);
+    check_throwing(3 * threshold, false);
+
+#if __cplusplus >= 201103L
+    // enough for four slices of _parallel_sort_grain
+    const std::size_t large = 4 * ft::_internal::_parallel_sort_grain + 11;
+    for (std::size_t s = 0; s < 4; ++s)
+    {
+        check_sort(large, shapes[s], true);
+    }
+    check_throwing(large, true);
+#endif
+    return 0;
+}
@@ -0,0 +1,188 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "list.hpp"
+#include "map.hpp"
+#include "set.hpp"
+#include "utility.hpp"
+
+#include <map>
+#include <string>
+
+static void test_differential()
+{
+    ft::map<unsigned, std::string> m;
+    std::map<unsigned, std::string> s;
+    for (unsigned round = 0; round < 5000; ++round)
+    {
+        unsigned key = test::random() % 300;
+        switch (test::random() % 3)
+        {
+        case 0:
+            m[key] = test::text(round);
+            s[key] = test::text(round);
+            break;
+        case 1:
+            CHECK(m.erase(key) == s.erase(key));
+            break;
+        case 2:
+            CHECK(m.insert(ft::make_pair(key, test::text(round))).second == s.insert(std::make_pair(key, test::text(round))).second);
+            break;
+        }
+    }
+    CHECK(m.size() == s.size());
+    std::map<unsigned, std::string>::const_iterator it = s.begin();
+    for (ft::map<unsigned, std::string>::const_iterator mt = m.begin(); mt != m.end(); ++mt, ++it)
+    {
+        CHECK(mt->first == it->first && mt->second == it->second);
+    }
+}
+
+#if __cplusplus >= 201103L
+// neither copyable nor movable: try_emplace has to build it where it stays
+struct pinned
+{
+    int a;
+    std::string b;
+
+    pinned(int a, const std::string& b) : a(a), b(b) {}
+    pinned(const pinned&) = delete;
+    pinned& operator=(const pinned&) = delete;
+};
+
+struct throwing_move_only
+{
+    int value;
+
+    explicit throwing_move_only(int value) : value(value) {}
+    throwing_move_only(throwing_move_only&& that) noexcept(false) : value(that.value) { that.value = -1; }
+    throwing_move_only(const throwing_move_only&) = delete;
+};
+
+struct throwing_copy
+{
+    throwing_copy() {}
+    throwing_copy(const throwing_copy&) noexcept(false) {}
+    bool operator()(int lhs, int rhs) const { return lhs < rhs; }
+};
+
+// throws on the comparison after armed ones
+struct throwing_less
+{
+    static int armed;
+
+    bool operator()(int lhs, int rhs) const
+    {
+        if (armed != 0 && --armed == 0)
+        {
+            throw 0;
+        }
+        return lhs < rhs;
+    }
+};
+
+int throwing_less::armed = 0;
+
+static void test_node_insert_throws()
+{
+    ft::multiset<int, throwing_less> source;
+    ft::multiset<int, throwing_less> target;
+    ft::multimap<int, std::string, throwing_less> map_source;
+    ft::multimap<int, std::string, throwing_less> map_target;
+    for (int i = 0; i < 20; ++i)
+    {
+        source.insert(i);
+        target.insert(i);
+        map_source.insert(ft::make_pair(i, test::text(i)));
+        map_target.insert(ft::make_pair(i, test::text(i)));
+    }
+    ft::multiset<int, throwing_less>::node_type node = source.extract(source.find(7));
+    ft::multimap<int, std::string, throwing_less>::node_type map_node = map_source.extract(map_source.find(7));
+    throwing_less::armed = 2;
+    try
+    {
+        target.insert(std::move(node));
+        CHECK(false);
+    }
+    catch (int)
+    {
+    }
+    throwing_less::armed = 2;
+    try
+    {
+        map_target.insert(map_target.end(), std::move(map_node));
+        CHECK(false);
+    }
+    catch (int)
+    {
+    }
+    throwing_less::armed = 0;
+    // the handles still own their nodes, which go in on the next attempt
+    CHECK(!node.empty() && node.value() == 7);
+    CHECK(!map_node.empty() && map_node.mapped() == test::text(7));
+    CHECK(target.size() == 20 && map_target.size() == 20);
+    target.insert(std::move(node));
+    map_target.insert(std::move(map_node));
+    CHECK(node.empty() && target.count(7) == 2 && map_target.count(7) == 2);
+}
+
+static void test_try_emplace()
+{
+    ft::map<int, pinned> m;
+    CHECK(m.try_emplace(1, 10, test::text(1)).second);
+    CHECK(!m.try_emplace(1, 20, test::text(2)).second);
+    std::string key_text = test::text(3);
+    ft::map<std::string, pinned> by_name;
+    by_name.try_emplace(by_name.end(), std::move(key_text), 30, test::text(4));
+    CHECK(m.find(1)->second.a == 10 && m.find(1)->second.b == test::text(1));
+    CHECK(by_name.begin()->first == test::text(3) && by_name.begin()->second.a == 30);
+
+    // a key that is already there is not moved from
+    ft::map<std::string, int> counts;
+    counts.try_emplace(test::text(5), 1);
+    std::string again = test::text(5);
+    CHECK(!counts.try_emplace(std::move(again), 2).second);
+    CHECK(again == test::text(5) && counts[test::text(5)] == 1);
+}
+
+static void test_noexcept_moves()
+{
+    static_assert(noexcept(ft::map<int, int>(ft::declval<ft::map<int, int> >())), "map move");
+    static_assert(noexcept(ft::multimap<int, int>(ft::declval<ft::multimap<int, int> >())), "multimap move");
+    static_assert(noexcept(ft::set<int>(ft::declval<ft::set<int> >())), "set move");
+    static_assert(noexcept(ft::multiset<int>(ft::declval<ft::multiset<int> >())), "multiset move");
+    static_assert(noexcept(ft::list<int>(ft::declval<ft::list<int> >())), "list move");
+    static_assert(!noexcept(ft::set<int, throwing_copy>(ft::declval<ft::set<int, throwing_copy> >())), "comparator copy may throw");
+
+    ft::map<int, std::string> m;
+    m[1] = test::text(1);
+    ft::map<int, std::string> moved(std::move(m));
+    CHECK(m.empty() && moved.size() == 1 && moved[1] == test::text(1));
+}
+
+static void test_move_if_noexcept()
+{
+    throwing_move_only source(7);
+    throwing_move_only target(ft::move_if_noexcept(source));
+    CHECK(target.value == 7 && source.value == -1);
+
+    std::string text = test::text(8);
+    static_assert(noexcept(std::string(ft::move_if_noexcept(text))), "nothrow move is a move");
+    std::string taken(ft::move_if_noexcept(text));
+    CHECK(taken == test::text(8));
+}
+#endif
+
+int main()
+{
+    test_differential();
+#if __cplusplus >= 201103L
+    test_try_emplace();
+    test_noexcept_moves();
+    test_move_if_noexcept();
+    test_node_insert_throws();
+#endif
+    return 0;
+}
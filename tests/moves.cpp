@@ -0,0 +1,203 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "algorithm.hpp"
+#include "flat_map.hpp"
+#include "flat_set.hpp"
+#include "unordered_map.hpp"
+#include "unordered_set.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+
+#if __cplusplus >= 201103L
+// counts its copies, moves are free; a container handed rvalues should never copy one
+template <bool NothrowMove>
+struct movable
+{
+    static std::size_t copies;
+
+    int value;
+
+    movable(int value = 0) : value(value) {}
+    movable(const movable& that) : value(that.value) { copies++; }
+    movable(movable&& that) noexcept(NothrowMove) : value(that.value) { that.value = -1; }
+
+    movable& operator=(const movable& that)
+    {
+        this->value = that.value;
+        copies++;
+        return *this;
+    }
+
+    movable& operator=(movable&& that) noexcept(NothrowMove)
+    {
+        this->value = that.value;
+        that.value = -1;
+        return *this;
+    }
+
+    bool operator==(const movable& that) const { return this->value == that.value; }
+    bool operator<(const movable& that) const { return this->value < that.value; }
+};
+
+template <bool NothrowMove>
+std::size_t movable<NothrowMove>::copies = 0;
+
+typedef movable<true> item;
+
+struct item_hash
+{
+    std::size_t operator()(const item& i) const { return static_cast<std::size_t>(i.value); }
+};
+
+// enough elements for several rehashes and reallocations
+static const int count = 3000;
+
+static void test_unordered_map()
+{
+    ft::unordered_map<int, item> m;
+    item::copies = 0;
+    for (int i = 0; i < count; i += 4)
+    {
+        m.try_emplace(i, i);
+        m.emplace(i + 1, item(i + 1));
+        m.insert(ft::pair<const int, item>(i + 2, item(i + 2)));
+        m[i + 3] = item(i + 3);
+    }
+    CHECK(item::copies == 0);
+    CHECK(m.size() == static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i)
+    {
+        CHECK(m.at(i).value == i);
+    }
+
+    // a present key leaves the arguments alone
+    item kept(7);
+    CHECK(!m.try_emplace(5, ft::move(kept)).second && kept.value == 7);
+
+    ft::unordered_map<int, item> moved(ft::move(m));
+    CHECK(moved.size() == static_cast<std::size_t>(count) && m.empty());
+    m = ft::move(moved);
+    CHECK(m.size() == static_cast<std::size_t>(count) && moved.empty());
+    moved.try_emplace(1, 1);
+    CHECK(moved.size() == 1 && item::copies == 0);
+
+    // a move that may throw is not used to rehash, the elements are copied instead
+    typedef movable<false> risky;
+    ft::unordered_map<int, risky> r;
+    r.rehash(0);
+    r.try_emplace(0, 0);
+    risky::copies = 0;
+    for (int i = 1; i < count; ++i)
+    {
+        r.try_emplace(i, i);
+    }
+    CHECK(risky::copies != 0);
+    for (int i = 0; i < count; ++i)
+    {
+        CHECK(r.at(i).value == i);
+    }
+}
+
+static void test_unordered_set()
+{
+    ft::unordered_set<item, item_hash> s;
+    ft::unordered_multiset<item, item_hash> ms;
+    ft::unordered_multimap<int, item> mm;
+    item::copies = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        s.insert(item(i));
+        s.emplace(i);
+        ms.insert(item(i % 100));
+        ms.emplace(i % 100);
+        mm.emplace(i % 100, i);
+    }
+    CHECK(item::copies == 0);
+    CHECK(s.size() == static_cast<std::size_t>(count));
+    CHECK(ms.size() == static_cast<std::size_t>(2 * count) && ms.count(item(42)) == 2 * count / 100);
+    CHECK(mm.size() == static_cast<std::size_t>(count) && mm.count(42) == count / 100);
+
+    ft::unordered_multiset<item, item_hash> moved(ft::move(ms));
+    CHECK(moved.size() == static_cast<std::size_t>(2 * count) && ms.empty());
+    ms = ft::move(moved);
+    CHECK(ms.count(item(42)) == 2 * count / 100 && moved.empty());
+    CHECK(item::copies == 0);
+}
+
+static void test_flat()
+{
+    ft::flat_map<int, item> m;
+    ft::flat_multimap<int, item> mm;
+    ft::flat_set<item> s;
+    ft::flat_multiset<item> ms;
+    item::copies = 0;
+    for (int i = count; i > 0; i -= 3)
+    {
+        // descending keys, every insert shifts the elements after it
+        m.try_emplace(i, i);
+        m.emplace(i - 1, item(i - 1));
+        m.insert(ft::pair<const int, item>(i - 2, item(i - 2)));
+        mm.emplace(i % 10, i);
+        s.insert(item(i));
+        s.emplace(i - 1);
+        ms.emplace(i % 10);
+    }
+    CHECK(item::copies == 0);
+    CHECK(m.size() == static_cast<std::size_t>(count) && s.size() == static_cast<std::size_t>(2 * count / 3));
+    CHECK(mm.count(4) == ms.count(item(4)) && mm.count(4) == static_cast<std::size_t>(count / 30));
+    int expected = 1;
+    for (ft::flat_map<int, item>::const_iterator it = m.begin(); it != m.end(); ++it, ++expected)
+    {
+        CHECK(it->first == expected && it->second.value == expected);
+    }
+
+    item kept(7);
+    CHECK(!m.try_emplace(5, ft::move(kept)).second && kept.value == 7);
+    m[count + 1] = item(count + 1);
+
+    ft::flat_map<int, item> moved(ft::move(m));
+    CHECK(moved.size() == static_cast<std::size_t>(count + 1) && m.empty());
+    m = ft::move(moved);
+    ft::flat_set<item> moved_set(ft::move(s));
+    CHECK(moved_set.size() == static_cast<std::size_t>(2 * count / 3) && s.empty());
+    CHECK(item::copies == 0);
+}
+
+static void test_swap_and_sort()
+{
+    item a(1);
+    item b(2);
+    item::copies = 0;
+    ft::swap(a, b);
+    CHECK(a.value == 2 && b.value == 1 && item::copies == 0);
+
+    // partitioning goes through ft::swap
+    ft::vector<item> v;
+    for (int i = 0; i < count; ++i)
+    {
+        v.push_back(item(static_cast<int>(test::random() % 1000)));
+    }
+    item::copies = 0;
+    ft::sort(v.begin(), v.end());
+    CHECK(item::copies == 0);
+    for (std::size_t i = 1; i < v.size(); ++i)
+    {
+        CHECK(!(v[i] < v[i - 1]));
+    }
+}
+#endif
+
+int main()
+{
+#if __cplusplus >= 201103L
+    test_unordered_map();
+    test_unordered_set();
+    test_flat();
+    test_swap_and_sort();
+#endif
+    return 0;
+}
@@ -0,0 +1,88 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "list.hpp"
+#include "map.hpp"
+#include "set.hpp"
+#include "unordered_set.hpp"
+
+#include <cstddef>
+
+// counts the copies a container makes of the values handed to it
+struct counted
+{
+    static std::size_t copies;
+    static std::size_t live;
+
+    int value;
+
+    counted(int value) : value(value) { live++; }
+    counted(const counted& that) : value(that.value) { copies++; live++; }
+    ~counted() { live--; }
+
+    counted& operator=(const counted& that)
+    {
+        this->value = that.value;
+        copies++;
+        return *this;
+    }
+
+    bool operator==(const counted& that) const { return this->value == that.value; }
+    bool operator<(const counted& that) const { return this->value < that.value; }
+};
+
+std::size_t counted::copies = 0;
+std::size_t counted::live = 0;
+
+struct counted_hash
+{
+    std::size_t operator()(const counted& c) const { return static_cast<std::size_t>(c.value); }
+};
+
+static const int inserts = 1000;
+
+template <typename TCont>
+static void check_one_copy_per_insert(TCont& c)
+{
+    counted::copies = 0;
+    for (int i = 0; i < inserts; i++)
+    {
+        const counted value(static_cast<int>(test::random()));
+        c.insert(c.end(), value);
+    }
+    CHECK(c.size() == static_cast<std::size_t>(inserts));
+    CHECK(counted::copies == static_cast<std::size_t>(inserts));
+    c.clear();
+    CHECK(counted::live == 0);
+}
+
+int main()
+{
+    {
+        ft::list<counted> list;
+        check_one_copy_per_insert(list);
+    }
+    {
+        ft::multiset<counted> set;
+        check_one_copy_per_insert(set);
+    }
+    {
+        ft::multimap<int, counted> map;
+        for (int i = 0; i < inserts; i++)
+        {
+            const ft::pair<const int, counted> value(i % 7, counted(i));
+            counted::copies = 0;
+            map.insert(value);
+            CHECK(counted::copies == 1);
+        }
+        map.clear();
+        CHECK(counted::live == 0);
+    }
+    {
+        ft::unordered_multiset<counted, counted_hash> set;
+        check_one_copy_per_insert(set);
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#define FT_TREE_ASSERT
+
+#include "test.hpp"
+
+#include "iterator.hpp"
+#include "map.hpp"
+#include "set.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Runs in every layout: with FT_TREE_ORDER_STATISTICS the positions come from the subtree
+// sizes, otherwise from walks, and both have to agree with a sorted vector.
+template <typename TSet>
+static void check_positions(const TSet& s, const std::vector<unsigned>& sorted)
+{
+    CHECK(s.size() == sorted.size());
+    CHECK(s.find_by_order(s.size()) == s.end());
+    for (std::size_t k = 0; k < sorted.size(); k += 1 + test::random() % 7)
+    {
+        typename TSet::const_iterator it = s.find_by_order(k);
+        CHECK(*it == sorted[k]);
+        CHECK(static_cast<std::size_t>(ft::distance(s.begin(), it)) == k);
+        CHECK(static_cast<std::size_t>(ft::distance(it, s.end())) == sorted.size() - k);
+
+        typename TSet::const_iterator moved = s.begin();
+        ft::advance(moved, k);
+        CHECK(moved == it);
+        ft::advance(moved, -static_cast<long>(k));
+        CHECK(moved == s.begin());
+    }
+    for (unsigned probe = 0; probe < 50; ++probe)
+    {
+        unsigned key = test::random() % 1200;
+        std::size_t rank = std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+        CHECK(s.order_of_key(key) == rank);
+        std::size_t count = std::upper_bound(sorted.begin(), sorted.end(), key) - sorted.begin() - rank;
+        CHECK(s.count(key) == count);
+    }
+}
+
+template <typename TSet>
+static void test_set(bool unique)
+{
+    TSet s;
+    std::vector<unsigned> sorted;
+    for (unsigned round = 0; round < 6000; ++round)
+    {
+        unsigned key = test::random() % 1000;
+        std::vector<unsigned>::iterator at = std::lower_bound(sorted.begin(), sorted.end(), key);
+        if (test::random() % 3 != 0)
+        {
+            s.insert(key);
+            if (!unique || at == sorted.end() || *at != key)
+            {
+                sorted.insert(at, key);
+            }
+        }
+        else if (!sorted.empty())
+        {
+            // erase by position, so find_by_order has to be right for the erase to match
+            std::size_t k = test::random() % sorted.size();
+            s.erase(s.find_by_order(k));
+            sorted.erase(sorted.begin() + k);
+        }
+        if (round % 500 == 0)
+        {
+            check_positions(s, sorted);
+        }
+    }
+    check_positions(s, sorted);
+}
+
+static void test_map()
+{
+    ft::map<unsigned, unsigned> m;
+    std::vector<unsigned> sorted;
+    for (unsigned i = 0; i < 700; ++i)
+    {
+        unsigned key = test::random() % 5000;
+        if (m.insert(ft::make_pair(key, i)).second)
+        {
+            sorted.insert(std::lower_bound(sorted.begin(), sorted.end(), key), key);
+        }
+    }
+    for (std::size_t k = 0; k < sorted.size(); ++k)
+    {
+        CHECK(m.find_by_order(k)->first == sorted[k]);
+        CHECK(m.order_of_key(sorted[k]) == k);
+    }
+}
+
+int main()
+{
+    test_set<ft::set<unsigned> >(true);
+    test_set<ft::multiset<unsigned> >(false);
+    test_map();
+    return 0;
+}
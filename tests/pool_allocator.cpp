@@ -0,0 +1,117 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "list.hpp"
+#include "map.hpp"
+#include "memory.hpp"
+#include "set.hpp"
+
+#include <list>
+#include <map>
+#include <string>
+
+typedef ft::pool_allocator<std::string> string_pool;
+typedef ft::list<std::string, string_pool> pooled_list;
+
+static void test_map()
+{
+    typedef ft::pool_allocator<ft::pair<const unsigned, std::string> > pool;
+    ft::map<unsigned, std::string, ft::less<unsigned>, pool> m;
+    std::map<unsigned, std::string> s;
+    for (unsigned cycle = 0; cycle < 3; ++cycle)
+    {
+        for (unsigned round = 0; round < 3000; ++round)
+        {
+            unsigned key = test::random() % 500;
+            if (test::random() % 3 == 0)
+            {
+                CHECK(m.erase(key) == s.erase(key));
+            }
+            else
+            {
+                m[key] = test::text(round);
+                s[key] = test::text(round);
+            }
+        }
+        CHECK(m.size() == s.size());
+        std::map<unsigned, std::string>::const_iterator it = s.begin();
+        for (ft::map<unsigned, std::string, ft::less<unsigned>, pool>::const_iterator mt = m.begin(); mt != m.end(); ++mt, ++it)
+        {
+            CHECK(mt->first == it->first && mt->second == it->second);
+        }
+        // the slabs go back, the next cycle starts from a fresh arena
+        m.clear();
+        s.clear();
+    }
+}
+
+static void test_shared_arena()
+{
+    string_pool pool;
+    pooled_list a(pool);
+    pooled_list b(a.get_allocator());
+    std::list<std::string> sa;
+    std::list<std::string> sb;
+    CHECK(a.get_allocator() == b.get_allocator());
+    CHECK(!(a.get_allocator() == string_pool()));
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        a.push_back(test::text(i));
+        sa.push_back(test::text(i));
+        b.push_front(test::text(i));
+        sb.push_front(test::text(i));
+    }
+
+    // nodes change lists within one arena
+    pooled_list::iterator first = a.begin();
+    std::list<std::string>::iterator std_first = sa.begin();
+    for (unsigned i = 0; i < 50; ++i)
+    {
+        ++first;
+        ++std_first;
+    }
+    b.splice(b.begin(), a, a.begin(), first);
+    sb.splice(sb.begin(), sa, sa.begin(), std_first);
+    CHECK(test::same(a, sa) && test::same(b, sb));
+
+    // b still holds nodes of the arena, clearing a must not take the slabs away
+    a.clear();
+    sa.clear();
+    CHECK(test::same(b, sb));
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        a.push_back(test::text(i));
+        sa.push_back(test::text(i));
+    }
+    a.swap(b);
+    sa.swap(sb);
+    CHECK(test::same(a, sa) && test::same(b, sb));
+    a.clear();
+    b.clear();
+    a.push_back(test::text(0));
+    CHECK(a.size() == 1 && a.front() == test::text(0));
+}
+
+static void test_set_copies()
+{
+    ft::set<unsigned, ft::less<unsigned>, ft::pool_allocator<unsigned> > s;
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        s.insert(test::random());
+    }
+    ft::set<unsigned, ft::less<unsigned>, ft::pool_allocator<unsigned> > copy(s);
+    CHECK(copy == s);
+    s.clear();
+    CHECK(copy.size() != 0 && *copy.begin() <= *(--copy.end()));
+    copy.clear();
+}
+
+int main()
+{
+    test_map();
+    test_shared_arena();
+    test_set_copies();
+    return 0;
+}
@@ -0,0 +1,151 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "small_vector.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef ft::small_vector<std::string, 8> small;
+
+template <typename TVector>
+static bool is_inline(const TVector& v)
+{
+    const char* object = reinterpret_cast<const char*>(&v);
+    const char* data = reinterpret_cast<const char*>(v.data());
+    return object <= data && data < object + sizeof(v);
+}
+
+static void test_differential()
+{
+    small v;
+    std::vector<std::string> s;
+    for (unsigned round = 0; round < 20000; ++round)
+    {
+        std::size_t n = s.size();
+        switch (test::random() % 6)
+        {
+        case 0:
+        case 1:
+            v.push_back(test::text(round));
+            s.push_back(test::text(round));
+            break;
+        case 2:
+            if (n != 0)
+            {
+                v.pop_back();
+                s.pop_back();
+            }
+            break;
+        case 3:
+        {
+            std::size_t pos = test::random() % (n + 1);
+            std::size_t count = test::random() % 5;
+            v.insert(v.begin() + pos, count, test::text(round));
+            s.insert(s.begin() + pos, count, test::text(round));
+            break;
+        }
+        case 4:
+            if (n != 0)
+            {
+                std::size_t first = test::random() % n;
+                std::size_t last = first + test::random() % (n - first + 1);
+                v.erase(v.begin() + first, v.begin() + last);
+                s.erase(s.begin() + first, s.begin() + last);
+            }
+            break;
+        case 5:
+            // keeps the size around N, so the elements cross between the inline and heap blocks
+            if (n > 12)
+            {
+                v.resize(test::random() % 8);
+                s.resize(v.size());
+                v.shrink_to_fit();
+            }
+            break;
+        }
+        CHECK(v.capacity() >= 8);
+        if (v.size() <= 8 && v.capacity() == 8)
+        {
+            CHECK(is_inline(v));
+        }
+        if (round % 50 == 0)
+        {
+            CHECK(test::same(v, s));
+        }
+    }
+    CHECK(test::same(v, s));
+}
+
+static void fill(small& v, std::vector<std::string>& s, std::size_t count, unsigned seed)
+{
+    v.clear();
+    s.clear();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        v.push_back(test::text(seed + i));
+        s.push_back(test::text(seed + i));
+    }
+}
+
+static void test_inline_storage()
+{
+    small v;
+    CHECK(v.capacity() == 8 && is_inline(v));
+    std::vector<std::string> s;
+    fill(v, s, 8, 0);
+    CHECK(is_inline(v));
+    v.push_back(test::text(8));
+    s.push_back(test::text(8));
+    CHECK(!is_inline(v) && test::same(v, s));
+    v.resize(3);
+    s.resize(3);
+    v.shrink_to_fit();
+    CHECK(is_inline(v) && test::same(v, s));
+
+    // every pairing of inline and heap blocks, for copy, swap and move
+    const std::size_t sizes[] = { 0, 3, 8, 9, 20 };
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+        for (std::size_t j = 0; j < 5; ++j)
+        {
+            small a;
+            small b;
+            std::vector<std::string> sa;
+            std::vector<std::string> sb;
+            fill(a, sa, sizes[i], 100);
+            fill(b, sb, sizes[j], 200);
+
+            small copy(a);
+            CHECK(test::same(copy, sa) && (sizes[i] > 8 || is_inline(copy)));
+            copy = b;
+            CHECK(test::same(copy, sb));
+
+            a.swap(b);
+            CHECK(test::same(a, sb) && test::same(b, sa));
+            ft::swap(a, b);
+            CHECK(test::same(a, sa) && test::same(b, sb));
+            CHECK(a.capacity() >= 8 && b.capacity() >= 8);
+
+#if __cplusplus >= 201103L
+            small moved(std::move(a));
+            CHECK(test::same(moved, sa) && a.empty() && a.capacity() >= 8);
+            moved = std::move(b);
+            CHECK(test::same(moved, sb) && b.empty() && b.capacity() >= 8);
+            b.push_back(test::text(1));
+            CHECK(b.size() == 1 && b[0] == test::text(1));
+#endif
+        }
+    }
+}
+
+int main()
+{
+    test_differential();
+    test_inline_storage();
+    return 0;
+}
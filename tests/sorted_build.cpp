@@ -0,0 +1,192 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+// the linear build ends in validate(), which asserts the red-black invariants
+#define FT_TREE_ASSERT
+
+#include "test.hpp"
+
+#include "map.hpp"
+#include "set.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+typedef std::vector<unsigned> keys;
+
+// counts the comparisons, the linear build of a tagged range needs none
+struct counting_less
+{
+    static std::size_t calls;
+
+    bool operator()(unsigned lhs, unsigned rhs) const
+    {
+        calls++;
+        return lhs < rhs;
+    }
+};
+
+std::size_t counting_less::calls = 0;
+
+typedef ft::set<unsigned, counting_less> counted_set;
+typedef ft::multiset<unsigned, counting_less> counted_multiset;
+
+// walks both ways, so the parent links are checked as well as the child links
+template <typename TSet>
+static bool holds(const TSet& s, const keys& k)
+{
+    if (!test::same(s, k))
+    {
+        return false;
+    }
+    keys::const_reverse_iterator it = k.rbegin();
+    for (typename TSet::const_reverse_iterator other = s.rbegin(); other != s.rend(); ++other, ++it)
+    {
+        if (*other != *it)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// every size around a power of two fills the last level of the build differently
+static std::vector<std::size_t> build_sizes()
+{
+    std::vector<std::size_t> sizes;
+    for (std::size_t n = 0; n < 20; ++n)
+    {
+        sizes.push_back(n);
+    }
+    for (std::size_t p = 32; p <= 4096; p *= 2)
+    {
+        sizes.push_back(p - 1);
+        sizes.push_back(p);
+        sizes.push_back(p + 1);
+    }
+    return sizes;
+}
+
+static void test_set(std::size_t n)
+{
+    keys k;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        k.push_back(static_cast<unsigned>(i * 3 + 1));
+    }
+
+    counting_less::calls = 0;
+    counted_set tagged(ft::sorted_unique, k.begin(), k.end());
+    CHECK(counting_less::calls == 0);
+    CHECK(holds(tagged, k));
+
+    // without the tag one pass checks the order, then the same build follows
+    counting_less::calls = 0;
+    counted_set detected(k.begin(), k.end());
+    CHECK(counting_less::calls == (n == 0 ? 0 : n - 1));
+    CHECK(holds(detected, k));
+
+    counted_set copy(tagged);
+    CHECK(holds(copy, k));
+
+    // the built tree takes inserts and erases at both ends and in the middle
+    tagged.insert(0);
+    tagged.insert(static_cast<unsigned>(n * 3 + 5));
+    tagged.insert(static_cast<unsigned>(n / 2 * 3 + 2));
+    tagged.erase(static_cast<unsigned>(n / 3 * 3 + 1));
+    keys expected(k);
+    expected.push_back(0);
+    expected.push_back(static_cast<unsigned>(n * 3 + 5));
+    expected.push_back(static_cast<unsigned>(n / 2 * 3 + 2));
+    std::sort(expected.begin(), expected.end());
+    keys::iterator erased = std::find(expected.begin(), expected.end(), static_cast<unsigned>(n / 3 * 3 + 1));
+    if (erased != expected.end())
+    {
+        expected.erase(erased);
+    }
+    CHECK(holds(tagged, expected));
+}
+
+static void test_multiset(std::size_t n)
+{
+    keys k;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        k.push_back(static_cast<unsigned>(i / 3));
+    }
+
+    counting_less::calls = 0;
+    counted_multiset tagged(ft::sorted_equivalent, k.begin(), k.end());
+    CHECK(counting_less::calls == 0);
+    CHECK(holds(tagged, k));
+
+    counted_multiset detected(k.begin(), k.end());
+    CHECK(holds(detected, k));
+    if (n != 0)
+    {
+        CHECK(detected.count(k[n / 2]) == static_cast<std::size_t>(std::count(k.begin(), k.end(), k[n / 2])));
+    }
+}
+
+static void test_map(std::size_t n)
+{
+    std::vector<ft::pair<unsigned, unsigned> > entries;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        entries.push_back(ft::make_pair(static_cast<unsigned>(i * 2), static_cast<unsigned>(i)));
+    }
+    ft::map<unsigned, unsigned> m(ft::sorted_unique, entries.begin(), entries.end());
+    CHECK(m.size() == n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        CHECK(m[static_cast<unsigned>(i * 2)] == i);
+    }
+    CHECK(m.size() == n);
+
+    ft::multimap<unsigned, unsigned> mm(entries.begin(), entries.end());
+    CHECK(mm.size() == n);
+}
+
+// unsorted input without a tag goes through the hinted inserts and still comes out right
+static void test_unsorted(std::size_t n)
+{
+    keys k;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        k.push_back(test::random() % (n + 1));
+    }
+    ft::set<unsigned> s(k.begin(), k.end());
+    ft::multiset<unsigned> ms(k.begin(), k.end());
+
+    keys sorted(k);
+    std::sort(sorted.begin(), sorted.end());
+    CHECK(holds(ms, sorted));
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    CHECK(holds(s, sorted));
+
+    // a sorted range into a tree that is not empty cannot take the linear build
+    keys more;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        more.push_back(static_cast<unsigned>(i * 2));
+    }
+    s.insert(more.begin(), more.end());
+    sorted.insert(sorted.end(), more.begin(), more.end());
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    CHECK(holds(s, sorted));
+}
+
+int main()
+{
+    std::vector<std::size_t> sizes = build_sizes();
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+    {
+        test_set(sizes[i]);
+        test_multiset(sizes[i]);
+        test_map(sizes[i]);
+        test_unsorted(sizes[i]);
+    }
+    return 0;
+}
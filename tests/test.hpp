@@ -0,0 +1,56 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#define CHECK(expr)                                                                  \
+    do                                                                               \
+    {                                                                                \
+        if (!(expr))                                                                 \
+        {                                                                            \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+            std::abort();                                                            \
+        }                                                                            \
+    } while (0)
+
+namespace test
+{
+    // deterministic across runs and standard libraries
+    inline unsigned random()
+    {
+        static unsigned long state = 12345;
+        state = state * 1103515245ul + 12345ul;
+        return static_cast<unsigned>(state >> 8) & 0xffffffu;
+    }
+
+    // long enough to live on the heap, so a moved-from string is visibly empty
+    inline std::string text(unsigned i)
+    {
+        char buffer[64];
+        std::sprintf(buffer, "value %u padded past the small string buffer", i);
+        return buffer;
+    }
+
+    template <typename TLeft, typename TRight>
+    inline bool same(const TLeft& lhs, const TRight& rhs)
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+        typename TLeft::const_iterator it = lhs.begin();
+        for (typename TRight::const_iterator other = rhs.begin(); other != rhs.end(); ++other)
+        {
+            if (!(*it == *other))
+            {
+                return false;
+            }
+            ++it;
+        }
+        return true;
+    }
+}
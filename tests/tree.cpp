@@ -0,0 +1,253 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+// every bulk operation ends in install, which then checks the red-black invariants
+#define FT_TREE_ASSERT
+
+#include "test.hpp"
+
+#include "map.hpp"
+#include "memory.hpp"
+#include "set.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+typedef std::vector<unsigned> keys;
+
+static keys random_keys(std::size_t n, unsigned range)
+{
+    std::set<unsigned> s;
+    while (s.size() < n)
+    {
+        s.insert(test::random() % range);
+    }
+    return keys(s.begin(), s.end());
+}
+
+// walks both ways, so the parent links are checked as well as the child links
+template <typename TSet>
+static bool holds(const TSet& s, const keys& k)
+{
+    if (!test::same(s, k))
+    {
+        return false;
+    }
+    keys::const_reverse_iterator it = k.rbegin();
+    for (typename TSet::const_reverse_iterator other = s.rbegin(); other != s.rend(); ++other)
+    {
+        if (*other != *it)
+        {
+            return false;
+        }
+        ++it;
+    }
+    return true;
+}
+
+enum operation
+{
+    op_union,
+    op_intersection,
+    op_difference,
+    op_join,
+    op_split
+};
+
+template <typename TSet>
+static void apply(operation op, TSet& a, TSet& b, unsigned key)
+{
+    switch (op)
+    {
+    case op_union:
+        a.set_union(b);
+        break;
+    case op_intersection:
+        a.set_intersection(b);
+        break;
+    case op_difference:
+        a.set_difference(b);
+        break;
+    case op_join:
+        a.join(b);
+        break;
+    case op_split:
+        a.split(key, b);
+        break;
+    }
+}
+
+static keys expected(operation op, const keys& a, const keys& b, unsigned key, keys& rest)
+{
+    keys result;
+    rest.clear();
+    switch (op)
+    {
+    case op_union:
+    case op_join:
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+        break;
+    case op_intersection:
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+        break;
+    case op_difference:
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+        break;
+    case op_split:
+        result.assign(a.begin(), std::upper_bound(a.begin(), a.end(), key));
+        rest.assign(std::upper_bound(a.begin(), a.end(), key), a.end());
+        break;
+    }
+    return result;
+}
+
+// a and b from two allocators, equal or not
+template <typename TSet>
+static void test_operations(const typename TSet::allocator_type& alloc_a, const typename TSet::allocator_type& alloc_b)
+{
+    const operation operations[] = { op_union, op_intersection, op_difference, op_join, op_split };
+    const std::size_t sizes[] = { 0, 1, 7, 50, 300 };
+    for (std::size_t o = 0; o < 5; ++o)
+    {
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            for (std::size_t j = 0; j < 5; ++j)
+            {
+                // a narrow range makes the sets overlap, an offset one makes join take its fast path
+                unsigned range = test::random() % 2 == 0 ? 400 : 4000;
+                keys ka = random_keys(sizes[i], range);
+                keys kb = random_keys(sizes[j], range);
+                if (operations[o] == op_join && test::random() % 2 == 0)
+                {
+                    for (std::size_t k = 0; k < kb.size(); ++k)
+                    {
+                        kb[k] += range;
+                    }
+                }
+                unsigned key = test::random() % range;
+
+                TSet a(ka.begin(), ka.end(), typename TSet::key_compare(), alloc_a);
+                TSet b(kb.begin(), kb.end(), typename TSet::key_compare(), alloc_b);
+                apply(operations[o], a, b, key);
+                keys rest;
+                keys result = expected(operations[o], ka, kb, key, rest);
+                CHECK(holds(a, result) && holds(b, rest));
+                CHECK(a.get_allocator() == alloc_a && b.get_allocator() == alloc_b);
+
+                // both stay usable afterwards
+                a.insert(ka.begin(), ka.end());
+                b.insert(kb.begin(), kb.end());
+                CHECK(a.size() >= ka.size() && b.size() >= kb.size());
+            }
+        }
+    }
+}
+
+// throws on the given call, counting from one
+struct throwing_less
+{
+    static long countdown;
+
+    bool operator()(unsigned lhs, unsigned rhs) const
+    {
+        if (countdown > 0 && --countdown == 0)
+        {
+            throw std::runtime_error("comparison");
+        }
+        return lhs < rhs;
+    }
+};
+
+long throwing_less::countdown = 0;
+
+// With a comparator throwing on every call in turn, both sets stay valid and nothing
+// is lost: a union keeps every key in one of them, the others keep subsets of their own.
+template <typename TSet>
+static void test_throwing(const typename TSet::allocator_type& alloc_a, const typename TSet::allocator_type& alloc_b)
+{
+    const operation operations[] = { op_union, op_intersection, op_difference, op_join, op_split };
+    for (std::size_t o = 0; o < 5; ++o)
+    {
+        keys ka = random_keys(50, 200);
+        keys kb = random_keys(33, 200);
+        keys all;
+        std::set_union(ka.begin(), ka.end(), kb.begin(), kb.end(), std::back_inserter(all));
+        for (long call = 1;; ++call)
+        {
+            TSet a(ka.begin(), ka.end(), typename TSet::key_compare(), alloc_a);
+            TSet b(kb.begin(), kb.end(), typename TSet::key_compare(), alloc_b);
+            throwing_less::countdown = call;
+            try
+            {
+                apply(operations[o], a, b, 100);
+                throwing_less::countdown = 0;
+                break;
+            }
+            catch (const std::runtime_error&)
+            {
+            }
+            throwing_less::countdown = 0;
+            CHECK(a.get_allocator() == alloc_a && b.get_allocator() == alloc_b);
+
+            keys in_a(a.begin(), a.end());
+            keys in_b(b.begin(), b.end());
+            CHECK(holds(a, in_a) && holds(b, in_b));
+            if (operations[o] == op_union || operations[o] == op_join || operations[o] == op_split)
+            {
+                // split replaces the content of b, the keys of a end up on either side
+                keys left;
+                std::set_union(in_a.begin(), in_a.end(), in_b.begin(), in_b.end(), std::back_inserter(left));
+                CHECK(left == (operations[o] == op_split ? ka : all));
+            }
+            else
+            {
+                CHECK(std::includes(ka.begin(), ka.end(), in_a.begin(), in_a.end()));
+                CHECK(std::includes(kb.begin(), kb.end(), in_b.begin(), in_b.end()));
+            }
+            a.insert(kb.begin(), kb.end());
+            CHECK(a.size() >= kb.size());
+        }
+    }
+}
+
+static void test_map_split()
+{
+    ft::map<unsigned, unsigned> m;
+    ft::map<unsigned, unsigned> greater;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        m[i * 2] = i;
+    }
+    greater[1000] = 1;
+    m.split(99, greater);
+    CHECK(m.size() == 50 && greater.size() == 50);
+    CHECK(m.rbegin()->first == 98 && greater.begin()->first == 100 && greater.begin()->second == 50);
+    m.join(greater);
+    CHECK(m.size() == 100 && greater.empty());
+}
+
+int main()
+{
+    typedef ft::set<unsigned> plain_set;
+    test_operations<plain_set>(plain_set::allocator_type(), plain_set::allocator_type());
+
+    // one arena: the nodes change hands; two arenas: the argument is copied and keeps its own
+    typedef ft::pool_allocator<unsigned> pool;
+    typedef ft::set<unsigned, ft::less<unsigned>, pool> pooled_set;
+    pool shared;
+    test_operations<pooled_set>(shared, shared);
+    test_operations<pooled_set>(pool(), pool());
+
+    typedef ft::set<unsigned, throwing_less> throwing_set;
+    test_throwing<throwing_set>(throwing_set::allocator_type(), throwing_set::allocator_type());
+    typedef ft::set<unsigned, throwing_less, pool> pooled_throwing_set;
+    test_throwing<pooled_throwing_set>(shared, shared);
+    test_throwing<pooled_throwing_set>(pool(), pool());
+
+    test_map_split();
+    return 0;
+}
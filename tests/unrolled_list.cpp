@@ -0,0 +1,167 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "unrolled_list.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <string>
+
+// four slots per chunk, so a few hundred elements already split and merge chunks often
+typedef ft::unrolled_list<std::string, 4> unrolled;
+
+template <typename TList>
+static typename TList::iterator at(TList& l, std::size_t pos)
+{
+    typename TList::iterator it = l.begin();
+    std::advance(it, pos);
+    return it;
+}
+
+static void test_differential()
+{
+    unrolled u;
+    std::list<std::string> s;
+    for (unsigned round = 0; round < 20000; ++round)
+    {
+        std::size_t n = s.size();
+        switch (test::random() % 8)
+        {
+        case 0:
+        case 1:
+            u.push_back(test::text(round));
+            s.push_back(test::text(round));
+            break;
+        case 2:
+            u.push_front(test::text(round));
+            s.push_front(test::text(round));
+            break;
+        case 3:
+            if (n != 0)
+            {
+                u.pop_back();
+                s.pop_back();
+            }
+            if (n > 1)
+            {
+                u.pop_front();
+                s.pop_front();
+            }
+            break;
+        case 4:
+        case 5:
+        {
+            std::size_t pos = test::random() % (n + 1);
+            CHECK(*u.insert(at(u, pos), test::text(round)) == *s.insert(at(s, pos), test::text(round)));
+            break;
+        }
+        case 6:
+        {
+            std::size_t pos = test::random() % (n + 1);
+            std::size_t count = test::random() % 9;
+            u.insert(at(u, pos), count, test::text(round));
+            s.insert(at(s, pos), count, test::text(round));
+            break;
+        }
+        case 7:
+            if (n != 0)
+            {
+                std::size_t first = test::random() % n;
+                std::size_t last = first + test::random() % (n - first + 1) / 4;
+                unrolled::iterator it = u.erase(at(u, first), at(u, last));
+                s.erase(at(s, first), at(s, last));
+                CHECK(it == at(u, first));
+            }
+            break;
+        }
+        if (round % 100 == 0)
+        {
+            CHECK(test::same(u, s));
+        }
+    }
+    CHECK(test::same(u, s));
+
+    // walk backwards through the chunks
+    std::list<std::string>::reverse_iterator other = s.rbegin();
+    for (unrolled::reverse_iterator it = u.rbegin(); it != u.rend(); ++it)
+    {
+        CHECK(*it == *other);
+        ++other;
+    }
+}
+
+static void test_list_operations()
+{
+    unrolled u;
+    std::list<std::string> s;
+    for (unsigned i = 0; i < 300; ++i)
+    {
+        std::string value = test::text(test::random() % 100);
+        u.push_back(value);
+        s.push_back(value);
+    }
+
+    u.sort();
+    s.sort();
+    CHECK(test::same(u, s));
+    u.unique();
+    s.unique();
+    CHECK(test::same(u, s));
+    u.reverse();
+    s.reverse();
+    CHECK(test::same(u, s));
+    u.remove(test::text(42));
+    s.remove(test::text(42));
+    CHECK(test::same(u, s));
+    u.resize(17);
+    s.resize(17);
+    CHECK(test::same(u, s));
+    u.resize(40, test::text(7));
+    s.resize(40, test::text(7));
+    CHECK(test::same(u, s));
+
+    unrolled v;
+    std::list<std::string> t;
+    for (unsigned i = 0; i < 50; ++i)
+    {
+        v.push_back(test::text(i));
+        t.push_back(test::text(i));
+    }
+    u.splice(at(u, 5), v, at(v, 10), at(v, 30));
+    s.splice(at(s, 5), t, at(t, 10), at(t, 30));
+    CHECK(test::same(u, s) && test::same(v, t));
+    u.splice(at(u, 20), v, at(v, 3));
+    s.splice(at(s, 20), t, at(t, 3));
+    CHECK(test::same(u, s) && test::same(v, t));
+    u.splice(u.end(), v);
+    s.splice(s.end(), t);
+    CHECK(test::same(u, s) && v.empty());
+
+    u.sort();
+    s.sort();
+    for (unsigned i = 0; i < 60; ++i)
+    {
+        v.push_back(test::text(i * 3));
+        t.push_back(test::text(i * 3));
+    }
+    v.sort();
+    t.sort();
+    u.merge(v);
+    s.merge(t);
+    CHECK(test::same(u, s) && v.empty());
+
+    unrolled copy(u);
+    CHECK(test::same(copy, s));
+    copy.swap(v);
+    CHECK(copy.empty() && test::same(v, s));
+}
+
+int main()
+{
+    test_differential();
+    test_list_operations();
+    return 0;
+}
@@ -0,0 +1,194 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "flat_map.hpp"
+#include "flat_set.hpp"
+#include "memory.hpp"
+#include "vector.hpp"
+
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// every member is instantiated, the ones limited to trivial types must not get in the way
+template class ft::vector<std::string>;
+template class ft::vector<int, ft::malloc_allocator<int> >;
+
+static void test_erase()
+{
+    for (unsigned round = 0; round < 500; ++round)
+    {
+        ft::vector<std::string> v;
+        std::vector<std::string> s;
+        for (unsigned i = test::random() % 20; i != 0; --i)
+        {
+            v.push_back(test::text(i));
+            s.push_back(test::text(i));
+        }
+        unsigned first = test::random() % (s.size() + 1);
+        unsigned last = first + test::random() % (s.size() - first + 1);
+        CHECK(v.erase(v.begin() + first, v.begin() + last) - v.begin() == static_cast<long>(first));
+        s.erase(s.begin() + first, s.begin() + last);
+        CHECK(test::same(v, s));
+        if (!s.empty())
+        {
+            unsigned pos = test::random() % s.size();
+            v.erase(v.begin() + pos);
+            s.erase(s.begin() + pos);
+            CHECK(test::same(v, s));
+        }
+    }
+}
+
+static void test_flat_erase_missing()
+{
+    ft::flat_multiset<std::string> set;
+    ft::flat_multimap<std::string, std::string> map;
+    for (unsigned i = 0; i < 10; ++i)
+    {
+        set.insert(test::text(i));
+        map.insert(ft::make_pair(test::text(i), test::text(i)));
+    }
+    CHECK(set.erase("missing") == 0);
+    CHECK(map.erase("missing") == 0);
+    CHECK(set.size() == 10 && map.size() == 10);
+    for (unsigned i = 0; i < 10; ++i)
+    {
+        CHECK(set.count(test::text(i)) == 1);
+        CHECK(map.find(test::text(i))->second == test::text(i));
+    }
+}
+
+static std::string numbers(unsigned first, unsigned count)
+{
+    std::ostringstream out;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        out << first + i << ' ';
+    }
+    return out.str();
+}
+
+// single pass ranges are appended and rotated into place, or assigned over the live elements
+static void test_input_iterators()
+{
+    typedef std::istream_iterator<int> input;
+    for (unsigned round = 0; round < 300; ++round)
+    {
+        unsigned size = test::random() % 20;
+        std::istringstream initial(numbers(0, size));
+        ft::vector<int> v((input(initial)), input());
+        std::vector<int> s;
+        for (unsigned i = 0; i < size; ++i)
+        {
+            s.push_back(i);
+        }
+        CHECK(test::same(v, s));
+
+        // the front, the middle and the end
+        unsigned positions[] = { 0, size / 2, size };
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            unsigned count = test::random() % 10;
+            std::istringstream in(numbers(100 * (i + 1), count));
+            std::istringstream copy(in.str());
+            v.insert(v.begin() + positions[i], input(in), input());
+            s.insert(s.begin() + positions[i], input(copy), input());
+            CHECK(test::same(v, s));
+        }
+
+        // shorter and longer than the current size
+        unsigned lengths[] = { static_cast<unsigned>(s.size() / 2), static_cast<unsigned>(s.size() + test::random() % 20) };
+        for (unsigned i = 0; i < 2; ++i)
+        {
+            std::istringstream in(numbers(1000 * (i + 1), lengths[i]));
+            std::istringstream copy(in.str());
+            v.assign(input(in), input());
+            s.assign(input(copy), input());
+            CHECK(test::same(v, s));
+        }
+    }
+}
+
+static void test_insert()
+{
+    for (unsigned round = 0; round < 300; ++round)
+    {
+        ft::vector<std::string> v;
+        std::vector<std::string> s;
+        for (unsigned op = test::random() % 30; op != 0; --op)
+        {
+            unsigned pos = test::random() % (s.size() + 1);
+            unsigned count = test::random() % 5;
+            std::string value = test::text(op);
+            v.insert(v.begin() + pos, count, value);
+            s.insert(s.begin() + pos, count, value);
+            if (!s.empty())
+            {
+                // an element of the vector itself as the source
+                unsigned from = test::random() % s.size();
+                v.insert(v.begin() + pos, v[from]);
+                s.insert(s.begin() + pos, std::string(s[from]));
+            }
+            CHECK(test::same(v, s));
+        }
+        ft::vector<std::string> copy(v);
+        CHECK(copy == v && !(copy < v));
+    }
+}
+
+// the vector grows through realloc and swaps its allocator along with the buffer
+static void test_malloc_allocator()
+{
+    ft::vector<int, ft::malloc_allocator<int> > v;
+    ft::vector<int, ft::malloc_allocator<int> > w(3, 7);
+    std::vector<int> s;
+    for (int i = 0; i < 1000; ++i)
+    {
+        v.push_back(i);
+        s.push_back(i);
+    }
+    CHECK(test::same(v, s));
+    v.swap(w);
+    CHECK(test::same(w, s) && v.size() == 3 && v[2] == 7);
+    ft::swap(v, w);
+    CHECK(test::same(v, s) && w.get_allocator() == v.get_allocator());
+}
+
+static void test_uninitialized()
+{
+    ft::vector<int> v;
+    std::vector<int> s;
+    for (int round = 0; round < 200; ++round)
+    {
+        std::size_t count = test::random() % 50;
+        int* p = v.append_uninitialized(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            p[i] = round;
+            s.push_back(round);
+        }
+        CHECK(test::same(v, s));
+        std::size_t size = test::random() % (s.size() + 1);
+        v.resize_uninitialized(size);
+        s.resize(size);
+        CHECK(test::same(v, s));
+    }
+    ft::vector<std::string> strings;
+    strings.resize_default_init(3);
+    CHECK(strings.size() == 3 && strings[2].empty());
+}
+
+int main()
+{
+    test_erase();
+    test_flat_erase_missing();
+    test_input_iterators();
+    test_insert();
+    test_malloc_allocator();
+    test_uninitialized();
+    return 0;
+}
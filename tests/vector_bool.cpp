@@ -0,0 +1,195 @@
+/* Any copyright is dedicated to the Public Domain.
+ * https://creativecommons.org/publicdomain/zero/1.0/ */
+
+#include "test.hpp"
+
+#include "algorithm.hpp"
+#include "flat_map.hpp"
+#include "flat_set.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <list>
+#include <vector>
+
+typedef ft::vector<bool> bits;
+typedef std::vector<bool> std_bits;
+
+static void check_same(const bits& b, const std_bits& s)
+{
+    CHECK(test::same(b, s));
+    std::size_t set = static_cast<std::size_t>(std::count(s.begin(), s.end(), true));
+    CHECK(b.count() == set);
+    CHECK(b.find_first() == static_cast<std::size_t>(std::find(s.begin(), s.end(), true) - s.begin()));
+    std::size_t found = 0;
+    for (std::size_t i = b.find_first(); i < b.size(); i = b.find_next(i + 1))
+    {
+        CHECK(s[i]);
+        ++found;
+    }
+    CHECK(found == set);
+    CHECK(std::equal(b.rbegin(), b.rend(), s.rbegin()));
+}
+
+static void test_differential()
+{
+    for (unsigned round = 0; round < 1000; ++round)
+    {
+        bits b;
+        std_bits s;
+        for (unsigned op = test::random() % 40; op != 0; --op)
+        {
+            std::size_t n = s.size();
+            switch (test::random() % 8)
+            {
+            case 0:
+            case 1:
+            {
+                bool value = test::random() & 1;
+                b.push_back(value);
+                s.push_back(value);
+                break;
+            }
+            case 2:
+                if (n != 0)
+                {
+                    b.pop_back();
+                    s.pop_back();
+                }
+                break;
+            case 3:
+            {
+                std::size_t pos = test::random() % (n + 1);
+                std::size_t count = test::random() % 150;
+                bool value = test::random() & 1;
+                b.insert(b.begin() + pos, count, value);
+                s.insert(s.begin() + pos, count, value);
+                break;
+            }
+            case 4:
+                if (n != 0)
+                {
+                    std::size_t first = test::random() % n;
+                    std::size_t last = first + test::random() % (n - first + 1);
+                    b.erase(b.begin() + first, b.begin() + last);
+                    s.erase(s.begin() + first, s.begin() + last);
+                }
+                break;
+            case 5:
+            {
+                std::size_t count = test::random() % 300;
+                bool value = test::random() & 1;
+                b.resize(count, value);
+                s.resize(count, value);
+                break;
+            }
+            case 6:
+            {
+                std::list<bool> l;
+                for (unsigned i = test::random() % 100; i != 0; --i)
+                {
+                    l.push_back(test::random() % 3 == 0);
+                }
+                std::size_t pos = test::random() % (n + 1);
+                b.insert(b.begin() + pos, l.begin(), l.end());
+                s.insert(s.begin() + pos, l.begin(), l.end());
+                break;
+            }
+            case 7:
+                b.flip();
+                s.flip();
+                break;
+            }
+            check_same(b, s);
+        }
+
+        bits other(s.begin(), s.end());
+        std_bits std_other = s;
+        if (!s.empty())
+        {
+            std::size_t i = test::random() % s.size();
+            other[i].flip();
+            std_other[i] = !std_other[i];
+        }
+        if (test::random() & 1)
+        {
+            other.push_back(true);
+            std_other.push_back(true);
+        }
+        CHECK((other == b) == (std_other == s));
+        CHECK((other < b) == (std_other < s));
+        CHECK((b < other) == (s < std_other));
+
+        // bitwise operators read the right side at the size of the left one
+        bits conj = b & other;
+        bits disj = b | other;
+        bits excl = b ^ other;
+        CHECK(conj.size() == s.size());
+        for (std::size_t i = 0; i < s.size(); ++i)
+        {
+            bool rhs = i < std_other.size() && std_other[i];
+            CHECK(conj[i] == (s[i] && rhs));
+            CHECK(disj[i] == (s[i] || rhs));
+            CHECK(excl[i] == (s[i] != rhs));
+        }
+    }
+}
+
+static void test_algorithms()
+{
+    bits b;
+    std_bits s;
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        bool value = test::random() % 3 == 0;
+        b.push_back(value);
+        s.push_back(value);
+    }
+    ft::reverse(b.begin(), b.end());
+    std::reverse(s.begin(), s.end());
+    CHECK(test::same(b, s));
+    ft::rotate(b.begin(), b.begin() + 77, b.end());
+    std::rotate(s.begin(), s.begin() + 77, s.end());
+    CHECK(test::same(b, s));
+    ft::iter_swap(b.begin(), b.end() - 1);
+    std::iter_swap(s.begin(), s.end() - 1);
+    CHECK(test::same(b, s));
+    ft::swap(b[3], b[4]);
+    std_bits::swap(s[3], s[4]);
+    CHECK(test::same(b, s));
+    ft::make_heap(b.begin(), b.end());
+    ft::sort_heap(b.begin(), b.end());
+    std::sort(s.begin(), s.end());
+    CHECK(test::same(b, s));
+}
+
+static void test_flat_containers()
+{
+    ft::flat_map<int, bool> map;
+    ft::flat_set<bool> set;
+    ft::flat_map<bool, int> by_flag;
+    for (int i = 0; i < 50; ++i)
+    {
+        map[i] = i % 3 == 0;
+        set.insert(i % 2 == 0);
+        by_flag[i % 2 == 0] += i;
+    }
+    CHECK(map.size() == 50 && set.size() == 2 && by_flag.size() == 2);
+    for (int i = 0; i < 50; ++i)
+    {
+        CHECK(map.find(i)->second == (i % 3 == 0));
+    }
+    bool& flag = map.find(7)->second;
+    flag = true;
+    CHECK(map[7]);
+    CHECK(*set.begin() == false && *(set.end() - 1) == true);
+    CHECK(by_flag[true] == 600 && by_flag[false] == 625);
+}
+
+int main()
+{
+    test_differential();
+    test_algorithms();
+    test_flat_containers();
+    return 0;
+}